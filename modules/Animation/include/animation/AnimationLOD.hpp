@@ -0,0 +1,87 @@
+#pragma once
+
+#include "entt/core/type_info.hpp"
+#include "glm/ext/matrix_float4x4.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Animation level of detail (per scene).
+struct AnimationLODSettings {
+  bool enabled{true};
+  // Projected size (of the bounding sphere, relative to the viewport height)
+  // at which the pose is updated every frame. The update interval grows as
+  // the entity gets smaller on the screen.
+  float fullRateScreenSize{0.25f};
+  // Max number of frames between two updates of a visible entity.
+  uint32_t maxInterval{8};
+  // Number of frames between two updates of an entity outside of the
+  // view (0 = paused, the last skin is kept).
+  uint32_t offscreenInterval{0};
+  // Interpolates the skin between the updates (one interval behind).
+  bool interpolate{true};
+  // Max number of pose updates per frame (0 = unlimited).
+  // The smallest (and the least recently updated) entities are postponed.
+  uint32_t maxUpdatesPerFrame{0};
+
+  template <class Archive> void serialize(Archive &archive) {
+    archive(enabled, fullRateScreenSize, maxInterval, offscreenInterval,
+            interpolate, maxUpdatesPerFrame);
+  }
+};
+
+// @param screenSize See AnimationLODSettings::fullRateScreenSize.
+// @return Number of frames between updates (0 = don't update).
+[[nodiscard]] uint32_t calcUpdateInterval(const AnimationLODSettings &,
+                                          float screenSize, bool visible);
+
+// Per entity (runtime only) state.
+class AnimationLOD {
+public:
+  // @param phase Spreads the updates of entities with the same interval over
+  // different frames.
+  explicit AnimationLOD(uint32_t phase = 0);
+
+  // Call once per frame.
+  void advance(uint32_t interval, float dt);
+  [[nodiscard]] bool isDue(uint64_t frame) const;
+  // @return Priority of a due update (see maxUpdatesPerFrame).
+  [[nodiscard]] float getPriority(float screenSize) const;
+
+  [[nodiscard]] uint32_t getInterval() const;
+  // @return Time elapsed since the last update (and marks the entity as
+  // updated).
+  float consumeDeltaTime();
+
+  // -- Skin interpolation:
+
+  // @return Storage for the skin of the new pose.
+  [[nodiscard]] std::span<glm::mat4> pushSkin(std::size_t numJoints);
+  void clearSkin();
+
+  [[nodiscard]] bool canInterpolate() const;
+  [[nodiscard]] std::size_t getNumJoints() const;
+  // Blends between the two last updates (by the time since the last one).
+  void interpolate(std::span<glm::mat4> out) const;
+
+private:
+  uint32_t m_phase{0};
+  uint32_t m_interval{1};
+  uint32_t m_framesSinceUpdate{0};
+  float m_deltaTime{0.0f};
+  bool m_updated{false};
+
+  std::vector<glm::mat4> m_previousSkin;
+  std::vector<glm::mat4> m_latestSkin;
+};
+
+// out[i] = a[i] * (1 - t) + b[i] * t
+void lerpSkin(std::span<const glm::mat4> a, std::span<const glm::mat4> b,
+              float t, std::span<glm::mat4> out);
+
+template <> struct entt::type_hash<AnimationLOD> {
+  [[nodiscard]] static constexpr entt::id_type value() noexcept {
+    return 3911560254;
+  }
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "entt/core/type_info.hpp"
+#include "animation/AnimationManager.hpp"
+#include "animation/PlaybackController.hpp"
+#include "ozz/animation/runtime/skeleton.h"
+
+#include <span>
+#include <vector>
+
+// Weighted stack of animation clips, blended with ozz::animation::BlendingJob.
+// An entity with AnimationLayers ignores AnimationComponent and
+// PlaybackController.
+class AnimationLayers {
+public:
+  enum class Mode : uint8_t {
+    // Weighted average with the other (override) layers.
+    Override = 0,
+    // Added on top of the blended pose (the clip has to be additive).
+    Additive,
+  };
+
+  struct Layer {
+    std::shared_ptr<AnimationResource> animation;
+    PlaybackController controller;
+    Mode mode{Mode::Override};
+    float weight{1.0f};
+    // Per-joint weights (in [0..1]), empty = whole skeleton.
+    // See makeJointMask.
+    std::vector<float> mask;
+
+    // Cross-fade:
+    float targetWeight{1.0f};
+    float fadeSpeed{0.0f}; // Weight change per second, 0 = instant.
+
+    template <class Archive> void save(Archive &archive) const {
+      archive(::serialize(animation), controller, mode, weight, mask,
+              targetWeight, fadeSpeed);
+    }
+    template <class Archive> void load(Archive &archive) {
+      std::optional<std::string> path;
+      archive(path, controller, mode, weight, mask, targetWeight, fadeSpeed);
+      if (path) animation = loadResource<AnimationManager>(*path);
+    }
+  };
+
+  // @return Index of the added layer.
+  std::size_t addLayer(std::shared_ptr<AnimationResource>,
+                       Mode = Mode::Override, float weight = 1.0f);
+  AnimationLayers &removeLayer(std::size_t index);
+  AnimationLayers &clear();
+
+  [[nodiscard]] std::size_t size() const;
+  [[nodiscard]] bool empty() const;
+
+  [[nodiscard]] Layer &getLayer(std::size_t index);
+  [[nodiscard]] const Layer &getLayer(std::size_t index) const;
+  [[nodiscard]] std::span<const Layer> getLayers() const;
+
+  // Changes the weight (linearly) over the given duration (in seconds).
+  AnimationLayers &fadeTo(std::size_t index, float weight, float duration);
+  // Fades the given layer in, and all the other override layers out.
+  AnimationLayers &crossFade(std::size_t index, float duration);
+
+  // Total weight under which the rest pose is used
+  // (see ozz::animation::BlendingJob::threshold).
+  AnimationLayers &setThreshold(float);
+  [[nodiscard]] float getThreshold() const;
+
+  // Advances the playback of each layer and the fades.
+  void update(float dt);
+
+  template <class Archive> void serialize(Archive &archive) {
+    archive(m_layers, m_threshold);
+  }
+
+private:
+  std::vector<Layer> m_layers;
+  float m_threshold{0.1f};
+};
+
+// @return Per-joint weights: the given joint and its descendants (or the whole
+// skeleton if the joint has not been found) get the weight, the rest gets 0.
+[[nodiscard]] std::vector<float>
+makeJointMask(const ozz::animation::Skeleton &, std::string_view jointName,
+              float weight = 1.0f);
+
+static_assert(std::is_copy_constructible_v<AnimationLayers>);
+
+template <> struct entt::type_hash<AnimationLayers> {
+  [[nodiscard]] static constexpr entt::id_type value() noexcept {
+    return 2063716158;
+  }
+};
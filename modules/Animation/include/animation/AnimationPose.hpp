@@ -0,0 +1,59 @@
+#pragma once
+
+#include "animation/AnimationLayers.hpp"
+#include "ozz/animation/runtime/animation.h"
+#include "ozz/animation/runtime/skeleton.h"
+#include "ozz/animation/runtime/sampling_job.h"
+#include "ozz/animation/runtime/blending_job.h"
+#include "ozz/base/maths/soa_transform.h"
+#include "glm/ext/matrix_float4x4.hpp"
+
+#include <memory>
+#include <span>
+#include <vector>
+
+// Persistent (per entity) buffers of the animation update, sized to the
+// skeleton (and the number of layers). Allocates only when the skeleton
+// changes or when a layer is added.
+// Different instances can be updated concurrently.
+class AnimationPose {
+public:
+  // Samples the animation and converts the pose to the model-space.
+  // @return false if the animation doesn't match the skeleton.
+  bool update(const ozz::animation::Skeleton &,
+              const ozz::animation::Animation &, float timeRatio);
+  // Samples and blends the layers (those that don't match the skeleton are
+  // skipped), then converts the pose to the model-space.
+  bool update(const ozz::animation::Skeleton &, const AnimationLayers &);
+
+  [[nodiscard]] std::span<const ozz::math::Float4x4> getModels() const;
+
+private:
+  struct Track {
+    // ozz::animation::SamplingJob::Context is not movable.
+    std::unique_ptr<ozz::animation::SamplingJob::Context> context;
+    std::vector<ozz::math::SoaTransform> locals;
+    std::vector<ozz::math::SimdFloat4> jointWeights;
+  };
+
+  void _resize(const ozz::animation::Skeleton &, std::size_t numTracks);
+  [[nodiscard]] static bool _sample(Track &, const ozz::animation::Animation &,
+                                    float timeRatio);
+  [[nodiscard]] bool _toModelSpace(const ozz::animation::Skeleton &,
+                                   std::span<const ozz::math::SoaTransform>);
+
+private:
+  const ozz::animation::Skeleton *m_skeleton{nullptr};
+  std::vector<Track> m_tracks;
+  std::vector<ozz::math::SoaTransform> m_locals; // Blended.
+  std::vector<ozz::animation::BlendingJob::Layer> m_layers;
+  std::vector<ozz::animation::BlendingJob::Layer> m_additiveLayers;
+  std::vector<ozz::math::Float4x4> m_models;
+};
+
+// skin[i] = models[i] * inverseBindPose[i]
+// SIMD (ozz::math), writes directly to the destination (no temporaries).
+// All spans must be of the same size.
+void buildSkin(std::span<const ozz::math::Float4x4> models,
+               std::span<const glm::mat4> inverseBindPose,
+               std::span<glm::mat4> skin);
@@ -0,0 +1,88 @@
+#include "animation/AnimationLOD.hpp"
+
+#include <algorithm> // min, max, ranges::copy
+#include <cassert>
+#include <cmath>     // ceil
+#include <utility>   // exchange
+
+uint32_t calcUpdateInterval(const AnimationLODSettings &settings,
+                            float screenSize, bool visible) {
+  if (!settings.enabled) return 1;
+  if (!visible) return settings.offscreenInterval;
+  if (screenSize >= settings.fullRateScreenSize) return 1;
+
+  const auto maxInterval = std::max(settings.maxInterval, 1u);
+  if (screenSize <= 0.0f) return maxInterval;
+
+  const auto interval = std::ceil(settings.fullRateScreenSize / screenSize);
+  return uint32_t(std::min(interval, float(maxInterval)));
+}
+
+//
+// AnimationLOD class:
+//
+
+AnimationLOD::AnimationLOD(uint32_t phase) : m_phase{phase} {}
+
+void AnimationLOD::advance(uint32_t interval, float dt) {
+  m_interval = interval;
+  ++m_framesSinceUpdate;
+  m_deltaTime += dt;
+}
+bool AnimationLOD::isDue(uint64_t frame) const {
+  if (m_interval == 0) return false;
+  // Postponed (or the interval has changed).
+  if (!m_updated || m_interval == 1 || m_framesSinceUpdate >= m_interval) {
+    return true;
+  }
+  return (frame + m_phase) % m_interval == 0;
+}
+float AnimationLOD::getPriority(float screenSize) const {
+  return screenSize * float(m_framesSinceUpdate);
+}
+
+uint32_t AnimationLOD::getInterval() const { return m_interval; }
+float AnimationLOD::consumeDeltaTime() {
+  m_updated = true;
+  m_framesSinceUpdate = 0;
+  return std::exchange(m_deltaTime, 0.0f);
+}
+
+std::span<glm::mat4> AnimationLOD::pushSkin(std::size_t numJoints) {
+  std::swap(m_previousSkin, m_latestSkin);
+  m_latestSkin.resize(numJoints);
+  return m_latestSkin;
+}
+void AnimationLOD::clearSkin() {
+  m_previousSkin.clear();
+  m_latestSkin.clear();
+}
+
+bool AnimationLOD::canInterpolate() const {
+  return !m_latestSkin.empty();
+}
+std::size_t AnimationLOD::getNumJoints() const { return m_latestSkin.size(); }
+
+void AnimationLOD::interpolate(std::span<glm::mat4> out) const {
+  assert(out.size() == m_latestSkin.size());
+  if (m_previousSkin.size() != m_latestSkin.size() || m_interval <= 1) {
+    std::ranges::copy(m_latestSkin, out.begin());
+  } else {
+    const auto t = std::min(float(m_framesSinceUpdate) / float(m_interval),
+                            1.0f);
+    lerpSkin(m_previousSkin, m_latestSkin, t, out);
+  }
+}
+
+//
+// Utility:
+//
+
+void lerpSkin(std::span<const glm::mat4> a, std::span<const glm::mat4> b,
+              float t, std::span<glm::mat4> out) {
+  assert(a.size() == b.size() && a.size() == out.size());
+  const auto s = 1.0f - t;
+  for (auto i = 0u; i < out.size(); ++i) {
+    out[i] = a[i] * s + b[i] * t;
+  }
+}
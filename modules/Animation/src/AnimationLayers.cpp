@@ -0,0 +1,119 @@
+#include "animation/AnimationLayers.hpp"
+#include "ozz/animation/runtime/skeleton_utils.h" // IterateJointsDF
+
+#include <algorithm> // min, max, ranges::find
+#include <cassert>
+#include <cmath>     // abs
+
+namespace {
+
+void updateFade(AnimationLayers::Layer &layer, float dt) {
+  if (layer.weight == layer.targetWeight) return;
+
+  if (layer.fadeSpeed <= 0.0f) {
+    layer.weight = layer.targetWeight;
+  } else {
+    const auto step = layer.fadeSpeed * dt;
+    layer.weight = layer.weight < layer.targetWeight
+                     ? std::min(layer.weight + step, layer.targetWeight)
+                     : std::max(layer.weight - step, layer.targetWeight);
+  }
+}
+
+} // namespace
+
+//
+// AnimationLayers class:
+//
+
+std::size_t AnimationLayers::addLayer(std::shared_ptr<AnimationResource> a,
+                                      Mode mode, float weight) {
+  m_layers.push_back(Layer{
+    .animation = std::move(a),
+    .mode = mode,
+    .weight = weight,
+    .targetWeight = weight,
+  });
+  return m_layers.size() - 1;
+}
+AnimationLayers &AnimationLayers::removeLayer(std::size_t index) {
+  assert(index < m_layers.size());
+  m_layers.erase(m_layers.begin() + index);
+  return *this;
+}
+AnimationLayers &AnimationLayers::clear() {
+  m_layers.clear();
+  return *this;
+}
+
+std::size_t AnimationLayers::size() const { return m_layers.size(); }
+bool AnimationLayers::empty() const { return m_layers.empty(); }
+
+AnimationLayers::Layer &AnimationLayers::getLayer(std::size_t index) {
+  assert(index < m_layers.size());
+  return m_layers[index];
+}
+const AnimationLayers::Layer &
+AnimationLayers::getLayer(std::size_t index) const {
+  assert(index < m_layers.size());
+  return m_layers[index];
+}
+std::span<const AnimationLayers::Layer> AnimationLayers::getLayers() const {
+  return m_layers;
+}
+
+AnimationLayers &AnimationLayers::fadeTo(std::size_t index, float weight,
+                                         float duration) {
+  auto &layer = getLayer(index);
+  layer.targetWeight = weight;
+  if (duration > 0.0f) {
+    layer.fadeSpeed = std::abs(weight - layer.weight) / duration;
+  } else {
+    layer.weight = weight;
+    layer.fadeSpeed = 0.0f;
+  }
+  return *this;
+}
+AnimationLayers &AnimationLayers::crossFade(std::size_t index,
+                                            float duration) {
+  for (auto i = 0u; i < m_layers.size(); ++i) {
+    if (i == index) {
+      fadeTo(i, 1.0f, duration);
+    } else if (m_layers[i].mode == Mode::Override) {
+      fadeTo(i, 0.0f, duration);
+    }
+  }
+  return *this;
+}
+
+AnimationLayers &AnimationLayers::setThreshold(float threshold) {
+  m_threshold = threshold;
+  return *this;
+}
+float AnimationLayers::getThreshold() const { return m_threshold; }
+
+void AnimationLayers::update(float dt) {
+  for (auto &layer : m_layers) {
+    updateFade(layer, dt);
+    if (layer.animation) layer.controller.update(*layer.animation, dt);
+  }
+}
+
+//
+// Utility:
+//
+
+std::vector<float> makeJointMask(const ozz::animation::Skeleton &skeleton,
+                                 std::string_view jointName, float weight) {
+  const auto names = skeleton.joint_names();
+  const auto it = std::ranges::find(names, jointName);
+  if (it == names.end()) {
+    return std::vector(skeleton.num_joints(), weight);
+  }
+
+  std::vector<float> mask(skeleton.num_joints(), 0.0f);
+  ozz::animation::IterateJointsDF(
+    skeleton, [&mask, weight](int joint, int) { mask[joint] = weight; },
+    int(std::distance(names.begin(), it)));
+  return mask;
+}
@@ -0,0 +1,171 @@
+#include "animation/AnimationPose.hpp"
+
+#include "ozz/animation/runtime/local_to_model_job.h"
+
+#include "tracy/Tracy.hpp"
+
+#include <cassert>
+
+namespace {
+
+[[nodiscard]] bool isCompatible(const ozz::animation::Skeleton &skeleton,
+                                const ozz::animation::Animation &animation) {
+  return animation.num_tracks() == skeleton.num_joints();
+}
+
+// Per-joint weights to SoA (4 joints per element), missing joints get 0.
+void toSoa(std::span<const float> mask,
+           std::span<ozz::math::SimdFloat4> jointWeights) {
+  const auto get = [mask](std::size_t i) {
+    return i < mask.size() ? mask[i] : 0.0f;
+  };
+  for (auto i = 0u; i < jointWeights.size(); ++i) {
+    const auto j = i * 4;
+    jointWeights[i] = ozz::math::simd_float4::Load(get(j), get(j + 1),
+                                                   get(j + 2), get(j + 3));
+  }
+}
+
+} // namespace
+
+//
+// AnimationPose class:
+//
+
+bool AnimationPose::update(const ozz::animation::Skeleton &skeleton,
+                           const ozz::animation::Animation &animation,
+                           float timeRatio) {
+  if (!isCompatible(skeleton, animation)) return false;
+  _resize(skeleton, 1);
+
+  auto &track = m_tracks.front();
+  return _sample(track, animation, timeRatio) &&
+         _toModelSpace(skeleton, track.locals);
+}
+bool AnimationPose::update(const ozz::animation::Skeleton &skeleton,
+                           const AnimationLayers &animationLayers) {
+  const auto layers = animationLayers.getLayers();
+  _resize(skeleton, layers.size());
+
+  m_layers.clear();
+  m_additiveLayers.clear();
+  for (auto i = 0u; i < layers.size(); ++i) {
+    const auto &layer = layers[i];
+    if (layer.weight <= 0.0f || !layer.animation ||
+        !isCompatible(skeleton, *layer.animation)) {
+      continue;
+    }
+    auto &track = m_tracks[i];
+    if (!_sample(track, *layer.animation,
+                 layer.controller.getTimeRatio())) {
+      return false;
+    }
+    ozz::animation::BlendingJob::Layer blendingLayer;
+    blendingLayer.weight = layer.weight;
+    blendingLayer.transform = ozz::make_span(track.locals);
+    if (!layer.mask.empty()) {
+      toSoa(layer.mask, track.jointWeights);
+      blendingLayer.joint_weights = ozz::make_span(track.jointWeights);
+    }
+    (layer.mode == AnimationLayers::Mode::Additive ? m_additiveLayers
+                                                    : m_layers)
+      .push_back(blendingLayer);
+  }
+
+  {
+    ZoneScopedN("BlendingJob");
+    ozz::animation::BlendingJob blendingJob;
+    blendingJob.threshold = animationLayers.getThreshold();
+    blendingJob.layers = ozz::make_span(m_layers);
+    blendingJob.additive_layers = ozz::make_span(m_additiveLayers);
+    blendingJob.rest_pose = skeleton.joint_rest_poses();
+    blendingJob.output = ozz::make_span(m_locals);
+    if (!blendingJob.Run()) return false;
+  }
+  return _toModelSpace(skeleton, m_locals);
+}
+
+std::span<const ozz::math::Float4x4> AnimationPose::getModels() const {
+  return m_models;
+}
+
+//
+// (private):
+//
+
+void AnimationPose::_resize(const ozz::animation::Skeleton &skeleton,
+                            std::size_t numTracks) {
+  const auto numJoints = std::size_t(skeleton.num_joints());
+  const auto numSoaJoints = std::size_t(skeleton.num_soa_joints());
+  if (m_skeleton != &skeleton || m_models.size() != numJoints) {
+    m_skeleton = &skeleton;
+    m_tracks.clear();
+    m_locals.resize(numSoaJoints);
+    m_models.resize(numJoints);
+  }
+  if (m_tracks.size() >= numTracks) return;
+
+  m_tracks.reserve(numTracks);
+  while (m_tracks.size() < numTracks) {
+    m_tracks.push_back(Track{
+      .context = std::make_unique<ozz::animation::SamplingJob::Context>(
+        int(numJoints)),
+      .locals = std::vector<ozz::math::SoaTransform>(numSoaJoints),
+      .jointWeights = std::vector<ozz::math::SimdFloat4>(numSoaJoints),
+    });
+  }
+  m_layers.reserve(numTracks);
+  m_additiveLayers.reserve(numTracks);
+}
+
+bool AnimationPose::_sample(Track &track,
+                            const ozz::animation::Animation &animation,
+                            float timeRatio) {
+  ZoneScopedN("SamplingJob");
+  ozz::animation::SamplingJob samplingJob;
+  samplingJob.animation = &animation;
+  samplingJob.context = track.context.get();
+  samplingJob.ratio = timeRatio;
+  samplingJob.output = ozz::make_span(track.locals);
+  return samplingJob.Run();
+}
+bool AnimationPose::_toModelSpace(
+  const ozz::animation::Skeleton &skeleton,
+  std::span<const ozz::math::SoaTransform> locals) {
+  ZoneScopedN("LocalToModelJob");
+  ozz::animation::LocalToModelJob localToModelJob;
+  localToModelJob.skeleton = &skeleton;
+  localToModelJob.input = {locals.data(), locals.size()};
+  localToModelJob.output = ozz::make_span(m_models);
+  return localToModelJob.Run();
+}
+
+//
+// Skinning:
+//
+
+void buildSkin(std::span<const ozz::math::Float4x4> models,
+               std::span<const glm::mat4> inverseBindPose,
+               std::span<glm::mat4> skin) {
+  ZoneScopedN("BuildSkin");
+  assert(models.size() == inverseBindPose.size() &&
+         models.size() == skin.size());
+  // glm::mat4 and ozz::math::Float4x4 are both column-major, the columns are
+  // loaded and stored as they are (unaligned), without a conversion.
+  using namespace ozz::math;
+  for (auto i = 0u; i < models.size(); ++i) {
+    const auto &in = inverseBindPose[i];
+    const Float4x4 inverseBind{{
+      simd_float4::LoadPtrU(&in[0].x),
+      simd_float4::LoadPtrU(&in[1].x),
+      simd_float4::LoadPtrU(&in[2].x),
+      simd_float4::LoadPtrU(&in[3].x),
+    }};
+    const auto m = models[i] * inverseBind;
+    auto &out = skin[i];
+    StorePtrU(m.cols[0], &out[0].x);
+    StorePtrU(m.cols[1], &out[1].x);
+    StorePtrU(m.cols[2], &out[2].x);
+    StorePtrU(m.cols[3], &out[3].x);
+  }
+}
@@ -0,0 +1,137 @@
+#include "catch.hpp"
+
+#include "animation/AnimationLOD.hpp"
+
+#include <algorithm> // fill_n, ranges::{fill, max}
+#include <span>
+#include <vector>
+
+namespace {
+
+// Simulates the AnimationSystem scheduling.
+// @return Number of updates in each frame.
+[[nodiscard]] std::vector<uint32_t>
+simulate(const AnimationLODSettings &settings,
+         std::span<const float> screenSizes, const std::vector<bool> &visible,
+         uint32_t numFrames) {
+  std::vector<AnimationLOD> lods;
+  lods.reserve(screenSizes.size());
+  for (auto i = 0u; i < screenSizes.size(); ++i) {
+    lods.emplace_back(i);
+  }
+  std::vector<uint32_t> numUpdates;
+  for (auto frame = 1u; frame <= numFrames; ++frame) {
+    auto n = 0u;
+    for (auto i = 0u; i < lods.size(); ++i) {
+      lods[i].advance(
+        calcUpdateInterval(settings, screenSizes[i], visible[i]), 0.016f);
+      if (lods[i].isDue(frame)) {
+        lods[i].consumeDeltaTime();
+        ++n;
+      }
+    }
+    numUpdates.push_back(n);
+  }
+  return numUpdates;
+}
+
+} // namespace
+
+TEST_CASE("Update interval") {
+  AnimationLODSettings settings{
+    .fullRateScreenSize = 0.25f,
+    .maxInterval = 8,
+    .offscreenInterval = 0,
+  };
+  REQUIRE(calcUpdateInterval(settings, 0.5f, true) == 1);
+  REQUIRE(calcUpdateInterval(settings, 0.25f, true) == 1);
+  REQUIRE(calcUpdateInterval(settings, 0.125f, true) == 2);
+  REQUIRE(calcUpdateInterval(settings, 0.1f, true) == 3);
+  REQUIRE(calcUpdateInterval(settings, 0.001f, true) == 8);
+  REQUIRE(calcUpdateInterval(settings, 0.0f, true) == 8);
+  REQUIRE(calcUpdateInterval(settings, 0.5f, false) == 0);
+
+  settings.offscreenInterval = 30;
+  REQUIRE(calcUpdateInterval(settings, 0.5f, false) == 30);
+
+  settings.enabled = false;
+  REQUIRE(calcUpdateInterval(settings, 0.001f, false) == 1);
+}
+
+TEST_CASE("AnimationLOD") {
+  SECTION("Accumulates the time between the updates") {
+    AnimationLOD lod{0};
+    lod.advance(4, 0.25f);
+    REQUIRE(lod.isDue(1)); // Never updated.
+    REQUIRE(lod.consumeDeltaTime() == 0.25f);
+
+    auto numUpdates = 0;
+    auto totalTime = 0.0f;
+    for (auto frame = 2u; frame < 2 + 16; ++frame) {
+      lod.advance(4, 0.25f);
+      if (lod.isDue(frame)) {
+        ++numUpdates;
+        totalTime += lod.consumeDeltaTime();
+      }
+    }
+    REQUIRE(numUpdates == 4);
+    // Nothing is lost (the remainder is still accumulated).
+    REQUIRE(totalTime + lod.consumeDeltaTime() == Approx{16 * 0.25f});
+  }
+  SECTION("Paused") {
+    AnimationLOD lod{0};
+    for (auto frame = 1u; frame < 10; ++frame) {
+      lod.advance(0, 0.016f);
+      REQUIRE_FALSE(lod.isDue(frame));
+    }
+  }
+  SECTION("Skin interpolation") {
+    AnimationLOD lod{0};
+    lod.advance(4, 0.016f);
+    lod.consumeDeltaTime();
+    REQUIRE_FALSE(lod.canInterpolate());
+
+    std::vector<glm::mat4> skin(2);
+    std::ranges::fill(lod.pushSkin(2), glm::mat4{0.0f});
+    REQUIRE(lod.canInterpolate());
+    lod.interpolate(skin); // Nothing to interpolate with.
+    REQUIRE(skin[0] == glm::mat4{0.0f});
+
+    std::ranges::fill(lod.pushSkin(2), glm::mat4{4.0f});
+    lod.interpolate(skin);
+    REQUIRE(skin[1] == glm::mat4{0.0f}); // One interval behind.
+    for (auto i = 1; i < 4; ++i) {
+      lod.advance(4, 0.016f);
+      lod.interpolate(skin);
+      REQUIRE(skin[1][0][0] == Approx{float(i)});
+    }
+  }
+}
+
+TEST_CASE("Crowd") {
+  // 1000 characters: 50 close to the camera, 450 far and 500 off-screen.
+  constexpr auto kNumFrames = 64u;
+  std::vector<float> screenSizes(1000, 0.5f);
+  std::vector<bool> visible(1000, true);
+  std::fill_n(screenSizes.begin() + 50, 450, 0.01f);
+  std::fill_n(visible.begin() + 500, 500, false);
+
+  const auto numUpdates =
+    simulate(AnimationLODSettings{}, screenSizes, visible, kNumFrames);
+  // The 1st frame updates everything visible (never updated).
+  REQUIRE(numUpdates.front() == 500);
+  // Then: 50 + 450 / 8, evenly spread over the frames.
+  for (auto i = 1u; i < kNumFrames; ++i) {
+    REQUIRE(numUpdates[i] >= 50 + 450 / 8);
+    REQUIRE(numUpdates[i] <= 50 + 450 / 8 + 1);
+  }
+  SECTION("Disabled") {
+    AnimationLODSettings settings;
+    settings.enabled = false;
+    const auto unlimited =
+      simulate(settings, screenSizes, visible, kNumFrames);
+    REQUIRE(std::ranges::max(unlimited) == 1000);
+  }
+}
+
+int main(int argc, char *argv[]) { return Catch::Session{}.run(argc, argv); }
@@ -0,0 +1,378 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include "animation/AnimationPose.hpp"
+#include "animation/Conversion.hpp"
+#include "ThreadPool.hpp"
+
+#include "ozz/animation/offline/raw_skeleton.h"
+#include "ozz/animation/offline/skeleton_builder.h"
+#include "ozz/animation/offline/raw_animation.h"
+#include "ozz/animation/offline/animation_builder.h"
+#include "ozz/animation/runtime/local_to_model_job.h"
+
+#include "glm/ext/matrix_transform.hpp" // translate, rotate, scale
+#include "glm/matrix.hpp"                // inverse
+
+#include <atomic>
+#include <cstdlib> // malloc, free
+#include <new>
+#include <string>
+
+namespace {
+
+std::atomic<std::size_t> g_numAllocations{0};
+
+constexpr auto kNumJoints = 60;
+constexpr auto kNumCharacters = 1000;
+
+// A chain of kNumJoints joints.
+[[nodiscard]] ozz::unique_ptr<ozz::animation::Skeleton> makeSkeleton() {
+  ozz::animation::offline::RawSkeleton raw;
+  raw.roots.resize(1);
+  auto *joint = &raw.roots.front();
+  for (auto i = 0; i < kNumJoints; ++i) {
+    joint->name = "joint" + std::to_string(i);
+    joint->transform = ozz::math::Transform::identity();
+    joint->transform.translation = ozz::math::Float3{0.0f, 0.1f, 0.0f};
+    if (i + 1 < kNumJoints) {
+      joint->children.resize(1);
+      joint = &joint->children.front();
+    }
+  }
+  return ozz::animation::offline::SkeletonBuilder{}(raw);
+}
+[[nodiscard]] ozz::unique_ptr<ozz::animation::Animation> makeAnimation() {
+  ozz::animation::offline::RawAnimation raw;
+  raw.duration = 1.0f;
+  raw.tracks.resize(kNumJoints);
+  for (auto i = 0; i < kNumJoints; ++i) {
+    auto &track = raw.tracks[i];
+    const auto angle = 0.01f * float(i);
+    for (auto t : {0.0f, 0.5f, 1.0f}) {
+      track.translations.push_back({t, ozz::math::Float3{0.0f, 0.1f, t}});
+      track.rotations.push_back(
+        {t, ozz::math::Quaternion::FromAxisAngle(
+              ozz::math::Float3::y_axis(), angle * (1.0f + t))});
+      track.scales.push_back({t, ozz::math::Float3::one()});
+    }
+  }
+  return ozz::animation::offline::AnimationBuilder{}(raw);
+}
+// Each joint translated by (0, height, 0), no rotation.
+[[nodiscard]] std::shared_ptr<AnimationResource> makeClip(float height) {
+  ozz::animation::offline::RawAnimation raw;
+  raw.duration = 1.0f;
+  raw.tracks.resize(kNumJoints);
+  for (auto &track : raw.tracks) {
+    track.translations.push_back({0.0f, ozz::math::Float3{0.0f, height, 0.0f}});
+    track.rotations.push_back({0.0f, ozz::math::Quaternion::identity()});
+    track.scales.push_back({0.0f, ozz::math::Float3::one()});
+  }
+  auto animation = ozz::animation::offline::AnimationBuilder{}(raw);
+  REQUIRE(animation);
+  return std::make_shared<AnimationResource>(std::move(*animation),
+                                             "clip" + std::to_string(height));
+}
+
+// Model-space height of the last joint (= sum of the local heights).
+[[nodiscard]] float getHeight(const AnimationPose &pose) {
+  return ozz::math::GetY(pose.getModels().back().cols[3]);
+}
+
+// Reference: fresh buffers on each call.
+[[nodiscard]] std::vector<ozz::math::Float4x4>
+samplePose(const ozz::animation::Skeleton &skeleton,
+           const ozz::animation::Animation &animation, float timeRatio) {
+  ozz::animation::SamplingJob::Context context{skeleton.num_joints()};
+  std::vector<ozz::math::SoaTransform> locals(skeleton.num_soa_joints());
+  std::vector<ozz::math::Float4x4> models(skeleton.num_joints());
+
+  ozz::animation::SamplingJob samplingJob;
+  samplingJob.animation = &animation;
+  samplingJob.context = &context;
+  samplingJob.ratio = timeRatio;
+  samplingJob.output = ozz::make_span(locals);
+  REQUIRE(samplingJob.Run());
+
+  ozz::animation::LocalToModelJob localToModelJob;
+  localToModelJob.skeleton = &skeleton;
+  localToModelJob.input = ozz::make_span(locals);
+  localToModelJob.output = ozz::make_span(models);
+  REQUIRE(localToModelJob.Run());
+  return models;
+}
+
+[[nodiscard]] bool equal(const ozz::math::Float4x4 &a,
+                         const ozz::math::Float4x4 &b) {
+  for (auto i = 0; i < 4; ++i) {
+    if (!ozz::math::AreAllTrue(ozz::math::CmpEq(a.cols[i], b.cols[i]))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+[[nodiscard]] float timeRatio(int character, int frame) {
+  return float((character + frame * 7) % 100) / 100.0f;
+}
+
+[[nodiscard]] std::vector<glm::mat4> makeInverseBindPose() {
+  std::vector<glm::mat4> out(kNumJoints);
+  for (auto i = 0u; i < out.size(); ++i) {
+    const auto m = glm::rotate(
+      glm::translate(glm::mat4{1.0f}, glm::vec3{0.0f, 0.1f * float(i), 0.0f}),
+      0.05f * float(i), glm::vec3{1.0f, 0.0f, 0.0f});
+    out[i] = glm::inverse(glm::scale(m, glm::vec3{1.0f + 0.01f * float(i)}));
+  }
+  return out;
+}
+
+// Reference: scalar (glm) math.
+void buildSkinScalar(std::span<const ozz::math::Float4x4> models,
+                     std::span<const glm::mat4> inverseBindPose,
+                     std::span<glm::mat4> skin) {
+  for (auto i = 0u; i < models.size(); ++i) {
+    skin[i] = to_mat4(models[i]) * inverseBindPose[i];
+  }
+}
+
+} // namespace
+
+void *operator new(std::size_t size) {
+  ++g_numAllocations;
+  if (auto *p = std::malloc(size)) return p;
+  throw std::bad_alloc{};
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+TEST_CASE("AnimationPose") {
+  const auto skeleton = makeSkeleton();
+  const auto animation = makeAnimation();
+  REQUIRE(skeleton);
+  REQUIRE(animation);
+
+  SECTION("Matches the per-call sampling") {
+    AnimationPose pose;
+    for (auto ratio : {0.0f, 0.25f, 0.75f, 0.1f, 1.0f}) {
+      REQUIRE(pose.update(*skeleton, *animation, ratio));
+      const auto expected = samplePose(*skeleton, *animation, ratio);
+      const auto models = pose.getModels();
+      REQUIRE(models.size() == expected.size());
+      for (auto i = 0u; i < models.size(); ++i) {
+        REQUIRE(equal(models[i], expected[i]));
+      }
+    }
+  }
+  SECTION("Skin") {
+    AnimationPose pose;
+    REQUIRE(pose.update(*skeleton, *animation, 0.5f));
+    const std::vector inverseBindPose(kNumJoints, glm::mat4{1.0f});
+    std::vector<glm::mat4> skin(kNumJoints);
+    buildSkin(pose.getModels(), inverseBindPose, skin);
+    // Each joint is 0.1 above its parent (rotations are around Y).
+    REQUIRE(skin.back()[3].y == Approx{0.1f * kNumJoints});
+  }
+  SECTION("Skin matches the scalar path") {
+    AnimationPose pose;
+    REQUIRE(pose.update(*skeleton, *animation, 0.3f));
+    const auto inverseBindPose = makeInverseBindPose();
+    std::vector<glm::mat4> expected(kNumJoints);
+    buildSkinScalar(pose.getModels(), inverseBindPose, expected);
+    // Unaligned destination.
+    std::vector<float> storage(kNumJoints * 16 + 1);
+    const std::span skin{reinterpret_cast<glm::mat4 *>(storage.data() + 1),
+                         kNumJoints};
+    buildSkin(pose.getModels(), inverseBindPose, skin);
+    for (auto i = 0; i < kNumJoints; ++i) {
+      for (auto c = 0; c < 4; ++c) {
+        for (auto r = 0; r < 4; ++r) {
+          REQUIRE(skin[i][c][r] == Approx{expected[i][c][r]}.margin(1e-5));
+        }
+      }
+    }
+  }
+  SECTION("Mismatched animation") {
+    ozz::animation::offline::RawAnimation raw;
+    raw.tracks.resize(kNumJoints - 1);
+    const auto other = ozz::animation::offline::AnimationBuilder{}(raw);
+    REQUIRE(other);
+    AnimationPose pose;
+    REQUIRE_FALSE(pose.update(*skeleton, *other, 0.0f));
+  }
+  SECTION("No allocations in the steady state") {
+    auto &threadPool = getSharedThreadPool();
+    std::vector<AnimationPose> poses(kNumCharacters);
+    std::vector<glm::mat4> skins(kNumCharacters * kNumJoints);
+    const std::vector inverseBindPose(kNumJoints, glm::mat4{1.0f});
+
+    const auto updateAll = [&](int frame) {
+      parallelFor(threadPool, kNumCharacters, 8,
+                  [&](std::size_t begin, std::size_t end) {
+                    for (auto i = begin; i < end; ++i) {
+                      const auto ratio = timeRatio(int(i), frame);
+                      if (!poses[i].update(*skeleton, *animation, ratio)) {
+                        continue;
+                      }
+                      buildSkin(poses[i].getModels(), inverseBindPose,
+                                std::span{skins}.subspan(i * kNumJoints,
+                                                         kNumJoints));
+                    }
+                  });
+    };
+    updateAll(0); // Warm-up.
+
+    const auto before = g_numAllocations.load();
+    for (auto frame = 1; frame < 10; ++frame) {
+      updateAll(frame);
+    }
+    REQUIRE(g_numAllocations.load() == before);
+
+    const auto expected = samplePose(*skeleton, *animation, timeRatio(42, 9));
+    REQUIRE(equal(poses[42].getModels().back(), expected.back()));
+  }
+}
+
+TEST_CASE("AnimationLayers") {
+  const auto skeleton = makeSkeleton();
+  REQUIRE(skeleton);
+  // The rest pose: 0.1 per joint.
+  const auto a = makeClip(0.2f);
+  const auto b = makeClip(0.4f);
+
+  AnimationLayers layers;
+  AnimationPose pose;
+
+  SECTION("No layers") {
+    REQUIRE(pose.update(*skeleton, layers));
+    REQUIRE(getHeight(pose) == Approx{0.1f * kNumJoints});
+  }
+  SECTION("Single layer") {
+    layers.addLayer(a);
+    REQUIRE(pose.update(*skeleton, layers));
+    const auto expected = samplePose(*skeleton, *a, 0.0f);
+    const auto models = pose.getModels();
+    REQUIRE(models.size() == expected.size());
+    for (auto i = 0u; i < models.size(); ++i) {
+      REQUIRE(equal(models[i], expected[i]));
+    }
+  }
+  SECTION("Weighted") {
+    layers.addLayer(a, AnimationLayers::Mode::Override, 0.75f);
+    layers.addLayer(b, AnimationLayers::Mode::Override, 0.25f);
+    REQUIRE(pose.update(*skeleton, layers));
+    REQUIRE(getHeight(pose) == Approx{0.25f * kNumJoints});
+  }
+  SECTION("Below the threshold") {
+    // The rest pose fills the gap: (0.05 * 0.2 + 0.05 * 0.1) / 0.1
+    layers.addLayer(a, AnimationLayers::Mode::Override, 0.05f);
+    REQUIRE(pose.update(*skeleton, layers));
+    REQUIRE(getHeight(pose) == Approx{0.15f * kNumJoints});
+  }
+  SECTION("Mask") {
+    layers.addLayer(a);
+    const auto idx = layers.addLayer(b);
+    layers.getLayer(idx).mask = makeJointMask(*skeleton, "joint30");
+    REQUIRE(pose.update(*skeleton, layers));
+    // Joints [0..30) = a, [30..60) = (a + b) / 2
+    REQUIRE(getHeight(pose) == Approx{30 * 0.2f + 30 * 0.3f});
+  }
+  SECTION("Additive") {
+    layers.addLayer(a);
+    layers.addLayer(makeClip(0.05f), AnimationLayers::Mode::Additive);
+    REQUIRE(pose.update(*skeleton, layers));
+    REQUIRE(getHeight(pose) == Approx{0.25f * kNumJoints});
+  }
+  SECTION("Cross-fade") {
+    layers.addLayer(a);
+    layers.addLayer(b, AnimationLayers::Mode::Override, 0.0f);
+    layers.crossFade(1, 0.5f);
+
+    layers.update(0.25f);
+    REQUIRE(layers.getLayer(0).weight == Approx{0.5f});
+    REQUIRE(layers.getLayer(1).weight == Approx{0.5f});
+    REQUIRE(pose.update(*skeleton, layers));
+    REQUIRE(getHeight(pose) == Approx{0.3f * kNumJoints});
+
+    layers.update(0.5f);
+    REQUIRE(layers.getLayer(0).weight == 0.0f);
+    REQUIRE(layers.getLayer(1).weight == 1.0f);
+    REQUIRE(pose.update(*skeleton, layers));
+    REQUIRE(getHeight(pose) == Approx{0.4f * kNumJoints});
+  }
+  SECTION("Mismatched layers are skipped") {
+    layers.addLayer(a);
+    ozz::animation::offline::RawAnimation raw;
+    raw.tracks.resize(kNumJoints - 1);
+    auto other = ozz::animation::offline::AnimationBuilder{}(raw);
+    REQUIRE(other);
+    layers.addLayer(
+      std::make_shared<AnimationResource>(std::move(*other), "other"));
+    REQUIRE(pose.update(*skeleton, layers));
+    REQUIRE(getHeight(pose) == Approx{0.2f * kNumJoints});
+  }
+  SECTION("No allocations in the steady state") {
+    layers.addLayer(a);
+    const auto idx = layers.addLayer(b);
+    layers.getLayer(idx).mask = makeJointMask(*skeleton, "joint30");
+    layers.addLayer(makeClip(0.05f), AnimationLayers::Mode::Additive);
+    REQUIRE(pose.update(*skeleton, layers)); // Warm-up.
+
+    const auto before = g_numAllocations.load();
+    auto succeeded = true;
+    for (auto frame = 0; frame < 10; ++frame) {
+      layers.update(0.016f);
+      succeeded &= pose.update(*skeleton, layers);
+    }
+    REQUIRE(g_numAllocations.load() == before);
+    REQUIRE(succeeded);
+  }
+}
+
+TEST_CASE("AnimationPose benchmark", "[.benchmark]") {
+  const auto skeleton = makeSkeleton();
+  const auto animation = makeAnimation();
+  std::vector<AnimationPose> poses(kNumCharacters);
+  auto frame = 0;
+
+  BENCHMARK("Serial") {
+    ++frame;
+    for (auto i = 0; i < kNumCharacters; ++i) {
+      poses[i].update(*skeleton, *animation, timeRatio(i, frame));
+    }
+  };
+  BENCHMARK("Parallel") {
+    ++frame;
+    parallelFor(getSharedThreadPool(), kNumCharacters, 8,
+                [&](std::size_t begin, std::size_t end) {
+                  for (auto i = begin; i < end; ++i) {
+                    poses[i].update(*skeleton, *animation,
+                                    timeRatio(int(i), frame));
+                  }
+                });
+  };
+}
+
+TEST_CASE("Skin benchmark", "[.benchmark]") {
+  const auto skeleton = makeSkeleton();
+  const auto animation = makeAnimation();
+  std::vector<AnimationPose> poses(kNumCharacters);
+  for (auto i = 0; i < kNumCharacters; ++i) {
+    poses[i].update(*skeleton, *animation, timeRatio(i, 0));
+  }
+  const auto inverseBindPose = makeInverseBindPose();
+  std::vector<glm::mat4> skins(kNumCharacters * kNumJoints);
+
+  const auto run = [&](auto &&build) {
+    for (auto i = 0u; i < poses.size(); ++i) {
+      build(poses[i].getModels(), inverseBindPose,
+            std::span{skins}.subspan(i * kNumJoints, kNumJoints));
+    }
+    return skins.back()[3].y;
+  };
+  BENCHMARK("Scalar") { return run(buildSkinScalar); };
+  BENCHMARK("SIMD") { return run(buildSkin); };
+}
+
+int main(int argc, char *argv[]) { return Catch::Session{}.run(argc, argv); }
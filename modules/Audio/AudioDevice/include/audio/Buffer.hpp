@@ -24,7 +24,9 @@ public:
   const ClipInfo &getInfo() const;
 
 private:
+  explicit Buffer(const ClipInfo &); // Without data (see: _upload).
   Buffer(const ClipInfo &, const void *data);
+  void _upload(const void *data);
   void _destroy();
 
 private:
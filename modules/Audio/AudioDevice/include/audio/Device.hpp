@@ -2,7 +2,10 @@
 
 #include "Source.hpp"
 #include "StreamPlayer.hpp"
+#include "StreamingThread.hpp"
 #include "AL/alc.h"
+#include <span>
+#include <vector>
 
 namespace audio {
 
@@ -18,8 +21,24 @@ enum class DistanceModel {
 
 class Device {
 public:
+  // Null and Loopback don't need an audio hardware (headless runs, tests).
+  // Both require the ALC_SOFT_loopback extension (OpenAL Soft), the
+  // constructor throws std::runtime_error without it.
+  enum class Backend {
+    Hardware, // The default output device (Null if there is none).
+    // Mixes only on render (a virtual clock, see: AudioSystem::update),
+    // drops the output.
+    Null,
+    Loopback, // Mixes into memory on render.
+  };
+
   struct Config {
     uint32_t maxNumSources{255};
+    // Refill the StreamPlayers on a dedicated thread (see: getStreamingThread).
+    bool streamingThread{true};
+    Backend backend{Backend::Hardware};
+    // Null/Loopback: frequency of the mix (stereo, 32-bit float).
+    uint32_t sampleRate{44100};
   };
 
 #ifdef __GNUG__
@@ -58,12 +77,43 @@ public:
   [[nodiscard]] Settings getSettings() const;
 
   [[nodiscard]] Buffer createBuffer(const ClipInfo &, const void *data) const;
+  // @return A buffer without data (can't be attached to a Source until the
+  // upload).
+  [[nodiscard]] Buffer createBuffer(const ClipInfo &) const;
+  // Can be called from any thread (e.g. the one that decoded the data), as
+  // long as the buffer is not used until then.
+  void upload(Buffer &, const void *data) const;
+
+  // @return nullptr if disabled (Config::streamingThread).
+  [[nodiscard]] StreamingThread *getStreamingThread() const;
+
+  // @return The backend in use (Hardware falls back to Null).
+  [[nodiscard]] Backend getBackend() const;
+  [[nodiscard]] uint32_t getSampleRate() const;
+
+  // Null/Loopback: mixes the sources for the given duration, so the sources
+  // and the streams advance. A fraction of a frame is carried over to the
+  // next call. Hardware: no-op.
+  // @return Interleaved stereo samples (Loopback), otherwise empty.
+  // Valid until the next call.
+  std::span<const float> render(const fsec duration);
+
+private:
+  // @return false if the extension or the format is not supported.
+  [[nodiscard]] bool _openLoopback(const uint32_t sampleRate);
 
 private:
+  Backend m_backend{Backend::Hardware};
+  uint32_t m_sampleRate{0};
   ALCdevice *m_device{nullptr};
   ALCcontext *m_context{nullptr};
+  std::unique_ptr<StreamingThread> m_streamingThread;
+
+  double m_pendingFrames{0.0};
+  std::vector<float> m_output; // Loopback: the mix, Null: scratch buffer.
 };
 
 [[nodiscard]] const char *toString(const DistanceModel);
+[[nodiscard]] const char *toString(const Device::Backend);
 
 } // namespace audio
@@ -2,22 +2,34 @@
 
 #include "SourceBase.hpp"
 #include "Decoder.hpp"
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
 
 namespace audio {
 
 class Device;
+class StreamingThread;
 
+// Refills the queue of the source with decoded chunks (a ring of buffers).
+// Without a StreamingThread, call update every frame.
+// With one (see: StreamingThread::add), the commands (play, seek, ...) are
+// executed and the buffers refilled by the streaming thread.
 class StreamPlayer final : public SourceBase {
   friend class Device;
+  friend class StreamingThread;
 
 public:
-  explicit StreamPlayer(const int32_t numBuffers = 3);
+  // @param decodeAhead Duration of the decoded audio queued on the source,
+  // split into buffers of the given bufferDuration (see: setStream).
+  explicit StreamPlayer(const fsec decodeAhead = fsec{0.5f});
   StreamPlayer(const StreamPlayer &) = delete;
-  StreamPlayer(StreamPlayer &&) noexcept = default;
+  StreamPlayer(StreamPlayer &&) noexcept = delete;
   ~StreamPlayer() override;
 
   StreamPlayer &operator=(const StreamPlayer &) = delete;
-  StreamPlayer &operator=(StreamPlayer &&) = default;
+  StreamPlayer &operator=(StreamPlayer &&) = delete;
 
   void setStream(std::unique_ptr<Decoder> &&, const fsec bufferDuration);
   void setLooping(const bool);
@@ -35,19 +47,73 @@ public:
   void pause();
   void stop();
 
+  // @return true from play until pause/stop or the end of the stream (the
+  // state of the source lags behind when a StreamingThread is used).
+  [[nodiscard]] bool isPlaying() const;
+
+  // No-op when a StreamingThread is used.
   void update();
 
+  struct Stats {
+    // The source ran out of the queued buffers (the refills didn't keep up).
+    uint32_t numUnderruns{0};
+    uint32_t numRefills{0};
+    fsec minBuffered{0}; // The lowest amount of queued audio (low-water mark).
+  };
+  [[nodiscard]] Stats getStats() const;
+
 private:
+  struct Command {
+    enum class Type : uint8_t {
+      SetStream,
+      Play,
+      Pause,
+      Stop,
+      Seek,
+    };
+    Type type;
+    Decoder *decoder{nullptr}; // SetStream (ownership is transferred).
+    float value{0.0f};         // SetStream (buffer duration), Seek (offset).
+  };
+  void _submit(const Command &);
+  void _execute(const Command &);
+
+  void _setStream(std::unique_ptr<Decoder> &&, const fsec bufferDuration);
+  void _createBuffers(const uint32_t count);
+  void _destroyBuffers();
+
   void _start();
+  void _refill();
+  [[nodiscard]] bool _queue(const ALuint bufferId);
   [[nodiscard]] int32_t _read();
 
 private:
+  const fsec m_decodeAhead;
+  StreamingThread *m_streamingThread{nullptr};
+
+  // -- Owned by the thread that executes the commands:
+
   std::vector<ALuint> m_buffers;
+  std::deque<float> m_queuedOffsets; // Stream position of the queued buffers.
+  fsec m_bufferDuration{0};
 
   std::unique_ptr<Decoder> m_decoder;
   ALenum m_format{AL_NONE};
   std::vector<std::byte> m_stagingBuffer;
-  bool m_looping{false};
+  // From the execution of the Play command until Pause/Stop (m_playing is
+  // set by the caller, before the command reaches the streaming thread).
+  bool m_streaming{false};
+
+  // -- Shared:
+
+  std::atomic<bool> m_looping{false};
+  std::atomic<bool> m_playing{false};
+  std::atomic<float> m_duration{0.0f};
+  std::atomic<float> m_offset{0.0f}; // Of the first queued buffer.
+
+  std::atomic<uint32_t> m_numUnderruns{0};
+  std::atomic<uint32_t> m_numRefills{0};
+  std::atomic<float> m_minBuffered{0.0f};
 };
 
 } // namespace audio
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "ClipInfo.hpp" // fsec
+#include <atomic>
+#include <semaphore>
+#include <thread>
+#include <vector>
+#include <memory>
+
+namespace audio {
+
+class StreamPlayer;
+
+// Owns the buffer refills of the StreamPlayers (decoding included), so a long
+// frame of the game thread doesn't starve the queued audio.
+// The players receive their commands (play, seek, ...) through a lock-free
+// queue.
+class StreamingThread final {
+  friend class StreamPlayer;
+
+public:
+  // @param interval Between the refills (keep it well below the decodeAhead
+  // of the players).
+  explicit StreamingThread(const fsec interval = fsec{0.01f});
+  StreamingThread(const StreamingThread &) = delete;
+  StreamingThread(StreamingThread &&) noexcept = delete;
+  ~StreamingThread();
+
+  StreamingThread &operator=(const StreamingThread &) = delete;
+  StreamingThread &operator=(StreamingThread &&) noexcept = delete;
+
+  // The player is removed in its destructor.
+  void add(StreamPlayer &);
+
+  struct Stats {
+    uint32_t numPlayers{0};
+    uint32_t numUnderruns{0}; // Of all players (see: StreamPlayer::Stats).
+    uint64_t numUpdates{0};
+  };
+  [[nodiscard]] Stats getStats() const;
+
+private:
+  struct Command;
+  void _submit(const Command &);
+  void _remove(StreamPlayer &);
+
+  void _run(std::stop_token);
+  void _execute(const Command &);
+
+private:
+  const fsec m_interval;
+
+  struct Queue;
+  std::unique_ptr<Queue> m_commands;
+  std::counting_semaphore<> m_wakeUp{0};
+
+  std::vector<StreamPlayer *> m_players; // Streaming thread only.
+
+  std::atomic<uint32_t> m_numPlayers{0};
+  std::atomic<uint32_t> m_numUnderruns{0};
+  std::atomic<uint64_t> m_numUpdates{0};
+
+  std::jthread m_thread; // Keep last.
+};
+
+} // namespace audio
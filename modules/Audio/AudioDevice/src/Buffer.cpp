@@ -25,10 +25,18 @@ const ClipInfo &Buffer::getInfo() const { return m_info; }
 // (private):
 //
 
+Buffer::Buffer(const ClipInfo &info) : m_info{info} {}
 Buffer::Buffer(const ClipInfo &info, const void *data) : m_info{info} {
-  alGenBuffers(1, &m_id);
-  AL_CHECK(alBufferData(m_id, pickFormat(info), data, info.dataSize(),
-                        info.sampleRate));
+  _upload(data);
+}
+
+void Buffer::_upload(const void *data) {
+  assert(m_id == AL_NONE);
+  ALuint id{AL_NONE};
+  alGenBuffers(1, &id);
+  AL_CHECK(alBufferData(id, pickFormat(m_info), data, m_info.dataSize(),
+                        m_info.sampleRate));
+  m_id = id;
 }
 
 void Buffer::_destroy() {
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <optional>
+#include <bit> // has_single_bit
+#include <cstdint>
+
+namespace audio {
+
+// Bounded, lock-free, multiple producers and a single consumer.
+// D. Vyukov's queue: each cell has a sequence number that tells whether it's
+// free (for the producer of the given position) or ready (for the consumer).
+template <typename T, std::size_t N> class CommandQueue {
+  static_assert(std::has_single_bit(N));
+
+public:
+  CommandQueue() {
+    for (auto i = 0u; i < N; ++i) {
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+  CommandQueue(const CommandQueue &) = delete;
+  CommandQueue &operator=(const CommandQueue &) = delete;
+
+  // @return false if the queue is full.
+  [[nodiscard]] bool tryPush(const T &value) {
+    auto pos = m_enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+      auto &cell = m_cells[pos & (N - 1)];
+      const auto sequence = cell.sequence.load(std::memory_order_acquire);
+      const auto diff = intptr_t(sequence) - intptr_t(pos);
+      if (diff == 0) {
+        if (m_enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          cell.value = value;
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = m_enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+  // Consumer only.
+  [[nodiscard]] std::optional<T> tryPop() {
+    auto &cell = m_cells[m_dequeuePos & (N - 1)];
+    const auto sequence = cell.sequence.load(std::memory_order_acquire);
+    if (intptr_t(sequence) - intptr_t(m_dequeuePos + 1) < 0) {
+      return std::nullopt;
+    }
+    std::optional<T> value{cell.value};
+    cell.sequence.store(m_dequeuePos + N, std::memory_order_release);
+    ++m_dequeuePos;
+    return value;
+  }
+
+private:
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+  std::array<Cell, N> m_cells;
+
+  alignas(64) std::atomic<std::size_t> m_enqueuePos{0};
+  alignas(64) std::size_t m_dequeuePos{0};
+};
+
+} // namespace audio
@@ -1,27 +1,92 @@
 #include "audio/Device.hpp"
 #include "ALCheck.hpp"
+#include "AL/alext.h" // ALC_SOFT_loopback
 
 #include "glm/common.hpp" // max
 #include "glm/gtc/type_ptr.hpp"
+#include <cmath> // floor
+#include <format>
+#include <optional>
+#include <stdexcept>
 
 namespace audio {
 
-Device::Device(const Config &config) {
-  m_device = alcOpenDevice(nullptr);
-  assert(m_device != nullptr);
+namespace {
 
+// ALC_SOFT_loopback (OpenAL Soft).
+struct LoopbackFunctions {
+  LPALCLOOPBACKOPENDEVICESOFT openDevice{nullptr};
+  LPALCISRENDERFORMATSUPPORTEDSOFT isRenderFormatSupported{nullptr};
+  LPALCRENDERSAMPLESSOFT renderSamples{nullptr};
+};
+// @return nullptr if the extension is not available (not OpenAL Soft).
+[[nodiscard]] const LoopbackFunctions *getLoopbackFunctions() {
+  static const auto functions = []() -> std::optional<LoopbackFunctions> {
+    if (!alcIsExtensionPresent(nullptr, "ALC_SOFT_loopback")) {
+      return std::nullopt;
+    }
+    return LoopbackFunctions{
+      .openDevice = reinterpret_cast<LPALCLOOPBACKOPENDEVICESOFT>(
+        alcGetProcAddress(nullptr, "alcLoopbackOpenDeviceSOFT")),
+      .isRenderFormatSupported =
+        reinterpret_cast<LPALCISRENDERFORMATSUPPORTEDSOFT>(
+          alcGetProcAddress(nullptr, "alcIsRenderFormatSupportedSOFT")),
+      .renderSamples = reinterpret_cast<LPALCRENDERSAMPLESSOFT>(
+        alcGetProcAddress(nullptr, "alcRenderSamplesSOFT")),
+    };
+  }();
+  return functions ? &*functions : nullptr;
+}
+
+// Null: the output is dropped, mixes in chunks (bounded scratch buffer).
+constexpr auto kMaxNullChunk = 1024u; // In frames.
+constexpr auto kNumOutputChannels = 2u;
+
+} // namespace
+
+Device::Device(const Config &config) : m_backend{config.backend} {
+  if (m_backend == Backend::Hardware) {
+    m_device = alcOpenDevice(nullptr);
+    // A headless machine.
+    if (!m_device) m_backend = Backend::Null;
+  }
+  if (m_backend != Backend::Hardware && !_openLoopback(config.sampleRate)) {
+    throw std::runtime_error{std::format(
+      "Could not open the audio device ({}), ALC_SOFT_loopback is required.",
+      toString(m_backend))};
+  }
+
+  const auto maxNumSources =
+    static_cast<ALCint>(glm::max(1u, config.maxNumSources));
   // clang-format off
   const ALCint attributes[] = {
-    ALC_MONO_SOURCES, static_cast<ALCint>(glm::max(1u, config.maxNumSources)),
+    ALC_MONO_SOURCES, maxNumSources,
+    0, 0,
+  };
+  // A loopback device has to know the format of the mix.
+  const ALCint loopbackAttributes[] = {
+    ALC_MONO_SOURCES, maxNumSources,
+    ALC_FORMAT_CHANNELS_SOFT, ALC_STEREO_SOFT,
+    ALC_FORMAT_TYPE_SOFT, ALC_FLOAT_SOFT,
+    ALC_FREQUENCY, static_cast<ALCint>(m_sampleRate),
     0, 0,
   };
   // clang-format on
-  m_context = alcCreateContext(m_device, attributes);
+  m_context = alcCreateContext(m_device, m_backend == Backend::Hardware
+                                           ? attributes
+                                           : loopbackAttributes);
   assert(m_context != nullptr);
   const auto result = alcMakeContextCurrent(m_context);
   assert(result == ALC_TRUE);
+
+  if (config.streamingThread) {
+    m_streamingThread = std::make_unique<StreamingThread>();
+  }
 }
 Device::~Device() {
+  // Refills the buffers (uses the context).
+  m_streamingThread.reset();
+
   alcMakeContextCurrent(nullptr);
   alcDestroyContext(m_context);
   m_context = nullptr;
@@ -87,6 +152,67 @@ Device::Settings Device::getSettings() const {
 Buffer Device::createBuffer(const ClipInfo &info, const void *data) const {
   return Buffer{info, data};
 }
+Buffer Device::createBuffer(const ClipInfo &info) const { return Buffer{info}; }
+void Device::upload(Buffer &buffer, const void *data) const {
+  buffer._upload(data);
+}
+
+StreamingThread *Device::getStreamingThread() const {
+  return m_streamingThread.get();
+}
+
+Device::Backend Device::getBackend() const { return m_backend; }
+uint32_t Device::getSampleRate() const {
+  if (m_backend != Backend::Hardware) return m_sampleRate;
+  ALCint frequency{0};
+  alcGetIntegerv(m_device, ALC_FREQUENCY, 1, &frequency);
+  return uint32_t(frequency);
+}
+
+std::span<const float> Device::render(const fsec duration) {
+  if (m_backend == Backend::Hardware) return {};
+
+  m_pendingFrames += double(glm::max(0.0f, duration.count())) * m_sampleRate;
+  const auto numFrames = uint32_t(std::floor(m_pendingFrames));
+  m_pendingFrames -= numFrames;
+
+  // Guaranteed by the constructor (see: _openLoopback).
+  const auto renderSamples = getLoopbackFunctions()->renderSamples;
+  if (m_backend == Backend::Loopback) {
+    m_output.resize(std::size_t(numFrames) * kNumOutputChannels);
+    renderSamples(m_device, m_output.data(), ALCsizei(numFrames));
+    return m_output;
+  }
+  m_output.resize(std::size_t(kMaxNullChunk) * kNumOutputChannels);
+  for (auto remaining = numFrames; remaining > 0;) {
+    const auto n = glm::min(remaining, kMaxNullChunk);
+    renderSamples(m_device, m_output.data(), ALCsizei(n));
+    remaining -= n;
+  }
+  return {};
+}
+
+//
+// (private):
+//
+
+bool Device::_openLoopback(const uint32_t sampleRate) {
+  const auto *loopback = getLoopbackFunctions();
+  if (!loopback) return false;
+
+  m_device = loopback->openDevice(nullptr);
+  if (!m_device) return false;
+
+  m_sampleRate = glm::max(1u, sampleRate);
+  if (loopback->isRenderFormatSupported(m_device, ALCsizei(m_sampleRate),
+                                        ALC_STEREO_SOFT,
+                                        ALC_FLOAT_SOFT) != ALC_TRUE) {
+    alcCloseDevice(m_device);
+    m_device = nullptr;
+    return false;
+  }
+  return true;
+}
 
 //
 // Helper:
@@ -109,5 +235,20 @@ const char *toString(const DistanceModel distanceModel) {
   assert(false);
   return "Undefined";
 }
+const char *toString(const Device::Backend backend) {
+  switch (backend) {
+    using enum Device::Backend;
+
+  case Hardware:
+    return "Hardware";
+  case Null:
+    return "Null";
+  case Loopback:
+    return "Loopback";
+  }
+
+  assert(false);
+  return "Undefined";
+}
 
 } // namespace audio
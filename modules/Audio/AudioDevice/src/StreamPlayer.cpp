@@ -1,115 +1,245 @@
 #include "audio/StreamPlayer.hpp"
+#include "audio/StreamingThread.hpp"
 #include "ALHelper.hpp"
 #include "ALCheck.hpp"
-#include <algorithm> // clamp
+#include <algorithm> // clamp, min
+#include <cmath>     // ceil
+#include <limits>
 
 #include "tracy/Tracy.hpp"
 
 namespace audio {
 
-StreamPlayer::StreamPlayer(const int32_t numBuffers) {
-  assert(numBuffers > 1);
-  m_buffers.resize(numBuffers);
-  AL_CHECK(alGenBuffers(numBuffers, m_buffers.data()));
-}
+StreamPlayer::StreamPlayer(const fsec decodeAhead)
+    : m_decodeAhead{decodeAhead}, m_minBuffered{decodeAhead.count()} {}
 StreamPlayer::~StreamPlayer() {
+  if (m_streamingThread) {
+    m_streamingThread->_remove(*this);
+    m_streamingThread = nullptr;
+  }
   stop();
-  alSourcei(m_id, AL_BUFFER, AL_NONE);
-  AL_CHECK(alDeleteBuffers(m_buffers.size(), m_buffers.data()));
+  _destroyBuffers();
 }
 
 void StreamPlayer::setStream(std::unique_ptr<Decoder> &&decoder,
                              const fsec bufferDuration) {
   if (decoder && decoder->isOpen()) {
-    m_decoder = std::move(decoder);
+    m_duration = decoder->getInfo().duration().count();
+    _submit({
+      .type = Command::Type::SetStream,
+      .decoder = decoder.release(),
+      .value = bufferDuration.count(),
+    });
+  } else {
+    // Keeps the current stream (if any), with the given buffer duration.
+    _submit({
+      .type = Command::Type::SetStream,
+      .value = bufferDuration.count(),
+    });
   }
-  if (!m_decoder) return;
-
-  const auto &info = m_decoder->getInfo();
-  m_format = pickFormat(info);
-  m_stagingBuffer.resize(calcBufferSize(bufferDuration, info));
 }
 void StreamPlayer::setLooping(const bool b) { m_looping = b; }
 
-fsec StreamPlayer::getDuration() const {
-  return m_decoder ? m_decoder->getInfo().duration() : fsec{0};
-}
+fsec StreamPlayer::getDuration() const { return fsec{m_duration}; }
 bool StreamPlayer::isLooping() const { return m_looping; }
 
 fsec StreamPlayer::tell() const {
-  return m_decoder ? m_decoder->tell() : fsec{0};
+  ALfloat offset{0.0f};
+  alGetSourcef(m_id, AL_SEC_OFFSET, &offset);
+  return fsec{m_offset + offset};
 }
 void StreamPlayer::seek(const fsec offset) {
-  if (m_decoder) {
-    m_decoder->seek(std::clamp(offset, fsec{0},
-                               m_decoder->getInfo().duration() -
-                                 fsec{std::numeric_limits<float>::epsilon()}));
-  }
+  const auto duration =
+    m_duration - std::numeric_limits<float>::epsilon();
+  _submit({
+    .type = Command::Type::Seek,
+    .value = std::clamp(offset.count(), 0.0f, std::max(0.0f, duration)),
+  });
 }
 
 void StreamPlayer::play() {
-  if (!isPlaying()) _start();
-  SourceBase::play();
+  m_playing = true;
+  _submit({.type = Command::Type::Play});
+}
+void StreamPlayer::pause() {
+  m_playing = false;
+  _submit({.type = Command::Type::Pause});
 }
-void StreamPlayer::pause() { SourceBase::pause(); }
 void StreamPlayer::stop() {
-  SourceBase::stop();
-  if (m_decoder) m_decoder->rewind();
+  m_playing = false;
+  _submit({.type = Command::Type::Stop});
 }
 
+bool StreamPlayer::isPlaying() const { return m_playing; }
+
 void StreamPlayer::update() {
-  using enum SourceBase::State;
-  if (const auto state = getState(); state != Playing) return;
+  if (!m_streamingThread) _refill();
+}
 
-  ZoneScopedN("StreamPlayer::Update");
+StreamPlayer::Stats StreamPlayer::getStats() const {
+  return {
+    .numUnderruns = m_numUnderruns.load(std::memory_order_relaxed),
+    .numRefills = m_numRefills.load(std::memory_order_relaxed),
+    .minBuffered = fsec{m_minBuffered.load(std::memory_order_relaxed)},
+  };
+}
 
-  ALint processed;
-  AL_CHECK(alGetSourcei(m_id, AL_BUFFERS_PROCESSED, &processed));
+//
+// (private):
+//
 
-  while (processed > 0) {
-    ALuint bufferId{AL_NONE};
-    alSourceUnqueueBuffers(m_id, 1, &bufferId);
-    --processed;
-
-    // Read the next chunk of data, refill the buffer,
-    // and queue it back on the source.
-    if (const auto decodedSize = _read(); decodedSize > 0) {
-      AL_CHECK(alBufferData(bufferId, m_format, m_stagingBuffer.data(),
-                            decodedSize, m_decoder->getInfo().sampleRate));
-      AL_CHECK(alSourceQueueBuffers(m_id, 1, &bufferId));
+void StreamPlayer::_submit(const Command &command) {
+  if (m_streamingThread) {
+    m_streamingThread->_submit({
+      .type = StreamingThread::Command::Type::Execute,
+      .player = this,
+      .playerCommand = command,
+    });
+  } else {
+    _execute(command);
+  }
+}
+void StreamPlayer::_execute(const Command &command) {
+  switch (command.type) {
+    using enum Command::Type;
+
+  case SetStream:
+    _setStream(std::unique_ptr<Decoder>{command.decoder},
+               fsec{command.value});
+    break;
+  case Play:
+    if (!m_decoder) {
+      m_playing = false;
+      break;
     }
+    if (SourceBase::getState() != State::Paused) _start();
+    SourceBase::play();
+    m_streaming = true;
+    break;
+  case Pause:
+    SourceBase::pause();
+    m_streaming = false;
+    break;
+  case Stop:
+    SourceBase::stop();
+    m_streaming = false;
+    if (m_decoder) m_decoder->rewind();
+    m_offset = 0.0f;
+    break;
+  case Seek:
+    if (m_decoder) {
+      const auto wasPlaying = SourceBase::isPlaying();
+      m_decoder->seek(fsec{command.value});
+      // Drop the chunks decoded ahead.
+      _start();
+      if (wasPlaying) SourceBase::play();
+    }
+    break;
+  }
+}
 
-    if (m_looping && m_decoder->eos()) m_decoder->rewind();
+void StreamPlayer::_setStream(std::unique_ptr<Decoder> &&decoder,
+                              const fsec bufferDuration) {
+  if (decoder) {
+    SourceBase::stop();
+    m_decoder = std::move(decoder);
   }
+  if (!m_decoder) return;
 
-  if (!isPlaying()) {
-    ALint queued;
-    alGetSourcei(m_id, AL_BUFFERS_QUEUED, &queued);
-    if (queued > 0) play();
+  const auto &info = m_decoder->getInfo();
+  m_format = pickFormat(info);
+  m_bufferDuration = bufferDuration;
+  m_stagingBuffer.resize(calcBufferSize(bufferDuration, info));
+
+  // The ring is sized in time, not in buffers.
+  const auto numBuffers =
+    std::max(2u, uint32_t(std::ceil(m_decodeAhead / bufferDuration)));
+  if (numBuffers != m_buffers.size()) {
+    SourceBase::stop();
+    _destroyBuffers();
+    _createBuffers(numBuffers);
   }
 }
+void StreamPlayer::_createBuffers(const uint32_t count) {
+  m_buffers.resize(count);
+  AL_CHECK(alGenBuffers(count, m_buffers.data()));
+}
+void StreamPlayer::_destroyBuffers() {
+  if (m_buffers.empty()) return;
 
-//
-// (private):
-//
+  alSourcei(m_id, AL_BUFFER, AL_NONE);
+  AL_CHECK(alDeleteBuffers(m_buffers.size(), m_buffers.data()));
+  m_buffers.clear();
+  m_queuedOffsets.clear();
+}
 
 void StreamPlayer::_start() {
-  if (!m_decoder) return;
-
   alSourceRewind(m_id);
   alSourcei(m_id, AL_BUFFER, AL_NONE);
+  m_queuedOffsets.clear();
+  if (!m_decoder) return;
 
-  int32_t numFilledBuffers{0};
   for (const auto bufferId : m_buffers) {
-    const auto decodedSize = _read();
-    if (decodedSize == 0) break;
+    if (!_queue(bufferId)) break;
+  }
+  m_offset = m_queuedOffsets.empty() ? 0.0f : m_queuedOffsets.front();
+}
+void StreamPlayer::_refill() {
+  // The source is stopped (or paused) until the Play command is executed.
+  if (!m_playing || !m_streaming || !m_decoder) return;
 
-    AL_CHECK(alBufferData(bufferId, m_format, m_stagingBuffer.data(),
-                          decodedSize, m_decoder->getInfo().sampleRate));
+  ZoneScopedN("StreamPlayer::Refill");
 
-    ++numFilledBuffers;
+  ALint processed;
+  AL_CHECK(alGetSourcei(m_id, AL_BUFFERS_PROCESSED, &processed));
+  ALint queued;
+  AL_CHECK(alGetSourcei(m_id, AL_BUFFERS_QUEUED, &queued));
+  // What's left to play (before the refill).
+  const auto buffered = float(queued - processed) * m_bufferDuration.count();
+  if (buffered < m_minBuffered.load(std::memory_order_relaxed)) {
+    m_minBuffered.store(buffered, std::memory_order_relaxed);
   }
-  AL_CHECK(alSourceQueueBuffers(m_id, numFilledBuffers, m_buffers.data()));
+
+  for (; processed > 0; --processed) {
+    ALuint bufferId{AL_NONE};
+    AL_CHECK(alSourceUnqueueBuffers(m_id, 1, &bufferId));
+    if (!m_queuedOffsets.empty()) m_queuedOffsets.pop_front();
+    // Read the next chunk of data, refill the buffer, and queue it back on
+    // the source.
+    if (_queue(bufferId)) m_numRefills.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (!m_queuedOffsets.empty()) m_offset = m_queuedOffsets.front();
+
+  if (SourceBase::getState() != State::Playing) {
+    AL_CHECK(alGetSourcei(m_id, AL_BUFFERS_QUEUED, &queued));
+    if (queued > 0) {
+      // The source has stopped before the end of the stream (starved).
+      m_numUnderruns.fetch_add(1, std::memory_order_relaxed);
+      if (m_streamingThread) {
+        m_streamingThread->m_numUnderruns.fetch_add(1,
+                                                    std::memory_order_relaxed);
+      }
+      SourceBase::play();
+    } else {
+      // The end of the stream.
+      m_playing = false;
+      m_streaming = false;
+      m_decoder->rewind();
+    }
+  }
+}
+bool StreamPlayer::_queue(const ALuint bufferId) {
+  if (m_looping && m_decoder->eos()) m_decoder->rewind();
+
+  const auto offset = m_decoder->tell().count();
+  const auto decodedSize = _read();
+  if (decodedSize <= 0) return false;
+
+  AL_CHECK(alBufferData(bufferId, m_format, m_stagingBuffer.data(),
+                        decodedSize, m_decoder->getInfo().sampleRate));
+  AL_CHECK(alSourceQueueBuffers(m_id, 1, &bufferId));
+  m_queuedOffsets.push_back(offset);
+  return true;
 }
 int32_t StreamPlayer::_read() {
   assert(m_decoder);
@@ -0,0 +1,114 @@
+#include "audio/StreamingThread.hpp"
+#include "audio/StreamPlayer.hpp"
+#include "CommandQueue.hpp"
+#include <algorithm> // find
+#include <cassert>
+
+#include "tracy/Tracy.hpp"
+
+namespace audio {
+
+struct StreamingThread::Command {
+  enum class Type : uint8_t { Add, Remove, Execute };
+  Type type;
+  StreamPlayer *player;
+  StreamPlayer::Command playerCommand{};
+  std::atomic_flag *done{nullptr}; // Remove.
+};
+struct StreamingThread::Queue {
+  CommandQueue<Command, 1024> commands;
+};
+
+//
+// StreamingThread class:
+//
+
+StreamingThread::StreamingThread(const fsec interval)
+    : m_interval{interval}, m_commands{std::make_unique<Queue>()},
+      m_thread{[this](std::stop_token stopToken) { _run(stopToken); }} {}
+StreamingThread::~StreamingThread() {
+  m_thread.request_stop();
+  m_wakeUp.release();
+  m_thread.join();
+
+  // Players that outlive the thread fall back to StreamPlayer::update.
+  while (const auto command = m_commands->commands.tryPop()) {
+    _execute(*command);
+  }
+  for (auto *player : m_players) {
+    player->m_streamingThread = nullptr;
+  }
+}
+
+void StreamingThread::add(StreamPlayer &player) {
+  assert(!player.m_streamingThread);
+  player.m_streamingThread = this;
+  _submit({.type = Command::Type::Add, .player = &player});
+}
+
+StreamingThread::Stats StreamingThread::getStats() const {
+  return {
+    .numPlayers = m_numPlayers.load(std::memory_order_relaxed),
+    .numUnderruns = m_numUnderruns.load(std::memory_order_relaxed),
+    .numUpdates = m_numUpdates.load(std::memory_order_relaxed),
+  };
+}
+
+//
+// (private):
+//
+
+void StreamingThread::_submit(const Command &command) {
+  // The queue is full only if the streaming thread is stalled, wait for it.
+  while (!m_commands->commands.tryPush(command)) {
+    m_wakeUp.release();
+    std::this_thread::yield();
+  }
+  m_wakeUp.release();
+}
+void StreamingThread::_remove(StreamPlayer &player) {
+  std::atomic_flag done;
+  _submit({.type = Command::Type::Remove, .player = &player, .done = &done});
+  done.wait(false);
+}
+
+void StreamingThread::_run(std::stop_token stopToken) {
+  while (!stopToken.stop_requested()) {
+    {
+      ZoneScopedN("StreamingThread::Update");
+      while (const auto command = m_commands->commands.tryPop()) {
+        _execute(*command);
+      }
+      for (auto *player : m_players) {
+        player->_refill();
+      }
+      m_numUpdates.fetch_add(1, std::memory_order_relaxed);
+    }
+    // Woken up early by a command.
+    (void)m_wakeUp.try_acquire_for(m_interval);
+  }
+}
+void StreamingThread::_execute(const Command &command) {
+  auto *player = command.player;
+  switch (command.type) {
+    using enum Command::Type;
+
+  case Add:
+    m_players.push_back(player);
+    break;
+  case Remove:
+    if (const auto it = std::ranges::find(m_players, player);
+        it != m_players.cend()) {
+      m_players.erase(it);
+    }
+    command.done->test_and_set();
+    command.done->notify_one();
+    break;
+  case Execute:
+    player->_execute(command.playerCommand);
+    break;
+  }
+  m_numPlayers.store(uint32_t(m_players.size()), std::memory_order_relaxed);
+}
+
+} // namespace audio
@@ -37,7 +37,7 @@ template <DecoderType T> void playback(const std::filesystem::path &p) {
 template <DecoderType T> void stream(const std::filesystem::path &p) {
   audio::Device audioDevice;
 
-  audio::StreamPlayer player{2};
+  audio::StreamPlayer player;
   auto decoder = std::make_unique<T>(os::FileSystem::mapFile(p));
   REQUIRE(decoder->isOpen());
   player.setStream(std::move(decoder), 250ms);
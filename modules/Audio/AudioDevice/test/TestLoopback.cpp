@@ -0,0 +1,101 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include "audio/Device.hpp"
+
+#include <algorithm> // any_of
+#include <cmath>     // sin
+#include <numbers>   // pi
+#include <vector>
+
+using namespace std::chrono_literals;
+
+// No audio hardware required.
+
+namespace {
+
+constexpr auto kSampleRate = 44100u;
+
+// A sine wave (mono, 16 bits).
+[[nodiscard]] auto createClip(audio::Device &device, const fsec duration) {
+  const audio::ClipInfo info{
+    .numChannels = audio::NumChannels::Mono,
+    .bitsPerSample = 16,
+    .sampleRate = kSampleRate,
+    .numSamples = std::size_t(duration.count() * kSampleRate),
+  };
+  std::vector<int16_t> samples(info.numSamples);
+  for (auto i = 0u; i < samples.size(); ++i) {
+    const auto t = float(i) / float(kSampleRate);
+    samples[i] = int16_t(
+      8000.0f * std::sin(2.0f * std::numbers::pi_v<float> * 440.0f * t));
+  }
+  return std::make_shared<audio::Buffer>(
+    device.createBuffer(info, samples.data()));
+}
+
+[[nodiscard]] std::vector<float> mix(const fsec duration) {
+  audio::Device device{{
+    .streamingThread = false,
+    .backend = audio::Device::Backend::Loopback,
+  }};
+  audio::Source source{createClip(device, 1s)};
+  source.play();
+  const auto output = device.render(duration);
+  return {output.begin(), output.end()};
+}
+
+} // namespace
+
+TEST_CASE("Null backend") {
+  audio::Device device{{
+    .streamingThread = false,
+    .backend = audio::Device::Backend::Null,
+  }};
+  REQUIRE(device.getBackend() == audio::Device::Backend::Null);
+  REQUIRE(device.getSampleRate() == kSampleRate);
+
+  audio::Source source{createClip(device, 500ms)};
+  source.play();
+
+  // The clip advances only on render (a virtual clock).
+  REQUIRE(device.render(250ms).empty());
+  REQUIRE(source.isPlaying());
+  REQUIRE(source.tell().count() == Approx(0.25f).margin(0.01f));
+
+  // Frame by frame (fractions of the frames are carried over).
+  for (auto i = 0; i < 18; ++i) {
+    device.render(fsec{1.0f / 60.0f});
+  }
+  REQUIRE(source.isStopped());
+}
+
+TEST_CASE("Loopback backend") {
+  const auto output = mix(100ms);
+  // Interleaved stereo.
+  REQUIRE(output.size() == 2 * kSampleRate / 10);
+  REQUIRE(std::ranges::any_of(output, [](float v) { return v != 0.0f; }));
+
+  SECTION("Deterministic") { REQUIRE(mix(100ms) == output); }
+}
+
+TEST_CASE("Loopback benchmark", "[.benchmark]") {
+  audio::Device device{{
+    .maxNumSources = 256,
+    .streamingThread = false,
+    .backend = audio::Device::Backend::Null,
+  }};
+  const auto clip = createClip(device, 1s);
+  std::vector<audio::Source> sources;
+  sources.reserve(64);
+  for (auto i = 0; i < 64; ++i) {
+    auto &source = sources.emplace_back(clip);
+    source.setLooping(true);
+    source.play();
+  }
+  BENCHMARK("64 sources, 1 frame (60 Hz)") {
+    return device.render(fsec{1.0f / 60.0f});
+  };
+}
+
+int main(int argc, char *argv[]) { return Catch::Session{}.run(argc, argv); }
@@ -0,0 +1,165 @@
+#include "catch.hpp"
+
+#include "audio/Device.hpp"
+
+#include <cmath> // sin
+#include <cstdlib> // setenv
+#include <numbers> // pi
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// A sine wave (mono, 16 bits), generated on the fly.
+class SineDecoder final : public audio::Decoder {
+public:
+  explicit SineDecoder(const fsec duration) {
+    m_info = {
+      .numChannels = audio::NumChannels::Mono,
+      .bitsPerSample = 16,
+      .sampleRate = 44100,
+      .numSamples = std::size_t(duration.count() * 44100),
+    };
+  }
+
+  bool isOpen() const override { return true; }
+  const audio::ClipInfo &getInfo() const override { return m_info; }
+
+  fsec tell() override {
+    return fsec{float(m_position) / float(m_info.sampleRate)};
+  }
+  void seek(const fsec offset) override {
+    m_position = std::min(std::size_t(offset.count() * m_info.sampleRate),
+                          m_info.numSamples);
+  }
+
+  std::size_t read(std::byte *buffer, const std::size_t length) override {
+    const auto numSamples =
+      std::min(length / sizeof(int16_t), m_info.numSamples - m_position);
+    auto *samples = reinterpret_cast<int16_t *>(buffer);
+    for (auto i = 0u; i < numSamples; ++i, ++m_position) {
+      const auto t = float(m_position) / float(m_info.sampleRate);
+      samples[i] = int16_t(
+        8000.0f * std::sin(2.0f * std::numbers::pi_v<float> * 440.0f * t));
+    }
+    return numSamples * sizeof(int16_t);
+  }
+
+private:
+  audio::ClipInfo m_info;
+  std::size_t m_position{0};
+};
+
+// A frame of the game thread (e.g. a level load or a shader compilation).
+void longFrame(audio::StreamPlayer &player, const fsec duration) {
+  player.update();
+  std::this_thread::sleep_for(duration);
+}
+
+} // namespace
+
+TEST_CASE("Streaming thread") {
+  audio::Device device;
+  auto *streamingThread = device.getStreamingThread();
+  REQUIRE(streamingThread != nullptr);
+
+  audio::StreamPlayer player{300ms};
+  streamingThread->add(player);
+  player.setStream(std::make_unique<SineDecoder>(10s), 50ms);
+  REQUIRE(player.getDuration() == 10s);
+  player.play();
+  REQUIRE(player.isPlaying());
+
+  for (auto i = 0; i < 10; ++i) {
+    longFrame(player, 150ms);
+  }
+  REQUIRE(player.isPlaying());
+  const auto stats = player.getStats();
+  REQUIRE(stats.numUnderruns == 0);
+  REQUIRE(stats.numRefills > 0);
+  REQUIRE(stats.minBuffered > 0s);
+  REQUIRE(streamingThread->getStats().numPlayers == 1);
+
+  SECTION("Seek") {
+    player.seek(5s);
+    std::this_thread::sleep_for(50ms);
+    REQUIRE(player.tell() >= 5s);
+  }
+  SECTION("Stop") {
+    player.stop();
+    REQUIRE_FALSE(player.isPlaying());
+  }
+  SECTION("Restart") {
+    // The refills between play and the execution of the Play command must
+    // not treat the stopped source as starved.
+    for (auto i = 0; i < 100; ++i) {
+      player.stop();
+      player.play();
+      std::this_thread::sleep_for(1ms);
+    }
+    REQUIRE(player.isPlaying());
+    REQUIRE(player.getStats().numUnderruns == 0);
+  }
+}
+
+TEST_CASE("End of a stream") {
+  audio::Device device;
+  audio::StreamPlayer player{200ms};
+  device.getStreamingThread()->add(player);
+  player.setStream(std::make_unique<SineDecoder>(300ms), 50ms);
+  player.play();
+
+  std::this_thread::sleep_for(600ms);
+  REQUIRE_FALSE(player.isPlaying());
+  REQUIRE(player.getStats().numUnderruns == 0);
+}
+
+// The refills on the game thread can't keep up with the long frames.
+TEST_CASE("Starvation without the streaming thread") {
+  audio::Device device{{.streamingThread = false}};
+  REQUIRE(device.getStreamingThread() == nullptr);
+
+  audio::StreamPlayer player{100ms};
+  player.setStream(std::make_unique<SineDecoder>(10s), 50ms);
+  player.play();
+  for (auto i = 0; i < 10; ++i) {
+    longFrame(player, 150ms);
+  }
+  REQUIRE(player.getStats().numUnderruns > 0);
+}
+
+// Deterministic: the stream is consumed only when the device renders.
+TEST_CASE("Streaming on a virtual clock") {
+  audio::Device device{{
+    .streamingThread = false,
+    .backend = audio::Device::Backend::Null,
+  }};
+  audio::StreamPlayer player{200ms};
+  player.setStream(std::make_unique<SineDecoder>(1s), 50ms);
+  player.play();
+  for (auto i = 0; i < 30; ++i) {
+    player.update();
+    device.render(fsec{1.0f / 60.0f});
+  }
+  REQUIRE(player.isPlaying());
+  REQUIRE(player.tell().count() == Approx(0.5f).margin(0.02f));
+
+  for (auto i = 0; i < 40; ++i) {
+    player.update();
+    device.render(fsec{1.0f / 60.0f});
+  }
+  player.update();
+  REQUIRE_FALSE(player.isPlaying());
+  REQUIRE(player.getStats().numUnderruns == 0);
+}
+
+int main(int argc, char *argv[]) {
+  // OpenAL Soft: no output device (mixes in real time), for headless runs.
+#ifdef _WIN32
+  _putenv_s("ALSOFT_DRIVERS", "null");
+#else
+  setenv("ALSOFT_DRIVERS", "null", 1);
+#endif
+  return Catch::Session{}.run(argc, argv);
+}
@@ -3,13 +3,34 @@
 #include "AudioClipResource.hpp"
 #include "entt/resource/loader.hpp"
 #include "Decoder.hpp"
+#include "ThreadPool.hpp"
 #include <expected>
 
 using AudioClipResourceHandle = entt::resource<AudioClipResource>;
 
+struct AudioClipPolicy {
+  // Clips with more decoded (PCM) data are streamed
+  // (1 MB = ~6 s of 16-bit stereo at 44.1 kHz).
+  std::size_t maxDecodedSize{1u << 20};
+  // Keep the files of the streamed clips in memory (decoded on demand),
+  // instead of reading them during the playback.
+  bool keepCompressed{false};
+  // The decoded and compressed data of the cached clips
+  // (see: AudioClipManager::trim).
+  std::size_t memoryBudget{64u << 20};
+  // Decode on a worker (AudioClipResource::Residency::Loading until done).
+  bool async{true};
+};
+
 struct AudioClipLoader final : entt::resource_loader<AudioClipResource> {
-  result_type operator()(const std::filesystem::path &, audio::Device &) const;
+  // @param group Tracks the asynchronous decoding (see: AudioClipPolicy).
+  result_type operator()(const std::filesystem::path &, audio::Device &,
+                         const AudioClipPolicy &,
+                         ThreadPool::TaskGroup &group) const;
 };
 
 [[nodiscard]] std::expected<std::unique_ptr<audio::Decoder>, std::string>
 createDecoder(const std::filesystem::path &);
+// @return A decoder of a streamed clip (see: AudioClipResource::isStreamed).
+[[nodiscard]] std::expected<std::unique_ptr<audio::Decoder>, std::string>
+createDecoder(const AudioClipResource &);
@@ -2,16 +2,51 @@
 
 #include "AudioClipLoader.hpp"
 #include "entt/resource/cache.hpp"
+#include <unordered_map>
 
 using AudioClipCache = entt::resource_cache<AudioClipResource, AudioClipLoader>;
 
+struct AudioClipStats {
+  uint32_t numClips{0};
+  uint32_t numLoading{0};
+  uint32_t numStreamed{0};
+  std::size_t memoryUsage{0}; // In bytes (see: AudioClipPolicy::memoryBudget).
+  uint32_t numEvictions{0};
+};
+
 class AudioClipManager final : public AudioClipCache {
 public:
   explicit AudioClipManager(audio::Device &);
-  ~AudioClipManager() = default;
+  AudioClipManager(const AudioClipManager &) = delete;
+  AudioClipManager(AudioClipManager &&) noexcept = delete;
+  ~AudioClipManager();
+
+  AudioClipManager &operator=(const AudioClipManager &) = delete;
+  AudioClipManager &operator=(AudioClipManager &&) noexcept = delete;
+
+  // Affects the clips loaded afterwards.
+  void setPolicy(const AudioClipPolicy &);
+  [[nodiscard]] const AudioClipPolicy &getPolicy() const;
 
+  // Trims the cache if the memory usage exceeds the budget.
   [[nodiscard]] AudioClipResourceHandle load(const std::filesystem::path &);
 
+  // Evicts the least recently loaded clips that are not used (owned only by
+  // the cache), until the memory usage fits the budget.
+  // @return Number of evicted clips.
+  uint32_t trim();
+  // Blocks until the pending (asynchronous) loads are done.
+  void wait();
+
+  [[nodiscard]] AudioClipStats getStats() const;
+
 private:
   audio::Device &m_device;
+  AudioClipPolicy m_policy;
+
+  uint64_t m_loadCounter{0};
+  std::unordered_map<entt::id_type, uint64_t> m_lastLoaded; // LRU.
+  uint32_t m_numEvictions{0};
+
+  ThreadPool::TaskGroup m_loads;
 };
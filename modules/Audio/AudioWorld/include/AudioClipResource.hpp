@@ -2,14 +2,47 @@
 
 #include "Resource.hpp"
 #include "audio/Buffer.hpp"
+#include "os/FileSystem.hpp" // RawBuffer
+#include <atomic>
+#include <span>
 
+// Small clips are decoded into the buffer (asynchronously), the large ones
+// are played with a StreamPlayer (see: AudioClipPolicy).
 class AudioClipResource : public Resource, public audio::Buffer {
+  friend struct AudioClipLoader;
+
 public:
+  enum class Residency : uint8_t {
+    Loading,    // Decoded on a worker.
+    Decoded,    // The buffer has the data.
+    Streamed,   // From the file.
+    Compressed, // The file in memory, decoded on demand.
+    Failed,
+  };
+
   AudioClipResource() = default;
   AudioClipResource(audio::Buffer &&, const std::filesystem::path &);
+  AudioClipResource(audio::Buffer &&, const Residency,
+                    const std::filesystem::path &);
   AudioClipResource(const AudioClipResource &) = delete;
-  AudioClipResource(AudioClipResource &&) noexcept = default;
+  AudioClipResource(AudioClipResource &&) noexcept;
 
   AudioClipResource &operator=(const AudioClipResource &) = delete;
-  AudioClipResource &operator=(AudioClipResource &&) noexcept = default;
+  AudioClipResource &operator=(AudioClipResource &&) noexcept;
+
+  [[nodiscard]] Residency getResidency() const;
+  // @return true if the clip can be played (not loading, not failed).
+  [[nodiscard]] bool isReady() const;
+  // @return true if the clip has to be played with a StreamPlayer
+  // (see: createDecoder).
+  [[nodiscard]] bool isStreamed() const;
+
+  // @return Compressed data (Residency::Compressed), otherwise empty.
+  [[nodiscard]] std::span<const std::byte> getCompressedData() const;
+  // @return Decoded or compressed data (in bytes).
+  [[nodiscard]] std::size_t getMemoryUsage() const;
+
+private:
+  std::atomic<Residency> m_residency{Residency::Decoded};
+  os::RawBuffer m_compressedData{};
 };
@@ -28,27 +28,87 @@ public:
   void setSettings(const audio::Device::Settings &);
   [[nodiscard]] const audio::Device::Settings &getSettings() const;
 
+  struct VoiceSettings {
+    // The size of the pool of real voices (OpenAL sources) shared by the
+    // SoundSourceComponents. The AudioPlayerComponents (streams) are excluded.
+    uint32_t maxNumVoices{64};
+    // Sources with a lower (estimated) gain stay virtual.
+    float minAudibility{0.001f};
+
+    template <class Archive> void serialize(Archive &archive) {
+      archive(maxNumVoices, minAudibility);
+    }
+  };
+  void setVoiceSettings(const VoiceSettings &);
+  [[nodiscard]] const VoiceSettings &getVoiceSettings() const;
+
   void init(const Transform *, SoundSourceComponent &) const;
   void init(const Transform *, AudioPlayerComponent &) const;
+  // Returns the real voice (if any) to the pool.
+  void release(SoundSourceComponent &) const;
 
   void updateListener(const Transform &, const ListenerComponent &);
-  void update(const Transform &, SoundSourceComponent &) const;
+  // Tracks the playback position and estimates the audibility.
+  // Call updateVoices once all the sources of a frame are updated.
+  void update(const Transform *, SoundSourceComponent &, const fsec dt);
   void update(const Transform *, AudioPlayerComponent &) const;
 
+  // Assigns the real voices to the most audible sources (by priority, then
+  // by the estimated gain), the other ones become virtual.
+  void updateVoices();
+
+  struct VoiceStats {
+    uint32_t numAudible{0}; // Candidates for a real voice.
+    uint32_t numReal{0};
+    uint32_t numVirtualized{0}; // Lost a real voice (in the last update).
+    uint32_t numRealized{0};    // Got a real voice (in the last update).
+  };
+  [[nodiscard]] const VoiceStats &getVoiceStats() const;
+
   template <class Archive> void save(Archive &archive) const {
-    archive(m_settings);
+    archive(m_settings, m_voiceSettings);
   }
   template <class Archive> void load(Archive &archive) {
     audio::Device::Settings settings;
     archive(settings);
     setSettings(settings);
+
+    // Scenes saved before the voice settings were introduced.
+    if constexpr (requires { archive.getNodeName(); }) {
+      if (archive.getNodeName() == nullptr) return;
+    }
+    VoiceSettings voiceSettings;
+    archive(voiceSettings);
+    setVoiceSettings(voiceSettings);
   }
 
   audio::Device &getDevice() const { return m_device; };
 
+private:
+  [[nodiscard]] float _estimateAudibility(const SoundSourceComponent &) const;
+
+  [[nodiscard]] std::shared_ptr<audio::Source> _acquireVoice();
+  void _realize(SoundSourceComponent &);
+  void _realizeStream(SoundSourceComponent &);
+  void _virtualize(SoundSourceComponent &) const;
+
 private:
   audio::Device &m_device;
   audio::Device::Settings m_settings;
+  VoiceSettings m_voiceSettings;
+
+  glm::vec3 m_listenerPosition{0.0f};
+
+  // A voice is free when the pool is its only owner.
+  std::vector<std::shared_ptr<audio::Source>> m_voices;
+
+  struct Candidate {
+    SoundSourceComponent *source;
+    uint8_t priority;
+    float audibility;
+  };
+  std::vector<Candidate> m_candidates; // Collected by update.
+  VoiceStats m_voiceStats;
 };
 
 [[nodiscard]] std::unique_ptr<audio::Decoder>
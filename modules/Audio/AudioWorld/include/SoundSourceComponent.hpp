@@ -2,15 +2,20 @@
 
 #include "entt/core/type_info.hpp"
 #include "audio/Source.hpp"
+#include "audio/StreamPlayer.hpp"
 #include "SoundSettings.hpp"
 #include "AudioClipManager.hpp"
 
+// A virtual voice, the AudioWorld assigns a real one (an OpenAL source) only
+// to the most audible sources (see: AudioWorld::updateVoices).
 class SoundSourceComponent {
   friend class AudioWorld;
 
   static constexpr auto in_place_delete = true;
 
 public:
+  static constexpr uint8_t kDefaultPriority{128};
+
   explicit SoundSourceComponent(const SoundSettings & = {});
 
   SoundSourceComponent &setClip(std::shared_ptr<AudioClipResource>);
@@ -25,19 +30,28 @@ public:
   SoundSourceComponent &setMaxGain(const float);
   SoundSourceComponent &setDirectional(const bool);
   SoundSourceComponent &setLooping(const bool);
+  // A source with a higher priority gets a real voice first, regardless of
+  // its audibility.
+  SoundSourceComponent &setPriority(const uint8_t);
 
   SoundSourceComponent &setVelocity(const glm::vec3 &);
 
   [[nodiscard]] std::shared_ptr<AudioClipResource> getClip() const;
   [[nodiscard]] const SoundSettings &getSettings() const;
+  [[nodiscard]] uint8_t getPriority() const;
   [[nodiscard]] glm::vec3 getVelocity() const;
 
+  // @return Playback position (tracked while the voice is virtual).
+  [[nodiscard]] fsec tell() const;
+  // @return true if the source has a real voice.
+  [[nodiscard]] bool isReal() const;
+
   SoundSourceComponent &play();
   SoundSourceComponent &pause();
   SoundSourceComponent &stop();
 
   template <typename Archive> void save(Archive &archive) const {
-    archive(m_settings, serialize(m_resource));
+    archive(m_settings, serialize(m_resource), m_priority);
   }
   template <typename Archive> void load(Archive &archive) {
     archive(m_settings);
@@ -45,12 +59,36 @@ public:
     std::optional<std::string> path;
     archive(path);
     if (path) m_resource = loadResource<AudioClipManager>(*path);
+
+    // Scenes saved before the priorities were introduced.
+    if constexpr (requires { archive.getNodeName(); }) {
+      if (archive.getNodeName() == nullptr) return;
+    }
+    archive(m_priority);
   }
 
+private:
+  // @return nullptr if virtual.
+  [[nodiscard]] audio::SourceBase *_getVoice() const;
+  // Returns the voice to the AudioWorld (the pool or streams).
+  void _releaseVoice();
+
+  void _setState(const audio::SourceBase::State);
+
 private:
   SoundSettings m_settings;
+  uint8_t m_priority{kDefaultPriority};
   std::shared_ptr<AudioClipResource> m_resource;
-  std::shared_ptr<audio::Source> m_source;
+
+  audio::SourceBase::State m_state{audio::SourceBase::State::Initial};
+  fsec m_offset{0};
+  glm::vec3 m_position{0.0f};
+  glm::vec3 m_direction{0.0f};
+  glm::vec3 m_velocity{0.0f};
+
+  // Real voice, nullptr = virtual.
+  std::shared_ptr<audio::Source> m_source;       // A decoded clip.
+  std::shared_ptr<audio::StreamPlayer> m_stream; // A streamed clip.
 };
 
 static_assert(std::is_copy_constructible_v<SoundSourceComponent>);
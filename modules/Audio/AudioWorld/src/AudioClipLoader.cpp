@@ -6,35 +6,91 @@
 #include "WaveDecoder.hpp"
 
 #include "spdlog/spdlog.h"
+#include "tracy/Tracy.hpp"
+
+#include <cassert>
 
 namespace {
 
-[[nodiscard]] std::expected<audio::Buffer, std::string>
-tryLoad(const std::filesystem::path &p, audio::Device &device) {
-  auto decoder = createDecoder(p);
+[[nodiscard]] std::expected<std::unique_ptr<audio::Decoder>, std::string>
+createDecoder(std::unique_ptr<os::DataStream> &&dataStream,
+              const std::string_view ext) {
+  std::unique_ptr<audio::Decoder> decoder;
+  try {
+    if (ext == ".wav") {
+      decoder = std::make_unique<audio::WaveDecoder>(std::move(dataStream));
+    } else if (ext == ".ogg") {
+      decoder = std::make_unique<audio::VorbisDecoder>(std::move(dataStream));
+    }
+  } catch (const std::exception &e) {
+    return std::unexpected{e.what()};
+  }
+
   if (!decoder) {
-    return std::unexpected{decoder.error()};
+    return std::unexpected{std::format("Unsupported extension: '{}'", ext)};
   }
-  const auto &info = (*decoder)->getInfo();
-  const auto length = info.dataSize();
-  std::vector<std::byte> buffer(length);
-  (*decoder)->read(buffer.data(), buffer.size());
-  return device.createBuffer(info, buffer.data());
+  return decoder;
+}
+
+[[nodiscard]] std::vector<std::byte> decode(audio::Decoder &decoder) {
+  ZoneScopedN("DecodeAudioClip");
+  std::vector<std::byte> buffer(decoder.getInfo().dataSize());
+  decoder.read(buffer.data(), buffer.size());
+  return buffer;
 }
 
 } // namespace
 
 AudioClipLoader::result_type
 AudioClipLoader::operator()(const std::filesystem::path &p,
-                            audio::Device &device) const {
-  if (auto buffer = tryLoad(p, device); buffer) {
-    return std::make_shared<AudioClipResource>(std::move(*buffer), p);
-  } else {
+                            audio::Device &device,
+                            const AudioClipPolicy &policy,
+                            ThreadPool::TaskGroup &group) const {
+  ZoneScopedN("LoadAudioClip");
+
+  auto decoder = createDecoder(p);
+  if (!decoder) {
     SPDLOG_ERROR("{}: Audio clip loading failed. {}",
                  os::FileSystem::relativeToRoot(p)->generic_string(),
-                 buffer.error());
+                 decoder.error());
     return {};
   }
+  using enum AudioClipResource::Residency;
+
+  const auto &info = (*decoder)->getInfo();
+  if (info.dataSize() > policy.maxDecodedSize) {
+    auto resource = std::make_shared<AudioClipResource>(
+      device.createBuffer(info), Streamed, p);
+    if (policy.keepCompressed) {
+      if (auto data = os::FileSystem::readBuffer(p); data) {
+        resource->m_compressedData = std::move(*data);
+        resource->m_residency = Compressed;
+      }
+    }
+    return resource;
+  }
+
+  if (!policy.async) {
+    const auto data = decode(**decoder);
+    return std::make_shared<AudioClipResource>(
+      device.createBuffer(info, data.data()), p);
+  }
+  auto resource =
+    std::make_shared<AudioClipResource>(device.createBuffer(info), Loading, p);
+  // std::function (ThreadPool::Task) has to be copyable.
+  getSharedThreadPool().run(
+    group, [&device, resource, decoder = std::shared_ptr{std::move(*decoder)}] {
+      try {
+        const auto data = decode(*decoder);
+        device.upload(*resource, data.data());
+        resource->m_residency.store(Decoded, std::memory_order_release);
+      } catch (const std::exception &e) {
+        SPDLOG_ERROR("{}: Audio clip decoding failed. {}",
+                     resource->getPath().generic_string(), e.what());
+        resource->m_residency.store(Failed, std::memory_order_release);
+      }
+    });
+  return resource;
 }
 
 std::expected<std::unique_ptr<audio::Decoder>, std::string>
@@ -47,20 +103,19 @@ createDecoder(const std::filesystem::path &p) {
   if (!file) {
     return std::unexpected{"Could not open file."};
   }
+  return createDecoder(std::move(file), *ext);
+}
+std::expected<std::unique_ptr<audio::Decoder>, std::string>
+createDecoder(const AudioClipResource &resource) {
+  assert(resource.isStreamed());
+  const auto data = resource.getCompressedData();
+  if (data.empty()) return createDecoder(resource.getPath());
 
-  std::unique_ptr<audio::Decoder> decoder;
-  try {
-    if (ext == ".wav") {
-      decoder = std::make_unique<audio::WaveDecoder>(std::move(file));
-    } else if (ext == ".ogg") {
-      decoder = std::make_unique<audio::VorbisDecoder>(std::move(file));
-    }
-  } catch (const std::exception &e) {
-    return std::unexpected{e.what()};
-  }
-
-  if (!decoder) {
-    return std::unexpected{std::format("Unsupported extension: '{}'", *ext)};
+  const auto ext = os::FileSystem::getExtension(resource.getPath());
+  if (!ext) {
+    return std::unexpected{"No extension."};
   }
-  return decoder;
+  // The data outlives the decoder (as long as the resource is alive).
+  auto *ptr = const_cast<char *>(reinterpret_cast<const char *>(data.data()));
+  return createDecoder(os::FileSystem::mapMemory(ptr, data.size()), *ext);
 }
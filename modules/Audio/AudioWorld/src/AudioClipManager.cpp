@@ -1,9 +1,91 @@
 #include "AudioClipManager.hpp"
 #include "audio/Device.hpp"
 #include "LoaderHelper.hpp"
+#include "tracy/Tracy.hpp"
+#include <algorithm> // sort
+
+namespace {
+
+// The cache and the handle of the iterator (a copy).
+constexpr auto kUnused = 2;
+
+} // namespace
+
+//
+// AudioClipManager class:
+//
 
 AudioClipManager::AudioClipManager(audio::Device &device) : m_device{device} {}
+AudioClipManager::~AudioClipManager() { wait(); }
+
+void AudioClipManager::setPolicy(const AudioClipPolicy &policy) {
+  m_policy = policy;
+}
+const AudioClipPolicy &AudioClipManager::getPolicy() const { return m_policy; }
 
 AudioClipResourceHandle AudioClipManager::load(const std::filesystem::path &p) {
-  return ::load(*this, p, LoadMode::External, m_device);
+  auto handle =
+    ::load(*this, p, LoadMode::External, m_device, m_policy, m_loads);
+  if (handle) {
+    m_lastLoaded[handle->getResourceId()] = ++m_loadCounter;
+    if (getStats().memoryUsage > m_policy.memoryBudget) trim();
+  }
+  return handle;
+}
+
+uint32_t AudioClipManager::trim() {
+  ZoneScopedN("AudioClipManager::Trim");
+
+  struct Candidate {
+    entt::id_type id;
+    uint64_t lastLoaded;
+    std::size_t memoryUsage;
+  };
+  std::vector<Candidate> candidates;
+  std::size_t memoryUsage{0};
+  for (auto [id, resource] : *this) {
+    const auto size = resource->getMemoryUsage();
+    memoryUsage += size;
+    // A clip that is still loading is owned by the worker too.
+    if (size > 0 && resource.handle().use_count() == kUnused) {
+      candidates.push_back({id, m_lastLoaded[id], size});
+    }
+  }
+  std::ranges::sort(candidates, {}, &Candidate::lastLoaded);
+
+  uint32_t numEvicted{0};
+  for (const auto &[id, _, size] : candidates) {
+    if (memoryUsage <= m_policy.memoryBudget) break;
+    erase(id);
+    m_lastLoaded.erase(id);
+    memoryUsage -= size;
+    ++numEvicted;
+  }
+  m_numEvictions += numEvicted;
+  return numEvicted;
+}
+void AudioClipManager::wait() { getSharedThreadPool().wait(m_loads); }
+
+AudioClipStats AudioClipManager::getStats() const {
+  AudioClipStats stats{
+    .numClips = uint32_t(size()),
+    .numEvictions = m_numEvictions,
+  };
+  for (const auto [_, resource] : *this) {
+    using enum AudioClipResource::Residency;
+    switch (resource->getResidency()) {
+    case Loading:
+      ++stats.numLoading;
+      break;
+    case Streamed:
+    case Compressed:
+      ++stats.numStreamed;
+      break;
+
+    default:
+      break;
+    }
+    stats.memoryUsage += resource->getMemoryUsage();
+  }
+  return stats;
 }
@@ -2,4 +2,54 @@
 
 AudioClipResource::AudioClipResource(audio::Buffer &&buffer,
                                      const std::filesystem::path &p)
-    : Resource{p}, audio::Buffer{std::move(buffer)} {}
+    : AudioClipResource{std::move(buffer), Residency::Decoded, p} {}
+AudioClipResource::AudioClipResource(audio::Buffer &&buffer,
+                                     const Residency residency,
+                                     const std::filesystem::path &p)
+    : Resource{p}, audio::Buffer{std::move(buffer)}, m_residency{residency} {}
+AudioClipResource::AudioClipResource(AudioClipResource &&other) noexcept
+    : Resource{std::move(other)}, audio::Buffer{std::move(other)},
+      m_residency{other.m_residency.load()},
+      m_compressedData{std::move(other.m_compressedData)} {}
+
+AudioClipResource &
+AudioClipResource::operator=(AudioClipResource &&rhs) noexcept {
+  if (this != &rhs) {
+    Resource::operator=(std::move(rhs));
+    audio::Buffer::operator=(std::move(rhs));
+    m_residency = rhs.m_residency.load();
+    m_compressedData = std::move(rhs.m_compressedData);
+  }
+  return *this;
+}
+
+AudioClipResource::Residency AudioClipResource::getResidency() const {
+  return m_residency.load(std::memory_order_acquire);
+}
+bool AudioClipResource::isReady() const {
+  const auto residency = getResidency();
+  return residency != Residency::Loading && residency != Residency::Failed;
+}
+bool AudioClipResource::isStreamed() const {
+  const auto residency = getResidency();
+  return residency == Residency::Streamed ||
+         residency == Residency::Compressed;
+}
+
+std::span<const std::byte> AudioClipResource::getCompressedData() const {
+  return {m_compressedData.data.get(), m_compressedData.size};
+}
+std::size_t AudioClipResource::getMemoryUsage() const {
+  switch (getResidency()) {
+    using enum Residency;
+
+  case Loading:
+  case Decoded:
+    return getInfo().dataSize();
+  case Compressed:
+    return m_compressedData.size;
+
+  default:
+    return 0;
+  }
+}
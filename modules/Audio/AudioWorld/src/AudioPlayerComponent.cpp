@@ -6,7 +6,7 @@ AudioPlayerComponent::AudioPlayerComponent(const SoundSettings &settings)
 AudioPlayerComponent &
 AudioPlayerComponent::setStream(std::unique_ptr<audio::Decoder> &&decoder) {
   using namespace std::chrono_literals;
-  m_streamPlayer->setStream(std::move(decoder), 250ms);
+  m_streamPlayer->setStream(std::move(decoder), 100ms);
   return *this;
 }
 
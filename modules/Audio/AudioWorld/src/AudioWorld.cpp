@@ -2,15 +2,90 @@
 #include "os/FileSystem.hpp"
 #include "AudioClipLoader.hpp"
 #include "spdlog/spdlog.h"
+#include "glm/common.hpp"    // min, max, clamp
+#include "glm/geometric.hpp" // distance
+#include "tracy/Tracy.hpp"
+#include <algorithm>
+#include <cmath> // fmod, pow
 
 namespace {
 
+[[nodiscard]] bool isAudible(const float audibility, const float threshold) {
+  return audibility > 0.0f && audibility >= threshold;
+}
+
+// A real voice keeps playing until another one is noticeably more audible
+// (prevents swapping sources of a similar gain every frame).
+constexpr auto kHysteresis = 1.25f;
+
+constexpr auto kStreamBufferDuration = fsec{0.1f};
+
+// audio::Source or audio::StreamPlayer (setLooping is not virtual).
+template <typename Voice>
+void applySettings(Voice &voice, const SoundSettings &settings) {
+  voice.setPitch(settings.pitch);
+  voice.setGain(settings.gain);
+  voice.setMaxDistance(settings.maxDistance);
+  voice.setRollOffFactor(settings.rollOffFactor);
+  voice.setReferenceDistance(settings.referenceDistance);
+  voice.setMinGain(settings.minGain);
+  voice.setMaxGain(settings.maxGain);
+  voice.setLooping(settings.loop);
+}
+
 void synchronize(audio::SourceBase &source, const Transform &xf,
                  const bool directional) {
   source.setPosition(xf.getPosition());
   if (directional) source.setDirection(xf.getForward());
 }
 
+// https://www.openal.org/documentation/openal-1.1-specification.pdf
+// (3.4. Attenuation By Distance)
+[[nodiscard]] float calcAttenuation(const audio::DistanceModel distanceModel,
+                                    float distance,
+                                    const SoundSettings &settings) {
+  const auto referenceDistance = settings.referenceDistance;
+  const auto maxDistance = glm::max(referenceDistance, settings.maxDistance);
+  const auto rollOff = settings.rollOffFactor;
+
+  using enum audio::DistanceModel;
+  switch (distanceModel) {
+  case InverseClamped:
+  case LinearClamped:
+  case ExponentClamped:
+    distance = glm::clamp(distance, referenceDistance, maxDistance);
+    break;
+
+  default:
+    break;
+  }
+
+  switch (distanceModel) {
+  case None:
+    return 1.0f;
+
+  case Inverse:
+  case InverseClamped: {
+    const auto d = referenceDistance + rollOff * (distance - referenceDistance);
+    return d > 0.0f ? referenceDistance / d : 1.0f;
+  }
+  case Linear:
+  case LinearClamped: {
+    const auto range = maxDistance - referenceDistance;
+    if (range <= 0.0f) return 1.0f;
+    distance = glm::min(distance, maxDistance);
+    return glm::max(0.0f,
+                    1.0f - rollOff * (distance - referenceDistance) / range);
+  }
+  case Exponent:
+  case ExponentClamped:
+    return distance > 0.0f && referenceDistance > 0.0f
+             ? std::pow(distance / referenceDistance, -rollOff)
+             : 1.0f;
+  }
+  return 1.0f;
+}
+
 } // namespace
 
 //
@@ -27,24 +102,87 @@ const audio::Device::Settings &AudioWorld::getSettings() const {
   return m_settings;
 }
 
+void AudioWorld::setVoiceSettings(const VoiceSettings &settings) {
+  m_voiceSettings = settings;
+}
+const AudioWorld::VoiceSettings &AudioWorld::getVoiceSettings() const {
+  return m_voiceSettings;
+}
+
 void AudioWorld::init(const Transform *xf, SoundSourceComponent &c) const {
-  c.m_source = std::make_shared<audio::Source>(c.m_resource);
+  // Virtual, until the next updateVoices.
+  c.m_source = nullptr;
+  c.m_stream = nullptr;
   c.setSettings(c.m_settings);
-  if (xf) update(*xf, c);
+  if (xf) {
+    c.m_position = xf->getPosition();
+    if (c.m_settings.directional) c.m_direction = xf->getForward();
+  }
 }
 void AudioWorld::init(const Transform *xf, AudioPlayerComponent &c) const {
-  c.m_streamPlayer = std::make_shared<audio::StreamPlayer>(3);
+  c.m_streamPlayer = std::make_shared<audio::StreamPlayer>();
+  if (auto *streamingThread = m_device.getStreamingThread(); streamingThread) {
+    streamingThread->add(*c.m_streamPlayer);
+  }
   if (xf) update(xf, c);
 }
+void AudioWorld::release(SoundSourceComponent &c) const {
+  if (c.isReal()) _virtualize(c);
+}
 
 void AudioWorld::updateListener(const Transform &xf,
                                 const ListenerComponent &listener) {
-  m_device.setListenerTransform(xf.getPosition(), xf.getForward(), xf.getUp())
+  m_listenerPosition = xf.getPosition();
+  m_device.setListenerTransform(m_listenerPosition, xf.getForward(), xf.getUp())
     .setListenerVelocity(listener.velocity);
 }
-void AudioWorld::update(const Transform &xf, SoundSourceComponent &c) const {
-  synchronize(*c.m_source, xf, c.getSettings().directional);
-  c.m_settings.playing = c.m_source->isPlaying();
+void AudioWorld::update(const Transform *xf, SoundSourceComponent &c,
+                        const fsec dt) {
+  using enum audio::SourceBase::State;
+
+  const auto &settings = c.m_settings;
+  if (xf) {
+    c.m_position = xf->getPosition();
+    if (settings.directional) c.m_direction = xf->getForward();
+  }
+
+  if (auto *voice = c._getVoice(); voice) {
+    if (xf) synchronize(*voice, *xf, settings.directional);
+    if (c.m_stream) c.m_stream->update();
+    if (c.m_state == Playing) {
+      if (c.m_source ? c.m_source->isStopped() : !c.m_stream->isPlaying()) {
+        c.m_offset = fsec{0};
+        c._setState(Stopped);
+      } else {
+        c.m_offset = c.tell();
+      }
+    }
+  } else if (c.m_state == Playing) {
+    const auto duration =
+      c.m_resource ? c.m_resource->getInfo().duration() : fsec{0};
+    c.m_offset += dt * glm::max(0.0f, settings.pitch);
+    if (c.m_offset >= duration) {
+      if (settings.loop && duration > fsec{0}) {
+        c.m_offset = fsec{std::fmod(c.m_offset.count(), duration.count())};
+      } else {
+        c.m_offset = fsec{0};
+        c._setState(Stopped);
+      }
+    }
+  }
+
+  // A clip that is still loading stays virtual (but its time goes on).
+  const auto audibility =
+    c.m_state == Playing && c.m_resource && c.m_resource->isReady()
+      ? _estimateAudibility(c)
+      : 0.0f;
+  if (isAudible(audibility, m_voiceSettings.minAudibility) || c.isReal()) {
+    m_candidates.push_back({
+      .source = &c,
+      .priority = c.m_priority,
+      .audibility = audibility,
+    });
+  }
 }
 void AudioWorld::update(const Transform *xf, AudioPlayerComponent &c) const {
   if (xf) synchronize(*c.m_streamPlayer, *xf, c.getSettings().directional);
@@ -52,6 +190,128 @@ void AudioWorld::update(const Transform *xf, AudioPlayerComponent &c) const {
   c.m_settings.playing = c.m_streamPlayer->isPlaying();
 }
 
+void AudioWorld::updateVoices() {
+  ZoneScopedN("AudioWorld::UpdateVoices");
+
+  m_voiceStats = {};
+  const auto minAudibility = m_voiceSettings.minAudibility;
+  const auto last = std::partition(
+    m_candidates.begin(), m_candidates.end(),
+    [minAudibility](const Candidate &c) {
+      return isAudible(c.audibility, minAudibility);
+    });
+  const auto numAudible = uint32_t(std::distance(m_candidates.begin(), last));
+  const auto n = std::min(numAudible, m_voiceSettings.maxNumVoices);
+  if (n < numAudible) {
+    const auto score = [](const Candidate &c) {
+      return std::pair{
+        c.priority,
+        c.source->isReal() ? c.audibility * kHysteresis : c.audibility,
+      };
+    };
+    std::nth_element(m_candidates.begin(), m_candidates.begin() + n, last,
+                     [&score](const Candidate &a, const Candidate &b) {
+                       return score(a) > score(b);
+                     });
+  }
+
+  // Release the voices first, the winners reuse them.
+  for (auto it = m_candidates.begin() + n; it != m_candidates.end(); ++it) {
+    if (it->source->isReal()) {
+      _virtualize(*it->source);
+      ++m_voiceStats.numVirtualized;
+    }
+  }
+  // The pool could have been shrunk (see: setVoiceSettings).
+  for (auto it = m_voices.begin(); it != m_voices.end();) {
+    const auto excess = m_voices.size() > m_voiceSettings.maxNumVoices;
+    it = excess && it->use_count() == 1 ? m_voices.erase(it) : std::next(it);
+  }
+
+  for (auto it = m_candidates.begin(); it != m_candidates.begin() + n; ++it) {
+    if (!it->source->isReal()) {
+      _realize(*it->source);
+      if (it->source->isReal()) ++m_voiceStats.numRealized;
+    }
+    if (it->source->isReal()) ++m_voiceStats.numReal;
+  }
+  m_voiceStats.numAudible = numAudible;
+
+  m_candidates.clear();
+}
+const AudioWorld::VoiceStats &AudioWorld::getVoiceStats() const {
+  return m_voiceStats;
+}
+
+//
+// (private):
+//
+
+float AudioWorld::_estimateAudibility(const SoundSourceComponent &c) const {
+  const auto &settings = c.m_settings;
+  const auto attenuation =
+    calcAttenuation(m_settings.distanceModel,
+                    glm::distance(c.m_position, m_listenerPosition), settings);
+  return glm::clamp(settings.gain * attenuation, settings.minGain,
+                    settings.maxGain);
+}
+
+std::shared_ptr<audio::Source> AudioWorld::_acquireVoice() {
+  if (const auto it = std::ranges::find_if(
+        m_voices, [](const auto &voice) { return voice.use_count() == 1; });
+      it != m_voices.cend()) {
+    return *it;
+  }
+  if (m_voices.size() < m_voiceSettings.maxNumVoices) {
+    return m_voices.emplace_back(std::make_shared<audio::Source>());
+  }
+  return nullptr;
+}
+void AudioWorld::_realize(SoundSourceComponent &c) {
+  if (c.m_resource->isStreamed()) {
+    _realizeStream(c);
+    return;
+  }
+  auto voice = _acquireVoice();
+  if (!voice) return;
+
+  voice->setBuffer(c.m_resource);
+  applySettings(*voice, c.m_settings);
+  voice->setPosition(c.m_position);
+  voice->setDirection(c.m_direction);
+  voice->setVelocity(c.m_velocity);
+  // Resumes where the virtual voice is.
+  voice->seek(c.m_offset);
+  voice->play();
+  c.m_source = std::move(voice);
+}
+void AudioWorld::_realizeStream(SoundSourceComponent &c) {
+  // Streamed clips don't take a voice from the pool (a player per source).
+  auto decoder = createDecoder(*c.m_resource);
+  if (!decoder) {
+    SPDLOG_WARN("{}: {}", c.m_resource->getPath().generic_string(),
+                decoder.error());
+    c._setState(audio::SourceBase::State::Stopped);
+    return;
+  }
+  auto voice = std::make_shared<audio::StreamPlayer>();
+  if (auto *streamingThread = m_device.getStreamingThread(); streamingThread) {
+    streamingThread->add(*voice);
+  }
+  voice->setStream(std::move(*decoder), kStreamBufferDuration);
+  applySettings(*voice, c.m_settings);
+  voice->setPosition(c.m_position);
+  voice->setDirection(c.m_direction);
+  voice->setVelocity(c.m_velocity);
+  voice->seek(c.m_offset);
+  voice->play();
+  c.m_stream = std::move(voice);
+}
+void AudioWorld::_virtualize(SoundSourceComponent &c) const {
+  if (c.m_state == audio::SourceBase::State::Playing) c.m_offset = c.tell();
+  c._releaseVoice();
+}
+
 //
 // Helper:
 //
@@ -5,8 +5,12 @@ SoundSourceComponent::SoundSourceComponent(const SoundSettings &settings)
 
 SoundSourceComponent &
 SoundSourceComponent::setClip(std::shared_ptr<AudioClipResource> clip) {
+  // The clip could be loading or streamed, AudioWorld picks a new voice.
+  // Released before the old clip (a stream could still read its data).
+  _releaseVoice();
   m_resource = std::move(clip);
-  if (m_source) m_source->setBuffer(m_resource);
+  m_offset = fsec{0};
+  _setState(audio::SourceBase::State::Stopped);
   return *this;
 }
 
@@ -26,55 +30,62 @@ SoundSourceComponent::setSettings(const SoundSettings &settings) {
 }
 SoundSourceComponent &SoundSourceComponent::setPitch(const float s) {
   m_settings.pitch = s;
-  m_source->setPitch(s);
+  if (auto *voice = _getVoice()) voice->setPitch(s);
   return *this;
 }
 SoundSourceComponent &SoundSourceComponent::setGain(const float s) {
   m_settings.gain = s;
-  m_source->setGain(s);
+  if (auto *voice = _getVoice()) voice->setGain(s);
   return *this;
 }
 SoundSourceComponent &SoundSourceComponent::setMaxDistance(const float s) {
   m_settings.maxDistance = s;
-  m_source->setMaxDistance(s);
+  if (auto *voice = _getVoice()) voice->setMaxDistance(s);
   return *this;
 }
 SoundSourceComponent &SoundSourceComponent::setRollOffFactor(const float s) {
   m_settings.rollOffFactor = s;
-  m_source->setRollOffFactor(s);
+  if (auto *voice = _getVoice()) voice->setRollOffFactor(s);
   return *this;
 }
 SoundSourceComponent &
 SoundSourceComponent::setReferenceDistance(const float s) {
   m_settings.referenceDistance = s;
-  m_source->setReferenceDistance(s);
+  if (auto *voice = _getVoice()) voice->setReferenceDistance(s);
   return *this;
 }
 SoundSourceComponent &SoundSourceComponent::setMinGain(const float s) {
   m_settings.minGain = s;
-  m_source->setMinGain(s);
+  if (auto *voice = _getVoice()) voice->setMinGain(s);
   return *this;
 }
 SoundSourceComponent &SoundSourceComponent::setMaxGain(const float s) {
   m_settings.maxGain = s;
-  m_source->setMaxGain(s);
+  if (auto *voice = _getVoice()) voice->setMaxGain(s);
   return *this;
 }
 SoundSourceComponent &SoundSourceComponent::setDirectional(const bool b) {
   m_settings.directional = b;
   if (!m_settings.directional) {
-    m_source->setDirection(glm::vec3{0.0f});
+    m_direction = glm::vec3{0.0f};
+    if (auto *voice = _getVoice()) voice->setDirection(m_direction);
   }
   return *this;
 }
 SoundSourceComponent &SoundSourceComponent::setLooping(const bool b) {
   m_settings.loop = b;
-  m_source->setLooping(b);
+  if (m_source) m_source->setLooping(b);
+  if (m_stream) m_stream->setLooping(b);
+  return *this;
+}
+SoundSourceComponent &SoundSourceComponent::setPriority(const uint8_t v) {
+  m_priority = v;
   return *this;
 }
 
 SoundSourceComponent &SoundSourceComponent::setVelocity(const glm::vec3 &v) {
-  m_source->setVelocity(v);
+  m_velocity = v;
+  if (auto *voice = _getVoice()) voice->setVelocity(v);
   return *this;
 }
 
@@ -84,19 +95,58 @@ std::shared_ptr<AudioClipResource> SoundSourceComponent::getClip() const {
 const SoundSettings &SoundSourceComponent::getSettings() const {
   return m_settings;
 }
-glm::vec3 SoundSourceComponent::getVelocity() const {
-  return m_source->getVelocity();
+uint8_t SoundSourceComponent::getPriority() const { return m_priority; }
+glm::vec3 SoundSourceComponent::getVelocity() const { return m_velocity; }
+
+fsec SoundSourceComponent::tell() const {
+  if (m_source) return m_source->tell();
+  if (m_stream) return m_stream->tell();
+  return m_offset;
 }
+bool SoundSourceComponent::isReal() const { return _getVoice() != nullptr; }
 
 SoundSourceComponent &SoundSourceComponent::play() {
-  m_source->play();
+  // Same as alSourcePlay: resumes a paused source, restarts the others.
+  if (m_state != audio::SourceBase::State::Paused) m_offset = fsec{0};
+  _setState(audio::SourceBase::State::Playing);
+  if (m_source) m_source->play();
+  if (m_stream) m_stream->play();
   return *this;
 }
 SoundSourceComponent &SoundSourceComponent::pause() {
-  m_source->pause();
+  if (m_state == audio::SourceBase::State::Playing) {
+    m_offset = tell();
+    _setState(audio::SourceBase::State::Paused);
+  }
+  if (m_source) m_source->pause();
+  if (m_stream) m_stream->pause();
   return *this;
 }
 SoundSourceComponent &SoundSourceComponent::stop() {
-  m_source->stop();
+  m_offset = fsec{0};
+  _setState(audio::SourceBase::State::Stopped);
+  if (m_source) m_source->stop();
+  if (m_stream) m_stream->stop();
   return *this;
 }
+
+//
+// (private):
+//
+
+audio::SourceBase *SoundSourceComponent::_getVoice() const {
+  if (m_source) return m_source.get();
+  return m_stream.get();
+}
+void SoundSourceComponent::_releaseVoice() {
+  if (m_source) {
+    m_source->setBuffer(nullptr); // Stops the source.
+    m_source = nullptr;
+  }
+  m_stream = nullptr;
+}
+
+void SoundSourceComponent::_setState(const audio::SourceBase::State state) {
+  m_state = state;
+  m_settings.playing = m_state == audio::SourceBase::State::Playing;
+}
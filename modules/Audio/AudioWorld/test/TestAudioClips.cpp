@@ -0,0 +1,202 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include "AudioWorld.hpp"
+#include "AudioClipManager.hpp"
+
+#include <cstdlib> // setenv
+#include <cstring> // memcpy
+#include <format>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+constexpr auto kSampleRate = 44100u;
+constexpr auto kDeltaTime = fsec{1.0f / 60.0f};
+
+// 16-bit mono PCM (silence).
+void writeWave(const std::filesystem::path &p, const fsec duration) {
+  const auto numSamples = uint32_t(duration.count() * kSampleRate);
+  const auto dataSize = numSamples * uint32_t(sizeof(int16_t));
+
+  std::vector<char> bytes(44 + dataSize);
+  const auto write = [&bytes](std::size_t offset, const auto &v) {
+    std::memcpy(bytes.data() + offset, &v, sizeof(v));
+  };
+  std::memcpy(bytes.data(), "RIFF", 4);
+  write(4, uint32_t(36 + dataSize));
+  std::memcpy(bytes.data() + 8, "WAVEfmt ", 8);
+  write(16, uint32_t{16});    // fmt chunk size.
+  write(20, uint16_t{1});     // PCM.
+  write(22, uint16_t{1});     // numChannels.
+  write(24, kSampleRate);     // sampleRate.
+  write(28, kSampleRate * 2); // byteRate.
+  write(32, uint16_t{2});     // blockAlign.
+  write(34, uint16_t{16});    // bitsPerSample.
+  std::memcpy(bytes.data() + 36, "data", 4);
+  write(40, dataSize);
+
+  std::ofstream{p, std::ios::binary}.write(bytes.data(), bytes.size());
+}
+
+// Synthetic clips in a temporary directory (the root of the FileSystem).
+class Corpus {
+public:
+  Corpus() {
+    const auto root =
+      std::filesystem::temp_directory_path() / "TestAudioClips";
+    std::filesystem::create_directories(root);
+    os::FileSystem::setRoot(root);
+
+    for (auto i = 0; i < kNumSmall; ++i) {
+      writeWave(root / small(i), fsec{0.5f}); // ~43 KiB.
+    }
+    writeWave(root / large(), fsec{4.0f}); // ~345 KiB.
+  }
+
+  static constexpr auto kNumSmall = 32;
+
+  [[nodiscard]] static std::filesystem::path small(const int32_t i) {
+    return std::format("small_{}.wav", i);
+  }
+  [[nodiscard]] static std::filesystem::path large() { return "large.wav"; }
+};
+
+constexpr AudioClipPolicy kTestPolicy{.maxDecodedSize = 64u << 10};
+
+} // namespace
+
+TEST_CASE("Audio clip policy") {
+  const Corpus corpus;
+  audio::Device device{{.streamingThread = false}};
+  AudioClipManager manager{device};
+
+  SECTION("Asynchronous decoding") {
+    manager.setPolicy(kTestPolicy);
+    const auto clip = manager.load(Corpus::small(0));
+    REQUIRE(clip);
+    REQUIRE_FALSE(clip->isStreamed());
+    manager.wait();
+    REQUIRE(clip->getResidency() == AudioClipResource::Residency::Decoded);
+    REQUIRE(clip->getMemoryUsage() == clip->getInfo().dataSize());
+  }
+  SECTION("Synchronous decoding") {
+    auto policy = kTestPolicy;
+    policy.async = false;
+    manager.setPolicy(policy);
+    const auto clip = manager.load(Corpus::small(0));
+    REQUIRE(clip->getResidency() == AudioClipResource::Residency::Decoded);
+  }
+  SECTION("Streamed") {
+    manager.setPolicy(kTestPolicy);
+    const auto clip = manager.load(Corpus::large());
+    REQUIRE(clip->getResidency() == AudioClipResource::Residency::Streamed);
+    REQUIRE(clip->getMemoryUsage() == 0);
+    REQUIRE(createDecoder(*clip).has_value());
+  }
+  SECTION("Compressed") {
+    auto policy = kTestPolicy;
+    policy.keepCompressed = true;
+    manager.setPolicy(policy);
+    const auto clip = manager.load(Corpus::large());
+    REQUIRE(clip->getResidency() == AudioClipResource::Residency::Compressed);
+    REQUIRE(clip->getMemoryUsage() == clip->getCompressedData().size());
+
+    const auto decoder = createDecoder(*clip);
+    REQUIRE(decoder.has_value());
+    REQUIRE((*decoder)->getInfo().numSamples == clip->getInfo().numSamples);
+  }
+}
+
+TEST_CASE("Audio clip eviction") {
+  const Corpus corpus;
+  audio::Device device{{.streamingThread = false}};
+  AudioClipManager manager{device};
+  // Two small clips fit.
+  manager.setPolicy({
+    .maxDecodedSize = 64u << 10,
+    .memoryBudget = 100u << 10,
+    .async = false,
+  });
+
+  const auto first = manager.load(Corpus::small(0));
+  const auto secondId = manager.load(Corpus::small(1))->getResourceId();
+  const auto third = manager.load(Corpus::small(2));
+
+  // The least recently loaded clip is in use, the second one is evicted.
+  const auto stats = manager.getStats();
+  REQUIRE(stats.numClips == 2);
+  REQUIRE(stats.numEvictions == 1);
+  REQUIRE(stats.memoryUsage <= manager.getPolicy().memoryBudget);
+  REQUIRE(manager.contains(first->getResourceId()));
+  REQUIRE_FALSE(manager.contains(secondId));
+  REQUIRE(manager.contains(third->getResourceId()));
+}
+
+TEST_CASE("Voices of the loading and streamed clips") {
+  const Corpus corpus;
+  audio::Device device{{.streamingThread = false}};
+  AudioClipManager manager{device};
+  manager.setPolicy(kTestPolicy);
+  AudioWorld world{device};
+  world.updateListener(Transform{}, ListenerComponent{});
+
+  const Transform xf{glm::vec3{1.0f, 0.0f, 0.0f}};
+  const auto update = [&](SoundSourceComponent &c) {
+    world.update(&xf, c, kDeltaTime);
+    world.updateVoices();
+  };
+
+  SECTION("Streamed") {
+    SoundSourceComponent c;
+    world.init(&xf, c);
+    c.setClip(manager.load(Corpus::large()).handle()).play();
+    update(c);
+    REQUIRE(c.isReal());
+    REQUIRE(world.getVoiceStats().numReal == 1);
+    REQUIRE(c.getSettings().playing);
+  }
+  SECTION("Loading") {
+    SoundSourceComponent c;
+    world.init(&xf, c);
+    c.setClip(manager.load(Corpus::small(0)).handle()).play();
+    if (!c.getClip()->isReady()) {
+      update(c);
+      REQUIRE_FALSE(c.isReal());
+    }
+    manager.wait();
+    update(c);
+    REQUIRE(c.isReal());
+  }
+}
+
+TEST_CASE("Audio clips benchmark", "[.benchmark]") {
+  const Corpus corpus;
+  audio::Device device{{.streamingThread = false}};
+  AudioClipManager manager{device};
+
+  const auto loadAll = [&manager](const bool async) {
+    auto policy = manager.getPolicy();
+    policy.async = async;
+    manager.setPolicy(policy);
+    manager.clear();
+    for (auto i = 0; i < Corpus::kNumSmall; ++i) {
+      [[maybe_unused]] const auto clip = manager.load(Corpus::small(i));
+    }
+    manager.wait();
+    return manager.getStats().memoryUsage;
+  };
+  BENCHMARK("32 clips, synchronous") { return loadAll(false); };
+  BENCHMARK("32 clips, asynchronous") { return loadAll(true); };
+}
+
+int main(int argc, char *argv[]) {
+  // OpenAL Soft: no output device, for headless runs.
+#ifdef _WIN32
+  _putenv_s("ALSOFT_DRIVERS", "null");
+#else
+  setenv("ALSOFT_DRIVERS", "null", 1);
+#endif
+  return Catch::Session{}.run(argc, argv);
+}
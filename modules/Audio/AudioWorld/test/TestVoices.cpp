@@ -0,0 +1,186 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include "AudioWorld.hpp"
+#include "glm/geometric.hpp" // length
+
+#include <algorithm>
+#include <cmath>   // ceil, sqrt
+#include <cstdlib> // setenv
+#include <vector>
+
+namespace {
+
+constexpr auto kDeltaTime = fsec{1.0f / 60.0f};
+
+[[nodiscard]] auto createClip(audio::Device &device, const fsec duration) {
+  const audio::ClipInfo info{
+    .numChannels = audio::NumChannels::Mono,
+    .bitsPerSample = 16,
+    .sampleRate = 44100,
+    .numSamples = std::size_t(duration.count() * 44100),
+  };
+  const std::vector<int16_t> silence(info.numSamples);
+  return std::make_shared<AudioClipResource>(
+    device.createBuffer(info, silence.data()), "Silence");
+}
+
+// Emitters on a grid (XZ plane) around the listener (at the origin).
+class Emitters {
+public:
+  Emitters(AudioWorld &world, std::shared_ptr<AudioClipResource> clip,
+           const std::size_t count)
+      : m_world{world}, m_sources(count) {
+    const auto side = int32_t(std::ceil(std::sqrt(float(count))));
+    m_transforms.reserve(count);
+    for (auto i = 0u; i < count; ++i) {
+      const auto x = float(int32_t(i) % side - side / 2);
+      const auto z = float(int32_t(i) / side - side / 2);
+      const auto &xf = m_transforms.emplace_back(glm::vec3{x, 0.0f, z} * 2.0f);
+      auto &c = m_sources[i];
+      m_world.init(&xf, c);
+      c.setClip(clip).setLooping(true).play();
+    }
+  }
+
+  void update() {
+    for (auto i = 0u; i < m_sources.size(); ++i) {
+      m_world.update(&m_transforms[i], m_sources[i], kDeltaTime);
+    }
+    m_world.updateVoices();
+  }
+
+  [[nodiscard]] std::size_t size() const { return m_sources.size(); }
+  [[nodiscard]] SoundSourceComponent &operator[](std::size_t i) {
+    return m_sources[i];
+  }
+  [[nodiscard]] float getDistance(std::size_t i) const {
+    return glm::length(m_transforms[i].getPosition());
+  }
+
+private:
+  AudioWorld &m_world;
+  std::vector<Transform> m_transforms;
+  std::vector<SoundSourceComponent> m_sources;
+};
+
+} // namespace
+
+TEST_CASE("Voice virtualization") {
+  audio::Device device{{.streamingThread = false}};
+  AudioWorld world{device};
+  world.updateListener(Transform{}, ListenerComponent{});
+  world.setVoiceSettings({.maxNumVoices = 32});
+
+  Emitters emitters{world, createClip(device, fsec{1.0f}), 10'000};
+  emitters.update();
+
+  const auto &stats = world.getVoiceStats();
+  REQUIRE(stats.numAudible == 10'000);
+  REQUIRE(stats.numReal == 32);
+  REQUIRE(stats.numRealized == 32);
+
+  SECTION("The nearest sources are real") {
+    auto maxReal = 0.0f;
+    auto minVirtual = std::numeric_limits<float>::max();
+    for (auto i = 0u; i < emitters.size(); ++i) {
+      const auto distance = emitters.getDistance(i);
+      if (emitters[i].isReal()) {
+        maxReal = std::max(maxReal, distance);
+      } else {
+        minVirtual = std::min(minVirtual, distance);
+      }
+    }
+    REQUIRE(maxReal <= minVirtual);
+  }
+  SECTION("No swaps in a static scene") {
+    emitters.update();
+    REQUIRE(stats.numReal == 32);
+    REQUIRE(stats.numRealized == 0);
+    REQUIRE(stats.numVirtualized == 0);
+  }
+  SECTION("Priority") {
+    auto &farthest = emitters[0];
+    REQUIRE_FALSE(farthest.isReal());
+    farthest.setPriority(SoundSourceComponent::kDefaultPriority + 1);
+    emitters.update();
+    REQUIRE(farthest.isReal());
+    REQUIRE(stats.numReal == 32);
+    REQUIRE(stats.numVirtualized == 1);
+  }
+  SECTION("Stopped sources release the voices") {
+    for (auto i = 0u; i < emitters.size(); ++i) {
+      emitters[i].stop();
+    }
+    emitters.update();
+    REQUIRE(stats.numAudible == 0);
+    REQUIRE(stats.numReal == 0);
+    REQUIRE(stats.numVirtualized == 32);
+  }
+}
+
+TEST_CASE("Virtual playback") {
+  audio::Device device{{.streamingThread = false}};
+  AudioWorld world{device};
+  world.setVoiceSettings({.maxNumVoices = 1});
+  const auto clip = createClip(device, fsec{2.0f});
+
+  const Transform near{glm::vec3{1.0f, 0.0f, 0.0f}};
+  const Transform far{glm::vec3{10.0f, 0.0f, 0.0f}};
+  world.updateListener(near, ListenerComponent{});
+
+  SoundSourceComponent a;
+  world.init(&near, a);
+  a.setClip(clip).play();
+  SoundSourceComponent b;
+  world.init(&far, b);
+  b.setClip(clip).setLooping(true).play();
+
+  const auto update = [&](const int32_t numFrames) {
+    for (auto i = 0; i < numFrames; ++i) {
+      world.update(&near, a, kDeltaTime);
+      world.update(&far, b, kDeltaTime);
+      world.updateVoices();
+    }
+  };
+
+  update(90); // 1.5 s
+  REQUIRE(a.isReal());
+  REQUIRE_FALSE(b.isReal());
+  REQUIRE(b.tell().count() == Approx(1.5f).margin(0.01f));
+
+  // The listener moves to b.
+  world.updateListener(far, ListenerComponent{});
+  update(1);
+  REQUIRE(b.isReal());
+  REQUIRE(b.getSettings().playing);
+  // Resumed where the virtual voice was.
+  REQUIRE(b.tell().count() == Approx(1.5f).margin(0.05f));
+  REQUIRE_FALSE(a.isReal());
+  REQUIRE(a.getSettings().playing);
+
+  update(150); // 2.5 s
+  // The virtual voice of a has reached the end of the clip.
+  REQUIRE_FALSE(a.getSettings().playing);
+  REQUIRE(a.tell() == fsec{0});
+  REQUIRE(b.isReal());
+}
+
+TEST_CASE("Voices benchmark", "[.benchmark]") {
+  audio::Device device{{.streamingThread = false}};
+  AudioWorld world{device};
+  world.updateListener(Transform{}, ListenerComponent{});
+  Emitters emitters{world, createClip(device, fsec{1.0f}), 10'000};
+
+  BENCHMARK("10k emitters, 64 voices") { emitters.update(); };
+}
+
+int main(int argc, char *argv[]) {
+  // OpenAL Soft: no output device, for headless runs.
+#ifdef _WIN32
+  _putenv_s("ALSOFT_DRIVERS", "null");
+#else
+  setenv("ALSOFT_DRIVERS", "null", 1);
+#endif
+  return Catch::Session{}.run(argc, argv);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// CPU implementation of the BCn block formats.
+// Encoders are meant for offline use (TextureCooker), decoders are used as a
+// fallback when a device does not support textureCompressionBC.
+
+namespace bc {
+
+enum class Format {
+  BC1, // RGB + 1-bit alpha (punch-through).
+  BC3, // RGBA (BC1 color + BC4 alpha).
+  BC4, // R.
+  BC5, // RG (normal maps).
+  BC6H, // RGB half-float (unsigned).
+  BC7, // RGBA.
+};
+
+[[nodiscard]] constexpr uint32_t getBlockSize(Format format) {
+  return format == Format::BC1 || format == Format::BC4 ? 8 : 16;
+}
+[[nodiscard]] constexpr bool isHDR(Format format) {
+  return format == Format::BC6H;
+}
+// @return Size in bytes of a single (decoded) pixel: RGBA8 or RGBA32F.
+[[nodiscard]] constexpr uint32_t getPixelSize(Format format) {
+  return isHDR(format) ? sizeof(float) * 4 : sizeof(uint8_t) * 4;
+}
+
+[[nodiscard]] constexpr uint32_t calcNumBlocks(uint32_t size) {
+  return (size + 3) / 4;
+}
+[[nodiscard]] constexpr std::size_t
+calcCompressedSize(Format format, uint32_t width, uint32_t height) {
+  return std::size_t{calcNumBlocks(width)} * calcNumBlocks(height) *
+         getBlockSize(format);
+}
+
+// @param pixels Tightly packed RGBA8 (or RGBA32F for BC6H).
+[[nodiscard]] std::vector<std::byte> encode(Format, const void *pixels,
+                                            uint32_t width, uint32_t height);
+
+// @param out Tightly packed RGBA8 (or RGBA32F for BC6H),
+// at least width * height * getPixelSize(format) bytes.
+// Every block mode is supported (reserved modes decode to black).
+// @return false if blocks is too small.
+[[nodiscard]] bool decode(Format, std::span<const std::byte> blocks,
+                          uint32_t width, uint32_t height, void *out);
+
+} // namespace bc
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace bc {
+
+// Peak signal-to-noise ratio (in dB) of two RGBA8 images.
+// @param numChannels Compares only the first N channels (e.g. 3 for RGB).
+[[nodiscard]] double calcPSNR(std::span<const uint8_t> a,
+                              std::span<const uint8_t> b,
+                              uint32_t numChannels = 4);
+// Same as above, for RGBA32F images, normalized by the given peak value.
+[[nodiscard]] double calcPSNR(std::span<const float> a,
+                              std::span<const float> b, float peak,
+                              uint32_t numChannels = 3);
+
+} // namespace bc
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace bc {
+
+// 128-bit block, bits are stored LSB first.
+
+class BitReader {
+public:
+  explicit BitReader(const void *block) { std::memcpy(m_data, block, 16); }
+
+  [[nodiscard]] uint32_t read(uint32_t numBits) {
+    uint32_t value{0};
+    for (auto i = 0u; i < numBits; ++i, ++m_position) {
+      const auto bit = (m_data[m_position >> 3] >> (m_position & 7)) & 1;
+      value |= uint32_t(bit) << i;
+    }
+    return value;
+  }
+  [[nodiscard]] uint32_t getPosition() const { return m_position; }
+
+private:
+  uint8_t m_data[16];
+  uint32_t m_position{0};
+};
+
+class BitWriter {
+public:
+  BitWriter() { std::memset(m_data, 0, 16); }
+
+  void write(uint32_t value, uint32_t numBits) {
+    for (auto i = 0u; i < numBits; ++i, ++m_position) {
+      if ((value >> i) & 1) m_data[m_position >> 3] |= 1 << (m_position & 7);
+    }
+  }
+  [[nodiscard]] uint32_t getPosition() const { return m_position; }
+
+  void copyTo(void *block) const { std::memcpy(block, m_data, 16); }
+
+private:
+  uint8_t m_data[16];
+  uint32_t m_position{0};
+};
+
+} // namespace bc
@@ -0,0 +1,330 @@
+#include "bc/BlockCompression.hpp"
+#include "BitStream.hpp"
+#include "Tables.hpp"
+#include "Half.hpp"
+
+#include <algorithm> // min, ranges::find
+#include <cmath>     // round
+#include <cassert>
+
+namespace bc {
+
+namespace {
+
+using RGBA8 = std::array<uint8_t, 4>;
+using RGBA32F = std::array<float, 4>;
+
+template <typename T> using DecodedBlock = std::array<T, 16>;
+
+[[nodiscard]] RGBA8 unpackRGB565(uint16_t c) {
+  const auto r = (c >> 11) & 31;
+  const auto g = (c >> 5) & 63;
+  const auto b = c & 31;
+  return {
+    uint8_t(r << 3 | r >> 2),
+    uint8_t(g << 2 | g >> 4),
+    uint8_t(b << 3 | b >> 2),
+    255,
+  };
+}
+
+// @param forceOpaque BC2/BC3 color blocks are always in the 4 color mode.
+void decodeBC1Block(const std::byte *src, bool forceOpaque,
+                    DecodedBlock<RGBA8> &out) {
+  uint16_t c0;
+  uint16_t c1;
+  uint32_t indices;
+  std::memcpy(&c0, src, 2);
+  std::memcpy(&c1, src + 2, 2);
+  std::memcpy(&indices, src + 4, 4);
+
+  RGBA8 palette[4]{unpackRGB565(c0), unpackRGB565(c1)};
+  for (auto c = 0u; c < 3; ++c) {
+    const auto e0 = uint32_t(palette[0][c]);
+    const auto e1 = uint32_t(palette[1][c]);
+    if (c0 > c1 || forceOpaque) {
+      palette[2][c] = uint8_t((2 * e0 + e1 + 1) / 3);
+      palette[3][c] = uint8_t((e0 + 2 * e1 + 1) / 3);
+    } else {
+      palette[2][c] = uint8_t((e0 + e1 + 1) / 2);
+      palette[3][c] = 0;
+    }
+  }
+  palette[2][3] = 255;
+  palette[3][3] = c0 > c1 || forceOpaque ? 255 : 0;
+
+  for (auto i = 0u; i < 16; ++i)
+    out[i] = palette[(indices >> (i * 2)) & 3];
+}
+
+void decodeBC4Block(const std::byte *src, DecodedBlock<RGBA8> &out,
+                    uint32_t channel) {
+  const auto e0 = uint32_t(src[0]);
+  const auto e1 = uint32_t(src[1]);
+
+  uint8_t palette[8]{uint8_t(e0), uint8_t(e1)};
+  if (e0 > e1) {
+    for (auto i = 1u; i < 7; ++i)
+      palette[i + 1] = uint8_t(((7 - i) * e0 + i * e1 + 3) / 7);
+  } else {
+    for (auto i = 1u; i < 5; ++i)
+      palette[i + 1] = uint8_t(((5 - i) * e0 + i * e1 + 2) / 5);
+    palette[6] = 0;
+    palette[7] = 255;
+  }
+
+  uint64_t indices{0};
+  for (auto i = 0u; i < 6; ++i)
+    indices |= uint64_t(src[2 + i]) << (i * 8);
+  for (auto i = 0u; i < 16; ++i)
+    out[i][channel] = palette[(indices >> (i * 3)) & 7];
+}
+
+[[nodiscard]] const uint8_t *getWeights(uint32_t numBits) {
+  switch (numBits) {
+  case 2:
+    return kWeights2;
+  case 3:
+    return kWeights3;
+  case 4:
+    return kWeights4;
+  }
+  assert(false);
+  return kWeights2;
+}
+[[nodiscard]] uint8_t interpolate(uint32_t e0, uint32_t e1, uint32_t weight) {
+  return uint8_t(((64 - weight) * e0 + weight * e1 + 32) >> 6);
+}
+
+[[nodiscard]] bool decodeBC7Block(const std::byte *src,
+                                  DecodedBlock<RGBA8> &out) {
+  BitReader reader{src};
+
+  auto mode = 0u;
+  while (mode < 8 && reader.read(1) == 0)
+    ++mode;
+  if (mode == 8) {
+    // Reserved, decodes to transparent black.
+    out.fill({0, 0, 0, 0});
+    return true;
+  }
+  const auto &info = kBC7Modes[mode];
+
+  const auto partition = reader.read(info.partitionBits);
+  const auto rotation = reader.read(info.rotationBits);
+  const auto indexSelection = reader.read(info.indexSelectionBits);
+
+  const auto numEndpoints = info.numSubsets * 2u;
+  // [endpoint][channel]
+  uint32_t endpoints[6][4]{};
+  for (auto c = 0u; c < 3; ++c)
+    for (auto e = 0u; e < numEndpoints; ++e)
+      endpoints[e][c] = reader.read(info.colorBits);
+  for (auto e = 0u; e < numEndpoints; ++e)
+    endpoints[e][3] = info.alphaBits ? reader.read(info.alphaBits) : 255;
+
+  auto colorBits = uint32_t(info.colorBits);
+  auto alphaBits = uint32_t(info.alphaBits);
+  if (info.endpointPBits || info.sharedPBits) {
+    uint32_t pBits[6];
+    if (info.endpointPBits) {
+      for (auto e = 0u; e < numEndpoints; ++e)
+        pBits[e] = reader.read(1);
+    } else {
+      for (auto s = 0u; s < info.numSubsets; ++s)
+        pBits[s * 2] = pBits[s * 2 + 1] = reader.read(1);
+    }
+    for (auto e = 0u; e < numEndpoints; ++e)
+      for (auto c = 0u; c < (alphaBits ? 4u : 3u); ++c)
+        endpoints[e][c] = endpoints[e][c] << 1 | pBits[e];
+
+    ++colorBits;
+    if (alphaBits) ++alphaBits;
+  }
+  // Expand to 8 bits (replicate MSBs).
+  for (auto e = 0u; e < numEndpoints; ++e) {
+    for (auto c = 0u; c < 3; ++c) {
+      auto &v = endpoints[e][c];
+      v = (v << (8 - colorBits)) | (v >> (2 * colorBits - 8));
+    }
+    if (alphaBits) {
+      auto &v = endpoints[e][3];
+      v = (v << (8 - alphaBits)) | (v >> (2 * alphaBits - 8));
+    }
+  }
+
+  uint32_t indices[16];
+  for (auto i = 0u; i < 16; ++i) {
+    const auto anchor = isAnchor(info.numSubsets, partition, i);
+    indices[i] = reader.read(info.indexBits - (anchor ? 1 : 0));
+  }
+  uint32_t secondaryIndices[16]{};
+  if (info.secondaryIndexBits) {
+    for (auto i = 0u; i < 16; ++i)
+      secondaryIndices[i] = reader.read(info.secondaryIndexBits - (i ? 0 : 1));
+  }
+  assert(reader.getPosition() == 128);
+
+  auto colorIndexBits = uint32_t(info.indexBits);
+  auto alphaIndexBits = uint32_t(info.secondaryIndexBits);
+  const auto *colorIndices = indices;
+  const auto *alphaIndices = info.secondaryIndexBits ? secondaryIndices : indices;
+  if (!alphaIndexBits) alphaIndexBits = colorIndexBits;
+  if (indexSelection) {
+    std::swap(colorIndexBits, alphaIndexBits);
+    std::swap(colorIndices, alphaIndices);
+  }
+  const auto *colorWeights = getWeights(colorIndexBits);
+  const auto *alphaWeights = getWeights(alphaIndexBits);
+
+  for (auto i = 0u; i < 16; ++i) {
+    const auto subset = getSubset(info.numSubsets, partition, i);
+    const auto *e0 = endpoints[subset * 2];
+    const auto *e1 = endpoints[subset * 2 + 1];
+
+    auto &pixel = out[i];
+    for (auto c = 0u; c < 3; ++c)
+      pixel[c] = interpolate(e0[c], e1[c], colorWeights[colorIndices[i]]);
+    pixel[3] = interpolate(e0[3], e1[3], alphaWeights[alphaIndices[i]]);
+
+    if (rotation) std::swap(pixel[3], pixel[rotation - 1]);
+  }
+  return true;
+}
+
+[[nodiscard]] int32_t signExtend(uint32_t v, uint32_t numBits) {
+  const auto shift = 32 - numBits;
+  return int32_t(v << shift) >> shift;
+}
+// Unsigned format, @see BC6H_UF16.
+[[nodiscard]] uint32_t unquantizeBC6H(uint32_t q, uint32_t numBits) {
+  if (numBits >= 15) return q;
+  if (q == 0) return 0;
+  if (q == (1u << numBits) - 1) return 0xFFFF;
+  return ((q << 16) + 0x8000) >> numBits;
+}
+
+[[nodiscard]] bool decodeBC6HBlock(const std::byte *src,
+                                   DecodedBlock<RGBA32F> &out) {
+  BitReader reader{src};
+
+  auto mode = reader.read(2);
+  if (mode > 1) mode |= reader.read(3) << 2;
+  const auto it = std::ranges::find(bc6h::kModes, mode, &bc6h::ModeInfo::value);
+  if (it == bc6h::kModes.end()) {
+    // Reserved, decodes to black.
+    out.fill({0.0f, 0.0f, 0.0f, 1.0f});
+    return true;
+  }
+  const auto &info = *it;
+
+  // [endpoint][channel]
+  uint32_t endpoints[4][3]{};
+  for (auto f = 0u; f < info.numFields; ++f) {
+    const auto &field = info.fields[f];
+    endpoints[field.endpoint][field.channel] |= reader.read(field.numBits)
+                                                << field.shift;
+  }
+  const auto partition = info.numRegions == 2 ? reader.read(5) : 0u;
+
+  const auto numEndpoints = info.numRegions * 2u;
+  const auto mask = (1u << info.endpointBits) - 1;
+  if (info.transformed) {
+    for (auto e = 1u; e < numEndpoints; ++e) {
+      for (auto c = 0u; c < 3; ++c) {
+        auto &v = endpoints[e][c];
+        const auto delta = signExtend(v, info.deltaBits[c]);
+        v = uint32_t(int32_t(endpoints[0][c]) + delta) & mask;
+      }
+    }
+  }
+  for (auto e = 0u; e < numEndpoints; ++e)
+    for (auto c = 0u; c < 3; ++c)
+      endpoints[e][c] = unquantizeBC6H(endpoints[e][c], info.endpointBits);
+
+  const auto indexBits = info.numRegions == 2 ? 3u : 4u;
+  const auto *weights = getWeights(indexBits);
+  for (auto i = 0u; i < 16; ++i) {
+    const auto anchor = isAnchor(info.numRegions, partition, i);
+    const auto w = uint32_t(weights[reader.read(indexBits - (anchor ? 1 : 0))]);
+    const auto region = getSubset(info.numRegions, partition, i);
+    const auto *e0 = endpoints[region * 2];
+    const auto *e1 = endpoints[region * 2 + 1];
+
+    auto &pixel = out[i];
+    for (auto c = 0u; c < 3; ++c) {
+      const auto v = ((64 - w) * e0[c] + w * e1[c] + 32) >> 6;
+      pixel[c] = fromHalf(uint16_t((v * 31) >> 6));
+    }
+    pixel[3] = 1.0f;
+  }
+  assert(reader.getPosition() == 128);
+  return true;
+}
+
+template <typename T>
+void storeBlock(const DecodedBlock<T> &block, uint32_t bx, uint32_t by,
+                uint32_t width, uint32_t height, T *out) {
+  const auto maxX = std::min(4u, width - bx * 4);
+  const auto maxY = std::min(4u, height - by * 4);
+  for (auto y = 0u; y < maxY; ++y) {
+    for (auto x = 0u; x < maxX; ++x) {
+      out[std::size_t{by * 4 + y} * width + bx * 4 + x] = block[y * 4 + x];
+    }
+  }
+}
+
+} // namespace
+
+bool decode(Format format, std::span<const std::byte> blocks, uint32_t width,
+            uint32_t height, void *out) {
+  assert(out && width > 0 && height > 0);
+  if (blocks.size() < calcCompressedSize(format, width, height)) return false;
+
+  const auto blockSize = getBlockSize(format);
+  const auto *src = blocks.data();
+  for (auto by = 0u; by < calcNumBlocks(height); ++by) {
+    for (auto bx = 0u; bx < calcNumBlocks(width); ++bx, src += blockSize) {
+      if (format == Format::BC6H) {
+        DecodedBlock<RGBA32F> block;
+        if (!decodeBC6HBlock(src, block)) return false;
+        storeBlock(block, bx, by, width, height,
+                   static_cast<RGBA32F *>(out));
+        continue;
+      }
+
+      DecodedBlock<RGBA8> block;
+      switch (format) {
+        using enum Format;
+
+      case BC1:
+        decodeBC1Block(src, false, block);
+        break;
+      case BC3:
+        decodeBC1Block(src + 8, true, block);
+        decodeBC4Block(src, block, 3);
+        break;
+      case BC4:
+        block.fill({0, 0, 0, 255});
+        decodeBC4Block(src, block, 0);
+        break;
+      case BC5:
+        block.fill({0, 0, 0, 255});
+        decodeBC4Block(src, block, 0);
+        decodeBC4Block(src + 8, block, 1);
+        break;
+      case BC7:
+        if (!decodeBC7Block(src, block)) return false;
+        break;
+
+      default:
+        assert(false);
+        return false;
+      }
+      storeBlock(block, bx, by, width, height, static_cast<RGBA8 *>(out));
+    }
+  }
+  return true;
+}
+
+} // namespace bc
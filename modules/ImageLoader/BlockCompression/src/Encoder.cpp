@@ -0,0 +1,574 @@
+#include "bc/BlockCompression.hpp"
+#include "BitStream.hpp"
+#include "Tables.hpp"
+#include "Half.hpp"
+
+#include <algorithm> // clamp, minmax_element
+#include <cmath>     // sqrt, round
+#include <limits>
+#include <cassert>
+
+namespace bc {
+
+namespace {
+
+template <std::size_t N> using Vec = std::array<float, N>;
+
+template <std::size_t N> struct Block {
+  Vec<N> pixels[16];
+};
+
+template <std::size_t N> [[nodiscard]] float dot(const Vec<N> &a, const Vec<N> &b) {
+  auto result = 0.0f;
+  for (auto i = 0u; i < N; ++i)
+    result += a[i] * b[i];
+  return result;
+}
+template <std::size_t N>
+[[nodiscard]] float distance2(const Vec<N> &a, const Vec<N> &b) {
+  auto result = 0.0f;
+  for (auto i = 0u; i < N; ++i)
+    result += (a[i] - b[i]) * (a[i] - b[i]);
+  return result;
+}
+
+// Fetches a 4x4 block, pixels outside of the image are clamped to the edge.
+template <std::size_t N, typename T>
+[[nodiscard]] auto fetchBlock(const T *pixels, uint32_t width, uint32_t height,
+                              uint32_t bx, uint32_t by,
+                              std::array<uint32_t, N> channels) {
+  Block<N> block;
+  for (auto y = 0u; y < 4; ++y) {
+    const auto py = std::min(by * 4 + y, height - 1);
+    for (auto x = 0u; x < 4; ++x) {
+      const auto px = std::min(bx * 4 + x, width - 1);
+      const auto *src = pixels + (std::size_t{py} * width + px) * 4;
+      for (auto c = 0u; c < N; ++c)
+        block.pixels[y * 4 + x][c] = float(src[channels[c]]);
+    }
+  }
+  return block;
+}
+
+// @return Endpoints along the principal axis of the given pixels.
+template <std::size_t N>
+[[nodiscard]] std::pair<Vec<N>, Vec<N>> findEndpoints(const Block<N> &block) {
+  Vec<N> mean{};
+  for (const auto &p : block.pixels)
+    for (auto c = 0u; c < N; ++c)
+      mean[c] += p[c] / 16.0f;
+
+  float covariance[N][N]{};
+  for (const auto &p : block.pixels)
+    for (auto i = 0u; i < N; ++i)
+      for (auto j = 0u; j < N; ++j)
+        covariance[i][j] += (p[i] - mean[i]) * (p[j] - mean[j]);
+
+  // Power iteration.
+  Vec<N> axis;
+  axis.fill(1.0f);
+  for (auto iteration = 0; iteration < 8; ++iteration) {
+    Vec<N> next{};
+    for (auto i = 0u; i < N; ++i)
+      for (auto j = 0u; j < N; ++j)
+        next[i] += covariance[i][j] * axis[j];
+
+    const auto length = std::sqrt(dot(next, next));
+    if (length < 1e-6f) break;
+    for (auto i = 0u; i < N; ++i)
+      axis[i] = next[i] / length;
+  }
+
+  auto minT = 0.0f;
+  auto maxT = 0.0f;
+  for (const auto &p : block.pixels) {
+    Vec<N> d;
+    for (auto c = 0u; c < N; ++c)
+      d[c] = p[c] - mean[c];
+    const auto t = dot(d, axis);
+    minT = std::min(minT, t);
+    maxT = std::max(maxT, t);
+  }
+  // Inset the bounding line (reduces the error of a palette with few entries).
+  const auto inset = (maxT - minT) / 32.0f;
+  minT += inset;
+  maxT -= inset;
+
+  std::pair<Vec<N>, Vec<N>> endpoints;
+  for (auto c = 0u; c < N; ++c) {
+    endpoints.first[c] = mean[c] + axis[c] * minT;
+    endpoints.second[c] = mean[c] + axis[c] * maxT;
+  }
+  return endpoints;
+}
+
+// Least squares fit of endpoints, given a weight (in [0, 1]) for each pixel.
+template <std::size_t N>
+[[nodiscard]] bool refineEndpoints(const Block<N> &block, const float *weights,
+                                   std::pair<Vec<N>, Vec<N>> &endpoints) {
+  auto aa = 0.0f;
+  auto ab = 0.0f;
+  auto bb = 0.0f;
+  Vec<N> ax{};
+  Vec<N> bx{};
+  for (auto i = 0u; i < 16; ++i) {
+    const auto b = weights[i];
+    const auto a = 1.0f - b;
+    aa += a * a;
+    ab += a * b;
+    bb += b * b;
+    for (auto c = 0u; c < N; ++c) {
+      ax[c] += a * block.pixels[i][c];
+      bx[c] += b * block.pixels[i][c];
+    }
+  }
+  const auto det = aa * bb - ab * ab;
+  if (std::abs(det) < 1e-6f) return false;
+
+  const auto invDet = 1.0f / det;
+  for (auto c = 0u; c < N; ++c) {
+    endpoints.first[c] = (ax[c] * bb - bx[c] * ab) * invDet;
+    endpoints.second[c] = (bx[c] * aa - ax[c] * ab) * invDet;
+  }
+  return true;
+}
+
+//
+// BC1:
+//
+
+[[nodiscard]] uint16_t packRGB565(const Vec<3> &color) {
+  const auto quantize = [](float v, float maxValue) {
+    return uint16_t(std::clamp(std::round(v * maxValue / 255.0f), 0.0f, maxValue));
+  };
+  return quantize(color[0], 31) << 11 | quantize(color[1], 63) << 5 |
+         quantize(color[2], 31);
+}
+[[nodiscard]] Vec<3> unpackRGB565(uint16_t c) {
+  const auto r = (c >> 11) & 31;
+  const auto g = (c >> 5) & 63;
+  const auto b = c & 31;
+  return {
+    float(r << 3 | r >> 2),
+    float(g << 2 | g >> 4),
+    float(b << 3 | b >> 2),
+  };
+}
+
+struct ColorBlockResult {
+  uint16_t c0;
+  uint16_t c1;
+  uint32_t indices;
+  float error;
+};
+
+[[nodiscard]] ColorBlockResult
+encodeColorBlock(const Block<3> &block, const bool *transparent,
+                 std::pair<Vec<3>, Vec<3>> endpoints) {
+  const auto punchThrough = transparent != nullptr;
+
+  ColorBlockResult result{
+    .c0 = packRGB565(endpoints.second),
+    .c1 = packRGB565(endpoints.first),
+    .indices = 0,
+    .error = 0.0f,
+  };
+  // 4 color mode requires c0 > c1, 3 color mode (punch-through): c0 <= c1.
+  if ((result.c0 < result.c1) != punchThrough &&
+      result.c0 != result.c1) {
+    std::swap(result.c0, result.c1);
+  }
+
+  const auto e0 = unpackRGB565(result.c0);
+  const auto e1 = unpackRGB565(result.c1);
+
+  Vec<3> palette[4]{e0, e1};
+  for (auto c = 0u; c < 3; ++c) {
+    if (result.c0 > result.c1) {
+      palette[2][c] = (2.0f * e0[c] + e1[c]) / 3.0f;
+      palette[3][c] = (e0[c] + 2.0f * e1[c]) / 3.0f;
+    } else {
+      palette[2][c] = (e0[c] + e1[c]) / 2.0f;
+      palette[3][c] = 0.0f;
+    }
+  }
+  const auto numColors = result.c0 > result.c1 ? 4u : 3u;
+
+  result.indices = 0;
+  result.error = 0.0f;
+  for (auto i = 0u; i < 16; ++i) {
+    auto bestIndex = 0u;
+    if (punchThrough && transparent[i]) {
+      bestIndex = 3;
+    } else {
+      auto bestError = distance2(block.pixels[i], palette[0]);
+      for (auto j = 1u; j < numColors; ++j) {
+        if (const auto error = distance2(block.pixels[i], palette[j]);
+            error < bestError) {
+          bestError = error;
+          bestIndex = j;
+        }
+      }
+      result.error += bestError;
+    }
+    result.indices |= bestIndex << (i * 2);
+  }
+  return result;
+}
+
+void encodeBC1Block(const Block<4> &rgba, bool allowPunchThrough,
+                    std::byte *dst) {
+  Block<3> block;
+  bool transparent[16];
+  auto anyTransparent = false;
+  for (auto i = 0u; i < 16; ++i) {
+    std::copy_n(rgba.pixels[i].cbegin(), 3, block.pixels[i].begin());
+    transparent[i] = rgba.pixels[i][3] < 128.0f;
+    anyTransparent |= transparent[i];
+  }
+  const auto punchThrough = allowPunchThrough && anyTransparent;
+
+  auto endpoints = findEndpoints(block);
+  auto best = encodeColorBlock(block, punchThrough ? transparent : nullptr,
+                               endpoints);
+  if (!punchThrough && best.c0 > best.c1) {
+    // Index -> interpolation weight of c0 (4 color mode).
+    constexpr float kWeights[]{1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+    endpoints = {unpackRGB565(best.c1), unpackRGB565(best.c0)};
+    float weights[16];
+    for (auto i = 0u; i < 16; ++i)
+      weights[i] = kWeights[(best.indices >> (i * 2)) & 3];
+    if (refineEndpoints(block, weights, endpoints)) {
+      if (const auto refined = encodeColorBlock(block, nullptr, endpoints);
+          refined.error < best.error) {
+        best = refined;
+      }
+    }
+  }
+
+  std::memcpy(dst, &best.c0, 2);
+  std::memcpy(dst + 2, &best.c1, 2);
+  std::memcpy(dst + 4, &best.indices, 4);
+}
+
+//
+// BC4:
+//
+
+void encodeBC4Block(const float *values, std::byte *dst) {
+  const auto [minIt, maxIt] = std::minmax_element(values, values + 16);
+  const auto e0 = uint8_t(std::round(*maxIt));
+  const auto e1 = uint8_t(std::round(*minIt));
+
+  // 8 value mode (e0 > e1).
+  float palette[8]{float(e0), float(e1)};
+  for (auto i = 1u; i < 7; ++i)
+    palette[i + 1] = ((7.0f - i) * e0 + float(i) * e1) / 7.0f;
+
+  uint64_t indices{0};
+  if (e0 != e1) {
+    for (auto i = 0u; i < 16; ++i) {
+      auto bestIndex = 0ull;
+      auto bestError = std::abs(values[i] - palette[0]);
+      for (auto j = 1u; j < 8; ++j) {
+        if (const auto error = std::abs(values[i] - palette[j]);
+            error < bestError) {
+          bestError = error;
+          bestIndex = j;
+        }
+      }
+      indices |= bestIndex << (i * 3);
+    }
+  }
+  dst[0] = std::byte{e0};
+  dst[1] = std::byte{e1};
+  for (auto i = 0u; i < 6; ++i)
+    dst[2 + i] = std::byte((indices >> (i * 8)) & 0xFF);
+}
+
+//
+// BC7 (mode 6 only: single subset, RGBA 7.7.7.7 + p-bit, 4-bit indices):
+//
+
+struct BC7Endpoint {
+  uint8_t value[4]; // 7 bits.
+  uint8_t pBit;
+};
+
+[[nodiscard]] BC7Endpoint quantizeBC7Endpoint(const Vec<4> &color) {
+  BC7Endpoint best{};
+  auto bestError = std::numeric_limits<float>::max();
+  for (auto p = 0u; p < 2; ++p) {
+    BC7Endpoint candidate{.value = {}, .pBit = uint8_t(p)};
+    auto error = 0.0f;
+    for (auto c = 0u; c < 4; ++c) {
+      const auto q = std::clamp(std::round((color[c] - p) / 2.0f), 0.0f, 127.0f);
+      candidate.value[c] = uint8_t(q);
+      const auto reconstructed = float(uint32_t(q) << 1 | p);
+      error += (reconstructed - color[c]) * (reconstructed - color[c]);
+    }
+    if (error < bestError) {
+      bestError = error;
+      best = candidate;
+    }
+  }
+  return best;
+}
+[[nodiscard]] Vec<4> unquantize(const BC7Endpoint &e) {
+  Vec<4> color;
+  for (auto c = 0u; c < 4; ++c)
+    color[c] = float(e.value[c] << 1 | e.pBit);
+  return color;
+}
+
+struct BC7Result {
+  BC7Endpoint e0;
+  BC7Endpoint e1;
+  uint8_t indices[16];
+  float error;
+};
+
+[[nodiscard]] BC7Result
+encodeBC7Mode6(const Block<4> &block,
+               const std::pair<Vec<4>, Vec<4>> &endpoints) {
+  BC7Result result{
+    .e0 = quantizeBC7Endpoint(endpoints.first),
+    .e1 = quantizeBC7Endpoint(endpoints.second),
+    .indices = {},
+    .error = 0.0f,
+  };
+  const auto e0 = unquantize(result.e0);
+  const auto e1 = unquantize(result.e1);
+
+  Vec<4> palette[16];
+  for (auto i = 0u; i < 16; ++i) {
+    const auto w = uint32_t(kWeights4[i]);
+    for (auto c = 0u; c < 4; ++c) {
+      palette[i][c] =
+        float(((64 - w) * uint32_t(e0[c]) + w * uint32_t(e1[c]) + 32) >> 6);
+    }
+  }
+  for (auto i = 0u; i < 16; ++i) {
+    auto bestIndex = 0u;
+    auto bestError = distance2(block.pixels[i], palette[0]);
+    for (auto j = 1u; j < 16; ++j) {
+      if (const auto error = distance2(block.pixels[i], palette[j]);
+          error < bestError) {
+        bestError = error;
+        bestIndex = j;
+      }
+    }
+    result.indices[i] = uint8_t(bestIndex);
+    result.error += bestError;
+  }
+  // The MSB of the anchor index is implicitly 0.
+  if (result.indices[0] & 8) {
+    std::swap(result.e0, result.e1);
+    for (auto &index : result.indices)
+      index = 15 - index;
+  }
+  return result;
+}
+
+void encodeBC7Block(const Block<4> &block, std::byte *dst) {
+  auto endpoints = findEndpoints(block);
+  auto best = encodeBC7Mode6(block, endpoints);
+
+  float weights[16];
+  for (auto i = 0u; i < 16; ++i)
+    weights[i] = kWeights4[best.indices[i]] / 64.0f;
+  // Endpoints might have been swapped (anchor fixup).
+  endpoints = {unquantize(best.e0), unquantize(best.e1)};
+  if (refineEndpoints(block, weights, endpoints)) {
+    if (const auto refined = encodeBC7Mode6(block, endpoints);
+        refined.error < best.error) {
+      best = refined;
+    }
+  }
+
+  BitWriter writer;
+  writer.write(1 << 6, 7);
+  for (auto c = 0u; c < 4; ++c) {
+    writer.write(best.e0.value[c], 7);
+    writer.write(best.e1.value[c], 7);
+  }
+  writer.write(best.e0.pBit, 1);
+  writer.write(best.e1.pBit, 1);
+  for (auto i = 0u; i < 16; ++i)
+    writer.write(best.indices[i], i == 0 ? 3 : 4);
+  assert(writer.getPosition() == 128);
+  writer.copyTo(dst);
+}
+
+//
+// BC6H (mode 11 only: single region, 10-bit endpoints, 4-bit indices):
+//
+
+// BC6H interpolates (unsigned) half-float bit patterns, scaled by 64/31.
+[[nodiscard]] float toInterpolationSpace(float v) {
+  return float(toHalf(std::clamp(v, 0.0f, 65504.0f))) * 64.0f / 31.0f;
+}
+[[nodiscard]] uint32_t quantizeBC6H(float v) {
+  // Inverse of: ((q << 16) + 0x8000) >> 10
+  return uint32_t(std::clamp(std::round((v * 1024.0f - 32768.0f) / 65536.0f),
+                             0.0f, 1023.0f));
+}
+[[nodiscard]] uint32_t unquantizeBC6H(uint32_t q) {
+  if (q == 0) return 0;
+  if (q == 1023) return 0xFFFF;
+  return ((q << 16) + 0x8000) >> 10;
+}
+
+void encodeBC6HBlock(const Block<3> &block, std::byte *dst) {
+  Block<3> transformed;
+  for (auto i = 0u; i < 16; ++i)
+    for (auto c = 0u; c < 3; ++c)
+      transformed.pixels[i][c] = toInterpolationSpace(block.pixels[i][c]);
+
+  const auto encode = [&transformed](const std::pair<Vec<3>, Vec<3>> &e,
+                                     uint32_t(&q)[2][3], uint8_t(&indices)[16]) {
+    Vec<3> endpoints[2];
+    for (auto c = 0u; c < 3; ++c) {
+      q[0][c] = quantizeBC6H(e.first[c]);
+      q[1][c] = quantizeBC6H(e.second[c]);
+      endpoints[0][c] = float(unquantizeBC6H(q[0][c]));
+      endpoints[1][c] = float(unquantizeBC6H(q[1][c]));
+    }
+    Vec<3> palette[16];
+    for (auto i = 0u; i < 16; ++i) {
+      const auto w = float(kWeights4[i]);
+      for (auto c = 0u; c < 3; ++c)
+        palette[i][c] = (endpoints[0][c] * (64.0f - w) + endpoints[1][c] * w) / 64.0f;
+    }
+    auto totalError = 0.0f;
+    for (auto i = 0u; i < 16; ++i) {
+      auto bestIndex = 0u;
+      auto bestError = distance2(transformed.pixels[i], palette[0]);
+      for (auto j = 1u; j < 16; ++j) {
+        if (const auto error = distance2(transformed.pixels[i], palette[j]);
+            error < bestError) {
+          bestError = error;
+          bestIndex = j;
+        }
+      }
+      indices[i] = uint8_t(bestIndex);
+      totalError += bestError;
+    }
+    return totalError;
+  };
+
+  auto endpoints = findEndpoints(transformed);
+  uint32_t q[2][3];
+  uint8_t indices[16];
+  const auto error = encode(endpoints, q, indices);
+
+  float weights[16];
+  for (auto i = 0u; i < 16; ++i)
+    weights[i] = kWeights4[indices[i]] / 64.0f;
+  if (refineEndpoints(transformed, weights, endpoints)) {
+    uint32_t refinedQ[2][3];
+    uint8_t refinedIndices[16];
+    if (encode(endpoints, refinedQ, refinedIndices) < error) {
+      std::memcpy(q, refinedQ, sizeof(q));
+      std::memcpy(indices, refinedIndices, sizeof(indices));
+    }
+  }
+  if (indices[0] & 8) {
+    std::swap(q[0], q[1]);
+    for (auto &index : indices)
+      index = 15 - index;
+  }
+
+  BitWriter writer;
+  writer.write(0b00011, 5);
+  for (auto e = 0u; e < 2; ++e)
+    for (auto c = 0u; c < 3; ++c)
+      writer.write(q[e][c], 10);
+  for (auto i = 0u; i < 16; ++i)
+    writer.write(indices[i], i == 0 ? 3 : 4);
+  assert(writer.getPosition() == 128);
+  writer.copyTo(dst);
+}
+
+template <typename T, typename Func>
+void forEachBlock(Format format, const T *pixels, uint32_t width,
+                  uint32_t height, std::vector<std::byte> &out, Func encoder) {
+  const auto blockSize = getBlockSize(format);
+  auto *dst = out.data();
+  for (auto by = 0u; by < calcNumBlocks(height); ++by) {
+    for (auto bx = 0u; bx < calcNumBlocks(width); ++bx) {
+      encoder(pixels, bx, by, dst);
+      dst += blockSize;
+    }
+  }
+}
+
+} // namespace
+
+std::vector<std::byte> encode(Format format, const void *pixels, uint32_t width,
+                              uint32_t height) {
+  assert(pixels && width > 0 && height > 0);
+
+  std::vector<std::byte> out(calcCompressedSize(format, width, height));
+  if (isHDR(format)) {
+    forEachBlock(format, static_cast<const float *>(pixels), width, height, out,
+                 [width, height](const float *src, uint32_t bx, uint32_t by,
+                                 std::byte *dst) {
+                   encodeBC6HBlock(
+                     fetchBlock<3>(src, width, height, bx, by, {0, 1, 2}), dst);
+                 });
+    return out;
+  }
+
+  const auto *src = static_cast<const uint8_t *>(pixels);
+  forEachBlock(
+    format, src, width, height, out,
+    [format, width, height](const uint8_t *src, uint32_t bx, uint32_t by,
+                            std::byte *dst) {
+      switch (format) {
+        using enum Format;
+
+      case BC1:
+        encodeBC1Block(fetchBlock<4>(src, width, height, bx, by, {0, 1, 2, 3}),
+                       true, dst);
+        break;
+      case BC3: {
+        const auto block =
+          fetchBlock<4>(src, width, height, bx, by, {0, 1, 2, 3});
+        float alpha[16];
+        for (auto i = 0u; i < 16; ++i)
+          alpha[i] = block.pixels[i][3];
+        encodeBC4Block(alpha, dst);
+        encodeBC1Block(block, false, dst + 8);
+      } break;
+      case BC4: {
+        const auto block = fetchBlock<1>(src, width, height, bx, by, {0});
+        float red[16];
+        for (auto i = 0u; i < 16; ++i)
+          red[i] = block.pixels[i][0];
+        encodeBC4Block(red, dst);
+      } break;
+      case BC5: {
+        const auto block = fetchBlock<2>(src, width, height, bx, by, {0, 1});
+        float red[16];
+        float green[16];
+        for (auto i = 0u; i < 16; ++i) {
+          red[i] = block.pixels[i][0];
+          green[i] = block.pixels[i][1];
+        }
+        encodeBC4Block(red, dst);
+        encodeBC4Block(green, dst + 8);
+      } break;
+      case BC7:
+        encodeBC7Block(fetchBlock<4>(src, width, height, bx, by, {0, 1, 2, 3}),
+                       dst);
+        break;
+
+      default:
+        assert(false);
+      }
+    });
+  return out;
+}
+
+} // namespace bc
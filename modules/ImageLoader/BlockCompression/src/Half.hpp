@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <algorithm> // min
+#include <bit>       // bit_cast
+
+namespace bc {
+
+// IEEE 754 binary16 <-> binary32, round to nearest even.
+// Denormals are flushed to zero, NaN/Inf are not expected (BC6H can't store
+// them).
+
+[[nodiscard]] inline uint16_t toHalf(float f) {
+  const auto bits = std::bit_cast<uint32_t>(f);
+  const auto sign = uint16_t((bits >> 16) & 0x8000);
+  const auto exponent = int32_t((bits >> 23) & 0xFF) - 127 + 15;
+  auto mantissa = bits & 0x007FFFFF;
+
+  if (exponent <= 0) return sign;
+  if (exponent >= 31) return sign | 0x7BFF;
+
+  auto half = uint32_t(exponent) << 10 | mantissa >> 13;
+  const auto remainder = mantissa & 0x1FFF;
+  if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) ++half;
+  return sign | uint16_t(std::min(half, 0x7BFFu));
+}
+[[nodiscard]] inline float fromHalf(uint16_t h) {
+  const auto sign = uint32_t(h & 0x8000) << 16;
+  const auto exponent = (h >> 10) & 0x1F;
+  const auto mantissa = uint32_t(h & 0x03FF);
+
+  if (exponent == 0) {
+    if (mantissa == 0) return std::bit_cast<float>(sign);
+    // Denormal.
+    return (sign ? -1.0f : 1.0f) * float(mantissa) / float(1 << 24);
+  }
+  if (exponent == 31) {
+    return std::bit_cast<float>(sign | 0x7F800000 | mantissa << 13);
+  }
+  return std::bit_cast<float>(sign | uint32_t(exponent - 15 + 127) << 23 |
+                              mantissa << 13);
+}
+
+} // namespace bc
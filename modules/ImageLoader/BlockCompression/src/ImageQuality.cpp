@@ -0,0 +1,40 @@
+#include "bc/ImageQuality.hpp"
+#include <limits>
+#include <cmath> // log10
+#include <cassert>
+
+namespace bc {
+
+namespace {
+
+template <typename T>
+[[nodiscard]] double calcMSE(std::span<const T> a, std::span<const T> b,
+                             uint32_t numChannels) {
+  assert(a.size() == b.size() && numChannels > 0 && numChannels <= 4);
+
+  auto sum = 0.0;
+  for (auto i = 0u; i < a.size(); i += 4) {
+    for (auto c = 0u; c < numChannels; ++c) {
+      const auto d = double(a[i + c]) - double(b[i + c]);
+      sum += d * d;
+    }
+  }
+  return sum / double(a.size() / 4 * numChannels);
+}
+[[nodiscard]] double toPSNR(double mse, double peak) {
+  return mse > 0.0 ? 10.0 * std::log10(peak * peak / mse)
+                   : std::numeric_limits<double>::infinity();
+}
+
+} // namespace
+
+double calcPSNR(std::span<const uint8_t> a, std::span<const uint8_t> b,
+                uint32_t numChannels) {
+  return toPSNR(calcMSE(a, b, numChannels), 255.0);
+}
+double calcPSNR(std::span<const float> a, std::span<const float> b, float peak,
+                uint32_t numChannels) {
+  return toPSNR(calcMSE(a, b, numChannels), peak);
+}
+
+} // namespace bc
@@ -0,0 +1,285 @@
+#pragma once
+
+#include <cstdint>
+#include <array>
+
+// https://learn.microsoft.com/en-us/windows/win32/direct3d11/bc7-format-mode-reference
+
+namespace bc {
+
+struct BC7ModeInfo {
+  uint8_t numSubsets;
+  uint8_t partitionBits;
+  uint8_t rotationBits;
+  uint8_t indexSelectionBits;
+  uint8_t colorBits;
+  uint8_t alphaBits;
+  uint8_t endpointPBits; // Unique p-bit per endpoint.
+  uint8_t sharedPBits;   // Shared p-bit per subset.
+  uint8_t indexBits;
+  uint8_t secondaryIndexBits;
+};
+
+// clang-format off
+inline constexpr std::array<BC7ModeInfo, 8> kBC7Modes{{
+  {3, 4, 0, 0, 4, 0, 1, 0, 3, 0},
+  {2, 6, 0, 0, 6, 0, 0, 1, 3, 0},
+  {3, 6, 0, 0, 5, 0, 0, 0, 2, 0},
+  {2, 6, 0, 0, 7, 0, 1, 0, 2, 0},
+  {1, 0, 2, 1, 5, 6, 0, 0, 2, 3},
+  {1, 0, 2, 0, 7, 8, 0, 0, 2, 2},
+  {1, 0, 0, 0, 7, 7, 1, 0, 4, 0},
+  {2, 6, 0, 0, 5, 5, 1, 0, 2, 0},
+}};
+
+inline constexpr uint8_t kWeights2[]{0, 21, 43, 64};
+inline constexpr uint8_t kWeights3[]{0, 9, 18, 27, 37, 46, 55, 64};
+inline constexpr uint8_t kWeights4[]{
+  0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64,
+};
+
+// Bit N = subset of the N-th pixel.
+inline constexpr uint16_t kPartitions2[64]{
+  0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+  0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+  0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+  0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+  0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+  0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+  0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+  0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+};
+
+inline constexpr uint8_t kPartitions3[64][16]{
+  {0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 1, 2, 2, 2, 2},
+  {0, 0, 0, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 2, 1},
+  {0, 0, 0, 0, 2, 0, 0, 1, 2, 2, 1, 1, 2, 2, 1, 1},
+  {0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 1, 0, 1, 1, 1},
+  {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2},
+  {0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 2, 2},
+  {0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1},
+  {0, 0, 1, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1},
+  {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2},
+  {0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2},
+  {0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2},
+  {0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2},
+  {0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2},
+  {0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2},
+  {0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2, 1, 2, 2, 2},
+  {0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0, 2, 2, 2, 0},
+  {0, 0, 0, 1, 0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2},
+  {0, 1, 1, 1, 0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0},
+  {0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2},
+  {0, 0, 2, 2, 0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1},
+  {0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2, 0, 2, 2, 2},
+  {0, 0, 0, 1, 0, 0, 0, 1, 2, 2, 2, 1, 2, 2, 2, 1},
+  {0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2},
+  {0, 0, 0, 0, 1, 1, 0, 0, 2, 2, 1, 0, 2, 2, 1, 0},
+  {0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1, 0, 0, 0, 0},
+  {0, 0, 1, 2, 0, 0, 1, 2, 1, 1, 2, 2, 2, 2, 2, 2},
+  {0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1, 0, 1, 1, 0},
+  {0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1},
+  {0, 0, 2, 2, 1, 1, 0, 2, 1, 1, 0, 2, 0, 0, 2, 2},
+  {0, 1, 1, 0, 0, 1, 1, 0, 2, 0, 0, 2, 2, 2, 2, 2},
+  {0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1},
+  {0, 0, 0, 0, 2, 0, 0, 0, 2, 2, 1, 1, 2, 2, 2, 1},
+  {0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 2, 2, 2},
+  {0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 2, 0, 0, 1, 1},
+  {0, 0, 1, 1, 0, 0, 1, 2, 0, 0, 2, 2, 0, 2, 2, 2},
+  {0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0},
+  {0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0},
+  {0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0},
+  {0, 1, 2, 0, 2, 0, 1, 2, 1, 2, 0, 1, 0, 1, 2, 0},
+  {0, 0, 1, 1, 2, 2, 0, 0, 1, 1, 2, 2, 0, 0, 1, 1},
+  {0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0, 1, 1},
+  {0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2},
+  {0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1},
+  {0, 0, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2, 1, 1, 2, 2},
+  {0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 1, 1},
+  {0, 2, 2, 0, 1, 2, 2, 1, 0, 2, 2, 0, 1, 2, 2, 1},
+  {0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 0, 1, 0, 1},
+  {0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1},
+  {0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2},
+  {0, 2, 2, 2, 0, 1, 1, 1, 0, 2, 2, 2, 0, 1, 1, 1},
+  {0, 0, 0, 2, 1, 1, 1, 2, 0, 0, 0, 2, 1, 1, 1, 2},
+  {0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2},
+  {0, 2, 2, 2, 0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2},
+  {0, 0, 0, 2, 1, 1, 1, 2, 1, 1, 1, 2, 0, 0, 0, 2},
+  {0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2},
+  {0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2},
+  {0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2, 2, 2, 2, 2},
+  {0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2},
+  {0, 0, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2},
+  {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2},
+  {0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1},
+  {0, 2, 2, 2, 1, 2, 2, 2, 0, 2, 2, 2, 1, 2, 2, 2},
+  {0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+  {0, 1, 1, 1, 2, 0, 1, 1, 2, 2, 0, 1, 2, 2, 2, 0},
+};
+
+// Anchor index of the 2nd subset (2 subsets).
+inline constexpr uint8_t kAnchors2[64]{
+  15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+  15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+  15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+   6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15,
+};
+// Anchor index of the 2nd subset (3 subsets).
+inline constexpr uint8_t kAnchors3_2[64]{
+   3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+   3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+   8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+   3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3,
+};
+// Anchor index of the 3rd subset (3 subsets).
+inline constexpr uint8_t kAnchors3_3[64]{
+  15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+  15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+  15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+  15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8,
+};
+// clang-format on
+
+// https://learn.microsoft.com/en-us/windows/win32/direct3d11/bc6h-format
+
+namespace bc6h {
+
+// Endpoints of the 1st (W, X) and 2nd (Y, Z) region.
+enum Endpoint : uint8_t { W, X, Y, Z };
+enum Channel : uint8_t { R, G, B };
+
+// Bits [shift, shift + numBits) of an endpoint channel, stored in the block
+// in that order (after the mode bits).
+struct Field {
+  uint8_t endpoint;
+  uint8_t channel;
+  uint8_t shift;
+  uint8_t numBits;
+};
+
+struct ModeInfo {
+  uint8_t value; // 2 or 5 bits.
+  uint8_t numRegions;
+  bool transformed; // X, Y, Z are stored as deltas from W.
+  uint8_t endpointBits;
+  std::array<uint8_t, 3> deltaBits;
+  uint8_t numFields;
+  std::array<Field, 24> fields;
+};
+
+// clang-format off
+inline constexpr std::array<ModeInfo, 14> kModes{{
+  {0b00, 2, true, 10, {5, 5, 5}, 19, {{
+    {Y, G, 4, 1}, {Y, B, 4, 1}, {Z, B, 4, 1}, {W, R, 0, 10}, {W, G, 0, 10},
+    {W, B, 0, 10}, {X, R, 0, 5}, {Z, G, 4, 1}, {Y, G, 0, 4}, {X, G, 0, 5},
+    {Z, B, 0, 1}, {Z, G, 0, 4}, {X, B, 0, 5}, {Z, B, 1, 1}, {Y, B, 0, 4},
+    {Y, R, 0, 5}, {Z, B, 2, 1}, {Z, R, 0, 5}, {Z, B, 3, 1},
+  }}},
+  {0b01, 2, true, 7, {6, 6, 6}, 23, {{
+    {Y, G, 5, 1}, {Z, G, 4, 1}, {Z, G, 5, 1}, {W, R, 0, 7}, {Z, B, 0, 1},
+    {Z, B, 1, 1}, {Y, B, 4, 1}, {W, G, 0, 7}, {Y, B, 5, 1}, {Z, B, 2, 1},
+    {Y, G, 4, 1}, {W, B, 0, 7}, {Z, B, 3, 1}, {Z, B, 5, 1}, {Z, B, 4, 1},
+    {X, R, 0, 6}, {Y, G, 0, 4}, {X, G, 0, 6}, {Z, G, 0, 4}, {X, B, 0, 6},
+    {Y, B, 0, 4}, {Y, R, 0, 6}, {Z, R, 0, 6},
+  }}},
+  {0b00010, 2, true, 11, {5, 4, 4}, 18, {{
+    {W, R, 0, 10}, {W, G, 0, 10}, {W, B, 0, 10}, {X, R, 0, 5}, {W, R, 10, 1},
+    {Y, G, 0, 4}, {X, G, 0, 4}, {W, G, 10, 1}, {Z, B, 0, 1}, {Z, G, 0, 4},
+    {X, B, 0, 4}, {W, B, 10, 1}, {Z, B, 1, 1}, {Y, B, 0, 4}, {Y, R, 0, 5},
+    {Z, B, 2, 1}, {Z, R, 0, 5}, {Z, B, 3, 1},
+  }}},
+  {0b00110, 2, true, 11, {4, 5, 4}, 20, {{
+    {W, R, 0, 10}, {W, G, 0, 10}, {W, B, 0, 10}, {X, R, 0, 4}, {W, R, 10, 1},
+    {Z, G, 4, 1}, {Y, G, 0, 4}, {X, G, 0, 5}, {W, G, 10, 1}, {Z, G, 0, 4},
+    {X, B, 0, 4}, {W, B, 10, 1}, {Z, B, 1, 1}, {Y, B, 0, 4}, {Y, R, 0, 4},
+    {Z, B, 0, 1}, {Z, B, 2, 1}, {Z, R, 0, 4}, {Y, G, 4, 1}, {Z, B, 3, 1},
+  }}},
+  {0b01010, 2, true, 11, {4, 4, 5}, 20, {{
+    {W, R, 0, 10}, {W, G, 0, 10}, {W, B, 0, 10}, {X, R, 0, 4}, {W, R, 10, 1},
+    {Y, B, 4, 1}, {Y, G, 0, 4}, {X, G, 0, 4}, {W, G, 10, 1}, {Z, B, 0, 1},
+    {Z, G, 0, 4}, {X, B, 0, 5}, {W, B, 10, 1}, {Y, B, 0, 4}, {Y, R, 0, 4},
+    {Z, B, 1, 1}, {Z, B, 2, 1}, {Z, R, 0, 4}, {Z, B, 4, 1}, {Z, B, 3, 1},
+  }}},
+  {0b01110, 2, true, 9, {5, 5, 5}, 19, {{
+    {W, R, 0, 9}, {Y, B, 4, 1}, {W, G, 0, 9}, {Y, G, 4, 1}, {W, B, 0, 9},
+    {Z, B, 4, 1}, {X, R, 0, 5}, {Z, G, 4, 1}, {Y, G, 0, 4}, {X, G, 0, 5},
+    {Z, B, 0, 1}, {Z, G, 0, 4}, {X, B, 0, 5}, {Z, B, 1, 1}, {Y, B, 0, 4},
+    {Y, R, 0, 5}, {Z, B, 2, 1}, {Z, R, 0, 5}, {Z, B, 3, 1},
+  }}},
+  {0b10010, 2, true, 8, {6, 5, 5}, 19, {{
+    {W, R, 0, 8}, {Z, G, 4, 1}, {Y, B, 4, 1}, {W, G, 0, 8}, {Z, B, 2, 1},
+    {Y, G, 4, 1}, {W, B, 0, 8}, {Z, B, 3, 1}, {Z, B, 4, 1}, {X, R, 0, 6},
+    {Y, G, 0, 4}, {X, G, 0, 5}, {Z, B, 0, 1}, {Z, G, 0, 4}, {X, B, 0, 5},
+    {Z, B, 1, 1}, {Y, B, 0, 4}, {Y, R, 0, 6}, {Z, R, 0, 6},
+  }}},
+  {0b10110, 2, true, 8, {5, 6, 5}, 21, {{
+    {W, R, 0, 8}, {Z, B, 0, 1}, {Y, B, 4, 1}, {W, G, 0, 8}, {Y, G, 5, 1},
+    {Y, G, 4, 1}, {W, B, 0, 8}, {Z, G, 5, 1}, {Z, B, 4, 1}, {X, R, 0, 5},
+    {Z, G, 4, 1}, {Y, G, 0, 4}, {X, G, 0, 6}, {Z, G, 0, 4}, {X, B, 0, 5},
+    {Z, B, 1, 1}, {Y, B, 0, 4}, {Y, R, 0, 5}, {Z, B, 2, 1}, {Z, R, 0, 5},
+    {Z, B, 3, 1},
+  }}},
+  {0b11010, 2, true, 8, {5, 5, 6}, 21, {{
+    {W, R, 0, 8}, {Z, B, 1, 1}, {Y, B, 4, 1}, {W, G, 0, 8}, {Y, B, 5, 1},
+    {Y, G, 4, 1}, {W, B, 0, 8}, {Z, B, 5, 1}, {Z, B, 4, 1}, {X, R, 0, 5},
+    {Z, G, 4, 1}, {Y, G, 0, 4}, {X, G, 0, 5}, {Z, B, 0, 1}, {Z, G, 0, 4},
+    {X, B, 0, 6}, {Y, B, 0, 4}, {Y, R, 0, 5}, {Z, B, 2, 1}, {Z, R, 0, 5},
+    {Z, B, 3, 1},
+  }}},
+  {0b11110, 2, false, 6, {6, 6, 6}, 23, {{
+    {W, R, 0, 6}, {Z, G, 4, 1}, {Z, B, 0, 1}, {Z, B, 1, 1}, {Y, B, 4, 1},
+    {W, G, 0, 6}, {Y, G, 5, 1}, {Y, B, 5, 1}, {Z, B, 2, 1}, {Y, G, 4, 1},
+    {W, B, 0, 6}, {Z, G, 5, 1}, {Z, B, 3, 1}, {Z, B, 5, 1}, {Z, B, 4, 1},
+    {X, R, 0, 6}, {Y, G, 0, 4}, {X, G, 0, 6}, {Z, G, 0, 4}, {X, B, 0, 6},
+    {Y, B, 0, 4}, {Y, R, 0, 6}, {Z, R, 0, 6},
+  }}},
+  {0b00011, 1, false, 10, {10, 10, 10}, 6, {{
+    {W, R, 0, 10}, {W, G, 0, 10}, {W, B, 0, 10}, {X, R, 0, 10}, {X, G, 0, 10},
+    {X, B, 0, 10},
+  }}},
+  {0b00111, 1, true, 11, {9, 9, 9}, 9, {{
+    {W, R, 0, 10}, {W, G, 0, 10}, {W, B, 0, 10}, {X, R, 0, 9}, {W, R, 10, 1},
+    {X, G, 0, 9}, {W, G, 10, 1}, {X, B, 0, 9}, {W, B, 10, 1},
+  }}},
+  {0b01011, 1, true, 12, {8, 8, 8}, 12, {{
+    {W, R, 0, 10}, {W, G, 0, 10}, {W, B, 0, 10}, {X, R, 0, 8}, {W, R, 11, 1},
+    {W, R, 10, 1}, {X, G, 0, 8}, {W, G, 11, 1}, {W, G, 10, 1}, {X, B, 0, 8},
+    {W, B, 11, 1}, {W, B, 10, 1},
+  }}},
+  {0b01111, 1, true, 16, {4, 4, 4}, 24, {{
+    {W, R, 0, 10}, {W, G, 0, 10}, {W, B, 0, 10}, {X, R, 0, 4}, {W, R, 15, 1},
+    {W, R, 14, 1}, {W, R, 13, 1}, {W, R, 12, 1}, {W, R, 11, 1}, {W, R, 10, 1},
+    {X, G, 0, 4}, {W, G, 15, 1}, {W, G, 14, 1}, {W, G, 13, 1}, {W, G, 12, 1},
+    {W, G, 11, 1}, {W, G, 10, 1}, {X, B, 0, 4}, {W, B, 15, 1}, {W, B, 14, 1},
+    {W, B, 13, 1}, {W, B, 12, 1}, {W, B, 11, 1}, {W, B, 10, 1},
+  }}},
+}};
+// clang-format on
+
+} // namespace bc6h
+
+[[nodiscard]] constexpr uint8_t getSubset(uint32_t numSubsets,
+                                          uint32_t partition, uint32_t pixel) {
+  switch (numSubsets) {
+  case 2:
+    return (kPartitions2[partition] >> pixel) & 1;
+  case 3:
+    return kPartitions3[partition][pixel];
+  default:
+    return 0;
+  }
+}
+[[nodiscard]] constexpr bool isAnchor(uint32_t numSubsets, uint32_t partition,
+                                      uint32_t pixel) {
+  if (pixel == 0) return true;
+  switch (numSubsets) {
+  case 2:
+    return pixel == kAnchors2[partition];
+  case 3:
+    return pixel == kAnchors3_2[partition] || pixel == kAnchors3_3[partition];
+  default:
+    return false;
+  }
+}
+
+} // namespace bc
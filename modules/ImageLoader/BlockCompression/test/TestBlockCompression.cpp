@@ -0,0 +1,268 @@
+#include "catch.hpp"
+
+#include "bc/BlockCompression.hpp"
+#include "bc/ImageQuality.hpp"
+
+#include <array>
+#include <cmath>
+#include <random>
+
+namespace {
+
+constexpr auto kWidth = 70u;
+constexpr auto kHeight = 45u; // Not a multiple of the block size.
+
+// Smooth gradients with a bit of noise, similar to a photographed texture.
+[[nodiscard]] std::vector<uint8_t> makeTestImage(uint32_t width,
+                                                 uint32_t height) {
+  std::mt19937 rng{1337};
+  std::uniform_int_distribution<int32_t> noise{-6, 6};
+
+  std::vector<uint8_t> pixels(std::size_t{width} * height * 4);
+  for (auto y = 0u; y < height; ++y) {
+    for (auto x = 0u; x < width; ++x) {
+      const auto u = float(x) / float(width);
+      const auto v = float(y) / float(height);
+      const float rgba[]{
+        255.0f * u,
+        255.0f * v,
+        127.5f + 127.5f * std::sin(6.0f * (u + v)),
+        255.0f * (1.0f - u * v),
+      };
+      auto *dst = pixels.data() + (std::size_t{y} * width + x) * 4;
+      for (auto c = 0; c < 4; ++c)
+        dst[c] = uint8_t(std::clamp(int32_t(rgba[c]) + noise(rng), 0, 255));
+    }
+  }
+  return pixels;
+}
+
+[[nodiscard]] std::vector<uint8_t>
+roundTrip(bc::Format format, const std::vector<uint8_t> &pixels,
+          uint32_t width, uint32_t height) {
+  const auto blocks = bc::encode(format, pixels.data(), width, height);
+  REQUIRE(blocks.size() == bc::calcCompressedSize(format, width, height));
+
+  std::vector<uint8_t> decoded(pixels.size());
+  REQUIRE(bc::decode(format, blocks, width, height, decoded.data()));
+  return decoded;
+}
+
+// Appends bits to a 128-bit block, LSB first.
+void writeBits(uint8_t (&block)[16], uint32_t &position, uint32_t value,
+               uint32_t numBits) {
+  for (auto i = 0u; i < numBits; ++i, ++position) {
+    if ((value >> i) & 1) block[position >> 3] |= uint8_t(1 << (position & 7));
+  }
+}
+
+[[nodiscard]] std::array<float, 16 * 4> decodeBC6H(const uint8_t (&block)[16]) {
+  std::array<float, 16 * 4> pixels;
+  REQUIRE(bc::decode(bc::Format::BC6H, std::as_bytes(std::span{block}), 4, 4,
+                     pixels.data()));
+  return pixels;
+}
+
+} // namespace
+
+TEST_CASE("Compressed size") {
+  REQUIRE(bc::calcCompressedSize(bc::Format::BC1, 4, 4) == 8);
+  REQUIRE(bc::calcCompressedSize(bc::Format::BC7, 4, 4) == 16);
+  REQUIRE(bc::calcCompressedSize(bc::Format::BC4, 5, 1) == 16);
+
+  // RGBA8: 4 bytes per pixel, BC1: 0.5 byte per pixel, BC7: 1 byte per pixel.
+  constexpr auto kUncompressedSize = 4096u * 4096u * 4u;
+  REQUIRE(kUncompressedSize /
+            bc::calcCompressedSize(bc::Format::BC1, 4096, 4096) ==
+          8);
+  REQUIRE(kUncompressedSize /
+            bc::calcCompressedSize(bc::Format::BC7, 4096, 4096) ==
+          4);
+}
+
+TEST_CASE("LDR round trip") {
+  auto source = makeTestImage(kWidth, kHeight);
+
+  struct Expectation {
+    bc::Format format;
+    uint32_t numChannels;
+    double minPSNR;
+  };
+  const auto [format, numChannels, minPSNR] = GENERATE(
+    Expectation{bc::Format::BC1, 3, 32.0}, Expectation{bc::Format::BC3, 4, 32.0},
+    Expectation{bc::Format::BC4, 1, 38.0}, Expectation{bc::Format::BC5, 2, 38.0},
+    Expectation{bc::Format::BC7, 4, 36.0});
+
+  if (format == bc::Format::BC1) {
+    // Otherwise the punch-through alpha would discard color.
+    for (auto i = 3u; i < source.size(); i += 4)
+      source[i] = 255;
+  }
+  const auto decoded = roundTrip(format, source, kWidth, kHeight);
+  const auto psnr = bc::calcPSNR(source, decoded, numChannels);
+  INFO("Format: " << int32_t(format) << ", PSNR: " << psnr);
+  REQUIRE(psnr >= minPSNR);
+}
+
+TEST_CASE("BC1 punch-through alpha") {
+  auto source = makeTestImage(8, 8);
+  for (auto i = 0u; i < source.size(); i += 4)
+    source[i + 3] = (i / 4) % 2 ? 255 : 0;
+
+  const auto decoded = roundTrip(bc::Format::BC1, source, 8, 8);
+  for (auto i = 0u; i < source.size(); i += 4)
+    REQUIRE(decoded[i + 3] == source[i + 3]);
+}
+
+TEST_CASE("Solid color is lossless") {
+  std::vector<uint8_t> source(16 * 16 * 4);
+  for (auto i = 0u; i < source.size(); i += 4) {
+    source[i + 0] = 255;
+    source[i + 1] = 128;
+    source[i + 2] = 0;
+    source[i + 3] = 255;
+  }
+  for (const auto format : {bc::Format::BC4, bc::Format::BC5}) {
+    const auto decoded = roundTrip(format, source, 16, 16);
+    REQUIRE(std::isinf(bc::calcPSNR(source, decoded, 1)));
+  }
+  REQUIRE(bc::calcPSNR(source, roundTrip(bc::Format::BC7, source, 16, 16)) >
+          48.0);
+}
+
+TEST_CASE("BC7 reference block") {
+  // Mode 6: R = 127|1, G = 0|1, B = 0|1, A = 127|1 (7 bits|p-bit), index 0.
+  const uint8_t block[16]{
+    0xC0, 0xFF, 0x1F, 0x00, 0x00, 0x00, 0xFE, 0xFF,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  };
+  uint8_t decoded[16 * 4];
+  REQUIRE(bc::decode(bc::Format::BC7, std::as_bytes(std::span{block}), 4, 4,
+                     decoded));
+  for (auto i = 0u; i < 16; ++i) {
+    REQUIRE(decoded[i * 4 + 0] == 255);
+    REQUIRE(decoded[i * 4 + 1] == 1);
+    REQUIRE(decoded[i * 4 + 2] == 1);
+    REQUIRE(decoded[i * 4 + 3] == 255);
+  }
+}
+
+TEST_CASE("BC7 decodes every mode") {
+  std::mt19937 rng{42};
+  std::uniform_int_distribution<uint32_t> byte{0, 255};
+
+  std::vector<uint8_t> blocks(16 * 64);
+  for (auto i = 0u; i < blocks.size(); ++i) {
+    blocks[i] = uint8_t(byte(rng));
+    // Force a mode (N-th bit set, preceded by N zeros).
+    if (i % 16 == 0) blocks[i] = uint8_t((blocks[i] | 1) << ((i / 16) % 8));
+  }
+  std::vector<uint8_t> decoded(blocks.size() * 4);
+  REQUIRE(bc::decode(bc::Format::BC7, std::as_bytes(std::span{blocks}), 32, 8,
+                     decoded.data()));
+
+  // Reserved mode (8) decodes to transparent black.
+  const uint8_t reserved[16]{};
+  uint8_t pixels[16 * 4];
+  REQUIRE(bc::decode(bc::Format::BC7, std::as_bytes(std::span{reserved}), 4,
+                     4, pixels));
+  REQUIRE(std::ranges::all_of(pixels, [](auto v) { return v == 0; }));
+}
+
+TEST_CASE("BC6H round trip") {
+  constexpr auto kPeak = 16.0f;
+
+  std::vector<float> source(std::size_t{kWidth} * kHeight * 4);
+  for (auto y = 0u; y < kHeight; ++y) {
+    for (auto x = 0u; x < kWidth; ++x) {
+      auto *dst = source.data() + (std::size_t{y} * kWidth + x) * 4;
+      dst[0] = kPeak * float(x) / kWidth;
+      dst[1] = kPeak * float(y) / kHeight;
+      dst[2] = 0.5f;
+      dst[3] = 1.0f;
+    }
+  }
+  const auto blocks =
+    bc::encode(bc::Format::BC6H, source.data(), kWidth, kHeight);
+
+  std::vector<float> decoded(source.size());
+  REQUIRE(
+    bc::decode(bc::Format::BC6H, blocks, kWidth, kHeight, decoded.data()));
+
+  const auto psnr = bc::calcPSNR(source, decoded, kPeak);
+  INFO("PSNR: " << psnr);
+  REQUIRE(psnr >= 36.0);
+}
+
+TEST_CASE("BC6H decodes every mode") {
+  constexpr uint32_t kColor[]{700, 300, 50}; // 10 bits.
+
+  // Mode 11: 10-bit endpoints (both the same), indices = 0.
+  uint8_t reference[16]{};
+  auto position = 0u;
+  writeBits(reference, position, 0b00011, 5);
+  for (auto e = 0u; e < 2; ++e)
+    for (auto c : kColor)
+      writeBits(reference, position, c, 10);
+  const auto expected = decodeBC6H(reference);
+
+  SECTION("Transformed, 2 regions") {
+    // Mode 1: 10-bit base endpoint, the deltas (and indices) are zero.
+    uint8_t block[16]{};
+    position = 5;
+    for (auto c : kColor)
+      writeBits(block, position, c, 10);
+    REQUIRE(decodeBC6H(block) == expected);
+  }
+  SECTION("Transformed, 16-bit endpoints") {
+    // Mode 14: bits [10, 16) of the base endpoint are stored reversed, 30 is
+    // a palindrome (011110). 31711 decodes to 1.0 (after the * 31/64 scale).
+    constexpr auto kOne = 31711u;
+    uint8_t block[16]{};
+    position = 0;
+    writeBits(block, position, 0b01111, 5);
+    for (auto c = 0u; c < 3; ++c)
+      writeBits(block, position, kOne & 1023, 10);
+    for (auto c = 0u; c < 3; ++c) {
+      writeBits(block, position, 0, 4); // Delta.
+      writeBits(block, position, kOne >> 10, 6);
+    }
+    const auto pixels = decodeBC6H(block);
+    for (auto i = 0u; i < 16; ++i) {
+      REQUIRE(pixels[i * 4 + 0] == 1.0f);
+      REQUIRE(pixels[i * 4 + 1] == 1.0f);
+      REQUIRE(pixels[i * 4 + 2] == 1.0f);
+      REQUIRE(pixels[i * 4 + 3] == 1.0f);
+    }
+  }
+  SECTION("Random bits") {
+    constexpr uint32_t kModes[]{
+      0b00,    0b01,    0b00010, 0b00110, 0b01010, 0b01110, 0b10010,
+      0b10110, 0b11010, 0b11110, 0b00011, 0b00111, 0b01011, 0b01111,
+    };
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<uint32_t> byte{0, 255};
+    for (const auto mode : kModes) {
+      uint8_t block[16];
+      for (auto &v : block)
+        v = uint8_t(byte(rng));
+      const auto mask = mode > 1 ? 0b11111u : 0b11u;
+      block[0] = uint8_t((block[0] & ~mask) | mode);
+
+      INFO("Mode: " << mode);
+      const auto pixels = decodeBC6H(block);
+      REQUIRE(std::ranges::all_of(
+        pixels, [](float v) { return std::isfinite(v) && v >= 0.0f; }));
+    }
+  }
+  SECTION("Reserved") {
+    uint8_t block[16]{0b10011};
+    const auto pixels = decodeBC6H(block);
+    for (auto i = 0u; i < 16; ++i) {
+      REQUIRE(pixels[i * 4 + 0] == 0.0f);
+      REQUIRE(pixels[i * 4 + 3] == 1.0f);
+    }
+  }
+}
+
+int main(int argc, char *argv[]) { return Catch::Session{}.run(argc, argv); }
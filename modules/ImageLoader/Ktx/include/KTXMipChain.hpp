@@ -0,0 +1,43 @@
+#pragma once
+
+#include "rhi/RenderDevice.hpp"
+#include <filesystem>
+
+// Random access to the mip levels of a KTX2 file (used by texture streaming).
+// Only plain 2D textures qualify (no supercompression, no Basis Universal).
+
+struct KTXMipChain {
+  rhi::PixelFormat pixelFormat{rhi::PixelFormat::Undefined};
+  rhi::Extent2D extent; // Of the base level.
+
+  struct Level {
+    uint64_t offset{0}; // In the file.
+    uint64_t size{0};   // In bytes.
+  };
+  std::vector<Level> levels; // [0] = Base level.
+
+  [[nodiscard]] uint32_t getNumLevels() const;
+  // @return Size (in bytes) of mip levels [firstLevel, numLevels).
+  [[nodiscard]] uint64_t calcSize(uint32_t firstLevel) const;
+};
+
+struct KTXMipLevels {
+  uint32_t firstLevel{0};
+  // Levels [firstLevel, numLevels), in the file order (the smallest first).
+  std::vector<std::byte> data;
+};
+
+// Reads only the header and the level index.
+// @return std::nullopt if the file can't be streamed to the given device.
+[[nodiscard]] std::optional<KTXMipChain>
+readMipChainKTX(const std::filesystem::path &, const rhi::RenderDevice &);
+
+// Does not touch the RenderDevice (safe to call from a worker thread).
+[[nodiscard]] std::expected<KTXMipLevels, std::string>
+readMipLevelsKTX(const std::filesystem::path &, const KTXMipChain &,
+                 uint32_t firstLevel);
+
+// @return Texture with (numLevels - firstLevel) mip levels.
+[[nodiscard]] std::expected<rhi::Texture, std::string>
+createTextureKTX(rhi::RenderDevice &, const KTXMipChain &,
+                 const KTXMipLevels &);
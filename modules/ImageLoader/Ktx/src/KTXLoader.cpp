@@ -1,6 +1,7 @@
 #include "KTXLoader.hpp"
 #include "rhi/TextureUtility.hpp"
 #include "os/FileSystem.hpp"
+#include "bc/BlockCompression.hpp"
 
 #include "ktxvulkan.h" // ktxTexture_GetVkFormat
 
@@ -232,6 +233,134 @@ KTX_error_code optimalTilingPadCallback(int miplevel, int face, int width,
   return result;
 }
 
+[[nodiscard]] std::optional<bc::Format> getBlockFormat(rhi::PixelFormat in) {
+  switch (in) {
+    using enum rhi::PixelFormat;
+
+  case BC1_RGB_UNorm:
+  case BC1_RGB_sRGB:
+  case BC1_RGBA_UNorm:
+  case BC1_RGBA_sRGB:
+    return bc::Format::BC1;
+  case BC3_UNorm:
+  case BC3_sRGB:
+    return bc::Format::BC3;
+  case BC4_UNorm:
+    return bc::Format::BC4;
+  case BC5_UNorm:
+    return bc::Format::BC5;
+  case BC6H_UFloat:
+    return bc::Format::BC6H;
+  case BC7_UNorm:
+  case BC7_sRGB:
+    return bc::Format::BC7;
+
+  default:
+    return std::nullopt;
+  }
+}
+[[nodiscard]] bool isSRGB(rhi::PixelFormat pixelFormat) {
+  switch (pixelFormat) {
+    using enum rhi::PixelFormat;
+
+  case BC1_RGB_sRGB:
+  case BC1_RGBA_sRGB:
+  case BC3_sRGB:
+  case BC7_sRGB:
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+// Fallback for devices without textureCompressionBC.
+[[nodiscard]] std::expected<rhi::Texture, std::string>
+decodeTexture(rhi::RenderDevice &rd, ktxTexture *ktx,
+              rhi::PixelFormat compressedFormat) {
+  const auto blockFormat = getBlockFormat(compressedFormat);
+  if (!blockFormat) {
+    return std::unexpected{
+      std::format("Unsupported pixel format: {} (no CPU decoder)",
+                  rhi::toString(compressedFormat))};
+  }
+  if (!ktx->pData) {
+    if (const auto result = ktxTexture_LoadImageData(ktx, nullptr, 0);
+        result != KTX_SUCCESS) {
+      return std::unexpected{toString(result)};
+    }
+  }
+
+  const auto pixelFormat = bc::isHDR(*blockFormat) ? rhi::PixelFormat::RGBA32F
+                           : isSRGB(compressedFormat)
+                             ? rhi::PixelFormat::RGBA8_sRGB
+                             : rhi::PixelFormat::RGBA8_UNorm;
+  const auto numLayers = ktx->isArray ? ktx->numLayers : 1u;
+  auto texture =
+    rhi::Texture::Builder{}
+      .setExtent({ktx->baseWidth, ktx->baseHeight})
+      .setPixelFormat(pixelFormat)
+      .setNumMipLevels(ktx->numLevels)
+      .setNumLayers(ktx->isArray ? std::optional{ktx->numLayers} : std::nullopt)
+      .setCubemap(ktx->isCubemap)
+      .setUsageFlags(rhi::ImageUsage::TransferDst | rhi::ImageUsage::Sampled)
+      .setupOptimalSampler(true)
+      .build(rd);
+  if (!texture) {
+    return std::unexpected{std::format("Unsupported pixel format: {}",
+                                       rhi::toString(pixelFormat))};
+  }
+
+  const auto pixelSize = bc::getPixelSize(*blockFormat);
+  VkDeviceSize dataSize{0};
+  for (auto level = 0u; level < ktx->numLevels; ++level) {
+    const auto width = std::max(1u, ktx->baseWidth >> level);
+    const auto height = std::max(1u, ktx->baseHeight >> level);
+    dataSize += VkDeviceSize{width} * height * pixelSize * numLayers *
+                ktx->numFaces;
+  }
+  auto srcStagingBuffer = rd.createStagingBuffer(dataSize);
+  auto *pMappedStagingBuffer = static_cast<std::byte *>(srcStagingBuffer.map());
+
+  std::vector<VkBufferImageCopy> copyRegions;
+  copyRegions.reserve(ktx->numLevels * numLayers * ktx->numFaces);
+  VkDeviceSize offset{0};
+  for (auto level = 0u; level < ktx->numLevels; ++level) {
+    const auto width = std::max(1u, ktx->baseWidth >> level);
+    const auto height = std::max(1u, ktx->baseHeight >> level);
+    const auto imageSize = ktxTexture_GetImageSize(ktx, level);
+
+    for (auto layer = 0u; layer < numLayers; ++layer) {
+      for (auto face = 0u; face < ktx->numFaces; ++face) {
+        ktx_size_t srcOffset;
+        ktxTexture_GetImageOffset(ktx, level, layer, face, &srcOffset);
+        const auto blocks =
+          std::span{std::bit_cast<const std::byte *>(ktx->pData) + srcOffset,
+                    imageSize};
+        if (!bc::decode(*blockFormat, blocks, width, height,
+                        pMappedStagingBuffer + offset)) {
+          return std::unexpected{
+            std::format("Could not decode: {}", rhi::toString(compressedFormat))};
+        }
+        copyRegions.push_back({
+          .bufferOffset = offset,
+          .imageSubresource =
+            {
+              .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+              .mipLevel = level,
+              .baseArrayLayer = layer * ktx->numFaces + face,
+              .layerCount = 1,
+            },
+          .imageExtent = {.width = width, .height = height, .depth = 1},
+        });
+        offset += VkDeviceSize{width} * height * pixelSize;
+      }
+    }
+  }
+  rhi::upload(rd, srcStagingBuffer, copyRegions, texture);
+  return texture;
+}
+
 [[nodiscard]] std::expected<rhi::Texture, std::string>
 loadTexture(rhi::RenderDevice &rd, ktxTexture *ktx) {
   assert(ktx && ktx->baseDepth == 1);
@@ -246,6 +375,10 @@ loadTexture(rhi::RenderDevice &rd, ktxTexture *ktx) {
   }
 
   const auto pixelFormat = rhi::PixelFormat(ktxTexture_GetVkFormat(ktx));
+  if (getBlockFormat(pixelFormat) &&
+      !rd.getDeviceFeatures().textureCompressionBC) {
+    return decodeTexture(rd, ktx, pixelFormat);
+  }
   auto texture =
     rhi::Texture::Builder{}
       .setExtent(
@@ -274,10 +407,10 @@ loadTexture(rhi::RenderDevice &rd, ktxTexture *ktx) {
 }
 
 [[nodiscard]] auto pickTranscodeFormat(const rhi::RenderDevice &rd) {
-  if (const auto &df = rd.getDeviceFeatures(); df.textureCompressionETC2) {
+  if (const auto &df = rd.getDeviceFeatures(); df.textureCompressionBC) {
+    return KTX_TTF_BC7_RGBA;
+  } else if (df.textureCompressionETC2) {
     return KTX_TTF_ETC;
-  } else if (df.textureCompressionBC) {
-    return KTX_TTF_BC3_RGBA;
   }
   // Compressed textures not supported.
   return KTX_TTF_RGBA32;
@@ -0,0 +1,173 @@
+#include "KTXMipChain.hpp"
+#include "rhi/TextureUtility.hpp"
+#include "os/FileSystem.hpp"
+
+#include <algorithm> // equal
+#include <format>
+
+// https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+
+namespace {
+
+#pragma pack(push, 1)
+struct Header {
+  uint8_t identifier[12];
+  uint32_t vkFormat;
+  uint32_t typeSize;
+  uint32_t pixelWidth;
+  uint32_t pixelHeight;
+  uint32_t pixelDepth;
+  uint32_t layerCount;
+  uint32_t faceCount;
+  uint32_t levelCount;
+  uint32_t supercompressionScheme;
+
+  uint32_t dfdByteOffset;
+  uint32_t dfdByteLength;
+  uint32_t kvdByteOffset;
+  uint32_t kvdByteLength;
+  uint64_t sgdByteOffset;
+  uint64_t sgdByteLength;
+};
+struct LevelIndex {
+  uint64_t byteOffset;
+  uint64_t byteLength;
+  uint64_t uncompressedByteLength;
+};
+#pragma pack(pop)
+static_assert(sizeof(Header) == 80);
+
+constexpr uint8_t kIdentifier[12]{
+  0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A,
+};
+
+[[nodiscard]] bool canStream(const Header &header) {
+  return std::equal(std::cbegin(kIdentifier), std::cend(kIdentifier),
+                    header.identifier) &&
+         header.vkFormat != VK_FORMAT_UNDEFINED && // Basis Universal.
+         header.pixelHeight > 0 && header.pixelDepth == 0 &&
+         header.layerCount == 0 && header.faceCount == 1 &&
+         header.levelCount > 1 && header.supercompressionScheme == 0;
+}
+
+} // namespace
+
+uint32_t KTXMipChain::getNumLevels() const { return uint32_t(levels.size()); }
+uint64_t KTXMipChain::calcSize(uint32_t firstLevel) const {
+  uint64_t size{0};
+  for (auto i = firstLevel; i < levels.size(); ++i)
+    size += levels[i].size;
+  return size;
+}
+
+std::optional<KTXMipChain> readMipChainKTX(const std::filesystem::path &p,
+                                           const rhi::RenderDevice &rd) {
+  auto stream = os::FileSystem::mapFile(p);
+  if (!stream) return std::nullopt;
+
+  Header header{};
+  if (stream->read(&header, sizeof(Header)) != sizeof(Header) ||
+      !canStream(header)) {
+    return std::nullopt;
+  }
+  const auto pixelFormat = rhi::PixelFormat(header.vkFormat);
+  // The CPU decoder (KTXLoader) needs the whole file.
+  if (rhi::isCompressed(pixelFormat) &&
+      !rd.getDeviceFeatures().textureCompressionBC) {
+    return std::nullopt;
+  }
+  if (!rhi::isFormatSupported(rd, pixelFormat,
+                              rhi::ImageUsage::TransferDst |
+                                rhi::ImageUsage::Sampled)) {
+    return std::nullopt;
+  }
+
+  std::vector<LevelIndex> levelIndex(header.levelCount);
+  const auto levelIndexSize = sizeof(LevelIndex) * levelIndex.size();
+  if (stream->read(levelIndex.data(), levelIndexSize) != levelIndexSize) {
+    return std::nullopt;
+  }
+
+  KTXMipChain chain{
+    .pixelFormat = pixelFormat,
+    .extent = {header.pixelWidth, header.pixelHeight},
+  };
+  chain.levels.reserve(levelIndex.size());
+  for (const auto &level : levelIndex) {
+    chain.levels.push_back({level.byteOffset, level.byteLength});
+  }
+  return chain;
+}
+
+std::expected<KTXMipLevels, std::string>
+readMipLevelsKTX(const std::filesystem::path &p, const KTXMipChain &chain,
+                 uint32_t firstLevel) {
+  assert(firstLevel < chain.getNumLevels());
+
+  auto stream = os::FileSystem::mapFile(p);
+  if (!stream) {
+    return std::unexpected{"Could not open file."};
+  }
+  // Mip levels are stored from the smallest one, the requested range is
+  // contiguous (with padding in between).
+  const auto &smallest = chain.levels.back();
+  const auto &largest = chain.levels[firstLevel];
+  const auto size = largest.offset + largest.size - smallest.offset;
+
+  KTXMipLevels out{.firstLevel = firstLevel};
+  out.data.resize(size);
+  stream->seek(smallest.offset, os::DataStream::Origin::Beginning);
+  if (stream->read(out.data.data(), size) != size) {
+    return std::unexpected{"Unexpected end of file."};
+  }
+  return out;
+}
+
+std::expected<rhi::Texture, std::string>
+createTextureKTX(rhi::RenderDevice &rd, const KTXMipChain &chain,
+                 const KTXMipLevels &mipLevels) {
+  const auto firstLevel = mipLevels.firstLevel;
+  const auto numLevels = chain.getNumLevels() - firstLevel;
+  auto texture =
+    rhi::Texture::Builder{}
+      .setExtent({
+        std::max(1u, chain.extent.width >> firstLevel),
+        std::max(1u, chain.extent.height >> firstLevel),
+      })
+      .setPixelFormat(chain.pixelFormat)
+      .setNumMipLevels(numLevels)
+      .setUsageFlags(rhi::ImageUsage::TransferDst | rhi::ImageUsage::Sampled)
+      .setupOptimalSampler(true)
+      .build(rd);
+  if (!texture) {
+    return std::unexpected{std::format("Unsupported pixel format: {}",
+                                       rhi::toString(chain.pixelFormat))};
+  }
+
+  auto srcStagingBuffer =
+    rd.createStagingBuffer(mipLevels.data.size(), mipLevels.data.data());
+
+  const auto baseOffset = chain.levels.back().offset;
+  std::vector<VkBufferImageCopy> copyRegions;
+  copyRegions.reserve(numLevels);
+  for (auto level = 0u; level < numLevels; ++level) {
+    const auto srcLevel = firstLevel + level;
+    copyRegions.push_back({
+      .bufferOffset = chain.levels[srcLevel].offset - baseOffset,
+      .imageSubresource =
+        {
+          .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+          .mipLevel = level,
+          .layerCount = 1,
+        },
+      .imageExtent =
+        {
+          .width = std::max(1u, chain.extent.width >> srcLevel),
+          .height = std::max(1u, chain.extent.height >> srcLevel),
+          .depth = 1,
+        },
+    });
+  }
+  rhi::upload(rd, srcStagingBuffer, copyRegions, texture);
+  return texture;
+}
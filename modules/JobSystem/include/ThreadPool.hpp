@@ -0,0 +1,141 @@
+#pragma once
+
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <exception>
+#include <algorithm> // min
+
+// Each worker owns a queue: pushes and pops at the back (the most recent task
+// first), idle workers steal from the front of the other queues.
+// Tasks submitted from outside of the pool go to a shared queue.
+// Doesn't allocate once the queues have grown to the peak number of tasks
+// (and the tasks fit in the small buffer of std::function, e.g. a lambda
+// that captures a pointer or two).
+class ThreadPool final {
+public:
+  using Task = std::function<void()>;
+
+  // Tracks completion of the tasks submitted with run.
+  class TaskGroup final {
+    friend class ThreadPool;
+
+  public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+  private:
+    std::atomic<std::size_t> m_numPending{0};
+    std::mutex m_mutex;
+    std::exception_ptr m_exception; // The first one, guarded by m_mutex.
+  };
+
+  // @param numThreads 0 = tasks are executed by the thread that waits.
+  explicit ThreadPool(uint32_t numThreads);
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool(ThreadPool &&) noexcept = delete;
+  ~ThreadPool();
+
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ThreadPool &operator=(ThreadPool &&) noexcept = delete;
+
+  [[nodiscard]] uint32_t getNumThreads() const;
+
+  void run(TaskGroup &, Task);
+  // Executes pending tasks (of any group) until the given group is done, so
+  // it's fine to wait inside of a task.
+  // Rethrows the first exception that escaped a task of the group.
+  void wait(TaskGroup &);
+
+private:
+  struct Job {
+    TaskGroup *group{nullptr};
+    Task task;
+  };
+  // Ring buffer, guarded by the mutex.
+  struct Queue {
+    std::mutex mutex;
+    std::vector<Job> jobs;
+    std::size_t head{0};
+    std::size_t size{0};
+
+    void pushBack(Job &&);
+    [[nodiscard]] std::optional<Job> popBack();
+    [[nodiscard]] std::optional<Job> popFront();
+  };
+
+  [[nodiscard]] std::size_t _getQueueIndex() const;
+  [[nodiscard]] std::optional<Job> _pop(std::size_t queueIndex);
+  [[nodiscard]] std::optional<Job> _steal(std::size_t thiefIndex);
+  void _execute(Job &);
+
+  void _workerLoop(std::stop_token, std::size_t queueIndex);
+
+private:
+  // [0..numThreads) = workers, the last one is shared (external threads).
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  std::atomic<std::size_t> m_numQueued{0};
+
+  std::mutex m_sleepMutex;
+  std::condition_variable_any m_jobAdded;
+
+  std::vector<std::jthread> m_workers; // Keep last.
+};
+
+// Splits [0, count) into chunks of grainSize, processed by the workers and the
+// calling thread: fn(begin, end).
+// Blocks until all chunks are done, rethrows the first exception.
+template <typename Fn>
+void parallelFor(ThreadPool &threadPool, std::size_t count,
+                 std::size_t grainSize, Fn &&fn) {
+  grainSize = std::max(grainSize, std::size_t{1});
+  const auto numChunks = (count + grainSize - 1) / grainSize;
+  if (numChunks <= 1 || threadPool.getNumThreads() == 0) {
+    if (count > 0) fn(std::size_t{0}, count);
+    return;
+  }
+
+  // Chunks are claimed dynamically (tasks don't have to be balanced).
+  struct Shared {
+    Fn &fn;
+    const std::size_t count;
+    const std::size_t grainSize;
+    const std::size_t numChunks;
+    std::atomic<std::size_t> nextChunk{0};
+
+    void execute() {
+      while (true) {
+        const auto i = nextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (i >= numChunks) break;
+        const auto begin = i * grainSize;
+        fn(begin, std::min(begin + grainSize, count));
+      }
+    }
+  } shared{fn, count, grainSize, numChunks};
+
+  ThreadPool::TaskGroup group;
+  const auto numTasks =
+    std::min<std::size_t>(numChunks - 1, threadPool.getNumThreads());
+  for (auto i = 0u; i < numTasks; ++i) {
+    threadPool.run(group, [&shared] { shared.execute(); });
+  }
+  try {
+    shared.execute();
+  } catch (...) {
+    // The tasks reference the shared state (on this stack frame).
+    shared.nextChunk = numChunks;
+    threadPool.wait(group);
+    throw;
+  }
+  threadPool.wait(group);
+}
+
+// The engine-wide pool (hardware_concurrency - 1 workers, the main thread
+// participates in parallelFor and wait), created on the first use.
+[[nodiscard]] ThreadPool &getSharedThreadPool();
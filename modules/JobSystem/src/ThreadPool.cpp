@@ -0,0 +1,166 @@
+#include "ThreadPool.hpp"
+#include <utility> // exchange
+#include <cassert>
+
+namespace {
+
+struct WorkerInfo {
+  const ThreadPool *pool{nullptr};
+  std::size_t queueIndex{0};
+};
+thread_local WorkerInfo g_worker;
+
+} // namespace
+
+//
+// ThreadPool::Queue struct:
+//
+
+void ThreadPool::Queue::pushBack(Job &&job) {
+  if (size == jobs.size()) {
+    std::vector<Job> grown(std::max(jobs.size() * 2, std::size_t{16}));
+    for (auto i = 0u; i < size; ++i) {
+      grown[i] = std::move(jobs[(head + i) % jobs.size()]);
+    }
+    jobs = std::move(grown);
+    head = 0;
+  }
+  jobs[(head + size) % jobs.size()] = std::move(job);
+  ++size;
+}
+std::optional<ThreadPool::Job> ThreadPool::Queue::popBack() {
+  if (size == 0) return std::nullopt;
+  --size;
+  return std::move(jobs[(head + size) % jobs.size()]);
+}
+std::optional<ThreadPool::Job> ThreadPool::Queue::popFront() {
+  if (size == 0) return std::nullopt;
+  auto job = std::move(jobs[head]);
+  head = (head + 1) % jobs.size();
+  --size;
+  return job;
+}
+
+//
+// ThreadPool class:
+//
+
+ThreadPool::ThreadPool(uint32_t numThreads) {
+  m_queues.reserve(numThreads + 1);
+  for (auto i = 0u; i <= numThreads; ++i) {
+    m_queues.emplace_back(std::make_unique<Queue>());
+  }
+  m_workers.reserve(numThreads);
+  for (auto i = 0u; i < numThreads; ++i) {
+    m_workers.emplace_back(
+      [this, i](std::stop_token stopToken) { _workerLoop(stopToken, i); });
+  }
+}
+ThreadPool::~ThreadPool() {
+  for (auto &worker : m_workers) {
+    worker.request_stop();
+  }
+  m_jobAdded.notify_all();
+  m_workers.clear();
+}
+
+uint32_t ThreadPool::getNumThreads() const {
+  return uint32_t(m_workers.size());
+}
+
+void ThreadPool::run(TaskGroup &group, Task task) {
+  assert(task);
+  group.m_numPending.fetch_add(1, std::memory_order_relaxed);
+  // Before the push, so a concurrent pop never underflows the counter.
+  m_numQueued.fetch_add(1, std::memory_order_release);
+  {
+    auto &queue = *m_queues[_getQueueIndex()];
+    std::scoped_lock lock{queue.mutex};
+    queue.pushBack({&group, std::move(task)});
+  }
+  {
+    // Prevents a lost wakeup (a worker between the check and the wait).
+    std::scoped_lock lock{m_sleepMutex};
+  }
+  m_jobAdded.notify_one();
+}
+void ThreadPool::wait(TaskGroup &group) {
+  const auto queueIndex = _getQueueIndex();
+  while (group.m_numPending.load(std::memory_order_acquire) > 0) {
+    if (auto job = _pop(queueIndex); job) {
+      _execute(*job);
+    } else if (auto stolen = _steal(queueIndex); stolen) {
+      _execute(*stolen);
+    } else {
+      // The remaining tasks of the group are being executed by the workers.
+      std::this_thread::yield();
+    }
+  }
+  std::scoped_lock lock{group.m_mutex};
+  if (auto exception = std::exchange(group.m_exception, nullptr); exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+//
+// (private):
+//
+
+std::size_t ThreadPool::_getQueueIndex() const {
+  return g_worker.pool == this ? g_worker.queueIndex : m_queues.size() - 1;
+}
+
+std::optional<ThreadPool::Job> ThreadPool::_pop(std::size_t queueIndex) {
+  auto &queue = *m_queues[queueIndex];
+  std::scoped_lock lock{queue.mutex};
+  auto job = queue.popBack();
+  if (job) m_numQueued.fetch_sub(1, std::memory_order_relaxed);
+  return job;
+}
+std::optional<ThreadPool::Job> ThreadPool::_steal(std::size_t thiefIndex) {
+  const auto numQueues = m_queues.size();
+  for (auto i = 1u; i < numQueues; ++i) {
+    auto &queue = *m_queues[(thiefIndex + i) % numQueues];
+    std::scoped_lock lock{queue.mutex};
+    // The oldest task, likely the largest one (submitted before it was split).
+    if (auto job = queue.popFront(); job) {
+      m_numQueued.fetch_sub(1, std::memory_order_relaxed);
+      return job;
+    }
+  }
+  return std::nullopt;
+}
+void ThreadPool::_execute(Job &job) {
+  auto &group = *job.group;
+  try {
+    job.task();
+  } catch (...) {
+    std::scoped_lock lock{group.m_mutex};
+    if (!group.m_exception) group.m_exception = std::current_exception();
+  }
+  // The group might be destroyed right after the last decrement.
+  group.m_numPending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void ThreadPool::_workerLoop(std::stop_token stopToken,
+                             std::size_t queueIndex) {
+  g_worker = {.pool = this, .queueIndex = queueIndex};
+  while (!stopToken.stop_requested()) {
+    if (auto job = _pop(queueIndex); job) {
+      _execute(*job);
+    } else if (auto stolen = _steal(queueIndex); stolen) {
+      _execute(*stolen);
+    } else {
+      std::unique_lock lock{m_sleepMutex};
+      m_jobAdded.wait(lock, stopToken, [this] {
+        return m_numQueued.load(std::memory_order_acquire) > 0;
+      });
+    }
+  }
+}
+
+ThreadPool &getSharedThreadPool() {
+  static ThreadPool threadPool{
+    std::max(std::thread::hardware_concurrency(), 2u) - 1};
+  return threadPool;
+}
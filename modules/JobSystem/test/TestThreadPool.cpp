@@ -0,0 +1,81 @@
+#include "catch.hpp"
+
+#include "ThreadPool.hpp"
+#include <algorithm> // all_of
+#include <numeric>   // accumulate
+#include <stdexcept>
+
+TEST_CASE("ThreadPool") {
+  const auto numThreads = GENERATE(0u, 1u, 4u);
+  ThreadPool threadPool{numThreads};
+  REQUIRE(threadPool.getNumThreads() == numThreads);
+
+  SECTION("Executes every task once") {
+    std::vector<int32_t> values(1000, 0);
+    ThreadPool::TaskGroup group;
+    for (auto &v : values) {
+      threadPool.run(group, [&v] { ++v; });
+    }
+    threadPool.wait(group);
+    REQUIRE(std::ranges::all_of(values, [](auto v) { return v == 1; }));
+  }
+  SECTION("Nested groups") {
+    // The same pattern as the MeshConverter: files -> submeshes.
+    constexpr auto kNumOuter = 32;
+    constexpr auto kNumInner = 50;
+
+    std::vector<int32_t> sums(kNumOuter, 0);
+    ThreadPool::TaskGroup outer;
+    for (auto &sum : sums) {
+      threadPool.run(outer, [&threadPool, &sum] {
+        std::vector<int32_t> values(kNumInner);
+        ThreadPool::TaskGroup inner;
+        for (auto i = 0; i < kNumInner; ++i) {
+          threadPool.run(inner, [&values, i] { values[i] = i; });
+        }
+        threadPool.wait(inner);
+        sum = std::accumulate(values.cbegin(), values.cend(), 0);
+      });
+    }
+    threadPool.wait(outer);
+    constexpr auto kExpected = kNumInner * (kNumInner - 1) / 2;
+    REQUIRE(
+      std::ranges::all_of(sums, [](auto sum) { return sum == kExpected; }));
+  }
+  SECTION("Exceptions") {
+    ThreadPool::TaskGroup group;
+    auto numExecuted = std::atomic{0};
+    for (auto i = 0; i < 10; ++i) {
+      threadPool.run(group, [&numExecuted, i] {
+        ++numExecuted;
+        if (i == 5) throw std::runtime_error{"Task failed"};
+      });
+    }
+    REQUIRE_THROWS_AS(threadPool.wait(group), std::runtime_error);
+    // The remaining tasks are not cancelled.
+    REQUIRE(numExecuted == 10);
+
+    // Reported once.
+    REQUIRE_NOTHROW(threadPool.wait(group));
+  }
+  SECTION("parallelFor") {
+    const auto grainSize = GENERATE(1u, 7u, 64u, 1000u);
+    std::vector<int32_t> values(1000, 0);
+    parallelFor(threadPool, values.size(), grainSize,
+                [&values](std::size_t begin, std::size_t end) {
+                  for (auto i = begin; i < end; ++i)
+                    ++values[i];
+                });
+    REQUIRE(std::ranges::all_of(values, [](auto v) { return v == 1; }));
+
+    // The last chunk.
+    const auto fails = [n = values.size()](std::size_t, std::size_t end) {
+      if (end == n) throw std::logic_error{"Chunk failed"};
+    };
+    REQUIRE_THROWS_AS(
+      parallelFor(threadPool, values.size(), grainSize, fails),
+      std::logic_error);
+  }
+}
+
+int main(int argc, char *argv[]) { return Catch::Session{}.run(argc, argv); }
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CollisionLayer.hpp"
+#include "glm/vec3.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include <span>
+#include <vector>
+
+// Input/output of the batched queries (PhysicsWorld::castRays, castShapes,
+// overlapShapes). The results are stored per field (SoA), in the order of the
+// queries. The vectors keep their capacity, reuse the results to avoid
+// allocations.
+
+// Sweep/overlap volume (constructed on the stack of a worker, no allocations).
+struct QueryShape {
+  enum class Type : uint8_t { Sphere, Box, Capsule };
+  Type type{Type::Sphere};
+  // Sphere: x = radius.
+  // Box: half extents.
+  // Capsule: x = radius, y = half height of the cylinder (along the Y axis).
+  glm::vec3 size{0.5f};
+
+  [[nodiscard]] static QueryShape sphere(float radius);
+  [[nodiscard]] static QueryShape box(const glm::vec3 &halfExtents);
+  [[nodiscard]] static QueryShape capsule(float halfHeight, float radius);
+};
+
+// A query collides with the bodies that pass the same test as a pair of
+// bodies (see: CollisionLayer).
+
+struct RayCastQuery {
+  glm::vec3 from;
+  glm::vec3 direction; // The length of the ray.
+  CollisionLayer layer;
+};
+struct ShapeCastQuery {
+  QueryShape shape;
+  glm::vec3 from;
+  glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+  glm::vec3 direction; // The length of the sweep.
+  CollisionLayer layer;
+};
+struct OverlapQuery {
+  QueryShape shape;
+  glm::vec3 position;
+  glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+  CollisionLayer layer;
+};
+
+// The closest hit of each ray/shape cast.
+struct CastResults {
+  static constexpr uint32_t kNoHit{~0u};
+
+  std::vector<uint32_t> entityIds; // kNoHit = no hit.
+  std::vector<float> fractions;    // Of the direction.
+  std::vector<glm::vec3> positions;
+  std::vector<glm::vec3> normals;
+
+  void resize(std::size_t);
+  [[nodiscard]] std::size_t size() const;
+  [[nodiscard]] bool hasHit(std::size_t i) const;
+};
+
+// Entities overlapped by each shape, sorted by id.
+struct OverlapResults {
+  uint32_t maxHits{16}; // Per query, the remaining ones are dropped.
+  std::vector<uint32_t> numHits;
+  std::vector<uint32_t> entityIds; // [query * maxHits, + numHits[query])
+
+  void resize(std::size_t);
+  [[nodiscard]] std::size_t size() const;
+  [[nodiscard]] std::span<const uint32_t> getEntities(std::size_t i) const;
+};
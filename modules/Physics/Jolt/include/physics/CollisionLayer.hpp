@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <string>
 #include <cstdint>
 
 struct CollisionLayer {
@@ -12,3 +14,43 @@ struct CollisionLayer {
 
   constexpr static auto kNumGroups = 8;
 };
+
+// Two bodies collide when the group of one is in the mask of the other.
+[[nodiscard]] constexpr bool shouldCollide(const CollisionLayer &a,
+                                           const CollisionLayer &b) {
+  return ((1 << a.group) & b.mask) || ((1 << b.group) & a.mask);
+}
+
+// Per world table of the collision groups (applied on top of the masks of
+// the bodies), by default every group collides with every other.
+struct CollisionGroups {
+  static constexpr auto kNumGroups = CollisionLayer::kNumGroups;
+
+  std::array<std::string, kNumGroups> names;
+  // Bit j of matrix[i] = group i can collide with group j (symmetric).
+  std::array<uint8_t, kNumGroups> matrix;
+
+  CollisionGroups() { matrix.fill(0xFF); }
+
+  CollisionGroups &set(uint8_t a, uint8_t b, bool collide) {
+    if (collide) {
+      matrix[a] |= 1 << b;
+      matrix[b] |= 1 << a;
+    } else {
+      matrix[a] &= ~(1 << b);
+      matrix[b] &= ~(1 << a);
+    }
+    return *this;
+  }
+  [[nodiscard]] bool canCollide(uint8_t a, uint8_t b) const {
+    return matrix[a] & (1 << b);
+  }
+  [[nodiscard]] bool shouldCollide(const CollisionLayer &a,
+                                   const CollisionLayer &b) const {
+    return canCollide(a.group, b.group) && ::shouldCollide(a, b);
+  }
+
+  template <class Archive> void serialize(Archive &archive) {
+    archive(names, matrix);
+  }
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "physics/PhysicsWorld.hpp"
+#include <optional>
+#include <vector>
+
+// Deterministic replay: records the steps of a simulation (the time step and
+// the hash of the state after it), then replays them from the initial state
+// and reports the first step that diverged.
+// @note Changes made to the world between the steps (e.g. by scripts) are
+// not recorded, a recording is meant for the simulation alone.
+class PhysicsReplay {
+public:
+  struct Step {
+    float timeStep;
+    uint64_t hash;
+  };
+
+  // Captures the initial state, discards the recorded steps.
+  void begin(const PhysicsWorld &);
+  // Simulates one step and records it.
+  void record(PhysicsWorld &, float timeStep);
+
+  // Restores the initial state and simulates the recorded steps again.
+  // @return The index of the first step with a different hash (std::nullopt
+  // if the replay is identical).
+  [[nodiscard]] std::optional<std::size_t> verify(PhysicsWorld &) const;
+
+  [[nodiscard]] const PhysicsState &getInitialState() const;
+  [[nodiscard]] const std::vector<Step> &getSteps() const;
+
+private:
+  PhysicsState m_initialState;
+  std::vector<Step> m_steps;
+};
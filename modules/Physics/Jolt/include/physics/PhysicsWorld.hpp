@@ -2,7 +2,8 @@
 
 #include "Jolt/Jolt.h"
 #include "Jolt/Physics/PhysicsSystem.h"
-#include "Jolt/Core/JobSystemThreadPool.h"
+#include "Jolt/Core/JobSystem.h"
+#include "Jolt/Physics/Body/BodyActivationListener.h"
 
 #include "ScopedEnumFlags.hpp"
 
@@ -10,8 +11,14 @@
 #include "physics/RigidBody.hpp"
 #include "physics/Character.hpp"
 #include "physics/CharacterVirtual.hpp"
+#include "physics/BatchQueries.hpp"
+#include "physics/TempAllocator.hpp"
 #include "Transform.hpp"
 
+#include <mutex>
+#include <span>
+#include <string>
+
 struct RayCastBPResult {
   glm::vec3 position;
   uint32_t entityId;
@@ -35,13 +42,32 @@ struct ContactRemovedEvent {
   BodyUserDataPair bodyUserDataPair;
 };
 
+// In-memory snapshot of a simulation (see: PhysicsWorld::saveState).
+struct PhysicsState {
+  std::string data; // JPH::StateRecorderImpl
+
+  [[nodiscard]] bool empty() const { return data.empty(); }
+  // Identical simulations produce identical hashes (Jolt is deterministic).
+  [[nodiscard]] uint64_t hash() const;
+};
+
 class PhysicsWorld : private entt::emitter<PhysicsWorld>,
                      private JPH::ContactListener,
-                     private JPH::CharacterContactListener {
+                     private JPH::CharacterContactListener,
+                     private JPH::BodyActivationListener {
   friend class entt::emitter<PhysicsWorld>;
 
 public:
+  struct Config {
+    // Preallocated for the temporary allocations of a step (the overflow
+    // goes to malloc, see: getTempAllocatorStats).
+    uint32_t tempAllocatorSize{10 * 1024 * 1024};
+    uint32_t maxJobs{2048};
+    uint32_t maxBarriers{8};
+  };
+
   PhysicsWorld();
+  explicit PhysicsWorld(const Config &);
 
   using entt::emitter<PhysicsWorld>::on;
   using entt::emitter<PhysicsWorld>::erase;
@@ -59,6 +85,24 @@ public:
   void setGravity(const glm::vec3 &);
   [[nodiscard]] glm::vec3 getGravity() const;
 
+  struct StepSettings {
+    uint32_t collisionSteps{1}; // Minimum per simulate call.
+    // A longer time step is split into more collision steps (0 = never).
+    float maxStepSize{1.0f / 60.0f};
+
+    template <class Archive> void serialize(Archive &archive) {
+      archive(collisionSteps, maxStepSize);
+    }
+  };
+  void setStepSettings(const StepSettings &);
+  [[nodiscard]] const StepSettings &getStepSettings() const;
+  // Collision steps taken by simulate(timeStep).
+  [[nodiscard]] uint32_t getNumCollisionSteps(float timeStep) const;
+
+  // Applies to the existing bodies as well.
+  void setCollisionGroups(const CollisionGroups &);
+  [[nodiscard]] const CollisionGroups &getCollisionGroups() const;
+
   struct CreateInfo {
     const Transform &transform;
     const JPH::Shape *shape{nullptr};
@@ -83,28 +127,75 @@ public:
   [[nodiscard]] std::optional<RayCastNPResult>
   castRayNP(const glm::vec3 &from, const glm::vec3 &direction);
 
+  // -- Batched queries (NarrowPhase), executed in parallel
+  // (getSharedThreadPool). Blocks until all the results are written.
+  // @note Not during simulate.
+
+  void castRays(std::span<const RayCastQuery>, CastResults &) const;
+  void castShapes(std::span<const ShapeCastQuery>, CastResults &) const;
+  void overlapShapes(std::span<const OverlapQuery>, OverlapResults &) const;
+
   [[nodiscard]] JPH::BodyManager::BodyStats getBodyStats() const;
+  [[nodiscard]] TempAllocator::Stats getTempAllocatorStats() const;
 
   auto &getBodyInterface() { return m_physicsSystem.GetBodyInterface(); }
   auto &getBodyLockInterface() const {
     return m_physicsSystem.GetBodyLockInterface();
   }
+  // @note Only between the simulation steps (on the thread that calls
+  // simulate).
+  auto &getBodyInterfaceNoLock() {
+    return m_physicsSystem.GetBodyInterfaceNoLock();
+  }
+  auto &getBodyLockInterfaceNoLock() const {
+    return m_physicsSystem.GetBodyLockInterfaceNoLock();
+  }
+
+  // @return Bodies that moved in the last simulate: the active ones and
+  // those that went to sleep in that step (static and sleeping bodies are
+  // not included). Valid until the next simulate.
+  [[nodiscard]] std::span<const JPH::BodyID> getMovedBodies() const;
 
   void update(const Character &, Transform *, float collisionTollerance);
   void update(const CharacterVirtual &, Transform *, float timeStep);
 
+  // Call after adding a lot of (static) bodies, e.g. when a level is loaded.
+  void optimizeBroadPhase();
+
   void simulate(float timeStep);
   void debugDraw(DebugDraw &);
 
+  // Bodies, constraints, the contact cache and the given (virtual)
+  // characters. Call between the simulation steps.
+  [[nodiscard]] PhysicsState
+  saveState(std::span<const CharacterVirtual *const> = {}) const;
+  // Into the world (and the characters) the state was saved from, the
+  // bodies can't be added or removed in between.
+  // Every body is reported by getMovedBodies (until the next step).
+  // @return false if the state doesn't match the world.
+  bool restoreState(const PhysicsState &,
+                    std::span<const CharacterVirtual *const> = {});
+
   // ---
 
   template <class Archive> void save(Archive &archive) const {
-    archive(getGravity());
+    archive(getGravity(), m_collisionGroups, m_stepSettings);
   }
   template <class Archive> void load(Archive &archive) {
+    // Older scenes (JSON) end earlier, the remaining fields keep defaults.
+    const auto hasNext = [&archive] {
+      if constexpr (requires { archive.getNodeName(); }) {
+        return archive.getNodeName() != nullptr;
+      } else {
+        return true;
+      }
+    };
+
     glm::vec3 v;
     archive(v);
     setGravity(v);
+    if (hasNext()) archive(m_collisionGroups);
+    if (hasNext()) archive(m_stepSettings);
   }
 
 private:
@@ -118,6 +209,9 @@ private:
                       JPH::Vec3Arg normal,
                       JPH::CharacterContactSettings &) override;
 
+  void OnBodyActivated(const JPH::BodyID &, JPH::uint64) override;
+  void OnBodyDeactivated(const JPH::BodyID &, JPH::uint64) override;
+
 private:
   void _destroy(const JPH::BodyID);
 
@@ -132,14 +226,21 @@ private:
 private:
   JPH::PhysicsSystem m_physicsSystem;
 
-  std::unique_ptr<JPH::TempAllocator> m_tempAllocator;
-  std::unique_ptr<JPH::JobSystemThreadPool> m_jobSystem;
+  std::unique_ptr<TempAllocator> m_tempAllocator;
+  std::unique_ptr<JPH::JobSystem> m_jobSystem;
   std::unique_ptr<JPH::BroadPhaseLayerInterface> m_broadPhaseLayerInterface;
   std::unique_ptr<JPH::ObjectVsBroadPhaseLayerFilter>
     m_objectVsBroadPhaseLayerFilter;
   std::unique_ptr<JPH::ObjectLayerPairFilter> m_objectVsObjectLayerFilter;
+  CollisionGroups m_collisionGroups;
+  StepSettings m_stepSettings;
 
   DebugDrawFlags m_debugDrawFlags{DebugDrawFlags::None};
+
+  JPH::BodyIDVector m_movedBodies;
+  // OnBodyDeactivated is called from the physics jobs.
+  std::mutex m_deactivatedBodiesMutex;
+  JPH::BodyIDVector m_deactivatedBodies;
 };
 template <> struct has_flags<PhysicsWorld::DebugDrawFlags> : std::true_type {};
 
@@ -5,6 +5,7 @@
 
 #include "glm/vec3.hpp"
 #include "glm/gtc/quaternion.hpp"
+#include "math/AABB.hpp"
 
 #include <expected>
 #include <span>
@@ -15,6 +16,8 @@ struct TriangleMesh {
       uint32_t byteOffset;
       uint32_t count;
       uint32_t stride;
+      // Positions are quantized (UNorm16) within these bounds.
+      std::optional<AABB> positionBounds;
     };
     struct Index {
       uint32_t byteOffset;
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Jolt/Jolt.h"
+#include "Jolt/Core/TempAllocator.h"
+
+// Preallocated stack for the temporary allocations of a physics step.
+// Allocations that don't fit fall back to malloc (a warning is logged once).
+// Not thread safe (same as JPH::TempAllocatorImpl), Jolt uses it from one
+// thread at a time.
+class TempAllocator final : public JPH::TempAllocator {
+public:
+  explicit TempAllocator(uint32_t size);
+
+  void *Allocate(JPH::uint size) override;
+  void Free(void *address, JPH::uint size) override;
+
+  struct Stats {
+    uint32_t capacity{0};      // In bytes.
+    uint32_t highWaterMark{0}; // Peak usage of the preallocated block.
+    uint32_t numOverflows{0};  // Allocations served by malloc.
+  };
+  [[nodiscard]] Stats getStats() const;
+  void resetStats();
+
+private:
+  JPH::TempAllocatorImpl m_allocator;
+  JPH::TempAllocatorMalloc m_fallback;
+
+  uint32_t m_highWaterMark{0};
+  uint32_t m_numOverflows{0};
+  bool m_overflowReported{false};
+};
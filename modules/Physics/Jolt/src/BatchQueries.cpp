@@ -0,0 +1,46 @@
+#include "physics/BatchQueries.hpp"
+#include <cassert>
+
+//
+// QueryShape struct:
+//
+
+QueryShape QueryShape::sphere(float radius) {
+  return {.type = Type::Sphere, .size = glm::vec3{radius, 0.0f, 0.0f}};
+}
+QueryShape QueryShape::box(const glm::vec3 &halfExtents) {
+  return {.type = Type::Box, .size = halfExtents};
+}
+QueryShape QueryShape::capsule(float halfHeight, float radius) {
+  return {.type = Type::Capsule, .size = glm::vec3{radius, halfHeight, 0.0f}};
+}
+
+//
+// CastResults struct:
+//
+
+void CastResults::resize(std::size_t count) {
+  entityIds.resize(count);
+  fractions.resize(count);
+  positions.resize(count);
+  normals.resize(count);
+}
+std::size_t CastResults::size() const { return entityIds.size(); }
+bool CastResults::hasHit(std::size_t i) const {
+  assert(i < size());
+  return entityIds[i] != kNoHit;
+}
+
+//
+// OverlapResults struct:
+//
+
+void OverlapResults::resize(std::size_t count) {
+  numHits.assign(count, 0);
+  entityIds.resize(count * maxHits);
+}
+std::size_t OverlapResults::size() const { return numHits.size(); }
+std::span<const uint32_t> OverlapResults::getEntities(std::size_t i) const {
+  assert(i < size());
+  return std::span{entityIds}.subspan(i * maxHits, numHits[i]);
+}
@@ -0,0 +1,50 @@
+#include "JobSystemAdapter.hpp"
+#include <cassert>
+#include <thread> // this_thread
+
+JobSystemAdapter::JobSystemAdapter(ThreadPool &threadPool, uint32_t maxJobs,
+                                   uint32_t maxBarriers)
+    : JPH::JobSystemWithBarrier{maxBarriers}, m_threadPool{threadPool} {
+  m_jobs.Init(maxJobs, maxJobs);
+}
+JobSystemAdapter::~JobSystemAdapter() { m_threadPool.wait(m_taskGroup); }
+
+int JobSystemAdapter::GetMaxConcurrency() const {
+  // + the thread that waits on a barrier.
+  return int(m_threadPool.getNumThreads()) + 1;
+}
+
+JobSystemAdapter::JobHandle
+JobSystemAdapter::CreateJob(const char *name, JPH::ColorArg color,
+                            const JobFunction &fn,
+                            JPH::uint32 numDependencies) {
+  uint32_t index;
+  while (true) {
+    index = m_jobs.ConstructObject(name, color, this, fn, numDependencies);
+    if (index != decltype(m_jobs)::cInvalidObjectIndex) break;
+    // Out of jobs, wait for the workers to finish some.
+    assert(false && "Increase maxJobs");
+    std::this_thread::yield();
+  }
+  auto *job = &m_jobs.Get(index);
+  // The handle keeps the job alive (it might complete before QueueJob
+  // returns).
+  JobHandle handle{job};
+  if (numDependencies == 0) QueueJob(job);
+  return handle;
+}
+
+void JobSystemAdapter::QueueJob(Job *job) {
+  job->AddRef();
+  m_threadPool.run(m_taskGroup, [job] {
+    // No-op if a barrier has executed it already.
+    job->Execute();
+    job->Release();
+  });
+}
+void JobSystemAdapter::QueueJobs(Job **jobs, JPH::uint numJobs) {
+  for (auto i = 0u; i < numJobs; ++i) {
+    QueueJob(jobs[i]);
+  }
+}
+void JobSystemAdapter::FreeJob(Job *job) { m_jobs.DestructObject(job); }
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Jolt/Jolt.h"
+#include "Jolt/Core/JobSystemWithBarrier.h"
+#include "Jolt/Core/FixedSizeFreeList.h"
+
+#include "ThreadPool.hpp"
+
+// Runs the physics jobs on the engine's ThreadPool (instead of a dedicated
+// set of threads competing for the cores).
+// The thread that waits on a barrier executes the pending jobs of it.
+class JobSystemAdapter final : public JPH::JobSystemWithBarrier {
+public:
+  JobSystemAdapter(ThreadPool &, uint32_t maxJobs, uint32_t maxBarriers);
+  ~JobSystemAdapter() override;
+
+  int GetMaxConcurrency() const override;
+
+  JobHandle CreateJob(const char *name, JPH::ColorArg, const JobFunction &,
+                      JPH::uint32 numDependencies) override;
+
+protected:
+  void QueueJob(Job *) override;
+  void QueueJobs(Job **, JPH::uint numJobs) override;
+  void FreeJob(Job *) override;
+
+private:
+  ThreadPool &m_threadPool;
+  JPH::FixedSizeFreeList<Job> m_jobs;
+  // The tasks hold a reference to a job, see: ~JobSystemAdapter.
+  ThreadPool::TaskGroup m_taskGroup;
+};
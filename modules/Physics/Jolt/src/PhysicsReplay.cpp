@@ -0,0 +1,32 @@
+#include "physics/PhysicsReplay.hpp"
+#include "tracy/Tracy.hpp"
+#include <cassert>
+
+void PhysicsReplay::begin(const PhysicsWorld &world) {
+  m_initialState = world.saveState();
+  m_steps.clear();
+}
+void PhysicsReplay::record(PhysicsWorld &world, float timeStep) {
+  assert(!m_initialState.empty());
+  world.simulate(timeStep);
+  m_steps.push_back({.timeStep = timeStep, .hash = world.saveState().hash()});
+}
+
+std::optional<std::size_t> PhysicsReplay::verify(PhysicsWorld &world) const {
+  ZoneScopedN("PhysicsReplay::Verify");
+  if (!world.restoreState(m_initialState)) return 0;
+
+  for (auto i = 0u; i < m_steps.size(); ++i) {
+    const auto [timeStep, hash] = m_steps[i];
+    world.simulate(timeStep);
+    if (world.saveState().hash() != hash) return i;
+  }
+  return std::nullopt;
+}
+
+const PhysicsState &PhysicsReplay::getInitialState() const {
+  return m_initialState;
+}
+const std::vector<PhysicsReplay::Step> &PhysicsReplay::getSteps() const {
+  return m_steps;
+}
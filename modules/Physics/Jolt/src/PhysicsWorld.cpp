@@ -1,17 +1,28 @@
 #include "physics/PhysicsWorld.hpp"
 
-#include "Jolt/Core/JobSystemThreadPool.h"
 #include "Jolt/Physics/Body/BodyCreationSettings.h"
 #include "Jolt/Physics/Collision/RayCast.h"
 #include "Jolt/Physics/Collision/CastResult.h"
 #include "Jolt/Physics/Collision/CollisionCollectorImpl.h"
+#include "Jolt/Physics/Collision/ShapeCast.h"
+#include "Jolt/Physics/Collision/CollideShape.h"
+#include "Jolt/Physics/Collision/Shape/SphereShape.h"
+#include "Jolt/Physics/Collision/Shape/BoxShape.h"
+#include "Jolt/Physics/Collision/Shape/CapsuleShape.h"
+#include "Jolt/Physics/StateRecorderImpl.h"
+#include "Jolt/Core/HashCombine.h"
 
 #include "physics/JoltPhysics.hpp"
 #include "physics/Conversion.hpp"
+#include "JobSystemAdapter.hpp"
 
+#include "ThreadPool.hpp"
 #include "tracy/Tracy.hpp"
 
+#include <algorithm> // find, sort, remove
+#include <array>
 #include <cassert>
+#include <cmath> // ceil
 
 namespace {
 
@@ -31,16 +42,63 @@ namespace {
   return JPH::EMotionType::Static;
 }
 
-[[nodiscard]] auto encode(const CollisionLayer &layer) {
-  return JPH::ObjectLayer{
-    static_cast<uint16_t>(layer.group | (layer.mask << 8))};
+// Separate trees of the broad phase, so the queries of the moving bodies
+// don't walk the (large) static geometry and vice versa.
+namespace BroadPhaseLayers {
+
+constexpr auto NonMoving = 0u;
+constexpr auto Moving = 1u;
+constexpr auto Sensor = 2u;
+constexpr auto Character = 3u;
+constexpr auto kCount = 4u;
+
+// Not a tree: the object layer of a query (collides with every tree).
+constexpr auto Query = kCount;
+
+// Bit j of kMatrix[i] = objects of the layer i can collide with the
+// objects of the layer j (symmetric).
+// Static objects don't collide with each other, sensors only detect the
+// moving objects and characters.
+constexpr uint8_t kAll{(1 << kCount) - 1};
+constexpr uint8_t kDynamic{(1 << Moving) | (1 << Character)};
+constexpr std::array<uint8_t, kCount + 1> kMatrix{
+  kDynamic, // NonMoving
+  kAll,     // Moving
+  kDynamic, // Sensor
+  kAll,     // Character
+  kAll,     // Query
+};
+
+[[nodiscard]] constexpr bool canCollide(uint32_t a, uint32_t b) {
+  return kMatrix[a] & (1 << b);
+}
+
+} // namespace BroadPhaseLayers
+
+// [0..3) group, [3..11) mask, [11..14) broad phase layer.
+[[nodiscard]] auto encode(const CollisionLayer &layer,
+                          uint32_t broadPhaseLayer) {
+  return JPH::ObjectLayer(layer.group | (layer.mask << 3) |
+                          (broadPhaseLayer << 11));
 }
-[[nodiscard]] auto decode(JPH::ObjectLayer u16) {
+[[nodiscard]] auto decode(JPH::ObjectLayer objectLayer) {
   return CollisionLayer{
-    .group = uint8_t(u16 & 0xFF),
-    .mask = uint8_t((u16 >> 8) & 0xFF),
+    .group = uint8_t(objectLayer & 0x7),
+    .mask = uint8_t((objectLayer >> 3) & 0xFF),
   };
 }
+[[nodiscard]] uint32_t getBroadPhaseLayer(JPH::ObjectLayer objectLayer) {
+  return (objectLayer >> 11) & 0x7;
+}
+static_assert(CollisionLayer::kNumGroups <= 8);
+
+[[nodiscard]] auto getBroadPhaseLayer(const RigidBody::Settings &settings,
+                                      const JPH::Shape &shape) {
+  if (settings.isSensor) return BroadPhaseLayers::Sensor;
+  return settings.motionType == MotionType::Static || shape.MustBeStatic()
+           ? BroadPhaseLayers::NonMoving
+           : BroadPhaseLayers::Moving;
+}
 
 [[nodiscard]] auto makeSettings(const RigidBody::Settings &settings,
                                 const PhysicsWorld::CreateInfo &createInfo) {
@@ -51,7 +109,7 @@ namespace {
     to_Jolt(createInfo.transform.getPosition()),
     to_Jolt(createInfo.transform.getOrientation()),
     convert(settings.motionType),
-    encode(settings.layer),
+    encode(settings.layer, getBroadPhaseLayer(settings, *createInfo.shape)),
   };
   out.mIsSensor = settings.isSensor;
   out.mFriction = settings.friction;
@@ -85,7 +143,7 @@ namespace {
   JPH::CharacterSettings out;
   out.mMaxSlopeAngle = glm::radians(settings.maxSlopeAngle);
   out.mShape = shape;
-  out.mLayer = encode(settings.layer);
+  out.mLayer = encode(settings.layer, BroadPhaseLayers::Character);
 
   out.mMass = settings.mass;
   out.mFriction = settings.friction;
@@ -119,29 +177,131 @@ class BPLayerInterface final : public JPH::BroadPhaseLayerInterface {
 public:
   BPLayerInterface() = default;
 
-  uint32_t GetNumBroadPhaseLayers() const override { return 1; }
+  uint32_t GetNumBroadPhaseLayers() const override {
+    return BroadPhaseLayers::kCount;
+  }
 
   JPH::BroadPhaseLayer
   GetBroadPhaseLayer(JPH::ObjectLayer layer) const override {
-    return JPH::BroadPhaseLayer{};
+    const auto broadPhaseLayer = getBroadPhaseLayer(layer);
+    return JPH::BroadPhaseLayer(broadPhaseLayer < BroadPhaseLayers::kCount
+                                  ? broadPhaseLayer
+                                  : BroadPhaseLayers::Moving);
   }
 
 #if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
   const char *
   GetBroadPhaseLayerName(JPH::BroadPhaseLayer layer) const override {
-    return "Default";
+    switch (JPH::BroadPhaseLayer::Type(layer)) {
+    case BroadPhaseLayers::NonMoving:
+      return "NonMoving";
+    case BroadPhaseLayers::Moving:
+      return "Moving";
+    case BroadPhaseLayers::Sensor:
+      return "Sensor";
+    case BroadPhaseLayers::Character:
+      return "Character";
+    }
+    return "Invalid";
   }
 #endif
 };
 
+class ObjectVsBroadPhaseLayerFilter final
+    : public JPH::ObjectVsBroadPhaseLayerFilter {
+public:
+  bool ShouldCollide(JPH::ObjectLayer objectLayer,
+                     JPH::BroadPhaseLayer broadPhaseLayer) const override {
+    return BroadPhaseLayers::canCollide(
+      getBroadPhaseLayer(objectLayer),
+      JPH::BroadPhaseLayer::Type(broadPhaseLayer));
+  }
+};
+
 class ObjectLayerPairFilter final : public JPH::ObjectLayerPairFilter {
 public:
+  explicit ObjectLayerPairFilter(const CollisionGroups &collisionGroups)
+      : m_collisionGroups{collisionGroups} {}
+
   bool ShouldCollide(JPH::ObjectLayer object1,
                      JPH::ObjectLayer object2) const override {
-    const auto a = decode(object1);
-    const auto b = decode(object2);
-    return ((1 << a.group) & b.mask) || ((1 << b.group) & a.mask);
+    return BroadPhaseLayers::canCollide(getBroadPhaseLayer(object1),
+                                        getBroadPhaseLayer(object2)) &&
+           m_collisionGroups.shouldCollide(decode(object1), decode(object2));
   }
+
+private:
+  const CollisionGroups &m_collisionGroups;
+};
+
+// A ray against a static mesh takes ~1us, a task per query would be too
+// fine-grained.
+constexpr auto kQueryGrainSize = 64;
+
+// Calls fn with a Jolt shape (on the stack, no allocations).
+template <typename Fn> void withShape(const QueryShape &in, Fn &&fn) {
+  constexpr auto kMinExtent = 1e-3f;
+  switch (in.type) {
+    using enum QueryShape::Type;
+
+  case Sphere: {
+    JPH::SphereShape shape{std::max(in.size.x, kMinExtent)};
+    shape.SetEmbedded();
+    fn(shape);
+  } break;
+  case Box: {
+    const auto halfExtents = glm::max(in.size, kMinExtent);
+    const auto convexRadius = std::min(
+      {JPH::cDefaultConvexRadius, halfExtents.x, halfExtents.y, halfExtents.z});
+    JPH::BoxShape shape{to_Jolt(halfExtents), convexRadius};
+    shape.SetEmbedded();
+    fn(shape);
+  } break;
+  case Capsule: {
+    JPH::CapsuleShape shape{std::max(in.size.y, kMinExtent),
+                            std::max(in.size.x, kMinExtent)};
+    shape.SetEmbedded();
+    fn(shape);
+  } break;
+  }
+}
+
+void setNoHit(CastResults &results, std::size_t i) {
+  results.entityIds[i] = CastResults::kNoHit;
+  results.fractions[i] = 1.0f;
+  results.positions[i] = glm::vec3{0.0f};
+  results.normals[i] = glm::vec3{0.0f};
+}
+
+[[nodiscard]] uint32_t getEntityId(const JPH::BodyLockInterface &lockInterface,
+                                   const JPH::BodyID &bodyId) {
+  const JPH::BodyLockRead lock{lockInterface, bodyId};
+  return lock.Succeeded() ? static_cast<uint32_t>(lock.GetBody().GetUserData())
+                          : CastResults::kNoHit;
+}
+
+// Collects (unique) bodies into a fixed size storage.
+// Bodies are stored as uint32 (JPH::BodyID::GetIndexAndSequenceNumber), the
+// body locks can't be taken here (CollideShape holds one).
+class BodyCollector final : public JPH::CollideShapeCollector {
+public:
+  explicit BodyCollector(std::span<uint32_t> storage) : m_storage{storage} {}
+
+  void AddHit(const JPH::CollideShapeResult &result) override {
+    const auto id = result.mBodyID2.GetIndexAndSequenceNumber();
+    if (std::ranges::find(getBodies(), id) != getBodies().end()) return;
+
+    m_storage[m_numBodies++] = id;
+    if (m_numBodies == m_storage.size()) ForceEarlyOut();
+  }
+
+  [[nodiscard]] std::span<uint32_t> getBodies() const {
+    return m_storage.first(m_numBodies);
+  }
+
+private:
+  std::span<uint32_t> m_storage;
+  std::size_t m_numBodies{0};
 };
 
 [[nodiscard]] auto
@@ -155,11 +315,20 @@ isNewContact(const JPH::CharacterVirtual::ContactList &activeContacts,
 
 } // namespace
 
+//
+// PhysicsState struct:
+//
+
+uint64_t PhysicsState::hash() const {
+  return JPH::HashBytes(data.data(), uint32_t(data.size()));
+}
+
 //
 // PhysicsWorld class:
 //
 
-PhysicsWorld::PhysicsWorld() {
+PhysicsWorld::PhysicsWorld() : PhysicsWorld{Config{}} {}
+PhysicsWorld::PhysicsWorld(const Config &config) {
   // This is the max amount of rigid bodies that you can add to the physics
   // system. If you try to add more you'll get an error. Note: This value is low
   // because this is a simple test. For a real project use something in the
@@ -191,41 +360,22 @@ PhysicsWorld::PhysicsWorld() {
   // so this instance needs to stay alive!
   m_broadPhaseLayerInterface = std::make_unique<BPLayerInterface>();
   m_objectVsBroadPhaseLayerFilter =
-    std::make_unique<JPH::ObjectVsBroadPhaseLayerFilter>();
-  m_objectVsObjectLayerFilter = std::make_unique<ObjectLayerPairFilter>();
+    std::make_unique<ObjectVsBroadPhaseLayerFilter>();
+  m_objectVsObjectLayerFilter =
+    std::make_unique<ObjectLayerPairFilter>(m_collisionGroups);
 
   m_physicsSystem.Init(kMaxBodies, kNumBodyMutexes, kMaxBodyPairs,
                        kMaxContactConstraints, *m_broadPhaseLayerInterface,
                        *m_objectVsBroadPhaseLayerFilter,
                        *m_objectVsObjectLayerFilter);
   m_physicsSystem.SetContactListener(this);
+  m_physicsSystem.SetBodyActivationListener(this);
 
-  // We need a temp allocator for temporary allocations during the physics
-  // update.
-#if 0
-  // We're pre-allocating 10 MB to avoid having to do allocations during
-  // the physics update. B.t.w. 10 MB is way too much for this example but it is
-  // a typical value you can use. If you don't want to pre-allocate you can also
-  // use TempAllocatorMalloc to fall back to malloc / free.
-  m_tempAllocator = std::make_unique<JPH::TempAllocatorImpl>(10 * 1024 * 1024);
-#else
-  m_tempAllocator = std::make_unique<JPH::TempAllocatorMalloc>();
-#endif
-
-  // Maximum amount of jobs to allow
-  constexpr auto kMaxPhysicsJobs = 2048;
-
-  // Maximum amount of barriers to allow
-  constexpr auto kMaxPhysicsBarriers = 8;
-
-  // We need a job system that will execute physics jobs on multiple threads.
-  // Typically you would implement the JobSystem interface yourself and let Jolt
-  // Physics run on top of your own job scheduler. JobSystemThreadPool is an
-  // example implementation.
-
-  const auto numThreads = std::thread::hardware_concurrency() - 1;
-  m_jobSystem = std::make_unique<JPH::JobSystemThreadPool>(
-    kMaxPhysicsJobs, kMaxPhysicsBarriers, numThreads);
+  // Preallocated, so a step doesn't hit malloc (unless it overflows).
+  m_tempAllocator = std::make_unique<TempAllocator>(config.tempAllocatorSize);
+  // Shares the workers with the rest of the engine (animation, culling, ...).
+  m_jobSystem = std::make_unique<JobSystemAdapter>(
+    getSharedThreadPool(), config.maxJobs, config.maxBarriers);
 }
 
 void PhysicsWorld::setDebugDrawFlags(const DebugDrawFlags flags) {
@@ -242,6 +392,29 @@ glm::vec3 PhysicsWorld::getGravity() const {
   return to_glm(m_physicsSystem.GetGravity());
 }
 
+void PhysicsWorld::setStepSettings(const StepSettings &settings) {
+  m_stepSettings = settings;
+}
+const PhysicsWorld::StepSettings &PhysicsWorld::getStepSettings() const {
+  return m_stepSettings;
+}
+uint32_t PhysicsWorld::getNumCollisionSteps(float timeStep) const {
+  const auto [collisionSteps, maxStepSize] = m_stepSettings;
+  auto n = std::max(collisionSteps, 1u);
+  if (maxStepSize > 0.0f) {
+    n = std::max(n, uint32_t(std::ceil(timeStep / maxStepSize)));
+  }
+  return n;
+}
+
+void PhysicsWorld::setCollisionGroups(const CollisionGroups &collisionGroups) {
+  // The pair filter reads the table (by reference).
+  m_collisionGroups = collisionGroups;
+}
+const CollisionGroups &PhysicsWorld::getCollisionGroups() const {
+  return m_collisionGroups;
+}
+
 void PhysicsWorld::initBody(RigidBody &rb, const CreateInfo &createInfo) {
   rb.m_bodyId = _createBody(rb.m_settings, createInfo);
   rb.m_joltPhysics = &m_physicsSystem;
@@ -273,7 +446,7 @@ void PhysicsWorld::setCollisionShape(Character &c, const JPH::Shape *shape) {
 void PhysicsWorld::setCollisionShape(CharacterVirtual &c,
                                      const JPH::Shape *shape) {
   if (c && shape) {
-    const auto layer = encode(c.m_settings.layer);
+    const auto layer = encode(c.m_settings.layer, BroadPhaseLayers::Character);
     // clang-format off
     c.m_character->SetShape(
       shape,
@@ -336,9 +509,138 @@ PhysicsWorld::castRayNP(const glm::vec3 &from, const glm::vec3 &direction) {
   };
 }
 
+void PhysicsWorld::castRays(std::span<const RayCastQuery> queries,
+                            CastResults &results) const {
+  ZoneScopedN("PhysicsWorld::CastRays");
+  results.resize(queries.size());
+
+  const auto &narrowPhase = m_physicsSystem.GetNarrowPhaseQuery();
+  const auto &lockInterface = m_physicsSystem.GetBodyLockInterface();
+  parallelFor(
+    getSharedThreadPool(), queries.size(), kQueryGrainSize,
+    [&](std::size_t begin, std::size_t end) {
+      ZoneScopedN("PhysicsWorld::CastRaysChunk");
+      for (auto i = begin; i < end; ++i) {
+        setNoHit(results, i);
+
+        const auto &[from, direction, layer] = queries[i];
+        const auto objectLayer = encode(layer, BroadPhaseLayers::Query);
+        const JPH::RRayCast ray{to_Jolt(from), to_Jolt(direction)};
+        JPH::RayCastResult hit;
+        if (!narrowPhase.CastRay(
+              ray, hit,
+              m_physicsSystem.GetDefaultBroadPhaseLayerFilter(objectLayer),
+              m_physicsSystem.GetDefaultLayerFilter(objectLayer))) {
+          continue;
+        }
+        const JPH::BodyLockRead lock{lockInterface, hit.mBodyID};
+        if (!lock.Succeeded()) continue;
+
+        const auto &body = lock.GetBody();
+        const auto position = ray.GetPointOnRay(hit.mFraction);
+        results.entityIds[i] = static_cast<uint32_t>(body.GetUserData());
+        results.fractions[i] = hit.mFraction;
+        results.positions[i] = to_glm(position);
+        results.normals[i] = to_glm(
+          body.GetWorldSpaceSurfaceNormal(hit.mSubShapeID2, position));
+      }
+    });
+}
+void PhysicsWorld::castShapes(std::span<const ShapeCastQuery> queries,
+                              CastResults &results) const {
+  ZoneScopedN("PhysicsWorld::CastShapes");
+  results.resize(queries.size());
+
+  const auto &narrowPhase = m_physicsSystem.GetNarrowPhaseQuery();
+  const auto &lockInterface = m_physicsSystem.GetBodyLockInterface();
+  parallelFor(
+    getSharedThreadPool(), queries.size(), kQueryGrainSize,
+    [&](std::size_t begin, std::size_t end) {
+      ZoneScopedN("PhysicsWorld::CastShapesChunk");
+      for (auto i = begin; i < end; ++i) {
+        setNoHit(results, i);
+
+        const auto &query = queries[i];
+        const auto objectLayer = encode(query.layer, BroadPhaseLayers::Query);
+        withShape(query.shape, [&](const JPH::Shape &shape) {
+          const auto from = to_Jolt(query.from);
+          const JPH::RShapeCast shapeCast{
+            &shape,
+            JPH::Vec3::sReplicate(1.0f),
+            JPH::RMat44::sRotationTranslation(to_Jolt(query.rotation), from),
+            to_Jolt(query.direction),
+          };
+          JPH::ClosestHitCollisionCollector<JPH::CastShapeCollector> collector;
+          // Contact points are relative to the base offset.
+          narrowPhase.CastShape(
+            shapeCast, JPH::ShapeCastSettings{}, from, collector,
+            m_physicsSystem.GetDefaultBroadPhaseLayerFilter(objectLayer),
+            m_physicsSystem.GetDefaultLayerFilter(objectLayer));
+          if (!collector.HadHit()) return;
+
+          const auto &hit = collector.mHit;
+          const auto entityId = getEntityId(lockInterface, hit.mBodyID2);
+          if (entityId == CastResults::kNoHit) return;
+
+          results.entityIds[i] = entityId;
+          results.fractions[i] = hit.mFraction;
+          results.positions[i] = to_glm(from + hit.mContactPointOn2);
+          results.normals[i] =
+            to_glm(-hit.mPenetrationAxis.NormalizedOr(JPH::Vec3::sZero()));
+        });
+      }
+    });
+}
+void PhysicsWorld::overlapShapes(std::span<const OverlapQuery> queries,
+                                 OverlapResults &results) const {
+  ZoneScopedN("PhysicsWorld::OverlapShapes");
+  results.resize(queries.size());
+  if (results.maxHits == 0) return;
+
+  const auto &narrowPhase = m_physicsSystem.GetNarrowPhaseQuery();
+  const auto &lockInterface = m_physicsSystem.GetBodyLockInterface();
+  parallelFor(
+    getSharedThreadPool(), queries.size(), kQueryGrainSize,
+    [&](std::size_t begin, std::size_t end) {
+      ZoneScopedN("PhysicsWorld::OverlapShapesChunk");
+      for (auto i = begin; i < end; ++i) {
+        const auto &query = queries[i];
+        const auto objectLayer = encode(query.layer, BroadPhaseLayers::Query);
+        BodyCollector collector{std::span{results.entityIds}.subspan(
+          i * results.maxHits, results.maxHits)};
+        withShape(query.shape, [&](const JPH::Shape &shape) {
+          const auto position = to_Jolt(query.position);
+          narrowPhase.CollideShape(
+            &shape, JPH::Vec3::sReplicate(1.0f),
+            JPH::RMat44::sRotationTranslation(to_Jolt(query.rotation),
+                                              position),
+            JPH::CollideShapeSettings{}, position, collector,
+            m_physicsSystem.GetDefaultBroadPhaseLayerFilter(objectLayer),
+            m_physicsSystem.GetDefaultLayerFilter(objectLayer));
+        });
+        // Bodies -> entities (in place).
+        auto entities = collector.getBodies();
+        for (auto &id : entities) {
+          id = getEntityId(lockInterface, JPH::BodyID{id});
+        }
+        const auto removed = std::ranges::remove(entities, CastResults::kNoHit);
+        entities = entities.first(entities.size() - removed.size());
+        std::ranges::sort(entities);
+        results.numHits[i] = uint32_t(entities.size());
+      }
+    });
+}
+
 JPH::BodyManager::BodyStats PhysicsWorld::getBodyStats() const {
   return m_physicsSystem.GetBodyStats();
 }
+TempAllocator::Stats PhysicsWorld::getTempAllocatorStats() const {
+  return m_tempAllocator->getStats();
+}
+
+std::span<const JPH::BodyID> PhysicsWorld::getMovedBodies() const {
+  return {m_movedBodies.data(), m_movedBodies.size()};
+}
 
 void PhysicsWorld::update(const Character &c, Transform *xf,
                           float collisionTollerance) {
@@ -370,7 +672,7 @@ void PhysicsWorld::update(const CharacterVirtual &c, Transform *xf,
     updateSettings.mWalkStairsStepUp = JPH::Vec3::sZero();
   }
 
-  const auto layer = encode(c.m_settings.layer);
+  const auto layer = encode(c.m_settings.layer, BroadPhaseLayers::Character);
 
   // clang-format off
   character->ExtendedUpdate(
@@ -388,14 +690,52 @@ void PhysicsWorld::update(const CharacterVirtual &c, Transform *xf,
   if (xf) setTransform(character->GetWorldTransform(), *xf);
 }
 
+void PhysicsWorld::optimizeBroadPhase() {
+  ZoneScopedN("PhysicsWorld::OptimizeBroadPhase");
+  m_physicsSystem.OptimizeBroadPhase();
+}
+
+PhysicsState PhysicsWorld::saveState(
+  std::span<const CharacterVirtual *const> characters) const {
+  ZoneScopedN("PhysicsWorld::SaveState");
+  JPH::StateRecorderImpl recorder;
+  m_physicsSystem.SaveState(recorder);
+  for (const auto *c : characters) {
+    if (c && *c) c->m_character->SaveState(recorder);
+  }
+  return PhysicsState{.data = recorder.GetData()};
+}
+bool PhysicsWorld::restoreState(
+  const PhysicsState &state,
+  std::span<const CharacterVirtual *const> characters) {
+  ZoneScopedN("PhysicsWorld::RestoreState");
+  JPH::StateRecorderImpl recorder;
+  recorder.WriteBytes(state.data.data(), state.data.size());
+  if (!m_physicsSystem.RestoreState(recorder)) return false;
+  for (const auto *c : characters) {
+    if (c && *c) c->m_character->RestoreState(recorder);
+  }
+  if (recorder.IsFailed()) return false;
+
+  // Sleeping bodies might have been moved as well.
+  m_physicsSystem.GetBodies(m_movedBodies);
+  return true;
+}
+
 void PhysicsWorld::simulate(float timeStep) {
   ZoneScopedN("PhysicsWorld::Simulate");
-  // If you take larger steps than 1 / 60th of a second you need to do multiple
-  // collision steps in order to keep the simulation stable. Do 1 collision step
-  // per 1 / 60th of a second (round up).
-  constexpr auto kCollisionSteps = 1;
-  m_physicsSystem.Update(timeStep, kCollisionSteps, m_tempAllocator.get(),
-                         m_jobSystem.get());
+  {
+    // Bodies removed (or put to sleep) outside of the step.
+    std::scoped_lock lock{m_deactivatedBodiesMutex};
+    m_deactivatedBodies.clear();
+  }
+  m_physicsSystem.Update(timeStep, getNumCollisionSteps(timeStep),
+                         m_tempAllocator.get(), m_jobSystem.get());
+
+  m_physicsSystem.GetActiveBodies(JPH::EBodyType::RigidBody, m_movedBodies);
+  std::scoped_lock lock{m_deactivatedBodiesMutex};
+  m_movedBodies.insert(m_movedBodies.end(), m_deactivatedBodies.cbegin(),
+                       m_deactivatedBodies.cend());
 }
 void PhysicsWorld::debugDraw(DebugDraw &dd) {
   if (m_debugDrawFlags == DebugDrawFlags::None) return;
@@ -465,6 +805,13 @@ void PhysicsWorld::OnContactAdded(const JPH::CharacterVirtual *character,
   });
 }
 
+void PhysicsWorld::OnBodyActivated(const JPH::BodyID &, JPH::uint64) {}
+void PhysicsWorld::OnBodyDeactivated(const JPH::BodyID &bodyId, JPH::uint64) {
+  // The final transform (of the step in which the body went to sleep).
+  std::scoped_lock lock{m_deactivatedBodiesMutex};
+  m_deactivatedBodies.push_back(bodyId);
+}
+
 void PhysicsWorld::_destroy(const JPH::BodyID bodyId) {
   if (!bodyId.IsInvalid()) {
     auto &bodyInterface = m_physicsSystem.GetBodyInterface();
@@ -21,6 +21,9 @@ static void from_json(const json &j, TriangleMesh::Info::Vertex &out) {
   j.at("byteOffset").get_to(out.byteOffset);
   j.at("count").get_to(out.count);
   j.at("stride").get_to(out.stride);
+  if (j.contains("positionBounds")) {
+    out.positionBounds = j.at("positionBounds").get<AABB>();
+  }
 }
 static void from_json(const json &j, TriangleMesh::Info::Index &out) {
   j.at("byteOffset").get_to(out.byteOffset);
@@ -105,6 +108,16 @@ template <typename T, typename Func>
   return convert(in, [](const auto &v) { return to_Jolt(v); });
 }
 
+[[nodiscard]] JPH::Float3 readPosition(const std::byte *vertex,
+                                       const std::optional<AABB> &bounds) {
+  if (!bounds) return *std::bit_cast<const JPH::Float3 *>(vertex);
+
+  const auto *q = std::bit_cast<const uint16_t *>(vertex);
+  const auto v = bounds->min + glm::vec3{q[0], q[1], q[2]} / float(UINT16_MAX) *
+                                 (bounds->max - bounds->min);
+  return {v.x, v.y, v.z};
+}
+
 struct RawMesh {
   JPH::VertexList vertices;
   JPH::IndexedTriangleList triangles;
@@ -140,7 +153,7 @@ struct RawMesh {
       meta.vertices.byteOffset + (subMesh.vertexOffset * vertexStride);
     for (auto i = 0u; i < subMesh.numVertices; ++i) {
       const auto vertex = &buffer[baseVertexIdx + (i * vertexStride)];
-      vertices.push_back(*std::bit_cast<const JPH::Float3 *>(vertex));
+      vertices.push_back(readPosition(vertex, meta.vertices.positionBounds));
     }
 
     const auto &LOD = subMesh.LODs.back();
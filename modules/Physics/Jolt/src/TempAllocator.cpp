@@ -0,0 +1,41 @@
+#include "physics/TempAllocator.hpp"
+#include "spdlog/spdlog.h"
+#include <algorithm> // max
+
+TempAllocator::TempAllocator(uint32_t size) : m_allocator{size} {}
+
+void *TempAllocator::Allocate(JPH::uint size) {
+  if (m_allocator.CanAllocate(size)) {
+    auto *ptr = m_allocator.Allocate(size);
+    m_highWaterMark = std::max(m_highWaterMark, m_allocator.GetUsage());
+    return ptr;
+  }
+  ++m_numOverflows;
+  if (!m_overflowReported) {
+    SPDLOG_WARN("Physics temp allocator ({} bytes) is full, falling back to "
+                "malloc ({} bytes).",
+                m_allocator.GetSize(), size);
+    m_overflowReported = true;
+  }
+  return m_fallback.Allocate(size);
+}
+void TempAllocator::Free(void *address, JPH::uint size) {
+  if (m_allocator.OwnsMemory(address)) {
+    m_allocator.Free(address, size);
+  } else {
+    m_fallback.Free(address, size);
+  }
+}
+
+TempAllocator::Stats TempAllocator::getStats() const {
+  return {
+    .capacity = m_allocator.GetSize(),
+    .highWaterMark = m_highWaterMark,
+    .numOverflows = m_numOverflows,
+  };
+}
+void TempAllocator::resetStats() {
+  m_highWaterMark = m_allocator.GetUsage();
+  m_numOverflows = 0;
+  m_overflowReported = false;
+}
@@ -0,0 +1,313 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include "physics/PhysicsWorld.hpp"
+#include "physics/JoltPhysics.hpp"
+
+#include "Jolt/Physics/Collision/Shape/MeshShape.h"
+#include "Jolt/Physics/Collision/Shape/BoxShape.h"
+#include "Jolt/Physics/Collision/Shape/SphereShape.h"
+
+#include "glm/geometric.hpp" // dot
+
+#include <array>
+#include <cmath> // sin, cos, sqrt, ceil
+#include <deque>
+
+namespace {
+
+constexpr auto kTerrainId = 1u;
+constexpr auto kGridSize = 64;     // Quads per side.
+constexpr auto kCellSize = 2.0f;   // [0..128] on X and Z.
+constexpr auto kNumRays = 100'000; // Benchmark.
+
+[[nodiscard]] float getHeight(int x, int z) {
+  return std::sin(float(x) * 0.3f) + std::cos(float(z) * 0.2f);
+}
+
+// A static triangle mesh (kGridSize x kGridSize quads).
+[[nodiscard]] JPH::RefConst<JPH::Shape> makeTerrain(bool flat) {
+  const auto vertex = [flat](int x, int z) {
+    return JPH::Float3{float(x) * kCellSize, flat ? 0.0f : getHeight(x, z),
+                       float(z) * kCellSize};
+  };
+  JPH::TriangleList triangles;
+  triangles.reserve(kGridSize * kGridSize * 2);
+  for (auto z = 0; z < kGridSize; ++z) {
+    for (auto x = 0; x < kGridSize; ++x) {
+      const auto v0 = vertex(x, z);
+      const auto v1 = vertex(x + 1, z);
+      const auto v2 = vertex(x, z + 1);
+      const auto v3 = vertex(x + 1, z + 1);
+      triangles.emplace_back(v0, v2, v1);
+      triangles.emplace_back(v1, v2, v3);
+    }
+  }
+  const auto result = JPH::MeshShapeSettings{triangles}.Create();
+  REQUIRE(result.IsValid());
+  return result.Get();
+}
+
+struct Scene {
+  explicit Scene(bool flat = false) : terrain{makeTerrain(flat)} {
+    addBody(terrain, glm::vec3{0.0f}, kTerrainId);
+  }
+
+  RigidBody &addBody(const JPH::Shape *shape, const glm::vec3 &position,
+                     uint32_t userData, const CollisionLayer &layer = {}) {
+    return addBody(shape, position, userData,
+                   RigidBody::Settings{.layer = layer});
+  }
+  RigidBody &addBody(const JPH::Shape *shape, const glm::vec3 &position,
+                     uint32_t userData, const RigidBody::Settings &settings) {
+    auto &rb = bodies.emplace_back(settings);
+    world.initBody(rb, {
+                         .transform = Transform{position},
+                         .shape = shape,
+                         .userData = userData,
+                       });
+    return rb;
+  }
+
+  PhysicsWorld world;
+  JPH::RefConst<JPH::Shape> terrain;
+  std::deque<RigidBody> bodies;
+};
+
+// Deterministic: a grid of rays (slightly tilted) above the terrain.
+[[nodiscard]] std::vector<RayCastQuery> makeRays(int count) {
+  const auto side = int(std::ceil(std::sqrt(float(count))));
+  const auto step = kGridSize * kCellSize / float(side);
+  std::vector<RayCastQuery> rays;
+  rays.reserve(count);
+  for (auto i = 0; i < count; ++i) {
+    rays.push_back({
+      .from = glm::vec3{(float(i % side) + 0.5f) * step, 10.0f,
+                        (float(i / side) + 0.5f) * step},
+      .direction = glm::vec3{0.1f, -20.0f, -0.1f},
+    });
+  }
+  return rays;
+}
+
+} // namespace
+
+TEST_CASE("Ray casts") {
+  Scene scene;
+  auto &world = scene.world;
+  const auto rays = makeRays(1000);
+
+  CastResults results;
+  world.castRays(rays, results);
+  REQUIRE(results.size() == rays.size());
+
+  for (auto i = 0u; i < rays.size(); ++i) {
+    const auto expected = world.castRayNP(rays[i].from, rays[i].direction);
+    REQUIRE(expected.has_value() == results.hasHit(i));
+    if (!expected) continue;
+
+    REQUIRE(results.entityIds[i] == kTerrainId);
+    REQUIRE(results.positions[i].x == Approx{expected->position.x});
+    REQUIRE(results.positions[i].y == Approx{expected->position.y});
+    REQUIRE(results.positions[i].z == Approx{expected->position.z});
+    REQUIRE(glm::dot(results.normals[i], expected->normal) ==
+            Approx{1.0f}.margin(1e-4f));
+  }
+
+  SECTION("Miss") {
+    const std::array miss{RayCastQuery{
+      .from = glm::vec3{0.0f, 10.0f, 0.0f},
+      .direction = glm::vec3{0.0f, 5.0f, 0.0f},
+    }};
+    world.castRays(miss, results);
+    REQUIRE(results.size() == 1);
+    REQUIRE_FALSE(results.hasHit(0));
+  }
+}
+
+TEST_CASE("Collision layers") {
+  Scene scene{true};
+  const JPH::RefConst<JPH::Shape> box =
+    new JPH::BoxShape{JPH::Vec3::sReplicate(1.0f)};
+  scene.addBody(box, glm::vec3{10.0f, 5.0f, 10.0f}, 2,
+                CollisionLayer{.group = 1, .mask = 1 << 1});
+
+  RayCastQuery query{
+    .from = glm::vec3{10.0f, 20.0f, 10.0f},
+    .direction = glm::vec3{0.0f, -40.0f, 0.0f},
+  };
+  CastResults results;
+
+  // The default layer (group 0) collides with the terrain only.
+  scene.world.castRays({&query, 1}, results);
+  REQUIRE(results.entityIds[0] == kTerrainId);
+
+  query.layer = CollisionLayer{.group = 1, .mask = 1 << 1};
+  scene.world.castRays({&query, 1}, results);
+  REQUIRE(results.entityIds[0] == 2);
+  REQUIRE(results.positions[0].y == Approx{6.0f});
+}
+
+TEST_CASE("Collision groups") {
+  Scene scene{true};
+  const JPH::RefConst<JPH::Shape> box =
+    new JPH::BoxShape{JPH::Vec3::sReplicate(1.0f)};
+  constexpr CollisionLayer kLayer{.group = 1, .mask = (1 << 0) | (1 << 1)};
+  scene.addBody(box, glm::vec3{10.0f, 5.0f, 10.0f}, 2, kLayer);
+
+  const RayCastQuery query{
+    .from = glm::vec3{10.0f, 20.0f, 10.0f},
+    .direction = glm::vec3{0.0f, -40.0f, 0.0f},
+    .layer = kLayer,
+  };
+  CastResults results;
+  scene.world.castRays({&query, 1}, results);
+  REQUIRE(results.entityIds[0] == 2);
+
+  // The table overrides the masks.
+  auto groups = scene.world.getCollisionGroups();
+  REQUIRE(groups.canCollide(1, 1));
+  scene.world.setCollisionGroups(groups.set(1, 1, false));
+  REQUIRE_FALSE(scene.world.getCollisionGroups().canCollide(1, 1));
+  scene.world.castRays({&query, 1}, results);
+  REQUIRE(results.entityIds[0] == kTerrainId);
+
+  scene.world.setCollisionGroups(groups.set(0, 1, false));
+  scene.world.castRays({&query, 1}, results);
+  REQUIRE_FALSE(results.hasHit(0));
+}
+
+TEST_CASE("Shape casts") {
+  Scene scene{true};
+  const std::array queries{
+    ShapeCastQuery{
+      .shape = QueryShape::sphere(0.5f),
+      .from = glm::vec3{10.0f, 10.0f, 10.0f},
+      .direction = glm::vec3{0.0f, -20.0f, 0.0f},
+    },
+    ShapeCastQuery{
+      .shape = QueryShape::box(glm::vec3{0.5f, 1.0f, 0.5f}),
+      .from = glm::vec3{20.0f, 10.0f, 20.0f},
+      .direction = glm::vec3{0.0f, -20.0f, 0.0f},
+    },
+    ShapeCastQuery{
+      .shape = QueryShape::capsule(1.0f, 0.5f),
+      .from = glm::vec3{30.0f, 10.0f, 30.0f},
+      .direction = glm::vec3{0.0f, 5.0f, 0.0f},
+    },
+  };
+  CastResults results;
+  scene.world.castShapes(queries, results);
+  REQUIRE(results.size() == 3);
+
+  // The bottom of a shape touches the ground (y = 0).
+  REQUIRE(results.hasHit(0));
+  REQUIRE(results.fractions[0] * 20.0f == Approx{9.5f}.margin(0.01f));
+  REQUIRE(results.normals[0].y == Approx{1.0f}.margin(1e-3f));
+  REQUIRE(results.hasHit(1));
+  REQUIRE(results.fractions[1] * 20.0f == Approx{9.0f}.margin(0.01f));
+  REQUIRE_FALSE(results.hasHit(2)); // Upwards.
+}
+
+TEST_CASE("Overlaps") {
+  Scene scene{true};
+  const JPH::RefConst<JPH::Shape> box =
+    new JPH::BoxShape{JPH::Vec3::sReplicate(0.5f)};
+  scene.addBody(box, glm::vec3{12.0f, 5.0f, 10.0f}, 3);
+  scene.addBody(box, glm::vec3{10.0f, 5.0f, 10.0f}, 2);
+  scene.addBody(box, glm::vec3{20.0f, 5.0f, 10.0f}, 4);
+
+  const std::array queries{
+    OverlapQuery{
+      .shape = QueryShape::sphere(1.0f),
+      .position = glm::vec3{11.0f, 5.0f, 10.0f},
+    },
+    OverlapQuery{
+      .shape = QueryShape::box(glm::vec3{1.0f}),
+      .position = glm::vec3{50.0f, 50.0f, 50.0f},
+    },
+  };
+  OverlapResults results;
+  scene.world.overlapShapes(queries, results);
+  REQUIRE(results.size() == 2);
+
+  const auto entities = results.getEntities(0);
+  REQUIRE(std::vector(entities.begin(), entities.end()) ==
+          std::vector<uint32_t>{2, 3});
+  REQUIRE(results.getEntities(1).empty());
+
+  SECTION("Max hits") {
+    results.maxHits = 1;
+    scene.world.overlapShapes(queries, results);
+    REQUIRE(results.getEntities(0).size() == 1);
+  }
+}
+
+TEST_CASE("Ray cast benchmark", "[.benchmark]") {
+  Scene scene;
+  auto &world = scene.world;
+  world.optimizeBroadPhase();
+  const auto rays = makeRays(kNumRays);
+
+  BENCHMARK("castRayNP") {
+    auto numHits = 0;
+    for (const auto &[from, direction, _] : rays) {
+      numHits += world.castRayNP(from, direction).has_value();
+    }
+    return numHits;
+  };
+  CastResults results;
+  BENCHMARK("castRays") {
+    world.castRays(rays, results);
+    return results.size();
+  };
+}
+
+// A large static level with a few dynamic bodies, the static geometry lives
+// in its own broad phase tree.
+TEST_CASE("Broad phase benchmark", "[.benchmark]") {
+  constexpr auto kNumStaticBodies = 100; // Per side.
+  constexpr auto kNumDynamicBodies = 20; // Per side.
+
+  Scene scene{true};
+  auto &world = scene.world;
+
+  const JPH::RefConst<JPH::Shape> box =
+    new JPH::BoxShape{JPH::Vec3::sReplicate(0.25f)};
+  const auto step = kGridSize * kCellSize / float(kNumStaticBodies);
+  for (auto z = 0; z < kNumStaticBodies; ++z) {
+    for (auto x = 0; x < kNumStaticBodies; ++x) {
+      scene.addBody(box, glm::vec3{float(x) * step, 0.25f, float(z) * step},
+                    kTerrainId + 1);
+    }
+  }
+  const JPH::RefConst<JPH::Shape> sphere = new JPH::SphereShape{0.5f};
+  const auto dynamicStep = kGridSize * kCellSize / float(kNumDynamicBodies);
+  for (auto z = 0; z < kNumDynamicBodies; ++z) {
+    for (auto x = 0; x < kNumDynamicBodies; ++x) {
+      scene.addBody(
+        sphere, glm::vec3{float(x) * dynamicStep, 5.0f, float(z) * dynamicStep},
+        kTerrainId + 2, RigidBody::Settings{.motionType = MotionType::Dynamic});
+    }
+  }
+  world.optimizeBroadPhase();
+
+  const auto rays = makeRays(kNumRays / 10);
+  CastResults results;
+
+  BENCHMARK("simulate") {
+    world.simulate(1.0f / 60.0f);
+    return world.getBodyStats().mNumActiveBodiesDynamic;
+  };
+  BENCHMARK("castRays") {
+    world.castRays(rays, results);
+    return results.size();
+  };
+}
+
+int main(int argc, char *argv[]) {
+  JoltPhysics::setup();
+  const auto result = Catch::Session{}.run(argc, argv);
+  JoltPhysics::cleanup();
+  return result;
+}
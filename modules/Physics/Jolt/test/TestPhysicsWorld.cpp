@@ -0,0 +1,136 @@
+#include "catch.hpp"
+
+#include "physics/PhysicsWorld.hpp"
+#include "physics/PhysicsReplay.hpp"
+#include "physics/JoltPhysics.hpp"
+
+#include "Jolt/Physics/Collision/Shape/BoxShape.h"
+#include "Jolt/Physics/Collision/Shape/SphereShape.h"
+
+#include <deque>
+
+namespace {
+
+// A ground box (top at y = 1) and a grid of spheres above it.
+struct Scene {
+  explicit Scene(const PhysicsWorld::Config &config = {}) : world{config} {
+    const JPH::RefConst<JPH::Shape> ground =
+      new JPH::BoxShape{JPH::Vec3{50.0f, 1.0f, 50.0f}};
+    world.initBody(bodies.emplace_back(RigidBody::Settings{}),
+                   {.transform = Transform{}, .shape = ground});
+
+    const JPH::RefConst<JPH::Shape> sphere = new JPH::SphereShape{0.5f};
+    for (auto i = 0; i < 100; ++i) {
+      const glm::vec3 position{float(i % 10) * 2.0f - 10.0f,
+                               5.0f + float(i % 3),
+                               float(i / 10) * 2.0f - 10.0f};
+      auto &rb = bodies.emplace_back(
+        RigidBody::Settings{.motionType = MotionType::Dynamic});
+      world.initBody(rb, {.transform = Transform{position}, .shape = sphere});
+    }
+  }
+
+  PhysicsWorld world;
+  std::deque<RigidBody> bodies;
+};
+
+} // namespace
+
+TEST_CASE("TempAllocator") {
+  TempAllocator allocator{1024};
+  REQUIRE(allocator.getStats().capacity == 1024);
+
+  auto *a = allocator.Allocate(256);
+  auto *b = allocator.Allocate(512);
+  REQUIRE(a != nullptr);
+  REQUIRE(b != nullptr);
+  REQUIRE(allocator.getStats().highWaterMark == 768);
+
+  // Doesn't fit, served by malloc.
+  auto *c = allocator.Allocate(1024);
+  REQUIRE(c != nullptr);
+  REQUIRE(allocator.getStats().numOverflows == 1);
+  REQUIRE(allocator.getStats().highWaterMark == 768);
+
+  allocator.Free(c, 1024);
+  allocator.Free(b, 512);
+  allocator.Free(a, 256);
+
+  allocator.resetStats();
+  REQUIRE(allocator.getStats().highWaterMark == 0);
+  REQUIRE(allocator.getStats().numOverflows == 0);
+}
+
+TEST_CASE("Collision steps") {
+  PhysicsWorld world;
+  REQUIRE(world.getNumCollisionSteps(1.0f / 60.0f) == 1);
+  REQUIRE(world.getNumCollisionSteps(1.0f / 30.0f) == 2);
+
+  world.setStepSettings({.collisionSteps = 3, .maxStepSize = 0.0f});
+  REQUIRE(world.getNumCollisionSteps(1.0f) == 3);
+}
+
+TEST_CASE("Simulate") {
+  Scene scene{{.tempAllocatorSize = 1024 * 1024}};
+  auto &[world, bodies] = scene;
+
+  for (auto i = 0; i < 120; ++i) {
+    world.simulate(1.0f / 60.0f);
+  }
+  // Resting on the ground (the top is at y = 1).
+  const auto &bodyInterface = world.getBodyInterface();
+  for (auto i = 1u; i < bodies.size(); ++i) {
+    const auto y = bodyInterface.GetPosition(bodies[i].getBodyId()).GetY();
+    REQUIRE(y == Approx{1.5f}.margin(0.05f));
+  }
+
+  const auto stats = world.getTempAllocatorStats();
+  REQUIRE(stats.highWaterMark > 0);
+  REQUIRE(stats.numOverflows == 0);
+}
+
+TEST_CASE("Save/Restore state") {
+  constexpr auto kNumSteps = 60;
+  constexpr auto kTimeStep = 1.0f / 60.0f;
+
+  Scene scene;
+  auto &world = scene.world;
+  // Some of the spheres are in contact with the ground.
+  for (auto i = 0; i < 30; ++i) {
+    world.simulate(kTimeStep);
+  }
+  const auto state = world.saveState();
+  REQUIRE_FALSE(state.empty());
+
+  std::vector<uint64_t> hashes;
+  for (auto i = 0; i < kNumSteps; ++i) {
+    world.simulate(kTimeStep);
+    hashes.push_back(world.saveState().hash());
+  }
+  REQUIRE(hashes.front() != hashes.back());
+
+  REQUIRE(world.restoreState(state));
+  REQUIRE(world.saveState().hash() == state.hash());
+  REQUIRE(world.getMovedBodies().size() == scene.bodies.size());
+  for (auto i = 0; i < kNumSteps; ++i) {
+    world.simulate(kTimeStep);
+    REQUIRE(world.saveState().hash() == hashes[i]);
+  }
+
+  SECTION("Replay") {
+    PhysicsReplay replay;
+    replay.begin(world);
+    for (auto i = 0; i < kNumSteps; ++i) {
+      replay.record(world, kTimeStep);
+    }
+    REQUIRE(replay.getSteps().size() == kNumSteps);
+    REQUIRE_FALSE(replay.verify(world).has_value());
+  }
+}
+
+int main(int argc, char *argv[]) {
+  JoltPhysics::setup();
+  const auto result = Catch::Session{}.run(argc, argv);
+  JoltPhysics::cleanup();
+  return result;
+}
@@ -9,6 +9,7 @@ namespace rhi {
 enum class Access : VkAccessFlags2 {
   None = VK_ACCESS_2_NONE,
 
+  IndirectCommandRead = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT,
   IndexRead = VK_ACCESS_2_INDEX_READ_BIT,
   VertexAttributeRead = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT,
   UniformRead = VK_ACCESS_2_UNIFORM_READ_BIT,
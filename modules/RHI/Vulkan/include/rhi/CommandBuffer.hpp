@@ -84,6 +84,12 @@ public:
   CommandBuffer &setScissor(const Rect2D &);
 
   CommandBuffer &draw(const GeometryInfo &, uint32_t numInstances = 1);
+  // @param commands Array of VkDrawIndexedIndirectCommand.
+  // drawCount > 1 requires the multiDrawIndirect feature.
+  CommandBuffer &drawIndexedIndirect(const VertexBuffer *, const IndexBuffer *,
+                                     const Buffer &commands,
+                                     VkDeviceSize offset,
+                                     uint32_t drawCount = 1);
   CommandBuffer &drawFullScreenTriangle();
   CommandBuffer &drawCube();
 
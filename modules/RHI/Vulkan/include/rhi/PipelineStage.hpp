@@ -10,6 +10,7 @@ enum class PipelineStages : VkPipelineStageFlags2 {
   None = VK_PIPELINE_STAGE_2_NONE,
 
   Top = VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT,
+  DrawIndirect = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
   VertexInput = VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT,
   VertexShader = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
   GeometryShader = VK_PIPELINE_STAGE_2_GEOMETRY_SHADER_BIT,
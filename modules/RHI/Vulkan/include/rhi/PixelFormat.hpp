@@ -98,16 +98,33 @@ enum class PixelFormat {
   ETC2_RGBA8_sRGB = VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK,
   ETC2_RGB8A1_sRGB = VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK,
 
-  BC2_UNorm = VK_FORMAT_BC2_UNORM_BLOCK,
-  BC2_sRGB = VK_FORMAT_BC2_SRGB_BLOCK,
-
   //
-  // BC3:
+  // BC:
   //
 
+  BC1_RGB_UNorm = VK_FORMAT_BC1_RGB_UNORM_BLOCK,
+  BC1_RGB_sRGB = VK_FORMAT_BC1_RGB_SRGB_BLOCK,
+  BC1_RGBA_UNorm = VK_FORMAT_BC1_RGBA_UNORM_BLOCK,
+  BC1_RGBA_sRGB = VK_FORMAT_BC1_RGBA_SRGB_BLOCK,
+
+  BC2_UNorm = VK_FORMAT_BC2_UNORM_BLOCK,
+  BC2_sRGB = VK_FORMAT_BC2_SRGB_BLOCK,
+
   BC3_UNorm = VK_FORMAT_BC3_UNORM_BLOCK,
   BC3_sRGB = VK_FORMAT_BC3_SRGB_BLOCK,
 
+  BC4_UNorm = VK_FORMAT_BC4_UNORM_BLOCK,
+  BC4_SNorm = VK_FORMAT_BC4_SNORM_BLOCK,
+
+  BC5_UNorm = VK_FORMAT_BC5_UNORM_BLOCK,
+  BC5_SNorm = VK_FORMAT_BC5_SNORM_BLOCK,
+
+  BC6H_UFloat = VK_FORMAT_BC6H_UFLOAT_BLOCK,
+  BC6H_SFloat = VK_FORMAT_BC6H_SFLOAT_BLOCK,
+
+  BC7_UNorm = VK_FORMAT_BC7_UNORM_BLOCK,
+  BC7_sRGB = VK_FORMAT_BC7_SRGB_BLOCK,
+
   //
   // Depth/Stencil:
   //
@@ -134,6 +151,7 @@ enum class PixelFormat {
 };
 
 [[nodiscard]] VkImageAspectFlags getAspectMask(PixelFormat);
+[[nodiscard]] bool isCompressed(PixelFormat);
 [[nodiscard]] const char *toString(PixelFormat);
 
 } // namespace rhi
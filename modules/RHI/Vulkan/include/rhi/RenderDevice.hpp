@@ -33,6 +33,12 @@ struct JobInfo {
   VkSemaphore signal{VK_NULL_HANDLE};
 };
 
+// Sum of all DEVICE_LOCAL heaps.
+struct MemoryBudget {
+  VkDeviceSize usage{0};  // Currently used by the process (in bytes).
+  VkDeviceSize budget{0}; // Available to the process (estimate, in bytes).
+};
+
 enum class AllocationHints {
   None = 0,
   MinMemory = 1 << 0,
@@ -90,8 +96,14 @@ public:
   [[nodiscard]] StorageBuffer
   createStorageBuffer(VkDeviceSize size,
                       AllocationHints = AllocationHints::None);
+  // Draw commands (also writable as a storage buffer).
+  [[nodiscard]] Buffer
+  createIndirectBuffer(VkDeviceSize size,
+                       AllocationHints = AllocationHints::None);
 
   [[nodiscard]] std::string getMemoryStats() const;
+  // Accurate only with VK_EXT_memory_budget, otherwise VMA estimates it.
+  [[nodiscard]] MemoryBudget getMemoryBudget() const;
 
   // ---
 
@@ -177,6 +189,7 @@ private:
   VkDevice m_logicalDevice{VK_NULL_HANDLE};
   VkQueue m_genericQueue{VK_NULL_HANDLE};
   VmaAllocator m_memoryAllocator;
+  bool m_hasMemoryBudget{false}; // VK_EXT_memory_budget
 
   VkCommandPool m_commandPool{VK_NULL_HANDLE};
   VkPipelineCache m_pipelineCache{VK_NULL_HANDLE};
@@ -14,6 +14,11 @@ struct VertexAttribute {
 
     Int4 = VK_FORMAT_R32G32B32A32_SINT,
 
+    Half2 = VK_FORMAT_R16G16_SFLOAT,
+    Short2_Norm = VK_FORMAT_R16G16_SNORM,
+    UShort4_Norm = VK_FORMAT_R16G16B16A16_UNORM,
+
+    UByte4 = VK_FORMAT_R8G8B8A8_UINT,
     UByte4_Norm = VK_FORMAT_R8G8B8A8_UNORM,
   };
   Type type;
@@ -20,6 +20,10 @@ NLOHMANN_JSON_SERIALIZE_ENUM(VertexAttribute::Type, {
                                                       MAKE_PAIR(Float3),
                                                       MAKE_PAIR(Float4),
                                                       MAKE_PAIR(Int4),
+                                                      MAKE_PAIR(Half2),
+                                                      MAKE_PAIR(Short2_Norm),
+                                                      MAKE_PAIR(UShort4_Norm),
+                                                      MAKE_PAIR(UByte4),
                                                       MAKE_PAIR(UByte4_Norm),
                                                     });
 
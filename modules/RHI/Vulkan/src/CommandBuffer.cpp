@@ -323,6 +323,20 @@ CommandBuffer &CommandBuffer::draw(const GeometryInfo &gi,
   }
   return *this;
 }
+CommandBuffer &CommandBuffer::drawIndexedIndirect(
+  const VertexBuffer *vertexBuffer, const IndexBuffer *indexBuffer,
+  const Buffer &commands, VkDeviceSize offset, uint32_t drawCount) {
+  assert(indexBuffer && commands);
+  assert(_invariant(State::Recording, InvariantFlags::ValidGraphicsPipeline |
+                                        InvariantFlags::InsideRenderPass));
+  _TRACY_GPU_ZONE2("DrawIndexedIndirect");
+
+  _setVertexBuffer(vertexBuffer, 0);
+  _setIndexBuffer(indexBuffer);
+  vkCmdDrawIndexedIndirect(m_handle, commands.getHandle(), offset, drawCount,
+                           sizeof(VkDrawIndexedIndirectCommand));
+  return *this;
+}
 CommandBuffer &CommandBuffer::drawFullScreenTriangle() {
   return draw({.numVertices = 3});
 }
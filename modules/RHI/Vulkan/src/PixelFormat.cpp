@@ -31,6 +31,39 @@ VkImageAspectFlags getAspectMask(PixelFormat pixelFormat) {
   assert(false);
   return 0;
 }
+bool isCompressed(PixelFormat pixelFormat) {
+  switch (pixelFormat) {
+    using enum PixelFormat;
+
+  case ETC2_RGB8_UNorm:
+  case ETC2_RGBA8_UNorm:
+  case ETC2_RGB8A1_UNorm:
+  case ETC2_RGB8_sRGB:
+  case ETC2_RGBA8_sRGB:
+  case ETC2_RGB8A1_sRGB:
+
+  case BC1_RGB_UNorm:
+  case BC1_RGB_sRGB:
+  case BC1_RGBA_UNorm:
+  case BC1_RGBA_sRGB:
+  case BC2_UNorm:
+  case BC2_sRGB:
+  case BC3_UNorm:
+  case BC3_sRGB:
+  case BC4_UNorm:
+  case BC4_SNorm:
+  case BC5_UNorm:
+  case BC5_SNorm:
+  case BC6H_UFloat:
+  case BC6H_SFloat:
+  case BC7_UNorm:
+  case BC7_sRGB:
+    return true;
+
+  default:
+    return false;
+  }
+}
 
 #define CASE(Value)                                                            \
   case Value:                                                                  \
@@ -126,16 +159,33 @@ const char *toString(PixelFormat pixelFormat) {
     CASE(ETC2_RGBA8_sRGB);
     CASE(ETC2_RGB8A1_sRGB);
 
-    CASE(BC2_UNorm);
-    CASE(BC2_sRGB);
-
     //
-    // BC3:
+    // BC:
     //
 
+    CASE(BC1_RGB_UNorm);
+    CASE(BC1_RGB_sRGB);
+    CASE(BC1_RGBA_UNorm);
+    CASE(BC1_RGBA_sRGB);
+
+    CASE(BC2_UNorm);
+    CASE(BC2_sRGB);
+
     CASE(BC3_UNorm);
     CASE(BC3_sRGB);
 
+    CASE(BC4_UNorm);
+    CASE(BC4_SNorm);
+
+    CASE(BC5_UNorm);
+    CASE(BC5_SNorm);
+
+    CASE(BC6H_UFloat);
+    CASE(BC6H_SFloat);
+
+    CASE(BC7_UNorm);
+    CASE(BC7_sRGB);
+
     //
     // Depth/Stencil:
     //
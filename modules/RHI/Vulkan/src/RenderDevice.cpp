@@ -16,6 +16,7 @@
 #include "spdlog/spdlog.h"
 
 #include <ranges>
+#include <array>
 
 // In case of a crash in NSIGHT Graphics, comment the following line.
 #define _USE_VALIDATION_LAYERS _DEBUG
@@ -337,7 +338,9 @@ VertexBuffer RenderDevice::createVertexBuffer(uint32_t stride,
     Buffer{
       m_memoryAllocator,
       stride * capacity,
-      VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+      // Storage: Compute shaders can read vertices (skinning).
+      VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
       makeAllocationFlags(allocationHint),
       VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
     },
@@ -353,7 +356,9 @@ IndexBuffer RenderDevice::createIndexBuffer(IndexType indexType,
     Buffer{
       m_memoryAllocator,
       uint8_t(indexType) * capacity,
-      VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+      // Storage: Compute shaders can read (or generate) indices.
+      VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
       makeAllocationFlags(allocationHint),
       VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
     },
@@ -385,6 +390,19 @@ RenderDevice::createStorageBuffer(VkDeviceSize size,
     VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
   };
 }
+Buffer RenderDevice::createIndirectBuffer(VkDeviceSize size,
+                                          AllocationHints allocationHint) {
+  assert(m_memoryAllocator != nullptr);
+
+  return Buffer{
+    m_memoryAllocator,
+    size,
+    VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+      VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+    makeAllocationFlags(allocationHint),
+    VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+  };
+}
 
 std::string RenderDevice::getMemoryStats() const {
   assert(m_memoryAllocator != nullptr);
@@ -395,6 +413,24 @@ std::string RenderDevice::getMemoryStats() const {
   vmaFreeStatsString(m_memoryAllocator, stats);
   return s;
 }
+MemoryBudget RenderDevice::getMemoryBudget() const {
+  assert(m_memoryAllocator != nullptr);
+
+  const VkPhysicalDeviceMemoryProperties *memoryProperties{nullptr};
+  vmaGetMemoryProperties(m_memoryAllocator, &memoryProperties);
+  std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> heapBudgets{};
+  vmaGetHeapBudgets(m_memoryAllocator, heapBudgets.data());
+
+  MemoryBudget out;
+  for (auto i = 0u; i < memoryProperties->memoryHeapCount; ++i) {
+    if (memoryProperties->memoryHeaps[i].flags &
+        VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+      out.usage += heapBudgets[i].usage;
+      out.budget += heapBudgets[i].budget;
+    }
+  }
+  return out;
+}
 
 std::pair<std::size_t, VkDescriptorSetLayout>
 RenderDevice::createDescriptorSetLayout(
@@ -893,6 +929,12 @@ void RenderDevice::_createLogicalDevice(uint32_t familyIndex) {
     }
   }
 
+  if (queryExtension(supportedDeviceExtensions,
+                     VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) {
+    deviceExtensions.emplace_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    m_hasMemoryBudget = true;
+  }
+
   const auto kDefaultQueuePriority = 1.0f;
   const VkDeviceQueueCreateInfo queueCreateInfo{
     .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
@@ -906,14 +948,19 @@ void RenderDevice::_createLogicalDevice(uint32_t familyIndex) {
     .imageCubeArray = VK_TRUE, // Shadows.
     .independentBlend = VK_TRUE,
     .geometryShader = VK_TRUE,
+    // Optional, used by the meshlet culling (GBufferPass).
+    .multiDrawIndirect = m_physicalDevice.features.multiDrawIndirect,
+    .drawIndirectFirstInstance =
+      m_physicalDevice.features.drawIndirectFirstInstance,
     .depthClamp = VK_TRUE,
     .depthBiasClamp = VK_TRUE,
     .fillModeNonSolid = VK_TRUE, // Wireframe rendering.
     .wideLines = VK_TRUE,
     .samplerAnisotropy = VK_TRUE,
-    //.textureCompressionETC2 = VK_TRUE,
+    // Compressed formats are optional (KTXLoader decodes BCn on CPU).
+    .textureCompressionETC2 = m_physicalDevice.features.textureCompressionETC2,
     //.textureCompressionASTC_LDR = VK_TRUE,
-    //.textureCompressionBC = VK_TRUE,
+    .textureCompressionBC = m_physicalDevice.features.textureCompressionBC,
     .shaderTessellationAndGeometryPointSize = VK_TRUE,
   };
   // clang-format on
@@ -964,6 +1011,8 @@ void RenderDevice::_createMemoryAllocator() {
 #endif
 
   const VmaAllocatorCreateInfo createInfo{
+    .flags = m_hasMemoryBudget ? VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT
+                               : VmaAllocatorCreateFlags{0},
     .physicalDevice = m_physicalDevice.handle,
     .device = m_logicalDevice,
     .instance = m_instance,
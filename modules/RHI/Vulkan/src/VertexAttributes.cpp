@@ -18,6 +18,13 @@ uint32_t getSize(VertexAttribute::Type type) {
   case Int4:
     return sizeof(int32_t) * 4;
 
+  case Half2:
+  case Short2_Norm:
+    return sizeof(int16_t) * 2;
+  case UShort4_Norm:
+    return sizeof(uint16_t) * 4;
+
+  case UByte4:
   case UByte4_Norm:
     return sizeof(uint8_t) * 4;
   }
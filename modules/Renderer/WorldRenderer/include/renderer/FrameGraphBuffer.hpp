@@ -10,6 +10,7 @@ enum class BufferType {
   StorageBuffer,
   VertexBuffer,
   IndexBuffer,
+  IndirectBuffer, // VkDrawIndexedIndirectCommand[]
 };
 
 class FrameGraphBuffer {
@@ -2,6 +2,7 @@
 
 #include "fg/Fwd.hpp"
 #include "rhi/RenderPass.hpp"
+#include "MeshletCuller.hpp"
 #include "Technique.hpp"
 #include "BaseGeometryPassInfo.hpp"
 #include "ViewInfo.hpp"
@@ -21,9 +22,10 @@ public:
   uint32_t count(PipelineGroups) const override;
   void clear(PipelineGroups) override;
 
+  // @param meshletCulling Culls clustered meshes on the GPU (if supported).
   void addGeometryPass(FrameGraph &, FrameGraphBlackboard &,
                        rhi::Extent2D resolution, const ViewInfo &,
-                       const PropertyGroupOffsets &);
+                       const PropertyGroupOffsets &, bool meshletCulling);
 
   [[nodiscard]] static CodePair buildShaderCode(const rhi::RenderDevice &,
                                                 const VertexFormat *,
@@ -32,6 +34,9 @@ public:
 private:
   [[nodiscard]] rhi::GraphicsPipeline
   _createPipeline(const BaseGeometryPassInfo &) const;
+
+private:
+  MeshletCuller m_meshletCuller;
 };
 
 } // namespace gfx
@@ -2,6 +2,7 @@
 
 #include "rhi/VertexBuffer.hpp"
 #include "rhi/IndexBuffer.hpp"
+#include "rhi/StorageBuffer.hpp"
 #include "rhi/GeometryInfo.hpp"
 #include "VertexFormat.hpp"
 #include "Material.hpp"
@@ -20,6 +21,10 @@ struct SubMesh {
   std::vector<LOD> lod;
   const std::shared_ptr<Material> material;
   AABB aabb{}; // Local-space.
+
+  // Clusters of the first LOD (see Mesh::getMeshletBuffer).
+  uint32_t meshletOffset{0};
+  uint32_t numMeshlets{0};
 };
 
 using Joints = std::vector<glm::mat4>;
@@ -36,6 +41,8 @@ public:
   [[nodiscard]] const VertexFormat &getVertexFormat() const;
   [[nodiscard]] const rhi::VertexBuffer *getVertexBuffer() const;
   [[nodiscard]] const rhi::IndexBuffer *getIndexBuffer() const;
+  // Array of gfx::Meshlet (might be nullptr).
+  [[nodiscard]] const rhi::StorageBuffer *getMeshletBuffer() const;
 
   [[nodiscard]] const std::vector<SubMesh> &getSubMeshes() const;
 
@@ -44,6 +51,9 @@ public:
 
   [[nodiscard]] const AABB &getAABB() const;
 
+  // Maps quantized positions (UShort4_Norm) to the local-space.
+  [[nodiscard]] const std::optional<glm::mat4> &getDequantization() const;
+
   class Builder {
   public:
     Builder() = default;
@@ -57,6 +67,7 @@ public:
     Builder &setVertexFormat(std::shared_ptr<VertexFormat>);
     Builder &setVertexBuffer(std::shared_ptr<rhi::VertexBuffer>);
     Builder &setIndexBuffer(std::shared_ptr<rhi::IndexBuffer>);
+    Builder &setMeshletBuffer(std::shared_ptr<rhi::StorageBuffer>);
 
     Builder &setInverseBindPose(Joints);
 
@@ -64,8 +75,11 @@ public:
     Builder &beginSubMesh(uint32_t vertexOffset, uint32_t numVertices,
                           std::shared_ptr<Material>, AABB);
     Builder &addLOD(uint32_t indexOffset, uint32_t numIndices);
+    Builder &setMeshlets(uint32_t meshletOffset, uint32_t numMeshlets);
 
     Builder &setAABB(AABB);
+    // Quantized positions cover the given bounds.
+    Builder &setPositionBounds(const AABB &);
 
     [[nodiscard]] Mesh build();
 
@@ -73,12 +87,14 @@ public:
     std::shared_ptr<VertexFormat> m_vertexFormat;
     std::shared_ptr<rhi::VertexBuffer> m_vertexBuffer;
     std::shared_ptr<rhi::IndexBuffer> m_indexBuffer;
+    std::shared_ptr<rhi::StorageBuffer> m_meshletBuffer;
 
     rhi::PrimitiveTopology m_topology{rhi::PrimitiveTopology::TriangleList};
     std::vector<SubMesh> m_subMeshes;
     Joints m_inverseBindPose;
 
     AABB m_aabb{};
+    std::optional<glm::mat4> m_dequantization;
   };
 
 private:
@@ -88,10 +104,12 @@ private:
   std::shared_ptr<VertexFormat> m_vertexFormat;
   std::shared_ptr<rhi::VertexBuffer> m_vertexBuffer;
   std::shared_ptr<rhi::IndexBuffer> m_indexBuffer;
+  std::shared_ptr<rhi::StorageBuffer> m_meshletBuffer;
 
   std::vector<SubMesh> m_subMeshes;
   Joints m_inverseBindPose;
   AABB m_aabb{}; // Local-space.
+  std::optional<glm::mat4> m_dequantization;
 };
 
 [[nodiscard]] rhi::GeometryInfo getGeometryInfo(const Mesh &, const SubMesh &);
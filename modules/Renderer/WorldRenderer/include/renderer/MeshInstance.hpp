@@ -43,6 +43,9 @@ public:
   MeshInstance &setMaterial(int32_t index, std::shared_ptr<Material>);
 
   MeshInstance &setSkinMatrices(Joints);
+  // Resizes the skin (reuses the memory).
+  // @return Matrices to be filled by the caller.
+  [[nodiscard]] std::span<glm::mat4> prepareSkin(std::size_t numJoints);
 
   // ---
 
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "math/Frustum.hpp"
+#include <cstdint>
+
+namespace gfx {
+
+// A cluster of (up to 124) triangles, generated by the MeshConverter.
+struct alignas(16) Meshlet {
+  glm::vec3 center; // Bounding sphere.
+  float radius;
+  glm::vec3 coneAxis; // Normal cone.
+  float coneCutoff;
+  uint32_t indexOffset; // In the mesh index buffer.
+  uint32_t numTriangles;
+};
+static_assert(sizeof(Meshlet) == 48);
+
+// CPU reference of shaders/MeshletCulling.comp.
+// @param frustum Planes in the mesh local-space (modelViewProj).
+// @param cameraPosition In the mesh local-space.
+// @param coneCulling Rejects back-facing clusters (single sided materials),
+// see canConeCull.
+[[nodiscard]] bool isMeshletVisible(const Meshlet &, const Frustum &,
+                                    const glm::vec3 &cameraPosition,
+                                    bool coneCulling);
+
+// The normal cone is tested in the mesh local-space, which holds only for a
+// rotation, a translation and a uniform (positive) scale.
+// @return false for a non-uniformly scaled (or mirrored) instance.
+[[nodiscard]] bool canConeCull(const glm::mat4 &modelMatrix);
+
+} // namespace gfx
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "fg/Fwd.hpp"
+#include "rhi/ComputePass.hpp"
+#include <span>
+
+namespace gfx {
+
+struct Batch;
+
+// Culls meshlets (frustum and normal cone) of batches with clustered meshes.
+// Visible triangles are appended to an index buffer, drawn with one indirect
+// command per instance (works without mesh shaders).
+class MeshletCuller final : public rhi::ComputePass<MeshletCuller> {
+  friend class BasePass;
+
+public:
+  explicit MeshletCuller(rhi::RenderDevice &);
+
+  // Indirect draws with firstInstance != 0.
+  [[nodiscard]] bool isSupported() const;
+
+  struct Result {
+    FrameGraphResource drawCommands; // VkDrawIndexedIndirectCommand[]
+    FrameGraphResource indices;      // UInt32
+    // Index of the first draw command (per batch), std::nullopt = not culled.
+    std::vector<std::optional<uint32_t>> firstCommands;
+    bool multiDraw; // Commands of a batch can be drawn at once.
+  };
+  // @param instances GPUInstance[] (of the given batches).
+  [[nodiscard]] std::optional<Result>
+  cull(FrameGraph &, FrameGraphBlackboard &, std::span<const Batch>,
+       std::optional<FrameGraphResource> instances);
+
+private:
+  [[nodiscard]] rhi::ComputePipeline _createPipeline() const;
+};
+
+} // namespace gfx
@@ -17,9 +17,11 @@ enum class RenderFeatures : int32_t {
   FXAA = 1 << 6,
   EyeAdaptation = 1 << 7,
   CustomPostprocess = 1 << 8,
+  MeshletCulling = 1 << 9,
+  ComputeSkinning = 1 << 10,
 
-  Default =
-    LightCulling | SSAO | Bloom | FXAA | EyeAdaptation | CustomPostprocess,
+  Default = LightCulling | SSAO | Bloom | FXAA | EyeAdaptation |
+            CustomPostprocess | MeshletCulling | ComputeSkinning,
 
   All = Default | SoftShadows | GI | SSR,
 };
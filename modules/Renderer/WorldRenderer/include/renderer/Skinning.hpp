@@ -0,0 +1,67 @@
+#pragma once
+
+#include "glm/ext/matrix_float4x4.hpp"
+#include <span>
+#include <cstdint>
+
+namespace gfx {
+
+// Output of shaders/Skinning.comp (mesh local-space), read by Mesh.vert.
+struct alignas(16) SkinnedVertex {
+  glm::vec3 position;
+  // Octahedral (packSnorm2x16), see: packOctahedral.
+  uint32_t normal;
+  uint32_t tangent;
+  uint32_t bitangent;
+};
+static_assert(sizeof(SkinnedVertex) == 32);
+
+// GPUInstance::skinOffset with this bit set points to the first vertex of a
+// mesh instance (in the SkinnedVertices buffer), instead of the first joint.
+constexpr uint32_t kPreSkinnedBit = 1u << 31;
+
+// Where (and how) the attributes are stored within a vertex.
+// Offsets (in bytes) have to be a multiple of 4 (the compute shader reads
+// a vertex buffer as uint[]).
+struct SkinningLayout {
+  static constexpr uint32_t kNone{~0u};
+
+  uint32_t stride{0};
+  uint32_t position{kNone};
+  uint32_t normal{kNone};
+  uint32_t tangent{kNone};
+  uint32_t bitangent{kNone};
+  uint32_t joints{kNone};
+  uint32_t weights{kNone};
+
+  // Matches Skinning.comp
+  enum Flags : uint32_t {
+    None = 0,
+    QuantizedPosition = 1 << 0,  // UShort4_Norm (Float3 otherwise).
+    OctahedralNormal = 1 << 1,   // Short2_Norm (Float3 otherwise).
+    OctahedralTangents = 1 << 2, // Short2_Norm (Float3 otherwise).
+    PackedJoints = 1 << 3,       // UByte4 (Int4 otherwise).
+    PackedWeights = 1 << 4,      // UByte4_Norm (Float4 otherwise).
+  };
+  uint32_t flags{None};
+};
+
+// https://knarkowicz.wordpress.com/2014/04/16/octahedron-normal-vector-encoding/
+[[nodiscard]] uint32_t packOctahedral(const glm::vec3 &);
+[[nodiscard]] glm::vec3 unpackOctahedral(uint32_t);
+
+// CPU reference of shaders/Skinning.comp.
+// @param vertex SkinningLayout::stride bytes.
+// @param joints Skin matrices of a mesh instance.
+// @param dequantization Maps quantized positions to the local-space.
+[[nodiscard]] SkinnedVertex skinVertex(const std::byte *vertex,
+                                       const SkinningLayout &,
+                                       std::span<const glm::mat4> joints,
+                                       const glm::mat4 &dequantization);
+
+// @param vertices Content of a vertex buffer.
+void skinVertices(std::span<const std::byte> vertices, const SkinningLayout &,
+                  std::span<const glm::mat4> joints,
+                  const glm::mat4 &dequantization, std::span<SkinnedVertex>);
+
+} // namespace gfx
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "fg/Fwd.hpp"
+#include "rhi/ComputePass.hpp"
+#include "Technique.hpp"
+#include "Skinning.hpp"
+#include <optional>
+#include <vector>
+
+namespace gfx {
+
+class Mesh;
+class VertexFormat;
+
+// Skins each (skinned) mesh instance once per frame, instead of in the vertex
+// shader of every pass that draws it (GBuffer, shadow maps, RSM, ...).
+// Meshes with an unsupported vertex format are skinned in the vertex shader.
+class SkinningPass final : public rhi::ComputePass<SkinningPass>,
+                           public Technique {
+  friend class BasePass;
+
+public:
+  explicit SkinningPass(rhi::RenderDevice &);
+
+  uint32_t count(PipelineGroups) const override;
+  void clear(PipelineGroups) override;
+
+  struct Instance {
+    const Mesh *mesh;
+    uint32_t jointOffset; // In the SkinData::skins buffer.
+    uint32_t transformId;
+    uint32_t firstVertex; // In the SkinData::skinnedVertices buffer.
+    uint32_t numVertices;
+  };
+
+  // @return Vertices to skin (the whole vertex buffer used by the submeshes),
+  // 0 = not supported.
+  [[nodiscard]] static uint32_t countVertices(const Mesh &);
+
+  // Adds the skinned vertices to the SkinData.
+  void addPass(FrameGraph &, FrameGraphBlackboard &, std::vector<Instance> &&);
+
+private:
+  [[nodiscard]] rhi::ComputePipeline _createPipeline() const;
+};
+
+[[nodiscard]] std::optional<SkinningLayout>
+getSkinningLayout(const VertexFormat &);
+
+} // namespace gfx
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "TextureResourceHandle.hpp"
+#include "TextureStreamer.hpp"
 #include "entt/resource/loader.hpp"
 
 namespace gfx {
@@ -8,6 +9,9 @@ namespace gfx {
 struct TextureLoader final : entt::resource_loader<TextureResource> {
   result_type operator()(const std::filesystem::path &,
                          rhi::RenderDevice &) const;
+  // Streams mip levels (when possible).
+  result_type operator()(const std::filesystem::path &, rhi::RenderDevice &,
+                         TextureStreamer &) const;
   result_type operator()(rhi::Texture &&) const;
 };
 
@@ -14,8 +14,11 @@ public:
 
   [[nodiscard]] TextureResourceHandle load(const std::filesystem::path &);
 
+  [[nodiscard]] TextureStreamer &getStreamer();
+
 private:
   rhi::RenderDevice &m_renderDevice;
+  TextureStreamer m_streamer{m_renderDevice};
 };
 
 } // namespace gfx
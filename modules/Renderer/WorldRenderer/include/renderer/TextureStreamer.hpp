@@ -0,0 +1,126 @@
+#pragma once
+
+#include "TextureResource.hpp"
+#include "KTXMipChain.hpp"
+
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+
+namespace gfx {
+
+struct TextureStreamingSettings {
+  bool enabled{true};
+  // Mip levels up to this size (the longer side, in texels) are always
+  // resident.
+  uint32_t residentSize{128};
+  // Upper limit for all streamed textures (in bytes). The effective budget is
+  // also bound by the free VRAM reported by the driver.
+  uint64_t budget{512ull << 20};
+  // Positive values favor sharper (larger) mip levels.
+  float mipBias{0.5f};
+  uint32_t maxUploadsPerFrame{4};
+};
+
+struct TextureStreamingStats {
+  uint32_t numTextures{0};
+  uint32_t numPending{0}; // Loads and evictions in flight.
+  uint64_t residentBytes{0};
+  uint64_t fullBytes{0}; // With all mip levels resident.
+  uint64_t budget{0};    // Effective.
+  uint32_t numEvictions{0};
+  uint32_t numOverBudget{0}; // Requests that didn't fit (last frame).
+};
+
+// Loads only the mip tail of a KTX2 texture, the remaining (larger) levels
+// are streamed in the background (driven by request), within a VRAM budget.
+// Textures that haven't been requested recently are the first to be evicted.
+class TextureStreamer final {
+public:
+  explicit TextureStreamer(rhi::RenderDevice &);
+  TextureStreamer(const TextureStreamer &) = delete;
+  TextureStreamer(TextureStreamer &&) noexcept = delete;
+  ~TextureStreamer();
+
+  TextureStreamer &operator=(const TextureStreamer &) = delete;
+  TextureStreamer &operator=(TextureStreamer &&) noexcept = delete;
+
+  void setSettings(const TextureStreamingSettings &);
+  [[nodiscard]] const TextureStreamingSettings &getSettings() const;
+
+  // @return nullptr if the file can't be streamed (use TextureLoader).
+  [[nodiscard]] std::shared_ptr<TextureResource>
+  load(const std::filesystem::path &);
+
+  // @param screenSize Size (in pixels) of the [0..1] UV range on the screen.
+  // Call for each visible texture (many times per frame is fine, the largest
+  // screenSize wins). Ignores textures that are not streamed.
+  void request(const rhi::Texture *, float screenSize);
+
+  // Uploads mip levels loaded by the worker and schedules new requests.
+  // Call once per frame, before recording commands that sample textures.
+  void update();
+
+  struct Residency {
+    uint32_t firstLevel; // The largest resident mip level.
+    uint32_t numLevels;  // Of the source file.
+    uint32_t desiredLevel;
+  };
+  [[nodiscard]] std::optional<Residency>
+  getResidency(const rhi::Texture *) const;
+
+  [[nodiscard]] const TextureStreamingStats &getStats() const;
+
+private:
+  struct Entry {
+    std::weak_ptr<TextureResource> resource;
+    std::shared_ptr<const KTXMipChain> mipChain;
+    uint32_t tailLevel;  // Never evicted.
+    uint32_t firstLevel; // Currently resident.
+    std::optional<uint32_t> pendingLevel;
+    uint32_t desiredLevel;
+    uint64_t lastRequested{0}; // Frame number.
+    bool failed{false};
+  };
+  using Key = const rhi::Texture *;
+
+  void _collectGarbage();
+  void _uploadLoaded();
+  void _schedule();
+  [[nodiscard]] uint64_t _calcBudget() const;
+  [[nodiscard]] uint64_t _evict(uint64_t required);
+  void _enqueue(Key, Entry &, uint32_t firstLevel);
+
+  void _workerLoop(std::stop_token);
+
+private:
+  rhi::RenderDevice &m_renderDevice;
+  TextureStreamingSettings m_settings;
+  TextureStreamingStats m_stats;
+  uint64_t m_frame{1};
+
+  std::unordered_map<Key, Entry> m_entries;
+
+  struct Job {
+    Key key;
+    std::filesystem::path path;
+    std::shared_ptr<const KTXMipChain> mipChain;
+    uint32_t firstLevel;
+  };
+  struct Result {
+    Key key;
+    std::shared_ptr<const KTXMipChain> mipChain;
+    std::expected<KTXMipLevels, std::string> mipLevels;
+  };
+
+  std::mutex m_mutex;
+  std::condition_variable_any m_jobAdded;
+  std::deque<Job> m_jobs;      // Guarded by m_mutex.
+  std::deque<Result> m_loaded; // Guarded by m_mutex.
+
+  std::jthread m_worker; // Keep last (joins before the queues are destroyed).
+};
+
+} // namespace gfx
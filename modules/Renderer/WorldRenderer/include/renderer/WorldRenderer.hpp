@@ -13,6 +13,7 @@
 #include "MeshInstance.hpp"
 #include "DecalInstance.hpp"
 
+#include "SkinningPass.hpp"
 #include "TiledLighting.hpp"
 #include "ShadowRenderer.hpp"
 #include "GlobalIllumination.hpp"
@@ -43,6 +44,7 @@
 #include "Blit.hpp"
 
 #include "SkyLight.hpp"
+#include "TextureStreamer.hpp"
 #include "RenderSettings.hpp"
 #include "PipelineGroups.hpp"
 
@@ -90,6 +92,11 @@ public:
 
   [[nodiscard]] SkyLight createSkyLight(TextureResourceHandle);
 
+  // Feeds the streamer with screen-space usage of material textures.
+  // drawFrame might be called many times per frame, the owner of the streamer
+  // calls TextureStreamer::update (once per frame).
+  void setTextureStreamer(TextureStreamer *);
+
   void drawFrame(rhi::CommandBuffer &, const WorldView &, float deltaTime,
                  DebugOutput * = nullptr);
 
@@ -109,6 +116,7 @@ private:
   float m_time{0.0f};
 
   CubemapConverter &m_cubemapConverter;
+  TextureStreamer *m_textureStreamer{nullptr};
   IBL m_ibl{m_renderDevice};
   rhi::Texture m_brdf;
 
@@ -119,6 +127,7 @@ private:
 
   CommonSamplers m_commonSamplers;
 
+  SkinningPass m_skinningPass{m_renderDevice};
   TiledLighting m_tiledLighting{m_renderDevice};
   ShadowRenderer m_shadowRenderer{m_renderDevice};
   GlobalIllumination m_globalIllumination{m_renderDevice, m_commonSamplers};
@@ -8,6 +8,7 @@
 #include "Lib/DefaultInstance.glsl"
 #include "Resources/InstanceBuffer.glsl"
 #include "Resources/TransformBuffer.glsl"
+#include "Lib/QuantizedPosition.glsl"
 
 #include "Lib/Math.glsl"
 
@@ -21,7 +22,7 @@ void main() {
   const mat4 modelMatrix = g_Transforms[instance.transformId];
   vs_out.invModelMatrix = inverse(modelMatrix);
 
-  gl_Position = u_Camera.viewProjection * modelMatrix * vec4(a_Position, 1.0);
+  gl_Position = u_Camera.viewProjection * modelMatrix * getPosition();
   gl_Position.z -= EPSILON;
 
   vs_out.fragPosClipSpace = gl_Position;
@@ -0,0 +1,24 @@
+#ifndef _OCTAHEDRAL_GLSL_
+#define _OCTAHEDRAL_GLSL_
+
+// https://knarkowicz.wordpress.com/2014/04/16/octahedron-normal-vector-encoding/
+
+vec2 _encodeOctahedral(vec3 n) {
+  const float sum = abs(n.x) + abs(n.y) + abs(n.z);
+  if (sum == 0.0) return vec2(0.0);
+
+  vec2 v = n.xy / sum;
+  if (n.z < 0.0) {
+    v = (1.0 - abs(v.yx)) *
+        mix(vec2(-1.0), vec2(1.0), greaterThanEqual(v, vec2(0.0)));
+  }
+  return v;
+}
+vec3 _decodeOctahedral(vec2 e) {
+  vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+  const float t = max(-v.z, 0.0);
+  v.xy += mix(vec2(t), vec2(-t), greaterThanEqual(v.xy, vec2(0.0)));
+  return normalize(v);
+}
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef _QUANTIZED_POSITION_GLSL_
+#define _QUANTIZED_POSITION_GLSL_
+
+// Requires: VertexAttributes.glsl, Resources/InstanceBuffer.glsl,
+// Resources/TransformBuffer.glsl
+
+#ifdef QUANTIZED_POSITION
+vec4 getPosition() {
+  // WorldRenderer (buildRenderables): Follows the model matrix.
+  const mat4 dequantization = g_Transforms[GET_INSTANCE().transformId + 1];
+  return dequantization * vec4(a_Position.xyz, 1.0);
+}
+#endif
+
+#endif
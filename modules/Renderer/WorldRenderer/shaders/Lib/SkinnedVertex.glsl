@@ -0,0 +1,23 @@
+#ifndef _SKINNED_VERTEX_GLSL_
+#define _SKINNED_VERTEX_GLSL_
+
+// renderer/Skinning.hpp
+
+#include "Octahedral.glsl"
+
+struct SkinnedVertex { // ArrayStride = 32
+  vec3 position;       // offset = 0 | size = 12
+  uint normal;         //         12 |         4
+  uint tangent;        //         16 |         4
+  uint bitangent;      //         20 |         4
+};
+
+// Instance::skinOffset
+#define PRE_SKINNED_BIT (1u << 31)
+
+uint _packDirection(vec3 v) { return packSnorm2x16(_encodeOctahedral(v)); }
+vec3 _unpackDirection(uint v) {
+  return _decodeOctahedral(unpackSnorm2x16(v));
+}
+
+#endif
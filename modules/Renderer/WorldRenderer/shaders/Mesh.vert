@@ -9,6 +9,7 @@
 #include "Resources/InstanceBuffer.glsl"
 #include "Resources/TransformBuffer.glsl"
 #include "Resources/SkinBuffer.glsl"
+#include "Lib/QuantizedPosition.glsl"
 
 #include "Resources/PropertyBuffer.glsl"
 _DECLARE_PROPERTIES(0, 1);
@@ -65,7 +66,31 @@ void main() {
   vs_out.flags = instance.flags;
 
   const mat4 modelMatrix = g_Transforms[instance.transformId];
-  vec4 localPos = vec4(a_Position, 1.0);
+  vec4 localPos = getPosition();
+#ifdef HAS_NORMAL
+  vec3 localNormal = getNormal();
+#  ifdef HAS_TANGENTS
+  vec3 localTangent = getTangent();
+  vec3 localBitangent = getBitangent();
+#  endif
+#endif
+
+#ifdef IS_SKINNED
+  // Already skinned (once per frame) by the SkinningPass, hence the user code
+  // operates on the skinned (instead of the bind pose) position.
+  const bool preSkinned = _isPreSkinned(instance.skinOffset);
+  if (preSkinned) {
+    const SkinnedVertex v = _fetchSkinnedVertex(instance.skinOffset);
+    localPos = vec4(v.position, 1.0);
+#  ifdef HAS_NORMAL
+    localNormal = _unpackDirection(v.normal);
+#    ifdef HAS_TANGENTS
+    localTangent = _unpackDirection(v.tangent);
+    localBitangent = _unpackDirection(v.bitangent);
+#    endif
+#  endif
+  }
+#endif
 
 #if !NO_MATERIAL
   // clang-format off
@@ -79,7 +104,7 @@ void main() {
 #endif
 
 #ifdef IS_SKINNED
-  const mat4 skinMatrix = instance.skinOffset == ~0
+  const mat4 skinMatrix = instance.skinOffset == ~0 || preSkinned
                             ? mat4(1.0)
                             : _buildSkinMatrix(instance.skinOffset);
   localPos = skinMatrix * localPos;
@@ -95,11 +120,11 @@ void main() {
 #  else
   const mat3 normalMatrix = _buildNormalMatrix(NORMAL_TARGET_SPACE);
 #  endif
-  const vec3 N = normalize(normalMatrix * a_Normal);
+  const vec3 N = normalize(normalMatrix * localNormal);
 #  ifdef HAS_TANGENTS
-  vec3 T = normalize(normalMatrix * a_Tangent);
+  vec3 T = normalize(normalMatrix * localTangent);
   T = normalize(T - dot(T, N) * N);
-  vec3 B = normalize(normalMatrix * a_Bitangent);
+  vec3 B = normalize(normalMatrix * localBitangent);
   vs_out.TBN = mat3(T, B, N);
 #  else
   vs_out.normal = N;
@@ -5,6 +5,12 @@ layout(set = 0, binding = 2, std430) buffer readonly _SkinBuffer {
   mat4 g_Skins[]; // ArrayStride = 64
 };
 
+#include <Lib/SkinnedVertex.glsl>
+
+layout(set = 0, binding = 3, std430) buffer readonly _SkinnedVertexBuffer {
+  SkinnedVertex g_SkinnedVertices[];
+};
+
 #ifdef IS_SKINNED
 mat4 _buildSkinMatrix(uint offset) {
   return (a_Weights[0] * g_Skins[offset + a_Joints[0]] +
@@ -12,6 +18,15 @@ mat4 _buildSkinMatrix(uint offset) {
           a_Weights[2] * g_Skins[offset + a_Joints[2]] +
           a_Weights[3] * g_Skins[offset + a_Joints[3]]);
 }
+
+// The Instance::skinOffset points to the first vertex (of a mesh instance)
+// skinned by the SkinningPass (instead of the first joint).
+bool _isPreSkinned(uint offset) {
+  return offset != ~0 && (offset & PRE_SKINNED_BIT) != 0;
+}
+SkinnedVertex _fetchSkinnedVertex(uint offset) {
+  return g_SkinnedVertices[(offset & ~PRE_SKINNED_BIT) + gl_VertexIndex];
+}
 #endif
 
 #endif
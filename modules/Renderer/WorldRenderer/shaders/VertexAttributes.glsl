@@ -7,33 +7,59 @@
 
 // WorldRenderer/VertexFormat.hpp
 
+#ifdef QUANTIZED_POSITION
+// [0..1] within the mesh bounds, see: Lib/QuantizedPosition.glsl
+layout(location = 0) in vec4 a_Position;
+#else
 layout(location = 0) in vec3 a_Position;
+#endif
 #ifdef HAS_COLOR
 layout(location = 1) in vec3 a_Color0;
 #endif
 #ifdef HAS_NORMAL
+#  ifdef OCTAHEDRAL_NORMAL
+layout(location = 2) in vec2 a_Normal;
+#  else
 layout(location = 2) in vec3 a_Normal;
+#  endif
 #endif
 #ifdef HAS_TEXCOORD0
 layout(location = 3) in vec2 a_TexCoord0;
 #  ifdef HAS_TANGENTS
+#    ifdef OCTAHEDRAL_TANGENTS
+layout(location = 5) in vec2 a_Tangent;
+layout(location = 6) in vec2 a_Bitangent;
+#    else
 layout(location = 5) in vec3 a_Tangent;
 layout(location = 6) in vec3 a_Bitangent;
+#    endif
 #  endif
 #endif
 #ifdef HAS_TEXCOORD1
 layout(location = 4) in vec2 a_TexCoord1;
 #endif
 #ifdef IS_SKINNED
+#  ifdef PACKED_JOINTS
+layout(location = 7) in uvec4 a_Joints;
+#  else
 layout(location = 7) in ivec4 a_Joints;
+#  endif
 layout(location = 8) in vec4 a_Weights;
 #endif
 
+#include "Lib/Octahedral.glsl"
+
 //
 // Getters:
 //
 
+#ifdef QUANTIZED_POSITION
+// The dequantization transform is stored per instance
+// (Lib/QuantizedPosition.glsl).
+vec4 getPosition();
+#else
 vec4 getPosition() { return vec4(a_Position, 1.0); }
+#endif
 
 vec3 getColor() {
 #ifdef HAS_COLOR
@@ -44,13 +70,32 @@ vec3 getColor() {
 }
 
 vec3 getNormal() {
-#ifdef HAS_NORMAL
+#if defined(HAS_NORMAL) && defined(OCTAHEDRAL_NORMAL)
+  return _decodeOctahedral(a_Normal);
+#elif defined(HAS_NORMAL)
   return a_Normal;
 #else
   return vec3(0.0);
 #endif
 }
 
+#ifdef HAS_TANGENTS
+vec3 getTangent() {
+#  ifdef OCTAHEDRAL_TANGENTS
+  return _decodeOctahedral(a_Tangent);
+#  else
+  return a_Tangent;
+#  endif
+}
+vec3 getBitangent() {
+#  ifdef OCTAHEDRAL_TANGENTS
+  return _decodeOctahedral(a_Bitangent);
+#  else
+  return a_Bitangent;
+#  endif
+}
+#endif
+
 vec2 getTexCoord0() {
 #ifdef HAS_TEXCOORD0
   return a_TexCoord0;
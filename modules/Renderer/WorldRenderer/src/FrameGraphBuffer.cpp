@@ -46,6 +46,10 @@ void FrameGraphBuffer::preRead(const Desc &desc, uint32_t bits, void *ctx) {
       dst.stageMask |= rhi::PipelineStages::VertexShader;
       dst.accessMask = rhi::Access::ShaderStorageRead;
       break;
+    case BufferType::IndirectBuffer:
+      dst.stageMask |= rhi::PipelineStages::DrawIndirect;
+      dst.accessMask = rhi::Access::IndirectCommandRead;
+      break;
     }
   }
   if (bool(pipelineStage & PipelineStage::GeometryShader)) {
@@ -88,7 +92,10 @@ void FrameGraphBuffer::preWrite(const Desc &desc, uint32_t bits, void *ctx) {
       .accessMask = rhi::Access::TransferWrite,
     };
   } else {
-    assert(desc.type == BufferType::StorageBuffer);
+    // Index and indirect buffers can be generated by a compute shader.
+    assert(desc.type == BufferType::StorageBuffer ||
+           desc.type == BufferType::IndexBuffer ||
+           desc.type == BufferType::IndirectBuffer);
 
     if (bool(pipelineStage & PipelineStage::VertexShader))
       dst.stageMask |= rhi::PipelineStages::VertexShader;
@@ -69,6 +69,12 @@ void read(FrameGraph::Builder &builder, const SkinData *data,
                  .location = {.set = 0, .binding = 2},
                  .pipelineStage = PipelineStage::VertexShader,
                });
+  builder.read(data && data->skinnedVertices ? *data->skinnedVertices
+                                             : dummyResources.storageBuffer,
+               BindingInfo{
+                 .location = {.set = 0, .binding = 3},
+                 .pipelineStage = PipelineStage::VertexShader,
+               });
 }
 
 void read(FrameGraph::Builder &builder, const MaterialPropertiesData &data) {
@@ -1,11 +1,14 @@
 #pragma once
 
 #include "fg/FrameGraphResource.hpp"
+#include <optional>
 
 namespace gfx {
 
 struct SkinData {
   FrameGraphResource skins;
+  // SkinnedVertex[] (SkinningPass).
+  std::optional<FrameGraphResource> skinnedVertices;
 };
 
 } // namespace gfx
@@ -2,6 +2,7 @@
 
 #include "FrameGraphCommon.hpp"
 #include "renderer/FrameGraphTexture.hpp"
+#include "renderer/FrameGraphBuffer.hpp"
 #include "FrameGraphResourceAccess.hpp"
 
 #include "FrameGraphData/DummyResources.hpp"
@@ -40,18 +41,23 @@ namespace {
 } // namespace
 
 GBufferPass::GBufferPass(rhi::RenderDevice &rd)
-    : rhi::RenderPass<GBufferPass>{rd} {}
+    : rhi::RenderPass<GBufferPass>{rd}, m_meshletCuller{rd} {}
 
 uint32_t GBufferPass::count(PipelineGroups flags) const {
-  return bool(flags & PipelineGroups::SurfaceMaterial) ? BasePass::count() : 0;
+  uint32_t n{0};
+  if (bool(flags & PipelineGroups::SurfaceMaterial)) n += BasePass::count();
+  if (bool(flags & PipelineGroups::BuiltIn)) n += m_meshletCuller.count();
+  return n;
 }
 void GBufferPass::clear(PipelineGroups flags) {
   if (bool(flags & PipelineGroups::SurfaceMaterial)) BasePass::clear();
+  if (bool(flags & PipelineGroups::BuiltIn)) m_meshletCuller.clear();
 }
 
 void GBufferPass::addGeometryPass(
   FrameGraph &fg, FrameGraphBlackboard &blackboard, rhi::Extent2D resolution,
-  const ViewInfo &viewData, const PropertyGroupOffsets &propertyGroupOffsets) {
+  const ViewInfo &viewData, const PropertyGroupOffsets &propertyGroupOffsets,
+  bool meshletCulling) {
   constexpr auto kPassName = "GBufferPass";
   ZoneScopedN(kPassName);
 
@@ -69,12 +75,24 @@ void GBufferPass::addGeometryPass(
 
   const auto instances = uploadInstances(fg, std::move(gpuInstances));
 
+  const auto meshlets = meshletCulling && m_meshletCuller.isSupported()
+                    ? m_meshletCuller.cull(fg, blackboard, batches, instances)
+                    : std::nullopt;
+
   blackboard.add<GBufferData>() = fg.addCallbackPass<GBufferData>(
     kPassName,
-    [&fg, &blackboard, resolution, instances](FrameGraph::Builder &builder,
-                                              GBufferData &data) {
+    [&fg, &blackboard, resolution, instances,
+     &meshlets](FrameGraph::Builder &builder, GBufferData &data) {
       PASS_SETUP_ZONE;
 
+      if (meshlets) {
+        const BindingInfo drawStage{
+          .pipelineStage = PipelineStage::VertexShader,
+        };
+        builder.read(meshlets->drawCommands, drawStage);
+        builder.read(meshlets->indices, drawStage);
+      }
+
       read(builder, blackboard.get<FrameData>());
       read(builder, blackboard.get<CameraData>());
 
@@ -162,20 +180,39 @@ void GBufferPass::addGeometryPass(
                                    .clearValue = ClearValue::TransparentBlack,
                                  });
     },
-    [this, batches = std::move(batches)](
-      const GBufferData &, const FrameGraphPassResources &, void *ctx) {
+    [this, batches = std::move(batches), meshlets](
+      const GBufferData &, FrameGraphPassResources &resources, void *ctx) {
       auto &rc = *static_cast<RenderContext *>(ctx);
       auto &[cb, framebufferInfo, sets] = rc;
       RHI_GPU_ZONE(cb, kPassName);
 
+      IndirectDrawInfo indirectDrawInfo{};
+      if (meshlets) {
+        indirectDrawInfo = {
+          .indexBuffer = static_cast<const rhi::IndexBuffer *>(
+            resources.get<FrameGraphBuffer>(meshlets->indices).buffer),
+          .drawCommands =
+            resources.get<FrameGraphBuffer>(meshlets->drawCommands).buffer,
+          .multiDraw = meshlets->multiDraw,
+        };
+      }
+
       BaseGeometryPassInfo passInfo{
         .depthFormat = rhi::getDepthFormat(*framebufferInfo),
         .colorFormats = rhi::getColorFormats(*framebufferInfo),
       };
       cb.beginRendering(*framebufferInfo);
-      for (const auto &batch : batches) {
-        if (const auto *pipeline = _getPipeline(adjust(passInfo, batch));
-            pipeline) {
+      for (auto i = 0u; i < batches.size(); ++i) {
+        const auto &batch = batches[i];
+        const auto *pipeline = _getPipeline(adjust(passInfo, batch));
+        if (!pipeline) continue;
+
+        if (const auto firstCommand =
+              meshlets ? meshlets->firstCommands[i] : std::nullopt;
+            firstCommand) {
+          indirectDrawInfo.firstCommand = *firstCommand;
+          render(rc, *pipeline, batch, indirectDrawInfo);
+        } else {
           render(rc, *pipeline, batch);
         }
       }
@@ -1,4 +1,5 @@
 #include "renderer/Mesh.hpp"
+#include "glm/ext/matrix_transform.hpp" // translate, scale
 #include "spdlog/spdlog.h"
 
 namespace gfx {
@@ -14,6 +15,9 @@ const rhi::VertexBuffer *Mesh::getVertexBuffer() const {
 const rhi::IndexBuffer *Mesh::getIndexBuffer() const {
   return m_indexBuffer.get();
 }
+const rhi::StorageBuffer *Mesh::getMeshletBuffer() const {
+  return m_meshletBuffer.get();
+}
 
 const std::vector<SubMesh> &Mesh::getSubMeshes() const { return m_subMeshes; }
 
@@ -22,6 +26,10 @@ const Joints &Mesh::getInverseBindPose() const { return m_inverseBindPose; }
 
 const AABB &Mesh::getAABB() const { return m_aabb; }
 
+const std::optional<glm::mat4> &Mesh::getDequantization() const {
+  return m_dequantization;
+}
+
 //
 // Builder class:
 //
@@ -42,6 +50,11 @@ Builder::setIndexBuffer(std::shared_ptr<rhi::IndexBuffer> indexBuffer) {
   m_indexBuffer = std::move(indexBuffer);
   return *this;
 }
+Builder &
+Builder::setMeshletBuffer(std::shared_ptr<rhi::StorageBuffer> meshletBuffer) {
+  m_meshletBuffer = std::move(meshletBuffer);
+  return *this;
+}
 
 Builder &Builder::setInverseBindPose(Joints joints) {
   m_inverseBindPose = std::move(joints);
@@ -74,27 +87,44 @@ Builder &Builder::addLOD(uint32_t indexOffset, uint32_t numIndices) {
   m_subMeshes.back().lod.push_back({indexOffset, numIndices});
   return *this;
 }
+Builder &Builder::setMeshlets(uint32_t meshletOffset, uint32_t numMeshlets) {
+  auto &subMesh = m_subMeshes.back();
+  subMesh.meshletOffset = meshletOffset;
+  subMesh.numMeshlets = numMeshlets;
+  return *this;
+}
 
 Builder &Builder::setAABB(AABB aabb) {
   m_aabb = std::move(aabb);
   return *this;
 }
+Builder &Builder::setPositionBounds(const AABB &bounds) {
+  m_dequantization = glm::scale(glm::translate(glm::mat4{1.0f}, bounds.min),
+                                bounds.max - bounds.min);
+  return *this;
+}
 
 Mesh Builder::build() {
   Mesh m;
   m.m_vertexFormat = m_vertexFormat;
   m.m_vertexBuffer = m_vertexBuffer;
   m.m_indexBuffer = m_indexBuffer;
+  m.m_meshletBuffer = m_meshletBuffer;
 
   static const auto withoutLOD = [](const gfx::SubMesh &sm) {
     return sm.lod.empty();
   };
   assert(m_indexBuffer || std::ranges::all_of(m_subMeshes, withoutLOD));
+  static const auto withoutMeshlets = [](const gfx::SubMesh &sm) {
+    return sm.numMeshlets == 0;
+  };
+  assert(m_meshletBuffer || std::ranges::all_of(m_subMeshes, withoutMeshlets));
   if (isUninitialized(m_aabb)) m_aabb = m_subMeshes.front().aabb;
 
   m.m_subMeshes = std::move(m_subMeshes);
   m.m_inverseBindPose = std::move(m_inverseBindPose);
   m.m_aabb = m_aabb;
+  m.m_dequantization = m_dequantization;
 
   return m;
 }
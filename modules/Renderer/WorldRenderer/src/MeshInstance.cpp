@@ -53,6 +53,10 @@ MeshInstance &MeshInstance::setSkinMatrices(Joints skin) {
   m_skinMatrices = std::move(skin);
   return *this;
 }
+std::span<glm::mat4> MeshInstance::prepareSkin(std::size_t numJoints) {
+  m_skinMatrices.resize(numJoints);
+  return m_skinMatrices;
+}
 
 const glm::mat4 &MeshInstance::getModelMatrix() const { return m_modelMatrix; }
 const AABB &MeshInstance::getAABB() const { return m_aabb; }
@@ -4,6 +4,7 @@
 #include "rhi/json.hpp"
 #include "renderer/jsonVertexFormat.hpp"
 #include "renderer/jsonMaterial.hpp"
+#include "renderer/Meshlet.hpp"
 #include "spdlog/spdlog.h"
 
 using namespace nlohmann;
@@ -37,6 +38,7 @@ struct BufferMeta {
 
   struct Vertices : Info {
     AttributeMap attributes;
+    std::optional<AABB> positionBounds; // Quantized positions.
   };
   struct InverseBindPose : Info {
     [[nodiscard]] auto get(const std::byte *data) const {
@@ -48,6 +50,7 @@ struct BufferMeta {
 
   Vertices vertices;
   std::optional<Info> indices;
+  std::optional<Info> meshlets;
   std::optional<InverseBindPose> inverseBindPose;
 };
 
@@ -59,6 +62,9 @@ void from_json(const json &j, BufferMeta::Info &out) {
 void from_json(const json &j, BufferMeta::Vertices &out) {
   from_json(j, static_cast<BufferMeta::Info &>(out));
   j.at("attributes").get_to(out.attributes);
+  if (j.contains("positionBounds")) {
+    out.positionBounds = j.at("positionBounds").get<AABB>();
+  }
 }
 void from_json(const json &j, BufferMeta::InverseBindPose &out) {
   from_json(j, static_cast<BufferMeta::Info &>(out));
@@ -80,6 +86,9 @@ struct MeshMeta {
     std::vector<LOD> LODs;
     AABB aabb;
 
+    uint32_t meshletOffset{0};
+    uint32_t numMeshlets{0};
+
     std::filesystem::path materialPath; // Relative to mesh root file.
   };
   std::vector<SubMesh> meshes;
@@ -98,6 +107,11 @@ void from_json(const json &j, MeshMeta::SubMesh &out) {
   j.at("numVertices").get_to(out.numVertices);
   j.at("LOD").get_to(out.LODs);
   j.at("aabb").get_to(out.aabb);
+  if (j.contains("meshlets")) {
+    const auto &meshlets = j.at("meshlets");
+    meshlets.at("offset").get_to(out.meshletOffset);
+    meshlets.at("count").get_to(out.numMeshlets);
+  }
   out.materialPath = j.value("material", "");
 }
 
@@ -109,6 +123,9 @@ void from_json(const json &j, MeshMeta &out) {
   if (j.contains("indices")) {
     out.bufferMeta.indices = j.at("indices").get<BufferMeta::Info>();
   }
+  if (j.contains("meshlets")) {
+    out.bufferMeta.meshlets = j.at("meshlets").get<BufferMeta::Info>();
+  }
   if (j.contains("inverseBindPose")) {
     out.bufferMeta.inverseBindPose =
       j.at("inverseBindPose").get<BufferMeta::InverseBindPose>();
@@ -127,7 +144,8 @@ MeshLoader::result_type MeshLoader::operator()(const std::filesystem::path &p,
 
     const auto [data, bufferSize] =
       *os::FileSystem::readBuffer(p.parent_path() / meshMeta.bufferPath);
-    const auto &[vertices, indices, inverseBindPose] = meshMeta.bufferMeta;
+    const auto &[vertices, indices, meshlets, inverseBindPose] =
+      meshMeta.bufferMeta;
 
     auto vertexFormat = buildVertexFormat(vertices.attributes);
     if (vertexFormat->getStride() != vertices.stride)
@@ -140,11 +158,24 @@ MeshLoader::result_type MeshLoader::operator()(const std::filesystem::path &p,
     rhi::Buffer stagingIndexBuffer;
 
     if (indices) {
-      indexBuffer =
-        rd.createIndexBuffer(rhi::IndexType(indices->stride), indices->count);
+      // MeshletCulling.comp reads 16 bit indices in pairs (uint).
+      indexBuffer = rd.createIndexBuffer(rhi::IndexType(indices->stride),
+                                         indices->count + indices->count % 2);
       stagingIndexBuffer = indices->createStagingBuffer(rd, data.get());
     }
 
+    rhi::StorageBuffer meshletBuffer;
+    rhi::Buffer stagingMeshletBuffer;
+
+    if (meshlets) {
+      if (meshlets->stride != sizeof(Meshlet))
+        throw std::runtime_error{"Meshlet stride mismatch!"};
+      if (!indices) throw std::runtime_error{"Meshlets without indices!"};
+
+      meshletBuffer = rd.createStorageBuffer(meshlets->dataSize());
+      stagingMeshletBuffer = meshlets->createStagingBuffer(rd, data.get());
+    }
+
     rd.execute([&](rhi::CommandBuffer &cb) {
       cb.copyBuffer(stagingVertexBuffer, vertexBuffer,
                     {.size = vertices.dataSize()});
@@ -152,6 +183,10 @@ MeshLoader::result_type MeshLoader::operator()(const std::filesystem::path &p,
         cb.copyBuffer(stagingIndexBuffer, indexBuffer,
                       {.size = indices->dataSize()});
       }
+      if (stagingMeshletBuffer) {
+        cb.copyBuffer(stagingMeshletBuffer, meshletBuffer,
+                      {.size = meshlets->dataSize()});
+      }
     });
 
     // ---
@@ -164,9 +199,19 @@ MeshLoader::result_type MeshLoader::operator()(const std::filesystem::path &p,
         rhi::makeShared<rhi::IndexBuffer>(rd, std::move(indexBuffer)))
       .setAABB(meshMeta.aabb);
 
+    if (meshletBuffer) {
+      builder.setMeshletBuffer(
+        rhi::makeShared<rhi::StorageBuffer>(rd, std::move(meshletBuffer)));
+    }
     if (inverseBindPose) {
       builder.setInverseBindPose(inverseBindPose->get(data.get()));
     }
+    if (vertices.positionBounds) {
+      builder.setPositionBounds(*vertices.positionBounds);
+    } else if (vertices.attributes.at(AttributeLocation::Position).type ==
+               rhi::VertexAttribute::Type::UShort4_Norm) {
+      throw std::runtime_error{"Quantized positions without bounds!"};
+    }
 
     const auto dir = p.parent_path();
 
@@ -179,6 +224,9 @@ MeshLoader::result_type MeshLoader::operator()(const std::filesystem::path &p,
                            material.handle(), subMesh.aabb);
       for (const auto &lod : subMesh.LODs)
         builder.addLOD(lod.indexOffset, lod.numIndices);
+      if (meshlets && subMesh.numMeshlets > 0) {
+        builder.setMeshlets(subMesh.meshletOffset, subMesh.numMeshlets);
+      }
     }
 
     return std::make_shared<MeshResource>(builder.build(), p);
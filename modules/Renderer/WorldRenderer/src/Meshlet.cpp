@@ -0,0 +1,34 @@
+#include "renderer/Meshlet.hpp"
+#include "glm/geometric.hpp" // dot, length
+#include "glm/matrix.hpp"    // determinant
+#include <algorithm>         // min, max
+
+namespace gfx {
+
+bool isMeshletVisible(const Meshlet &meshlet, const Frustum &frustum,
+                      const glm::vec3 &cameraPosition, bool coneCulling) {
+  if (!frustum.testSphere({.c = meshlet.center, .r = meshlet.radius})) {
+    return false;
+  }
+  if (coneCulling) {
+    // https://github.com/zeux/meshoptimizer#clusterization
+    const auto v = meshlet.center - cameraPosition;
+    if (glm::dot(v, meshlet.coneAxis) >=
+        meshlet.coneCutoff * glm::length(v) + meshlet.radius) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool canConeCull(const glm::mat4 &m) {
+  const auto x = glm::dot(glm::vec3{m[0]}, glm::vec3{m[0]});
+  const auto y = glm::dot(glm::vec3{m[1]}, glm::vec3{m[1]});
+  const auto z = glm::dot(glm::vec3{m[2]}, glm::vec3{m[2]});
+  const auto maxScale = std::max({x, y, z});
+  constexpr auto kTolerance = 1e-3f;
+  return maxScale - std::min({x, y, z}) <= kTolerance * maxScale &&
+         glm::determinant(glm::mat3{m}) > 0.0f;
+}
+
+} // namespace gfx
@@ -0,0 +1,217 @@
+#include "renderer/MeshletCuller.hpp"
+
+#include "FrameGraphCommon.hpp"
+#include "renderer/FrameGraphBuffer.hpp"
+#include "FrameGraphResourceAccess.hpp"
+
+#include "FrameGraphData/Camera.hpp"
+#include "FrameGraphData/Transforms.hpp"
+
+#include "Batch.hpp"
+#include "UploadContainer.hpp"
+
+#include "ShaderCodeBuilder.hpp"
+#include "RenderContext.hpp"
+
+namespace gfx {
+
+namespace {
+
+constexpr auto kLocalSize = 64u;
+// Batches that don't fit are drawn as usual (64 MB).
+constexpr auto kMaxNumIndices = 1u << 24;
+
+// Matches MeshletCulling.comp
+constexpr auto kIndex16bit = 1u << 0;
+constexpr auto kConeCulling = 1u << 1;
+
+struct GPUDispatch {
+  uint32_t instanceOffset;
+  uint32_t meshletOffset;
+  uint32_t numMeshlets;
+  uint32_t firstCommand;
+  uint32_t flags;
+};
+static_assert(sizeof(GPUDispatch) == 20);
+
+struct Dispatch {
+  const Mesh *mesh;
+  GPUDispatch pushConstants;
+  uint32_t numInstances;
+};
+
+[[nodiscard]] bool hasMeshlets(const Batch &batch) {
+  // Skinned vertices don't fit the precomputed bounds.
+  return batch.subMesh->numMeshlets > 0 && !batch.mesh->isSkeletal();
+}
+[[nodiscard]] uint32_t getCullingFlags(const Batch &batch) {
+  uint32_t flags{0};
+  if (batch.mesh->getIndexBuffer()->getIndexType() == rhi::IndexType::UInt16) {
+    flags |= kIndex16bit;
+  }
+  // Back-facing clusters of double sided materials are visible.
+  if (getSurface(*batch.material).cullMode == rhi::CullMode::Back) {
+    flags |= kConeCulling;
+  }
+  return flags;
+}
+
+} // namespace
+
+//
+// MeshletCuller class:
+//
+
+MeshletCuller::MeshletCuller(rhi::RenderDevice &rd)
+    : rhi::ComputePass<MeshletCuller>{rd} {}
+
+bool MeshletCuller::isSupported() const {
+  return getRenderDevice().getDeviceFeatures().drawIndirectFirstInstance;
+}
+
+std::optional<MeshletCuller::Result>
+MeshletCuller::cull(FrameGraph &fg, FrameGraphBlackboard &blackboard,
+                    std::span<const Batch> batches,
+                    std::optional<FrameGraphResource> instances) {
+  constexpr auto kPassName = "MeshletCulling";
+  ZoneScopedN(kPassName);
+
+  const auto *transforms = blackboard.try_get<TransformData>();
+  if (!instances || !transforms) return std::nullopt;
+
+  Result result{
+    .firstCommands =
+      std::vector<std::optional<uint32_t>>(batches.size(), std::nullopt),
+    .multiDraw = bool(getRenderDevice().getDeviceFeatures().multiDrawIndirect),
+  };
+
+  std::vector<VkDrawIndexedIndirectCommand> drawCommands;
+  std::vector<Dispatch> dispatches;
+  uint32_t numIndices{0};
+
+  for (auto i = 0u; i < batches.size(); ++i) {
+    const auto &batch = batches[i];
+    if (!hasMeshlets(batch)) continue;
+
+    const auto &subMesh = *batch.subMesh;
+    // Each instance gets a range that fits all triangles of the first LOD.
+    const auto capacity = subMesh.lod.front().numIndices;
+    if (uint64_t{numIndices} + uint64_t{capacity} * batch.instances.count >
+        kMaxNumIndices) {
+      continue;
+    }
+    const auto firstCommand = uint32_t(drawCommands.size());
+    result.firstCommands[i] = firstCommand;
+    dispatches.push_back({
+      .mesh = batch.mesh,
+      .pushConstants =
+        {
+          .instanceOffset = batch.instances.offset,
+          .meshletOffset = subMesh.meshletOffset,
+          .numMeshlets = subMesh.numMeshlets,
+          .firstCommand = firstCommand,
+          .flags = getCullingFlags(batch),
+        },
+      .numInstances = batch.instances.count,
+    });
+    for (auto instance = 0u; instance < batch.instances.count; ++instance) {
+      drawCommands.push_back({
+        .indexCount = 0, // Incremented by the compute shader.
+        .instanceCount = 1,
+        .firstIndex = numIndices,
+        .vertexOffset = int32_t(subMesh.vertexOffset),
+        .firstInstance = instance,
+      });
+      numIndices += capacity;
+    }
+  }
+  if (dispatches.empty()) return std::nullopt;
+
+  result.drawCommands = *uploadContainer(fg, "UploadDrawCommands",
+                                         TransientBuffer{
+                                           .name = "DrawCommands",
+                                           .type = BufferType::IndirectBuffer,
+                                           .data = std::move(drawCommands),
+                                         });
+
+  struct Data {
+    FrameGraphResource drawCommands;
+    FrameGraphResource indices;
+  };
+  const auto [drawCommandsBuffer, indices] = fg.addCallbackPass<Data>(
+    kPassName,
+    [&blackboard, transforms, instances, &result,
+     numIndices](FrameGraph::Builder &builder, Data &data) {
+      PASS_SETUP_ZONE;
+
+      read(builder, blackboard.get<CameraData>(), PipelineStage::ComputeShader);
+      builder.read(transforms->transforms,
+                   BindingInfo{
+                     .location = {.set = 1, .binding = 1},
+                     .pipelineStage = PipelineStage::ComputeShader,
+                   });
+      builder.read(*instances,
+                   BindingInfo{
+                     .location = {.set = 1, .binding = 2},
+                     .pipelineStage = PipelineStage::ComputeShader,
+                   });
+
+      data.drawCommands = builder.write(
+        result.drawCommands, BindingInfo{
+                               .location = {.set = 2, .binding = 2},
+                               .pipelineStage = PipelineStage::ComputeShader,
+                             });
+
+      data.indices = builder.create<FrameGraphBuffer>(
+        "CulledIndices", {
+                           .type = BufferType::IndexBuffer,
+                           .stride = sizeof(uint32_t),
+                           .capacity = numIndices,
+                         });
+      data.indices = builder.write(
+        data.indices, BindingInfo{
+                        .location = {.set = 2, .binding = 3},
+                        .pipelineStage = PipelineStage::ComputeShader,
+                      });
+    },
+    [this, dispatches = std::move(dispatches)](
+      const Data &, const FrameGraphPassResources &, void *ctx) {
+      auto &rc = *static_cast<RenderContext *>(ctx);
+      auto &[cb, _, sets] = rc;
+      RHI_GPU_ZONE(cb, kPassName);
+
+      if (const auto *pipeline = _getPipeline(); pipeline) {
+        cb.bindPipeline(*pipeline);
+        for (const auto &[mesh, pushConstants, numInstances] : dispatches) {
+          sets[2][0] =
+            rhi::bindings::StorageBuffer{.buffer = mesh->getMeshletBuffer()};
+          sets[2][1] =
+            rhi::bindings::StorageBuffer{.buffer = mesh->getIndexBuffer()};
+          bindDescriptorSets(rc, *pipeline);
+          cb.pushConstants(rhi::ShaderStages::Compute, 0, &pushConstants);
+          cb.dispatch({
+            rhi::calcNumWorkGroups(
+              glm::uvec2{pushConstants.numMeshlets, numInstances},
+              glm::uvec2{kLocalSize, 1u}),
+            1u,
+          });
+        }
+      }
+      sets.clear();
+    });
+
+  result.drawCommands = drawCommandsBuffer;
+  result.indices = indices;
+  return result;
+}
+
+//
+// (private):
+//
+
+rhi::ComputePipeline MeshletCuller::_createPipeline() const {
+  return getRenderDevice().createComputePipeline(
+    ShaderCodeBuilder{}.buildFromFile("MeshletCulling.comp"));
+}
+
+} // namespace gfx
@@ -94,6 +94,34 @@ void drawBatch(RenderContext &rc, const Batch &batch) {
     .draw(getGeometryInfo(*batch.mesh, *batch.subMesh), batch.instances.count);
 }
 
+void render(RenderContext &rc, const rhi::GraphicsPipeline &pipeline,
+            const Batch &batch, const IndirectDrawInfo &info) {
+  if (validate(batch.textures)) {
+    bindBatch(rc, batch);
+    rc.commandBuffer.bindPipeline(pipeline);
+    bindDescriptorSets(rc, pipeline);
+    drawBatch(rc, batch, info);
+  }
+}
+void drawBatch(RenderContext &rc, const Batch &batch,
+               const IndirectDrawInfo &info) {
+  auto &cb = rc.commandBuffer;
+  cb.pushConstants(rhi::ShaderStages::Vertex, 0, &batch.instances.offset);
+
+  constexpr auto kStride = sizeof(VkDrawIndexedIndirectCommand);
+  const auto *vertexBuffer = batch.mesh->getVertexBuffer();
+  const auto &[indexBuffer, drawCommands, firstCommand, multiDraw] = info;
+  if (multiDraw) {
+    cb.drawIndexedIndirect(vertexBuffer, indexBuffer, *drawCommands,
+                           kStride * firstCommand, batch.instances.count);
+  } else {
+    for (auto i = 0u; i < batch.instances.count; ++i) {
+      cb.drawIndexedIndirect(vertexBuffer, indexBuffer, *drawCommands,
+                             kStride * (firstCommand + i));
+    }
+  }
+}
+
 void renderFullScreenPostProcess(RenderContext &rc,
                                  const rhi::GraphicsPipeline &pipeline) {
   auto &cb = rc.commandBuffer;
@@ -31,6 +31,17 @@ void bindMaterialTextures(RenderContext &, const TextureResources &);
 void bindDescriptorSets(RenderContext &, const rhi::BasePipeline &);
 void drawBatch(RenderContext &, const Batch &);
 
+// Draws a batch with one indirect command per instance (MeshletCuller).
+struct IndirectDrawInfo {
+  const rhi::IndexBuffer *indexBuffer;
+  const rhi::Buffer *drawCommands; // VkDrawIndexedIndirectCommand[]
+  uint32_t firstCommand;
+  bool multiDraw; // A single call for all instances.
+};
+void render(RenderContext &, const rhi::GraphicsPipeline &, const Batch &,
+            const IndirectDrawInfo &);
+void drawBatch(RenderContext &, const Batch &, const IndirectDrawInfo &);
+
 void renderFullScreenPostProcess(RenderContext &,
                                  const rhi::GraphicsPipeline &);
 
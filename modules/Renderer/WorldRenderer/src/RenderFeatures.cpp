@@ -9,7 +9,7 @@ std::string toString(RenderFeatures flags) {
   if (flags == None) return "None";
 
   std::vector<const char *> values;
-  constexpr auto kMaxNumFlags = 9;
+  constexpr auto kMaxNumFlags = 11;
   values.reserve(kMaxNumFlags);
 
 #define CHECK_FLAG(Value)                                                      \
@@ -24,6 +24,8 @@ std::string toString(RenderFeatures flags) {
   CHECK_FLAG(FXAA);
   CHECK_FLAG(EyeAdaptation);
   CHECK_FLAG(CustomPostprocess);
+  CHECK_FLAG(MeshletCulling);
+  CHECK_FLAG(ComputeSkinning);
 
   return join(values, ", ");
 }
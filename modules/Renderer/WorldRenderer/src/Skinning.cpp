@@ -0,0 +1,134 @@
+#include "renderer/Skinning.hpp"
+#include "glm/ext/matrix_float3x3.hpp"
+#include "glm/ext/vector_uint4_sized.hpp" // u8vec4, u16vec4
+#include "glm/common.hpp"    // abs, clamp, round
+#include "glm/geometric.hpp" // normalize
+#include "glm/matrix.hpp"    // inverse, transpose
+#include <cstring>           // memcpy
+#include <cassert>
+
+namespace gfx {
+
+namespace {
+
+template <typename T>
+[[nodiscard]] T read(const std::byte *vertex, uint32_t offset) {
+  T v;
+  std::memcpy(&v, vertex + offset, sizeof(T));
+  return v;
+}
+
+// GLSL: packSnorm2x16/unpackSnorm2x16
+[[nodiscard]] uint32_t packSnorm2x16(const glm::vec2 &v) {
+  const auto pack = [](float f) {
+    const auto i = int16_t(glm::round(glm::clamp(f, -1.0f, 1.0f) * 32767.0f));
+    return uint32_t(uint16_t(i));
+  };
+  return pack(v.x) | (pack(v.y) << 16);
+}
+[[nodiscard]] glm::vec2 unpackSnorm2x16(uint32_t v) {
+  const auto unpack = [](uint32_t bits) {
+    return glm::clamp(float(int16_t(uint16_t(bits))) / 32767.0f, -1.0f, 1.0f);
+  };
+  return {unpack(v & 0xFFFF), unpack(v >> 16)};
+}
+
+[[nodiscard]] glm::vec3 decodeOctahedral(glm::vec2 e) {
+  glm::vec3 v{e, 1.0f - glm::abs(e.x) - glm::abs(e.y)};
+  const auto t = glm::max(-v.z, 0.0f);
+  v.x += v.x >= 0.0f ? -t : t;
+  v.y += v.y >= 0.0f ? -t : t;
+  return glm::normalize(v);
+}
+
+[[nodiscard]] glm::vec3 readPosition(const std::byte *vertex,
+                                     const SkinningLayout &layout,
+                                     const glm::mat4 &dequantization) {
+  if (layout.flags & SkinningLayout::QuantizedPosition) {
+    const auto q = read<glm::u16vec4>(vertex, layout.position);
+    return dequantization * glm::vec4{glm::vec3{q} / 65535.0f, 1.0f};
+  }
+  return read<glm::vec3>(vertex, layout.position);
+}
+[[nodiscard]] glm::vec3 readDirection(const std::byte *vertex, uint32_t offset,
+                                      bool octahedral) {
+  if (offset == SkinningLayout::kNone) return glm::vec3{0.0f};
+  return octahedral
+           ? decodeOctahedral(unpackSnorm2x16(read<uint32_t>(vertex, offset)))
+           : read<glm::vec3>(vertex, offset);
+}
+[[nodiscard]] glm::uvec4 readJoints(const std::byte *vertex,
+                                    const SkinningLayout &layout) {
+  return layout.flags & SkinningLayout::PackedJoints
+           ? glm::uvec4{read<glm::u8vec4>(vertex, layout.joints)}
+           : glm::uvec4{read<glm::ivec4>(vertex, layout.joints)};
+}
+[[nodiscard]] glm::vec4 readWeights(const std::byte *vertex,
+                                    const SkinningLayout &layout) {
+  return layout.flags & SkinningLayout::PackedWeights
+           ? glm::vec4{read<glm::u8vec4>(vertex, layout.weights)} / 255.0f
+           : read<glm::vec4>(vertex, layout.weights);
+}
+
+} // namespace
+
+uint32_t packOctahedral(const glm::vec3 &n) {
+  const auto sum = glm::abs(n.x) + glm::abs(n.y) + glm::abs(n.z);
+  if (sum == 0.0f) return packSnorm2x16(glm::vec2{0.0f});
+
+  auto v = glm::vec2{n} / sum;
+  if (n.z < 0.0f) {
+    v = (1.0f - glm::abs(glm::vec2{v.y, v.x})) *
+        glm::vec2{v.x >= 0.0f ? 1.0f : -1.0f, v.y >= 0.0f ? 1.0f : -1.0f};
+  }
+  return packSnorm2x16(v);
+}
+glm::vec3 unpackOctahedral(uint32_t v) {
+  return decodeOctahedral(unpackSnorm2x16(v));
+}
+
+SkinnedVertex skinVertex(const std::byte *vertex, const SkinningLayout &layout,
+                         std::span<const glm::mat4> joints,
+                         const glm::mat4 &dequantization) {
+  const auto indices = readJoints(vertex, layout);
+  const auto weights = readWeights(vertex, layout);
+
+  glm::mat4 skinMatrix{0.0f};
+  for (auto i = 0; i < 4; ++i) {
+    assert(indices[i] < joints.size());
+    skinMatrix += weights[i] * joints[indices[i]];
+  }
+  // The same as Mesh.vert (_buildNormalMatrix), tangents included.
+  const auto normalMatrix = glm::transpose(glm::inverse(glm::mat3{skinMatrix}));
+
+  const auto position = readPosition(vertex, layout, dequantization);
+  const auto transform = [&normalMatrix](const glm::vec3 &v) {
+    return v == glm::vec3{0.0f} ? v : glm::normalize(normalMatrix * v);
+  };
+  const auto octahedralTangents =
+    bool(layout.flags & SkinningLayout::OctahedralTangents);
+  return {
+    .position = glm::vec3{skinMatrix * glm::vec4{position, 1.0f}},
+    .normal = packOctahedral(transform(readDirection(
+      vertex, layout.normal,
+      bool(layout.flags & SkinningLayout::OctahedralNormal)))),
+    .tangent = packOctahedral(transform(
+      readDirection(vertex, layout.tangent, octahedralTangents))),
+    .bitangent = packOctahedral(transform(
+      readDirection(vertex, layout.bitangent, octahedralTangents))),
+  };
+}
+
+void skinVertices(std::span<const std::byte> vertices,
+                  const SkinningLayout &layout,
+                  std::span<const glm::mat4> joints,
+                  const glm::mat4 &dequantization,
+                  std::span<SkinnedVertex> out) {
+  assert(layout.stride > 0 && vertices.size() / layout.stride <= out.size());
+  for (auto i = 0u; i < vertices.size() / layout.stride; ++i) {
+    out[i] = skinVertex(vertices.data() + i * layout.stride, layout, joints,
+                        dequantization);
+  }
+}
+
+} // namespace gfx
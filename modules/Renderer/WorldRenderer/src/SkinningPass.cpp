@@ -0,0 +1,232 @@
+#include "renderer/SkinningPass.hpp"
+#include "renderer/Mesh.hpp"
+
+#include "FrameGraphCommon.hpp"
+#include "renderer/FrameGraphBuffer.hpp"
+#include "FrameGraphResourceAccess.hpp"
+
+#include "FrameGraphData/Transforms.hpp"
+#include "FrameGraphData/Skins.hpp"
+
+#include "ShaderCodeBuilder.hpp"
+#include "RenderContext.hpp"
+
+namespace gfx {
+
+namespace {
+
+constexpr auto kLocalSize = 64u;
+// The buffer grows in steps (2 MB), so the same transient buffer is reused
+// in the following frames.
+constexpr auto kCapacityGranularity = 1u << 16;
+
+struct GPUDispatch {
+  uint32_t jointOffset;
+  uint32_t transformId;
+  uint32_t firstVertex;
+  uint32_t numVertices;
+  SkinningLayout layout;
+};
+static_assert(sizeof(GPUDispatch) == 48);
+
+struct Dispatch {
+  const Mesh *mesh;
+  GPUDispatch pushConstants;
+};
+
+[[nodiscard]] std::optional<uint32_t>
+getOffset(const VertexFormat &vertexFormat, AttributeLocation location,
+          std::initializer_list<rhi::VertexAttribute::Type> types) {
+  const auto &attributes = vertexFormat.getAttributes();
+  if (const auto it = attributes.find(uint32_t(location));
+      it != attributes.cend()) {
+    const auto [type, offset] = it->second;
+    if (std::ranges::find(types, type) != types.end() && offset % 4 == 0) {
+      return offset;
+    }
+  }
+  return std::nullopt;
+}
+[[nodiscard]] bool hasType(const VertexFormat &vertexFormat,
+                           AttributeLocation location,
+                           rhi::VertexAttribute::Type type) {
+  const auto &attributes = vertexFormat.getAttributes();
+  const auto it = attributes.find(uint32_t(location));
+  return it != attributes.cend() && it->second.type == type;
+}
+
+} // namespace
+
+std::optional<SkinningLayout>
+getSkinningLayout(const VertexFormat &vertexFormat) {
+  using enum AttributeLocation;
+  using enum rhi::VertexAttribute::Type;
+
+  const auto stride = vertexFormat.getStride();
+  const auto position =
+    getOffset(vertexFormat, Position, {Float3, UShort4_Norm});
+  const auto joints = getOffset(vertexFormat, Joints, {Int4, UByte4});
+  const auto weights =
+    getOffset(vertexFormat, Weights, {Float4, UByte4_Norm});
+  if (stride % 4 != 0 || !position || !joints || !weights) return std::nullopt;
+
+  // Attributes (present) in other formats are not supported.
+  const auto getDirection = [&vertexFormat](AttributeLocation location) {
+    return vertexFormat.contains(location)
+             ? getOffset(vertexFormat, location, {Float3, Short2_Norm})
+             : std::optional{SkinningLayout::kNone};
+  };
+  const auto normal = getDirection(Normal);
+  const auto tangent = getDirection(Tangent);
+  const auto bitangent = getDirection(Bitangent);
+  if (!normal || !tangent || !bitangent) return std::nullopt;
+
+  uint32_t flags{SkinningLayout::None};
+  if (hasType(vertexFormat, Position, UShort4_Norm)) {
+    flags |= SkinningLayout::QuantizedPosition;
+  }
+  if (hasType(vertexFormat, Normal, Short2_Norm)) {
+    flags |= SkinningLayout::OctahedralNormal;
+  }
+  if (hasType(vertexFormat, Tangent, Short2_Norm)) {
+    flags |= SkinningLayout::OctahedralTangents;
+  }
+  if (hasType(vertexFormat, Joints, UByte4)) {
+    flags |= SkinningLayout::PackedJoints;
+  }
+  if (hasType(vertexFormat, Weights, UByte4_Norm)) {
+    flags |= SkinningLayout::PackedWeights;
+  }
+  return SkinningLayout{
+    .stride = stride,
+    .position = *position,
+    .normal = *normal,
+    .tangent = *tangent,
+    .bitangent = *bitangent,
+    .joints = *joints,
+    .weights = *weights,
+    .flags = flags,
+  };
+}
+
+//
+// SkinningPass class:
+//
+
+SkinningPass::SkinningPass(rhi::RenderDevice &rd)
+    : rhi::ComputePass<SkinningPass>{rd} {}
+
+uint32_t SkinningPass::count(PipelineGroups flags) const {
+  return bool(flags & PipelineGroups::BuiltIn) ? BasePass::count() : 0;
+}
+void SkinningPass::clear(PipelineGroups flags) {
+  if (bool(flags & PipelineGroups::BuiltIn)) BasePass::clear();
+}
+
+uint32_t SkinningPass::countVertices(const Mesh &mesh) {
+  if (!mesh.isSkeletal() || !getSkinningLayout(mesh.getVertexFormat())) {
+    return 0;
+  }
+  uint32_t n{0};
+  for (const auto &subMesh : mesh.getSubMeshes()) {
+    n = std::max(n, subMesh.vertexOffset + subMesh.numVertices);
+  }
+  return n;
+}
+
+void SkinningPass::addPass(FrameGraph &fg, FrameGraphBlackboard &blackboard,
+                           std::vector<Instance> &&instances) {
+  constexpr auto kPassName = "Skinning";
+  ZoneScopedN(kPassName);
+
+  auto *skins = blackboard.try_get<SkinData>();
+  const auto *transforms = blackboard.try_get<TransformData>();
+  if (instances.empty() || !skins || !transforms) return;
+
+  std::vector<Dispatch> dispatches;
+  dispatches.reserve(instances.size());
+  uint32_t numVertices{0};
+  for (const auto &instance : instances) {
+    dispatches.push_back({
+      .mesh = instance.mesh,
+      .pushConstants =
+        {
+          .jointOffset = instance.jointOffset,
+          .transformId = instance.transformId,
+          .firstVertex = instance.firstVertex,
+          .numVertices = instance.numVertices,
+          .layout = *getSkinningLayout(instance.mesh->getVertexFormat()),
+        },
+    });
+    numVertices =
+      std::max(numVertices, instance.firstVertex + instance.numVertices);
+  }
+  const auto capacity = (numVertices + kCapacityGranularity - 1) /
+                        kCapacityGranularity * kCapacityGranularity;
+
+  struct Data {
+    FrameGraphResource skinnedVertices;
+  };
+  const auto [skinnedVertices] = fg.addCallbackPass<Data>(
+    kPassName,
+    [skins, transforms, capacity](FrameGraph::Builder &builder, Data &data) {
+      PASS_SETUP_ZONE;
+
+      builder.read(transforms->transforms,
+                   BindingInfo{
+                     .location = {.set = 1, .binding = 1},
+                     .pipelineStage = PipelineStage::ComputeShader,
+                   });
+      builder.read(skins->skins,
+                   BindingInfo{
+                     .location = {.set = 0, .binding = 2},
+                     .pipelineStage = PipelineStage::ComputeShader,
+                   });
+
+      data.skinnedVertices = builder.create<FrameGraphBuffer>(
+        "SkinnedVertices", {
+                             .type = BufferType::StorageBuffer,
+                             .stride = sizeof(SkinnedVertex),
+                             .capacity = capacity,
+                           });
+      data.skinnedVertices = builder.write(
+        data.skinnedVertices, BindingInfo{
+                                .location = {.set = 2, .binding = 1},
+                                .pipelineStage = PipelineStage::ComputeShader,
+                              });
+    },
+    [this, dispatches = std::move(dispatches)](
+      const Data &, const FrameGraphPassResources &, void *ctx) {
+      auto &rc = *static_cast<RenderContext *>(ctx);
+      auto &[cb, _, sets] = rc;
+      RHI_GPU_ZONE(cb, kPassName);
+
+      if (const auto *pipeline = _getPipeline(); pipeline) {
+        cb.bindPipeline(*pipeline);
+        for (const auto &[mesh, pushConstants] : dispatches) {
+          sets[2][0] =
+            rhi::bindings::StorageBuffer{.buffer = mesh->getVertexBuffer()};
+          bindDescriptorSets(rc, *pipeline);
+          cb.pushConstants(rhi::ShaderStages::Compute, 0, &pushConstants);
+          cb.dispatch({
+            rhi::calcNumWorkGroups(glm::uvec2{pushConstants.numVertices, 1u},
+                                   glm::uvec2{kLocalSize, 1u}),
+            1u,
+          });
+        }
+      }
+      sets.clear();
+    });
+  skins->skinnedVertices = skinnedVertices;
+}
+
+//
+// (private):
+//
+
+rhi::ComputePipeline SkinningPass::_createPipeline() const {
+  return getRenderDevice().createComputePipeline(
+    ShaderCodeBuilder{}.buildFromFile("Skinning.comp"));
+}
+
+} // namespace gfx
@@ -51,6 +51,12 @@ TextureLoader::operator()(const std::filesystem::path &p,
   }
 }
 TextureLoader::result_type
+TextureLoader::operator()(const std::filesystem::path &p, rhi::RenderDevice &rd,
+                          TextureStreamer &streamer) const {
+  if (auto resource = streamer.load(p); resource) return resource;
+  return (*this)(p, rd);
+}
+TextureLoader::result_type
 TextureLoader::operator()(rhi::Texture &&texture) const {
   return std::make_shared<TextureResource>(std::move(texture), "");
 }
@@ -7,7 +7,9 @@ namespace gfx {
 TextureManager::TextureManager(rhi::RenderDevice &rd) : m_renderDevice{rd} {}
 
 TextureResourceHandle TextureManager::load(const std::filesystem::path &p) {
-  return ::load(*this, p, LoadMode::External, m_renderDevice);
+  return ::load(*this, p, LoadMode::External, m_renderDevice, m_streamer);
 }
 
+TextureStreamer &TextureManager::getStreamer() { return m_streamer; }
+
 } // namespace gfx
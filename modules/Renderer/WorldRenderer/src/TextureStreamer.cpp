@@ -0,0 +1,294 @@
+#include "renderer/TextureStreamer.hpp"
+#include "os/FileSystem.hpp"
+
+#include "spdlog/spdlog.h"
+#include "tracy/Tracy.hpp"
+
+#include <algorithm> // sort, clamp
+#include <cmath>     // log2, floor
+#include <ranges>
+
+namespace gfx {
+
+namespace {
+
+// @return The first level that is not larger than the given size.
+[[nodiscard]] uint32_t calcTailLevel(const KTXMipChain &mipChain,
+                                     uint32_t residentSize) {
+  const auto size = std::max(mipChain.extent.width, mipChain.extent.height);
+  auto level = 0u;
+  while (level + 1 < mipChain.getNumLevels() && (size >> level) > residentSize)
+    ++level;
+  return level;
+}
+
+} // namespace
+
+//
+// TextureStreamer class:
+//
+
+TextureStreamer::TextureStreamer(rhi::RenderDevice &rd)
+    : m_renderDevice{rd},
+      m_worker{[this](std::stop_token stopToken) { _workerLoop(stopToken); }} {
+}
+TextureStreamer::~TextureStreamer() = default;
+
+void TextureStreamer::setSettings(const TextureStreamingSettings &settings) {
+  m_settings = settings;
+}
+const TextureStreamingSettings &TextureStreamer::getSettings() const {
+  return m_settings;
+}
+
+std::shared_ptr<TextureResource>
+TextureStreamer::load(const std::filesystem::path &p) {
+  if (!m_settings.enabled || os::FileSystem::getExtension(p) != ".ktx2") {
+    return nullptr;
+  }
+  auto mipChain = readMipChainKTX(p, m_renderDevice);
+  if (!mipChain) return nullptr;
+
+  const auto tailLevel = calcTailLevel(*mipChain, m_settings.residentSize);
+  if (tailLevel == 0) return nullptr; // Small enough, nothing to stream.
+
+  const auto mipLevels = readMipLevelsKTX(p, *mipChain, tailLevel);
+  if (!mipLevels) return nullptr;
+  auto texture = createTextureKTX(m_renderDevice, *mipChain, *mipLevels);
+  if (!texture) return nullptr;
+
+  auto resource =
+    rhi::makeShared<TextureResource>(m_renderDevice, std::move(*texture), p);
+  m_entries.emplace(resource.get(),
+                    Entry{
+                      .resource = resource,
+                      .mipChain = std::make_shared<const KTXMipChain>(
+                        std::move(*mipChain)),
+                      .tailLevel = tailLevel,
+                      .firstLevel = tailLevel,
+                      .desiredLevel = tailLevel,
+                    });
+  return resource;
+}
+
+void TextureStreamer::request(const rhi::Texture *texture, float screenSize) {
+  const auto it = m_entries.find(texture);
+  if (it == m_entries.cend()) return;
+
+  auto &entry = it->second;
+  const auto &extent = entry.mipChain->extent;
+  const auto texels = float(std::max(extent.width, extent.height));
+  const auto level =
+    std::floor(std::log2(texels / std::max(screenSize, 1.0f)) -
+               m_settings.mipBias);
+  const auto desiredLevel =
+    uint32_t(std::clamp(level, 0.0f, float(entry.tailLevel)));
+
+  if (entry.lastRequested != m_frame) {
+    entry.lastRequested = m_frame;
+    entry.desiredLevel = desiredLevel;
+  } else {
+    entry.desiredLevel = std::min(entry.desiredLevel, desiredLevel);
+  }
+}
+
+void TextureStreamer::update() {
+  ZoneScopedN("TextureStreamer::Update");
+
+  _collectGarbage();
+  _uploadLoaded();
+  if (m_settings.enabled) _schedule();
+
+  m_stats.numTextures = uint32_t(m_entries.size());
+  m_stats.numPending = 0;
+  m_stats.residentBytes = 0;
+  m_stats.fullBytes = 0;
+  for (const auto &entry : m_entries | std::views::values) {
+    if (entry.pendingLevel) ++m_stats.numPending;
+    m_stats.residentBytes += entry.mipChain->calcSize(entry.firstLevel);
+    m_stats.fullBytes += entry.mipChain->calcSize(0);
+  }
+  ++m_frame;
+}
+
+std::optional<TextureStreamer::Residency>
+TextureStreamer::getResidency(const rhi::Texture *texture) const {
+  const auto it = m_entries.find(texture);
+  if (it == m_entries.cend()) return std::nullopt;
+
+  const auto &entry = it->second;
+  return Residency{
+    .firstLevel = entry.firstLevel,
+    .numLevels = entry.mipChain->getNumLevels(),
+    .desiredLevel = entry.desiredLevel,
+  };
+}
+
+const TextureStreamingStats &TextureStreamer::getStats() const {
+  return m_stats;
+}
+
+//
+// (private):
+//
+
+void TextureStreamer::_collectGarbage() {
+  std::erase_if(m_entries,
+                [](const auto &p) { return p.second.resource.expired(); });
+}
+void TextureStreamer::_uploadLoaded() {
+  std::vector<Result> loaded;
+  {
+    std::scoped_lock lock{m_mutex};
+    while (!m_loaded.empty() && loaded.size() < m_settings.maxUploadsPerFrame) {
+      loaded.emplace_back(std::move(m_loaded.front()));
+      m_loaded.pop_front();
+    }
+  }
+
+  for (auto &[key, mipChain, mipLevels] : loaded) {
+    const auto it = m_entries.find(key);
+    // The address might have been reused by another texture.
+    if (it == m_entries.cend() || it->second.mipChain != mipChain) continue;
+
+    auto &entry = it->second;
+    entry.pendingLevel = std::nullopt;
+    auto resource = entry.resource.lock();
+    if (!resource) continue;
+
+    auto texture =
+      mipLevels ? createTextureKTX(m_renderDevice, *mipChain, *mipLevels)
+                : std::unexpected{mipLevels.error()};
+    if (!texture) {
+      SPDLOG_ERROR("Texture streaming failed ({}). {}",
+                   os::FileSystem::relativeToRoot(resource->getPath())
+                     ->generic_string(),
+                   texture.error());
+      entry.failed = true;
+      continue;
+    }
+
+    if (mipLevels->firstLevel > entry.firstLevel) ++m_stats.numEvictions;
+    entry.firstLevel = mipLevels->firstLevel;
+
+    // The old image might still be used by frames in flight.
+    auto &target = static_cast<rhi::Texture &>(*resource);
+    m_renderDevice.pushGarbage(target);
+    target = std::move(*texture);
+  }
+}
+void TextureStreamer::_schedule() {
+  ZoneScopedN("TextureStreamer::Schedule");
+
+  std::vector<std::pair<Key, Entry *>> candidates;
+  uint64_t projectedBytes{0}; // Including pending loads and evictions.
+  for (auto &[key, entry] : m_entries) {
+    projectedBytes +=
+      entry.mipChain->calcSize(entry.pendingLevel.value_or(entry.firstLevel));
+    if (entry.failed || entry.pendingLevel || entry.lastRequested != m_frame) {
+      continue;
+    }
+    if (entry.desiredLevel < entry.firstLevel) {
+      candidates.emplace_back(key, &entry);
+    }
+  }
+  // The largest difference between the desired and the resident level first.
+  std::ranges::sort(candidates, std::greater{}, [](const auto &p) {
+    return p.second->firstLevel - p.second->desiredLevel;
+  });
+
+  const auto budget = _calcBudget();
+  m_stats.budget = budget;
+  m_stats.numOverBudget = 0;
+  for (auto [key, entry] : candidates) {
+    const auto &mipChain = *entry->mipChain;
+    const auto residentBytes = mipChain.calcSize(entry->firstLevel);
+    const auto calcRequired = [&](uint32_t level) {
+      return mipChain.calcSize(level) - residentBytes;
+    };
+
+    if (const auto required = calcRequired(entry->desiredLevel);
+        projectedBytes + required > budget) {
+      projectedBytes -= _evict(projectedBytes + required - budget);
+    }
+    // Settle for a smaller mip level if the desired one does not fit.
+    auto level = entry->desiredLevel;
+    while (level < entry->firstLevel &&
+           projectedBytes + calcRequired(level) > budget) {
+      ++level;
+    }
+    if (level != entry->desiredLevel) ++m_stats.numOverBudget;
+    if (level == entry->firstLevel) continue;
+
+    projectedBytes += calcRequired(level);
+    _enqueue(key, *entry, level);
+  }
+}
+uint64_t TextureStreamer::_calcBudget() const {
+  const auto memory = m_renderDevice.getMemoryBudget();
+  const auto available =
+    memory.budget > memory.usage ? memory.budget - memory.usage : 0;
+  return std::min(m_settings.budget, m_stats.residentBytes + available);
+}
+uint64_t TextureStreamer::_evict(uint64_t required) {
+  std::vector<std::pair<Key, Entry *>> candidates;
+  for (auto &[key, entry] : m_entries) {
+    if (!entry.failed && !entry.pendingLevel &&
+        entry.lastRequested != m_frame && entry.firstLevel < entry.tailLevel) {
+      candidates.emplace_back(key, &entry);
+    }
+  }
+  // Least recently requested first.
+  std::ranges::sort(candidates, std::less{},
+                    [](const auto &p) { return p.second->lastRequested; });
+
+  uint64_t freed{0};
+  for (auto [key, entry] : candidates) {
+    if (freed >= required) break;
+
+    const auto &mipChain = *entry->mipChain;
+    freed += mipChain.calcSize(entry->firstLevel) -
+             mipChain.calcSize(entry->tailLevel);
+    _enqueue(key, *entry, entry->tailLevel);
+  }
+  return freed;
+}
+void TextureStreamer::_enqueue(Key key, Entry &entry, uint32_t firstLevel) {
+  auto resource = entry.resource.lock();
+  assert(resource);
+  entry.pendingLevel = firstLevel;
+  {
+    std::scoped_lock lock{m_mutex};
+    m_jobs.push_back({
+      .key = key,
+      .path = resource->getPath(),
+      .mipChain = entry.mipChain,
+      .firstLevel = firstLevel,
+    });
+  }
+  m_jobAdded.notify_one();
+}
+
+void TextureStreamer::_workerLoop(std::stop_token stopToken) {
+  while (true) {
+    Job job;
+    {
+      std::unique_lock lock{m_mutex};
+      if (!m_jobAdded.wait(lock, stopToken, [this] { return !m_jobs.empty(); }))
+        return;
+      job = std::move(m_jobs.front());
+      m_jobs.pop_front();
+    }
+
+    auto mipLevels =
+      readMipLevelsKTX(job.path, *job.mipChain, job.firstLevel);
+    std::scoped_lock lock{m_mutex};
+    m_loaded.push_back({
+      .key = job.key,
+      .mipChain = std::move(job.mipChain),
+      .mipLevels = std::move(mipLevels),
+    });
+  }
+}
+
+} // namespace gfx
@@ -144,6 +144,10 @@ TransientResources::acquireBuffer(const FrameGraphBuffer::Desc &desc) {
         std::make_unique<rhi::IndexBuffer>(m_renderDevice.createIndexBuffer(
           static_cast<rhi::IndexType>(desc.stride), desc.capacity));
       break;
+    case IndirectBuffer:
+      buffer = std::make_unique<rhi::Buffer>(
+        m_renderDevice.createIndirectBuffer(desc.dataSize()));
+      break;
 
     default:
       assert(false);
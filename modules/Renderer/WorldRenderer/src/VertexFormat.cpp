@@ -17,6 +17,18 @@ template <> struct hash<rhi::VertexAttribute> {
 
 namespace gfx {
 
+namespace {
+
+[[nodiscard]] bool hasType(const VertexFormat &vertexFormat,
+                           AttributeLocation location,
+                           rhi::VertexAttribute::Type type) {
+  const auto &attributes = vertexFormat.getAttributes();
+  const auto it = attributes.find(int32_t(location));
+  return it != attributes.cend() && it->second.type == type;
+}
+
+} // namespace
+
 //
 // VertexFormat class:
 //
@@ -109,23 +121,37 @@ const char *toString(AttributeLocation location) {
 }
 
 std::vector<std::string> buildDefines(const VertexFormat &vertexFormat) {
-  constexpr auto kMaxNumVertexDefines = 6;
+  constexpr auto kMaxNumVertexDefines = 10;
   std::vector<std::string> defines;
   defines.reserve(kMaxNumVertexDefines);
 
   using enum AttributeLocation;
+  using enum rhi::VertexAttribute::Type;
+
+  // Decoded in shaders/VertexAttributes.glsl
+  if (hasType(vertexFormat, Position, UShort4_Norm))
+    defines.emplace_back("QUANTIZED_POSITION");
 
   if (vertexFormat.contains(Color_0)) defines.emplace_back("HAS_COLOR");
-  if (vertexFormat.contains(Normal)) defines.emplace_back("HAS_NORMAL");
+  if (vertexFormat.contains(Normal)) {
+    defines.emplace_back("HAS_NORMAL");
+    if (hasType(vertexFormat, Normal, Short2_Norm))
+      defines.emplace_back("OCTAHEDRAL_NORMAL");
+  }
   if (vertexFormat.contains(TexCoord_0)) {
     defines.emplace_back("HAS_TEXCOORD0");
     if (vertexFormat.contains({Tangent, Bitangent})) {
       defines.emplace_back("HAS_TANGENTS");
+      if (hasType(vertexFormat, Tangent, Short2_Norm))
+        defines.emplace_back("OCTAHEDRAL_TANGENTS");
     }
   }
   if (vertexFormat.contains(TexCoord_1)) defines.emplace_back("HAS_TEXCOORD1");
-  if (vertexFormat.contains({Joints, Weights}))
+  if (vertexFormat.contains({Joints, Weights})) {
     defines.emplace_back("IS_SKINNED");
+    if (hasType(vertexFormat, Joints, UByte4))
+      defines.emplace_back("PACKED_JOINTS");
+  }
 
   return defines;
 }
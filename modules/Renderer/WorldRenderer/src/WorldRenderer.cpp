@@ -23,12 +23,17 @@
 
 #include "renderer/Vertex1p1n1st.hpp"
 
+#include "glm/geometric.hpp" // distance
+#include <ranges>
+
 namespace gfx {
 
 namespace {
 
 constexpr auto kUseWeightedBlendedTechnique = false;
 constexpr auto kTileSize = 16u;
+// Instances that don't fit are skinned in the vertex shader (128 MB).
+constexpr auto kMaxNumSkinnedVertices = 1u << 22;
 
 void importSkyLight(FrameGraph &fg, FrameGraphBlackboard &blackboard,
                     const SkyLight &skyLight) {
@@ -59,6 +64,33 @@ getVisibleRenderables(std::span<const Renderable> renderables,
   return result;
 }
 
+void requestTextureMips(TextureStreamer &streamer,
+                        std::span<const Renderable *> renderables,
+                        const PerspectiveCamera &camera,
+                        rhi::Extent2D resolution) {
+  ZoneScopedN("RequestTextureMips");
+
+  const auto eye = camera.getPosition();
+  // Projected size (in pixels) of one world unit, at the distance of 1.
+  const auto pixelsPerUnit =
+    camera.getProjection()[1][1] * 0.5f * float(resolution.height);
+  for (const auto *r : renderables) {
+    const auto &textures = r->subMeshInstance.material.getTextures();
+    if (textures.empty()) continue;
+
+    // Assumes that the [0..1] UV range covers the whole bounding sphere.
+    const auto &aabb = r->subMeshInstance.aabb;
+    const auto radius = aabb.getRadius();
+    const auto distance =
+      std::max(glm::distance(eye, aabb.getCenter()) - radius, 1e-3f);
+    const auto screenSize = 2.0f * radius * pixelsPerUnit / distance;
+
+    for (const auto &textureInfo : textures | std::views::values) {
+      streamer.request(textureInfo.texture.get(), screenSize);
+    }
+  }
+}
+
 // ---
 
 // Key = Property buffer size (_PropertyBlock struct stride).
@@ -93,8 +125,10 @@ struct RenderableStore {
   struct Config {
     std::size_t numTransforms;
     std::size_t numJoints;
+    bool computeSkinning;
   };
-  explicit RenderableStore(const Config &config) {
+  explicit RenderableStore(const Config &config)
+      : skinning{.enabled = config.computeSkinning} {
     modelMatrices.reserve(config.numTransforms);
     joints.reserve(config.numJoints);
   }
@@ -102,8 +136,43 @@ struct RenderableStore {
   std::vector<glm::mat4> modelMatrices;
   Joints joints;
   PropertyGroups propertyGroups;
+
+  struct Skinning {
+    bool enabled;
+    std::vector<SkinningPass::Instance> instances;
+    uint32_t numVertices{0};
+  };
+  Skinning skinning;
 };
 
+// @return GPUInstance::skinOffset (the first joint or the first vertex).
+[[nodiscard]] auto addSkin(RenderableStore &store,
+                           const MeshInstance &meshInstance,
+                           uint32_t transformId) {
+  const auto jointOffset = uint32_t(store.joints.size());
+  const auto &skin = meshInstance.getSkinMatrices();
+  store.joints.insert(store.joints.cend(), skin.cbegin(), skin.cend());
+  auto &skinning = store.skinning;
+  if (!skinning.enabled) return jointOffset;
+
+  const auto *mesh = meshInstance.getPrototype().get();
+  const auto numVertices = SkinningPass::countVertices(*mesh);
+  if (numVertices == 0 ||
+      skinning.numVertices + numVertices > kMaxNumSkinnedVertices) {
+    return jointOffset;
+  }
+  const auto firstVertex = skinning.numVertices;
+  skinning.instances.push_back({
+    .mesh = mesh,
+    .jointOffset = jointOffset,
+    .transformId = transformId,
+    .firstVertex = firstVertex,
+    .numVertices = numVertices,
+  });
+  skinning.numVertices += numVertices;
+  return firstVertex | kPreSkinnedBit;
+}
+
 [[nodiscard]] auto
 addMaterialInstance(RenderableStore &store,
                     const MaterialInstance &materialInstance) {
@@ -130,13 +199,15 @@ addMaterialInstance(RenderableStore &store,
 
     const auto transformId = uint32_t(store.modelMatrices.size());
     store.modelMatrices.emplace_back(meshInstance->getModelMatrix());
+    // Mesh.vert reads it from the slot next to the model matrix.
+    if (const auto &m = meshInstance->getPrototype()->getDequantization(); m) {
+      store.modelMatrices.emplace_back(*m);
+    }
 
-    const auto skinOffset = meshInstance->hasSkin()
-                              ? std::optional{uint32_t(store.joints.size())}
-                              : std::nullopt;
-
-    if (const auto &skin = meshInstance->getSkinMatrices(); !skin.empty())
-      store.joints.insert(store.joints.cend(), skin.cbegin(), skin.cend());
+    const auto skinOffset =
+      meshInstance->hasSkin()
+        ? std::optional{addSkin(store, *meshInstance, transformId)}
+        : std::nullopt;
 
     for (const SubMeshInstance &subMesh : meshInstance->each()) {
       if (!subMesh.visible || !subMesh.material) continue;
@@ -223,9 +294,13 @@ rhi::RenderDevice &WorldRenderer::getRenderDevice() const {
   return m_renderDevice;
 }
 
+void WorldRenderer::setTextureStreamer(TextureStreamer *streamer) {
+  m_textureStreamer = streamer;
+}
+
 #define TECHNIQUES                                                             \
-  &m_cubemapConverter, &m_ibl, &m_tiledLighting, &m_shadowRenderer,            \
-    &m_globalIllumination, &m_gBufferPass, &m_decalPass,                       \
+  &m_cubemapConverter, &m_ibl, &m_skinningPass, &m_tiledLighting,              \
+    &m_shadowRenderer, &m_globalIllumination, &m_gBufferPass, &m_decalPass,    \
     &m_deferredLightingPass, &m_transparencyPass, &m_transmissionPass,         \
     &m_skyboxPass, &m_weightedBlendedPass, &m_wireframePass,                   \
     &m_debugNormalPass, &m_ssao, &m_ssr, &m_bloom, &m_eyeAdaptation,           \
@@ -296,6 +371,13 @@ void WorldRenderer::drawFrame(rhi::CommandBuffer &commandBuffer,
       // Reserve size (to reduce reallocations).
       .numTransforms = worldView.meshes.size() + worldView.decals.size(),
       .numJoints = 1024,
+      // Skinned vertices are shared by all views.
+      .computeSkinning = std::ranges::any_of(
+        worldView.sceneViews,
+        [](const SceneView &sceneView) {
+          return bool(sceneView.renderSettings.features &
+                      RenderFeatures::ComputeSkinning);
+        }),
     }};
 
     const auto renderables =
@@ -306,11 +388,12 @@ void WorldRenderer::drawFrame(rhi::CommandBuffer &commandBuffer,
     const auto minOffsetAlignment =
       m_renderDevice.getDeviceLimits().minStorageBufferOffsetAlignment;
 
-    auto &[modelMatrices, joints, propertyGroups] = renderableStore;
+    auto &[modelMatrices, joints, propertyGroups, skinning] = renderableStore;
     auto propertyBlock = mergeProperties(propertyGroups, minOffsetAlignment);
 
     uploadTransforms(fg, blackboard, std::move(modelMatrices));
     uploadSkins(fg, blackboard, std::move(joints));
+    m_skinningPass.addPass(fg, blackboard, std::move(skinning.instances));
     uploadMaterialProperties(fg, blackboard, std::move(propertyBlock.buffer));
 
     blackboard.add<BRDF>(importTexture(fg, "BRDF LUT", &m_brdf));
@@ -440,13 +523,19 @@ void WorldRenderer::_drawScene(FrameGraph &fg, FrameGraphBlackboard blackboard,
   // ---
 
   auto visibleRenderables = getVisibleRenderables(renderables, viewFrustum);
+  if (m_textureStreamer) {
+    requestTextureMips(*m_textureStreamer, visibleRenderables, camera,
+                       resolution);
+  }
 
   m_gBufferPass.addGeometryPass(fg, blackboard, resolution,
                                 {
                                   camera,
                                   visibleRenderables,
                                 },
-                                propertyGroupOffsets);
+                                propertyGroupOffsets,
+                                bool(settings.features &
+                                     RenderFeatures::MeshletCulling));
 
   if (auto visibleDecalRenderables =
         getVisibleRenderables(decalRenderables, viewFrustum);
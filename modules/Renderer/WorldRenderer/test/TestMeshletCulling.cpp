@@ -0,0 +1,137 @@
+#include "catch.hpp"
+
+#include "renderer/Meshlet.hpp"
+#include "glm/ext/matrix_clip_space.hpp" // perspective
+#include "glm/ext/matrix_transform.hpp"  // lookAt, translate, rotate
+#include "glm/matrix.hpp"                // inverse
+
+namespace {
+
+const glm::vec3 kCameraPosition{0.0f};
+
+// Looking down -Z.
+[[nodiscard]] glm::mat4 makeViewProjection() {
+  const auto view = glm::lookAt(kCameraPosition, glm::vec3{0.0f, 0.0f, -1.0f},
+                                glm::vec3{0.0f, 1.0f, 0.0f});
+  const auto projection =
+    glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+  return projection * view;
+}
+
+[[nodiscard]] gfx::Meshlet makeMeshlet(const glm::vec3 &center,
+                                       const glm::vec3 &coneAxis,
+                                       float coneCutoff) {
+  return {
+    .center = center,
+    .radius = 1.0f,
+    .coneAxis = coneAxis,
+    .coneCutoff = coneCutoff,
+    .indexOffset = 0,
+    .numTriangles = 124,
+  };
+}
+
+[[nodiscard]] bool isVisible(const gfx::Meshlet &meshlet,
+                             bool coneCulling = true) {
+  return gfx::isMeshletVisible(meshlet, Frustum{makeViewProjection()},
+                               kCameraPosition, coneCulling);
+}
+
+} // namespace
+
+TEST_CASE("Frustum culling") {
+  SECTION("In front of the camera") {
+    REQUIRE(isVisible(makeMeshlet({0.0f, 0.0f, -10.0f}, {0, 0, 1}, 0.5f)));
+  }
+  SECTION("Behind the camera") {
+    REQUIRE_FALSE(isVisible(makeMeshlet({0.0f, 0.0f, 10.0f}, {0, 0, 1}, 1.0f)));
+  }
+  SECTION("Outside of the side planes") {
+    REQUIRE_FALSE(
+      isVisible(makeMeshlet({50.0f, 0.0f, -10.0f}, {0, 0, 1}, 1.0f)));
+    REQUIRE_FALSE(
+      isVisible(makeMeshlet({0.0f, -50.0f, -10.0f}, {0, 0, 1}, 1.0f)));
+  }
+  SECTION("Beyond the far plane") {
+    REQUIRE_FALSE(
+      isVisible(makeMeshlet({0.0f, 0.0f, -110.0f}, {0, 0, 1}, 1.0f)));
+  }
+  SECTION("Intersecting a plane") {
+    // The center is outside, but the bounding sphere is not.
+    REQUIRE(isVisible(makeMeshlet({0.0f, 0.0f, 0.5f}, {0, 0, 1}, 1.0f)));
+  }
+}
+
+TEST_CASE("Cone culling") {
+  SECTION("Facing the camera") {
+    REQUIRE(isVisible(makeMeshlet({0.0f, 0.0f, -10.0f}, {0, 0, 1}, 0.5f)));
+  }
+  SECTION("Facing away") {
+    const auto meshlet = makeMeshlet({0.0f, 0.0f, -10.0f}, {0, 0, -1}, 0.5f);
+    REQUIRE_FALSE(isVisible(meshlet));
+    // Double sided materials.
+    REQUIRE(isVisible(meshlet, false));
+  }
+  SECTION("Degenerate cone") {
+    // meshopt_computeMeshletBounds: cutoff = 1 if the cone can't be culled.
+    REQUIRE(isVisible(makeMeshlet({0.0f, 0.0f, -10.0f}, {0, 0, -1}, 1.0f)));
+  }
+  SECTION("Close to the camera") {
+    // Wider than the cone, some of the triangles might be front-facing.
+    REQUIRE(isVisible(makeMeshlet({0.0f, 0.0f, -2.0f}, {0, 0, -1}, 0.9f)));
+  }
+}
+
+TEST_CASE("Local space") {
+  // The compute shader transforms the frustum and the camera into the mesh
+  // space (instead of transforming each meshlet to the world space).
+  auto model = glm::translate(glm::mat4{1.0f}, glm::vec3{0.0f, 0.0f, -20.0f});
+  model = glm::rotate(model, glm::radians(180.0f), glm::vec3{0.0f, 1.0f, 0.0f});
+
+  const Frustum frustum{makeViewProjection() * model};
+  const auto cameraPosition =
+    glm::vec3{glm::inverse(model) * glm::vec4{kCameraPosition, 1.0f}};
+
+  // After the rotation the local +Z axis faces away from the camera.
+  const auto front = makeMeshlet(glm::vec3{0.0f}, {0, 0, -1}, 0.5f);
+  REQUIRE(gfx::isMeshletVisible(front, frustum, cameraPosition, true));
+  const auto back = makeMeshlet(glm::vec3{0.0f}, {0, 0, 1}, 0.5f);
+  REQUIRE_FALSE(gfx::isMeshletVisible(back, frustum, cameraPosition, true));
+  // Moved (in the local-space) behind the camera.
+  const auto behind = makeMeshlet({0.0f, 0.0f, -30.0f}, {0, 0, -1}, 1.0f);
+  REQUIRE_FALSE(gfx::isMeshletVisible(behind, frustum, cameraPosition, true));
+}
+
+TEST_CASE("Non-uniform scale") {
+  const auto translation =
+    glm::translate(glm::mat4{1.0f}, glm::vec3{0.0f, 0.0f, -20.0f});
+  SECTION("Uniform") {
+    auto model = glm::scale(translation, glm::vec3{2.0f});
+    model = glm::rotate(model, glm::radians(45.0f), glm::vec3{1.0f});
+    REQUIRE(gfx::canConeCull(model));
+  }
+  SECTION("Mirrored") {
+    REQUIRE_FALSE(
+      gfx::canConeCull(glm::scale(translation, glm::vec3{-1.0f, 1.0f, 1.0f})));
+  }
+  SECTION("Stretched") {
+    const auto model = glm::scale(translation, glm::vec3{1.0f, 4.0f, 1.0f});
+    REQUIRE_FALSE(gfx::canConeCull(model));
+
+    const Frustum frustum{makeViewProjection() * model};
+    const auto cameraPosition =
+      glm::vec3{glm::inverse(model) * glm::vec4{kCameraPosition, 1.0f}};
+    const auto coneCulling = gfx::canConeCull(model);
+
+    // Facing away, kept (the cone doesn't hold in the local-space).
+    const auto back = makeMeshlet(glm::vec3{0.0f}, {0, 0, -1}, 0.5f);
+    REQUIRE(
+      gfx::isMeshletVisible(back, frustum, cameraPosition, coneCulling));
+    // The frustum is still tested (y = 60 in the world-space, off the top).
+    const auto above = makeMeshlet({0.0f, 15.0f, 0.0f}, {0, 0, 1}, 1.0f);
+    REQUIRE_FALSE(
+      gfx::isMeshletVisible(above, frustum, cameraPosition, coneCulling));
+  }
+}
+
+int main(int argc, char *argv[]) { return Catch::Session{}.run(argc, argv); }
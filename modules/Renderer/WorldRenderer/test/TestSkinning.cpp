@@ -0,0 +1,202 @@
+#include "catch.hpp"
+
+#include "renderer/Skinning.hpp"
+#include "glm/ext/matrix_transform.hpp" // translate, rotate, scale
+#include "glm/ext/vector_uint4_sized.hpp"
+#include "glm/gtc/epsilon.hpp"       // epsilonEqual
+#include "glm/vector_relational.hpp" // all
+#include <array>
+#include <vector>
+#include <cstring> // memcpy
+
+namespace {
+
+constexpr auto kEpsilon = 1e-3f;
+
+[[nodiscard]] bool equal(const glm::vec3 &a, const glm::vec3 &b) {
+  return glm::all(glm::epsilonEqual(a, b, kEpsilon));
+}
+
+// Position (Float3), Normal (Float3), Joints (Int4), Weights (Float4).
+const gfx::SkinningLayout kDefaultLayout{
+  .stride = 56,
+  .position = 0,
+  .normal = 12,
+  .joints = 24,
+  .weights = 40,
+};
+// As written by the MeshConverter (--quantize): Position (UShort4_Norm),
+// Normal (Short2_Norm), TexCoord_0 (Half2), Tangent/Bitangent (Short2_Norm),
+// Joints (UByte4), Weights (UByte4_Norm).
+const gfx::SkinningLayout kQuantizedLayout{
+  .stride = 32,
+  .position = 0,
+  .normal = 8,
+  .tangent = 16,
+  .bitangent = 20,
+  .joints = 24,
+  .weights = 28,
+  .flags = gfx::SkinningLayout::QuantizedPosition |
+           gfx::SkinningLayout::OctahedralNormal |
+           gfx::SkinningLayout::OctahedralTangents |
+           gfx::SkinningLayout::PackedJoints |
+           gfx::SkinningLayout::PackedWeights,
+};
+
+class VertexWriter {
+public:
+  explicit VertexWriter(const gfx::SkinningLayout &layout)
+      : m_data(layout.stride) {}
+
+  template <typename T> VertexWriter &write(uint32_t offset, const T &v) {
+    std::memcpy(m_data.data() + offset, &v, sizeof(T));
+    return *this;
+  }
+
+  [[nodiscard]] const std::byte *data() const { return m_data.data(); }
+
+private:
+  std::vector<std::byte> m_data;
+};
+
+[[nodiscard]] auto makeVertex(const glm::vec3 &position,
+                              const glm::vec3 &normal,
+                              const glm::ivec4 &joints,
+                              const glm::vec4 &weights) {
+  VertexWriter writer{kDefaultLayout};
+  writer.write(kDefaultLayout.position, position)
+    .write(kDefaultLayout.normal, normal)
+    .write(kDefaultLayout.joints, joints)
+    .write(kDefaultLayout.weights, weights);
+  return writer;
+}
+
+[[nodiscard]] gfx::SkinnedVertex skin(const VertexWriter &vertex,
+                                      std::span<const glm::mat4> joints) {
+  return gfx::skinVertex(vertex.data(), kDefaultLayout, joints,
+                         glm::mat4{1.0f});
+}
+
+} // namespace
+
+TEST_CASE("Octahedral encoding") {
+  for (const auto &v : {
+         glm::vec3{0.0f, 0.0f, 1.0f},
+         glm::vec3{0.0f, 0.0f, -1.0f},
+         glm::vec3{1.0f, 0.0f, 0.0f},
+         glm::vec3{0.0f, -1.0f, 0.0f},
+         glm::normalize(glm::vec3{1.0f, -2.0f, -3.0f}),
+         glm::normalize(glm::vec3{-0.3f, 0.5f, 0.8f}),
+       }) {
+    REQUIRE(equal(gfx::unpackOctahedral(gfx::packOctahedral(v)), v));
+  }
+}
+
+TEST_CASE("Skinning") {
+  const glm::vec3 position{1.0f, 2.0f, 3.0f};
+  const glm::vec3 normal{0.0f, 1.0f, 0.0f};
+
+  SECTION("Bind pose") {
+    const std::array joints{glm::mat4{1.0f}};
+    const auto vertex = makeVertex(position, normal, {0, 0, 0, 0},
+                                   {1.0f, 0.0f, 0.0f, 0.0f});
+    const auto result = skin(vertex, joints);
+    REQUIRE(equal(result.position, position));
+    REQUIRE(equal(gfx::unpackOctahedral(result.normal), normal));
+  }
+  SECTION("Blended joints") {
+    const std::array joints{
+      glm::translate(glm::mat4{1.0f}, glm::vec3{2.0f, 0.0f, 0.0f}),
+      glm::translate(glm::mat4{1.0f}, glm::vec3{0.0f, 0.0f, -4.0f}),
+    };
+    const auto vertex = makeVertex(position, normal, {0, 1, 0, 0},
+                                   {0.5f, 0.5f, 0.0f, 0.0f});
+    const auto result = skin(vertex, joints);
+    REQUIRE(equal(result.position, position + glm::vec3{1.0f, 0.0f, -2.0f}));
+    // Translation doesn't affect directions.
+    REQUIRE(equal(gfx::unpackOctahedral(result.normal), normal));
+  }
+  SECTION("Rotation") {
+    const std::array joints{
+      glm::rotate(glm::mat4{1.0f}, glm::radians(90.0f), glm::vec3{0, 0, 1}),
+    };
+    const auto vertex = makeVertex(position, normal, {0, 0, 0, 0},
+                                   {1.0f, 0.0f, 0.0f, 0.0f});
+    const auto result = skin(vertex, joints);
+    REQUIRE(equal(result.position, glm::vec3{-2.0f, 1.0f, 3.0f}));
+    REQUIRE(equal(gfx::unpackOctahedral(result.normal),
+                  glm::vec3{-1.0f, 0.0f, 0.0f}));
+  }
+  SECTION("Non-uniform scale") {
+    // Normals are transformed by the inverse transpose.
+    const std::array joints{
+      glm::scale(glm::mat4{1.0f}, glm::vec3{2.0f, 1.0f, 1.0f}),
+    };
+    const auto vertex = makeVertex(
+      position, glm::normalize(glm::vec3{1.0f, 1.0f, 0.0f}), {0, 0, 0, 0},
+      {1.0f, 0.0f, 0.0f, 0.0f});
+    const auto result = skin(vertex, joints);
+    REQUIRE(equal(result.position, glm::vec3{2.0f, 2.0f, 3.0f}));
+    REQUIRE(equal(gfx::unpackOctahedral(result.normal),
+                  glm::normalize(glm::vec3{0.5f, 1.0f, 0.0f})));
+  }
+}
+
+TEST_CASE("Quantized vertex") {
+  // [0..1] -> [-1..1]
+  const auto dequantization =
+    glm::scale(glm::translate(glm::mat4{1.0f}, glm::vec3{-1.0f}),
+               glm::vec3{2.0f});
+  const std::array joints{
+    glm::mat4{1.0f},
+    glm::translate(glm::mat4{1.0f}, glm::vec3{0.0f, 10.0f, 0.0f}),
+  };
+
+  const glm::vec3 normal{0.0f, 0.0f, -1.0f};
+  const glm::vec3 tangent{1.0f, 0.0f, 0.0f};
+  const glm::vec3 bitangent{0.0f, 1.0f, 0.0f};
+
+  VertexWriter vertex{kQuantizedLayout};
+  vertex.write(kQuantizedLayout.position, glm::u16vec4{65535, 0, 65535, 0})
+    .write(kQuantizedLayout.normal, gfx::packOctahedral(normal))
+    .write(kQuantizedLayout.tangent, gfx::packOctahedral(tangent))
+    .write(kQuantizedLayout.bitangent, gfx::packOctahedral(bitangent))
+    .write(kQuantizedLayout.joints, glm::u8vec4{1, 0, 0, 0})
+    .write(kQuantizedLayout.weights, glm::u8vec4{255, 0, 0, 0});
+
+  const auto result = gfx::skinVertex(vertex.data(), kQuantizedLayout, joints,
+                                      dequantization);
+  REQUIRE(equal(result.position, glm::vec3{1.0f, 9.0f, 1.0f}));
+  REQUIRE(equal(gfx::unpackOctahedral(result.normal), normal));
+  REQUIRE(equal(gfx::unpackOctahedral(result.tangent), tangent));
+  REQUIRE(equal(gfx::unpackOctahedral(result.bitangent), bitangent));
+
+  SECTION("Blended weights") {
+    vertex.write(kQuantizedLayout.weights, glm::u8vec4{128, 127, 0, 0});
+    const auto blended = gfx::skinVertex(vertex.data(), kQuantizedLayout,
+                                         joints, dequantization);
+    REQUIRE(equal(blended.position,
+                  glm::vec3{1.0f, -1.0f + 10.0f * 128.0f / 255.0f, 1.0f}));
+  }
+}
+
+TEST_CASE("Vertex buffer") {
+  const std::array joints{
+    glm::translate(glm::mat4{1.0f}, glm::vec3{0.0f, 1.0f, 0.0f}),
+  };
+  std::vector<std::byte> vertices;
+  for (auto i = 0; i < 3; ++i) {
+    const auto vertex = makeVertex(glm::vec3{float(i)}, {0, 0, 1},
+                                   {0, 0, 0, 0}, {1.0f, 0.0f, 0.0f, 0.0f});
+    vertices.insert(vertices.cend(), vertex.data(),
+                    vertex.data() + kDefaultLayout.stride);
+  }
+  std::vector<gfx::SkinnedVertex> out(3);
+  gfx::skinVertices(vertices, kDefaultLayout, joints, glm::mat4{1.0f}, out);
+  for (auto i = 0; i < 3; ++i) {
+    const auto expected = glm::vec3{float(i)} + glm::vec3{0.0f, 1.0f, 0.0f};
+    REQUIRE(equal(out[i].position, expected));
+  }
+}
+
+int main(int argc, char *argv[]) { return Catch::Session{}.run(argc, argv); }
@@ -1,9 +1,11 @@
 #include "Scene.hpp"
 #include "os/FileSystem.hpp"
+#include "LuaEntity.hpp" // eachEntity
 
 #include "cereal/archives/json.hpp"
 #include "cereal/archives/binary.hpp"
 #include "math/Serialization.hpp"
+#include "cereal/types/array.hpp"
 #include "cereal/types/optional.hpp"
 #include "cereal/types/variant.hpp"
 #include "cereal/types/string.hpp"
@@ -30,11 +32,17 @@ void registerScene(entt::registry &r) {
       return h;
     });
   env["getEntity"] = [&r](entt::entity e) { return entt::handle{r, e}; };
+  env["each"] = [&r](const sol::variadic_args &args, const sol::this_state s) {
+    eachEntity(r, args, s);
+  };
 
   env["getPhysicsWorld"] = [&r]() -> decltype(auto) {
     return getPhysicsWorld(r);
   };
   env["getAudioWorld"] = [&r]() -> decltype(auto) { return getAudioWorld(r); };
+  env["getAnimationLODSettings"] = [&r]() -> decltype(auto) {
+    return getAnimationLODSettings(r);
+  };
 
   env["setMainCamera"] = sol::overload(
     [&r](const entt::entity e) { getMainCamera(r).e = e; },
@@ -52,6 +60,7 @@ void setupSystems(entt::registry &r, gfx::WorldRenderer &worldRenderer,
   HierarchySystem::setup(r);
   PhysicsSystem::setup(r);
   RenderSystem::setup(r, worldRenderer);
+  AnimationSystem::setup(r);
   AudioSystem::setup(r, audioDevice);
   UISystem::setup(r, uiRenderInterface);
   ScriptSystem::setup(r, lua);
@@ -242,6 +251,11 @@ void Scene::copyFrom(const Scene &src) {
   auto &dstCtx = m_registry->ctx();
   dstCtx.get<MainCamera>().e = srcCtx.get<MainCamera>().e;
   dstCtx.get<MainListener>().e = srcCtx.get<MainListener>().e;
+  dstCtx.get<AnimationLODSettings>() = srcCtx.get<AnimationLODSettings>();
+  dstCtx.get<GarbageCollector>().setSettings(
+    srcCtx.get<GarbageCollector>().getSettings());
+
+  ScriptSystem::collectGarbage(*m_registry);
 }
 
 entt::handle Scene::createEntity(std::optional<std::string> name) {
@@ -278,6 +292,8 @@ bool Scene::load(const std::filesystem::path &p,
   if (auto text = os::FileSystem::readText(p); text) {
     std::istringstream is{*text};
     is >> archiveType >> *m_registry;
+    // The scripts of the previous scene are garbage now.
+    ScriptSystem::collectGarbage(*m_registry);
     return is.good();
   }
   return false;
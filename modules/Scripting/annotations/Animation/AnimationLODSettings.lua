@@ -0,0 +1,10 @@
+---@meta
+
+---@class AnimationLODSettings
+---@field enabled boolean
+---@field fullRateScreenSize number # Relative to the viewport height.
+---@field maxInterval integer # In frames.
+---@field offscreenInterval integer # In frames, 0 = paused.
+---@field interpolate boolean
+---@field maxUpdatesPerFrame integer # 0 = unlimited.
+AnimationLODSettings = {}
@@ -0,0 +1,67 @@
+---@meta
+
+---@class AnimationLayers : ComponentBase
+---@overload fun(): AnimationLayers
+AnimationLayers = {}
+
+---@enum AnimationLayers.Mode
+AnimationLayers.Mode = {
+  Override = 0,
+  Additive = 1,
+}
+
+---@class AnimationLayers.Layer
+---@field animation AnimationResource
+---@field controller PlaybackController
+---@field mode AnimationLayers.Mode
+---@field weight number
+---@field mask number[] # Per-joint weights, empty = whole skeleton.
+---@field targetWeight number # Read-only.
+AnimationLayers.Layer = {}
+
+---@param animation AnimationResource
+---@param mode? AnimationLayers.Mode
+---@param weight? number
+---@return integer # Index of the added layer.
+function AnimationLayers:addLayer(animation, mode, weight) end
+
+---@param index integer
+---@return self
+function AnimationLayers:removeLayer(index) end
+
+---@return self
+function AnimationLayers:clear() end
+
+---@return integer
+function AnimationLayers:size() end
+
+---@return boolean
+function AnimationLayers:empty() end
+
+---@param index integer
+---@return AnimationLayers.Layer
+function AnimationLayers:getLayer(index) end
+
+---@param index integer
+---@param weight number
+---@param duration number # In seconds.
+---@return self
+function AnimationLayers:fadeTo(index, weight, duration) end
+
+---@param index integer
+---@param duration number # In seconds.
+---@return self
+function AnimationLayers:crossFade(index, duration) end
+
+---@param threshold number
+---@return self
+function AnimationLayers:setThreshold(threshold) end
+
+---@return number
+function AnimationLayers:getThreshold() end
+
+---@param skeleton SkeletonResource
+---@param jointName string
+---@param weight? number
+---@return number[]
+function makeJointMask(skeleton, jointName, weight) end
@@ -3,6 +3,18 @@
 ---@class AudioWorld
 AudioWorld = {}
 
+---@class AudioWorld.VoiceSettings
+---@field maxNumVoices integer
+---@field minAudibility number
+AudioWorld.VoiceSettings = {}
+
+---@class AudioWorld.VoiceStats
+---@field numAudible integer
+---@field numReal integer
+---@field numVirtualized integer
+---@field numRealized integer
+AudioWorld.VoiceStats = {}
+
 ---@param settings audio.Device.Settings
 ---@return self
 function AudioWorld:setSettings(settings) end
@@ -10,6 +22,16 @@ function AudioWorld:setSettings(settings) end
 ---@return audio.Device.Settings
 function AudioWorld:getSettings() end
 
+---@param settings AudioWorld.VoiceSettings
+---@return self
+function AudioWorld:setVoiceSettings(settings) end
+
+---@return AudioWorld.VoiceSettings
+function AudioWorld:getVoiceSettings() end
+
+---@return AudioWorld.VoiceStats
+function AudioWorld:getVoiceStats() end
+
 ---@return audio.Device
 function AudioWorld:getDevice() end
 
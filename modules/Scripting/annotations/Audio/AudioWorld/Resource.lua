@@ -3,6 +3,15 @@
 ---@class AudioClipResource : audio.Buffer, Resource
 AudioClipResource = {}
 
+---@return boolean # false while the clip is being decoded.
+function AudioClipResource:isReady() end
+
+---@return boolean
+function AudioClipResource:isStreamed() end
+
+---@return integer # In bytes.
+function AudioClipResource:getMemoryUsage() end
+
 ---@param path string
 ---@return AudioClipResource
 function loadAudioClip(path) end
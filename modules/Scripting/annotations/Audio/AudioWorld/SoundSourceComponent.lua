@@ -47,6 +47,10 @@ function SoundSourceComponent:setDirectional(b) end
 ---@return self
 function SoundSourceComponent:setLooping(b) end
 
+---@param v integer [0..255], higher = more important.
+---@return self
+function SoundSourceComponent:setPriority(v) end
+
 ---@param v vec3
 ---@return self
 function SoundSourceComponent:setVelocity(v) end
@@ -57,9 +61,15 @@ function SoundSourceComponent:getClip() end
 ---@return SoundSettings
 function SoundSourceComponent:getSettings() end
 
+---@return integer
+function SoundSourceComponent:getPriority() end
+
 ---@return vec3
 function SoundSourceComponent:getVelocity() end
 
+---@return boolean # false = virtual voice.
+function SoundSourceComponent:isReal() end
+
 ---@return self
 function SoundSourceComponent:play() end
 
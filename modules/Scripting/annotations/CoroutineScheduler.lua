@@ -0,0 +1,51 @@
+---@meta
+
+---@class CoroutineScheduler
+---@field budget number # Time of the resumes per update (in milliseconds)
+---@overload fun(): CoroutineScheduler
+---@overload fun(budget: number): CoroutineScheduler
+CoroutineScheduler = {}
+
+---@class CoroutineScheduler.Stats
+---@field numResumed integer # In the last update
+---@field numPending integer # Left out (the budget was spent)
+---@field time number # Of the last update (in milliseconds)
+---@field numFinished integer
+---@field numFailed integer
+---@field poolSize integer
+CoroutineScheduler.Stats = {}
+
+--- Starts in the next update.
+---@param fn function
+---@param ... any # Arguments of the fn
+---@return integer # ID (see: cancel)
+function CoroutineScheduler:spawn(fn, ...) end
+
+---@param id integer
+---@return boolean
+function CoroutineScheduler:cancel(id) end
+
+---@param dt number
+function CoroutineScheduler:update(dt) end
+
+---@return integer
+function CoroutineScheduler:size() end
+
+---@return boolean
+function CoroutineScheduler:empty() end
+
+function CoroutineScheduler:clear() end
+
+---@return CoroutineScheduler.Stats
+function CoroutineScheduler:getStats() end
+
+-- Inside of a coroutine (see: CoroutineScheduler:spawn):
+
+---@param seconds number
+function wait(seconds) end
+
+---@param n integer
+function waitFrames(n) end
+
+---@param predicate fun(): boolean # Checked once per update
+function waitUntil(predicate) end
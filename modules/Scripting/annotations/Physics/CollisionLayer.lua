@@ -6,3 +6,26 @@
 ---@overload fun(): CollisionLayer
 ---@overload fun(group: integer, mask: integer): CollisionLayer
 CollisionLayer = {}
+
+---@class CollisionGroups
+---@overload fun(): CollisionGroups
+CollisionGroups = {}
+
+---@param group integer
+---@return string
+function CollisionGroups:getName(group) end
+
+---@param group integer
+---@param name string
+function CollisionGroups:setName(group, name) end
+
+---@param a integer
+---@param b integer
+---@param collide boolean
+---@return CollisionGroups
+function CollisionGroups:set(a, b, collide) end
+
+---@param a integer
+---@param b integer
+---@return boolean
+function CollisionGroups:canCollide(a, b) end
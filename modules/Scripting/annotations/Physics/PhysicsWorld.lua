@@ -23,6 +23,12 @@ function PhysicsWorld:setGravity(v) end
 ---@return vec3
 function PhysicsWorld:getGravity() end
 
+---@param groups CollisionGroups
+function PhysicsWorld:setCollisionGroups(groups) end
+
+---@return CollisionGroups
+function PhysicsWorld:getCollisionGroups() end
+
 ---@class RayCastBPResult
 ---@field position vec3
 ---@field entityId integer
@@ -43,3 +49,92 @@ RayCastNPResult = {}
 ---@param direction vec3
 ---@return RayCastNPResult?
 function PhysicsWorld:castRayNP(from, direction) end
+
+---@enum QueryShape.Type
+QueryShape.Type = {
+    Sphere = 0,
+    Box = 1,
+    Capsule = 2,
+}
+
+---@class QueryShape
+---@field type QueryShape.Type
+---Sphere: x = radius, Box: half extents,
+---Capsule: x = radius, y = half height (of the cylinder).
+---@field size vec3
+QueryShape = {}
+
+---@param radius number
+---@return QueryShape
+function QueryShape.sphere(radius) end
+
+---@param halfExtents vec3
+---@return QueryShape
+function QueryShape.box(halfExtents) end
+
+---@param halfHeight number
+---@param radius number
+---@return QueryShape
+function QueryShape.capsule(halfHeight, radius) end
+
+---@class RayCastQuery
+---@field from vec3
+---@field direction vec3 # The length of the ray.
+---@field layer CollisionLayer?
+
+---@class ShapeCastQuery
+---@field shape QueryShape
+---@field from vec3
+---@field rotation quat?
+---@field direction vec3 # The length of the sweep.
+---@field layer CollisionLayer?
+
+---@class OverlapQuery
+---@field shape QueryShape
+---@field position vec3
+---@field rotation quat?
+---@field layer CollisionLayer?
+
+---The closest hit of each query (in the order of the queries).
+---@class CastResults
+---@field entityIds integer[] # CastResults.NoHit = no hit.
+---@field fractions number[]
+---@field positions vec3[]
+---@field normals vec3[]
+CastResults = {}
+
+---@type integer
+CastResults.NoHit = 0xFFFFFFFF
+
+---@return integer
+function CastResults:size() end
+
+---@param index integer
+---@return boolean
+function CastResults:hasHit(index) end
+
+---@class OverlapResults
+---@field maxHits integer
+---@field numHits integer[]
+OverlapResults = {}
+
+---@return integer
+function OverlapResults:size() end
+
+---@param index integer
+---@return integer[] # Sorted entity ids.
+function OverlapResults:getEntities(index) end
+
+---Queries are executed in parallel.
+---@param queries RayCastQuery[]
+---@return CastResults
+function PhysicsWorld:castRays(queries) end
+
+---@param queries ShapeCastQuery[]
+---@return CastResults
+function PhysicsWorld:castShapes(queries) end
+
+---@param queries OverlapQuery[]
+---@param maxHits integer? # Per query (16 by default).
+---@return OverlapResults
+function PhysicsWorld:overlapShapes(queries, maxHits) end
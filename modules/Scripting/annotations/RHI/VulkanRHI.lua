@@ -114,12 +114,29 @@ PixelFormat = {
   ETC2_RGBA8_sRGB = 152,
   ETC2_RGB8A1_sRGB = 150,
 
+  BC1_RGB_UNorm = 131,
+  BC1_RGB_sRGB = 132,
+  BC1_RGBA_UNorm = 133,
+  BC1_RGBA_sRGB = 134,
+
   BC2_UNorm = 135,
   BC2_sRGB = 136,
 
   BC3_UNorm = 137,
   BC3_sRGB = 138,
 
+  BC4_UNorm = 139,
+  BC4_SNorm = 140,
+
+  BC5_UNorm = 141,
+  BC5_SNorm = 142,
+
+  BC6H_UFloat = 143,
+  BC6H_SFloat = 144,
+
+  BC7_UNorm = 145,
+  BC7_sRGB = 146,
+
   Depth16 = 124,
   Depth32F = 126,
 
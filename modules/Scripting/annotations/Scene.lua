@@ -10,12 +10,20 @@ function createEntity() end
 ---@param id integer
 function getEntity(id) end
 
+--- Calls fn(entity, components...) for each entity that has all of the given
+--- components, e.g.: each(Transform, RigidBody, function(e, xf, rb) end)
+---@param ... table # Component types followed by the function.
+function each(...) end
+
 ---@return PhysicsWorld
 function getPhysicsWorld() end
 
 ---@return AudioWorld
 function getAudioWorld() end
 
+---@return AnimationLODSettings
+function getAnimationLODSettings() end
+
 ---@param e integer # Entity ID
 ---@overload fun(e: Entity)
 function setMainCamera(e) end
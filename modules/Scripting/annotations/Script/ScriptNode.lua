@@ -3,6 +3,7 @@
 ---@class ScriptNode
 ---@field id integer
 ---@field entity Entity
+---@field inputEvents? table[] # Event types of the input (default: all).
 ScriptNode = {}
 
 function ScriptNode:init() end
@@ -51,9 +51,11 @@ RenderFeatures = {
   FXAA = 1 << 6,
   EyeAdaptation = 1 << 7,
   CustomPostprocess = 1 << 8,
+  MeshletCulling = 1 << 9,
+  ComputeSkinning = 1 << 10,
 
   Default = RenderFeatures.LightCulling | RenderFeatures.SSAO | RenderFeatures.Bloom | RenderFeatures.FXAA |
-      RenderFeatures.CustomPostprocess,
+      RenderFeatures.CustomPostprocess | RenderFeatures.MeshletCulling | RenderFeatures.ComputeSkinning,
 
   All = RenderFeatures.Default | RenderFeatures.SoftShadows | RenderFeatures.GI | RenderFeatures.SSR,
 }
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "sol/state.hpp"
+#include <chrono>
+
+// Drives the Lua garbage collector of a state, instead of a full (stop the
+// world) collection every frame. The automatic collection (paced by the
+// allocations) is kept, step adds work in the spare time of a frame.
+class GarbageCollector {
+public:
+  struct Settings {
+    enum class Mode : uint8_t { Incremental, Generational };
+    Mode mode{Mode::Generational};
+    // Max time spent in the steps of a frame (in milliseconds), 0 = none.
+    // Generational mode: a single (minor) collection.
+    float stepBudget{0.5f};
+    // The work of a step (in KB of allocations), 0 = a basic step.
+    uint32_t stepSize{0};
+
+    template <class Archive> void serialize(Archive &archive) {
+      archive(mode, stepBudget, stepSize);
+    }
+  };
+  struct Stats {
+    std::size_t heapSize{0}; // In bytes.
+    std::chrono::duration<float, std::milli> time{0};
+    uint32_t numSteps{0};  // In the last frame.
+    uint32_t numCycles{0}; // Completed by the steps.
+    uint32_t numFullCollects{0};
+  };
+
+  void setSettings(const Settings &);
+  [[nodiscard]] const Settings &getSettings() const;
+
+  // Incremental work within the budget (see: Settings::stepBudget).
+  void step(sol::state &);
+  // A full cycle, e.g. after a scene transition.
+  void collect(sol::state &);
+
+  [[nodiscard]] const Stats &getStats() const;
+
+private:
+  // The state could be shared (by the scenes), hence set before every use
+  // (no-op if the mode is the same).
+  void _applyMode(lua_State *) const;
+
+private:
+  Settings m_settings;
+  Stats m_stats;
+};
+
+[[nodiscard]] const char *toString(const GarbageCollector::Settings::Mode);
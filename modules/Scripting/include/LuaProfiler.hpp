@@ -0,0 +1,108 @@
+#pragma once
+
+#include "sol/state.hpp"
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+// Attributes the time spent in Lua to the functions and scripts (the chunk
+// names of the ScriptResources, see: ScriptContext::instantiate).
+// Instruments the calls with a hook (lua_sethook) while running, there is no
+// hook (and no overhead) otherwise. The calls of the main thread are also
+// emitted as Tracy zones.
+class LuaProfiler {
+public:
+  explicit LuaProfiler(sol::state &);
+  LuaProfiler(const LuaProfiler &) = delete;
+  LuaProfiler(LuaProfiler &&) noexcept = delete;
+  ~LuaProfiler();
+
+  LuaProfiler &operator=(const LuaProfiler &) = delete;
+  LuaProfiler &operator=(LuaProfiler &&) noexcept = delete;
+
+  using Duration = std::chrono::duration<double, std::milli>;
+
+  struct FunctionStats {
+    std::string source; // Chunk name, e.g. "@scripts/Player.lua".
+    std::string name;   // Empty if unknown (e.g. called by pcall).
+    int32_t line{0};    // Where the function is defined (-1 = C function).
+    uint32_t numCalls{0};
+    Duration totalTime{0}; // Including the callees.
+    Duration selfTime{0};
+  };
+  struct ScriptStats {
+    std::string source;
+    uint32_t numCalls{0};
+    Duration selfTime{0}; // Of all functions of the script.
+  };
+  struct Report {
+    Duration duration{0}; // Time profiled.
+    // Sorted by the self time (descending).
+    std::vector<ScriptStats> scripts;
+    std::vector<FunctionStats> functions;
+  };
+
+  void start();
+  void stop();
+  [[nodiscard]] bool isRunning() const;
+  // Discards the collected stats.
+  void reset();
+
+  [[nodiscard]] Report getReport() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct FunctionKey {
+    const void *p; // Source (a Lua function) or lua_CFunction.
+    int32_t line;
+
+    auto operator<=>(const FunctionKey &) const = default;
+  };
+  struct FunctionKeyHash {
+    [[nodiscard]] std::size_t operator()(const FunctionKey &) const noexcept;
+  };
+  struct Frame {
+    FunctionKey function;
+    int32_t depth{0}; // Level count of the thread (see: _getDepth).
+    Clock::time_point start{};
+    Duration children{0};
+    bool tail{false};
+    // Tracy zone (the main thread only).
+    uint32_t zoneId{0};
+    int32_t zoneActive{0};
+  };
+  struct Stack {
+    std::vector<Frame> frames;
+    Clock::time_point lastEvent{}; // Of the last hook event.
+  };
+
+  static void _hook(lua_State *, lua_Debug *);
+  // @return The function being called (or returning).
+  [[nodiscard]] static FunctionKey _getFunction(lua_State *, lua_Debug *);
+  // @return The number of active functions (levels) of the given thread.
+  [[nodiscard]] static int32_t _getDepth(lua_State *);
+
+  void _onCall(lua_State *, lua_Debug *, const bool tail);
+  void _onReturn(lua_State *);
+  // Pops the frames deeper than the given depth. They were unwound by an
+  // error (there are no return events), e.g. caught by the host
+  // (sol::protected_function), and end at the last hook event.
+  void _unwind(Stack &, const int32_t depth, const bool mainThread);
+  // Pops the top frame.
+  void _finish(Stack &, const Clock::time_point, const bool mainThread);
+
+private:
+  lua_State *m_main{nullptr};
+  bool m_running{false};
+
+  Clock::time_point m_startTime{};
+  Duration m_duration{0}; // Of the previous runs (see: reset).
+
+  // Per thread (the coroutines inherit the hook).
+  std::unordered_map<lua_State *, Stack> m_stacks;
+  std::unordered_map<FunctionKey, FunctionStats, FunctionKeyHash> m_functions;
+};
+
+// Headless report, e.g. for the script performance regression tests.
+[[nodiscard]] std::string toJSON(const LuaProfiler::Report &);
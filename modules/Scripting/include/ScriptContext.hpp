@@ -1,10 +1,26 @@
 #pragma once
 
+#include "ScriptResource.hpp"
 #include "sol/state.hpp"
+#include <expected>
+#include <unordered_map>
 
 struct ScriptContext {
   explicit ScriptContext(sol::state &);
 
+  // @return A new instance of the script (a ScriptNode table).
+  // The script is compiled once, the next instances call the cached chunk.
+  [[nodiscard]] std::expected<sol::table, std::string>
+  instantiate(const std::shared_ptr<ScriptResource> &);
+
   sol::state *lua{nullptr};
   sol::environment defaultEnv;
+
+  struct CompiledChunk {
+    std::weak_ptr<ScriptResource> resource; // The key could be reused.
+    sol::protected_function function;       // Bound to the defaultEnv.
+  };
+  // The chunks hold references to the lua state, hence the cache lives here
+  // (not in the ScriptResource, shared by the scenes).
+  std::unordered_map<const ScriptResource *, CompiledChunk> chunks;
 };
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "sol/state.hpp"
+#include "os/InputEvents.hpp"
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+// Calls a hook of all listed ScriptNodes in a single Lua loop (each call is
+// still protected), instead of a protected_function call per node.
+// A node is listed only for the hooks it defines. The input hook can be
+// limited to the selected events, e.g.:
+//   node.inputEvents = { KeyboardEvent, MouseButtonEvent }
+class ScriptDispatcher {
+public:
+  using Id = uint32_t;
+
+  explicit ScriptDispatcher(sol::state &);
+
+  // Lists an initialized node (see: ScriptNode::self).
+  void add(const Id, const sol::table &self);
+  // Safe to call during a dispatch (e.g. an entity destroyed by a script).
+  void remove(const Id);
+
+  struct Failure {
+    Id id;
+    std::string message;
+  };
+  using Failures = std::vector<Failure>;
+
+  [[nodiscard]] Failures input(const os::InputEvent &);
+  [[nodiscard]] Failures update(const float dt);
+  [[nodiscard]] Failures physicsStep(const float dt);
+
+  static constexpr auto kNumInputEvents = std::variant_size_v<os::InputEvent>;
+
+  struct Stats {
+    uint32_t numUpdate{0};
+    uint32_t numPhysicsStep{0};
+    // Per alternative of the os::InputEvent.
+    std::array<uint32_t, kNumInputEvents> numInput{};
+  };
+  [[nodiscard]] Stats getStats() const;
+
+  // Nodes waiting for the init (see: ScriptSystem::onUpdate).
+  std::vector<Id> pending;
+
+private:
+  struct List {
+    sol::table selves;    // [i] = ScriptNode (false = removed).
+    sol::table functions; // [i] = Hook of the selves[i].
+    std::vector<Id> ids;  // [i - 1] = Id of the selves[i].
+    std::unordered_map<Id, std::size_t> positions;
+  };
+  void _add(List &, const Id, const sol::table &self,
+            const sol::function &fn);
+  // Moves the last node to the position.
+  void _remove(List &, const std::size_t position);
+
+  template <typename... Args>
+  [[nodiscard]] Failures _dispatch(List &, Args &&...);
+
+private:
+  sol::protected_function m_dispatch;
+
+  // [0] = update, [1] = physicsStep, [2 + i] = input (the i-th event type).
+  static constexpr auto kInputList = 2;
+  std::array<List, kInputList + kNumInputEvents> m_lists;
+
+  List *m_current{nullptr};           // Being dispatched.
+  std::vector<std::size_t> m_removed; // From the m_current (deferred).
+};
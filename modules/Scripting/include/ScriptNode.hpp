@@ -11,6 +11,12 @@ public:
 
   const sol::table &self() const;
 
+  enum class State { Invalid = -1, Uninitialized, Ready };
+  [[nodiscard]] State getState() const;
+  // Stops the hooks, e.g. after an error in a batched call
+  // (see: ScriptDispatcher).
+  void invalidate();
+
   void init();
   void input(const os::InputEvent &evt);
   void update(float);
@@ -26,7 +32,6 @@ private:
   }
 
 private:
-  enum class State { Invalid = -1, Uninitialized, Ready };
   State m_state{State::Uninitialized};
 
   sol::table m_self;
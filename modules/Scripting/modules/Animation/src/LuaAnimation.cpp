@@ -4,6 +4,8 @@
 #include "animation/SkeletonComponent.hpp"
 #include "animation/AnimationComponent.hpp"
 #include "animation/PlaybackController.hpp"
+#include "animation/AnimationLayers.hpp"
+#include "animation/AnimationLOD.hpp"
 
 #include "Sol2HelperMacros.hpp"
 
@@ -105,6 +107,105 @@ void registerPlaybackController(sol::state &lua) {
 #undef BIND
 }
 
+void registerAnimationLayers(sol::state &lua) {
+  using Mode = AnimationLayers::Mode;
+  using Layer = AnimationLayers::Layer;
+
+#define BIND(Member) _BIND(AnimationLayers, Member)
+  // clang-format off
+  lua.DEFINE_USERTYPE(AnimationLayers,
+    sol::call_constructor,
+    sol::constructors<AnimationLayers()>(),
+
+    "addLayer", sol::overload(
+      [](AnimationLayers &self, std::shared_ptr<AnimationResource> animation) {
+        return self.addLayer(std::move(animation));
+      },
+      [](AnimationLayers &self, std::shared_ptr<AnimationResource> animation,
+         Mode mode) {
+        return self.addLayer(std::move(animation), mode);
+      },
+      &AnimationLayers::addLayer
+    ),
+    BIND(removeLayer),
+    BIND(clear),
+
+    BIND(size),
+    BIND(empty),
+
+    "getLayer",
+      [](AnimationLayers &self, std::size_t index) -> Layer * {
+        // nil if out of range (AnimationLayers only asserts).
+        return index < self.size() ? &self.getLayer(index) : nullptr;
+      },
+
+    BIND(fadeTo),
+    BIND(crossFade),
+
+    BIND(setThreshold),
+    BIND(getThreshold),
+
+    BIND_TYPEID(AnimationLayers),
+    BIND_TOSTRING(AnimationLayers)
+  );
+#undef BIND
+
+#define MAKE_PAIR(Value) _MAKE_PAIR(Mode, Value)
+  lua DEFINE_NESTED_ENUM(AnimationLayers, Mode, {
+    MAKE_PAIR(Override),
+    MAKE_PAIR(Additive),
+  });
+#undef MAKE_PAIR
+
+#define BIND(Member) _BIND(Layer, Member)
+  lua DEFINE_NESTED_USERTYPE(AnimationLayers, Layer,
+    sol::no_constructor,
+
+    BIND(animation),
+    BIND(controller),
+    BIND(mode),
+    BIND(weight),
+    "mask", sol::property(
+      [](const Layer &self) { return sol::as_table(self.mask); },
+      [](Layer &self, std::vector<float> mask) { self.mask = std::move(mask); }
+    ),
+    "targetWeight", sol::readonly(&Layer::targetWeight),
+
+    BIND_TOSTRING(AnimationLayers::Layer)
+  );
+#undef BIND
+
+  lua["makeJointMask"] = sol::overload(
+    [](const SkeletonResource &skeleton, std::string_view jointName) {
+      return sol::as_table(makeJointMask(skeleton, jointName));
+    },
+    [](const SkeletonResource &skeleton, std::string_view jointName,
+       float weight) {
+      return sol::as_table(makeJointMask(skeleton, jointName, weight));
+    }
+  );
+  // clang-format on
+}
+
+void registerAnimationLODSettings(sol::state &lua) {
+#define BIND(Member) _BIND(AnimationLODSettings, Member)
+  // clang-format off
+  lua.DEFINE_USERTYPE(AnimationLODSettings,
+    sol::no_constructor,
+
+    BIND(enabled),
+    BIND(fullRateScreenSize),
+    BIND(maxInterval),
+    BIND(offscreenInterval),
+    BIND(interpolate),
+    BIND(maxUpdatesPerFrame),
+
+    BIND_TOSTRING(AnimationLODSettings)
+  );
+  // clang-format on
+#undef BIND
+}
+
 } // namespace
 
 void registerAnimation(sol::state &lua) {
@@ -112,4 +213,6 @@ void registerAnimation(sol::state &lua) {
   registerSkeletonComponent(lua);
   registerAnimationComponent(lua);
   registerPlaybackController(lua);
+  registerAnimationLayers(lua);
+  registerAnimationLODSettings(lua);
 }
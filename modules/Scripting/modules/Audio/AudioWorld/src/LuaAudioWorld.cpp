@@ -15,6 +15,10 @@ void registerResource(sol::state &lua) {
     sol::no_constructor,
     sol::base_classes, sol::bases<Resource, audio::Buffer>(),
 
+    BIND(isReady),
+    BIND(isStreamed),
+    BIND(getMemoryUsage),
+
     BIND_TOSTRING(AudioClipResource)
   );
   // clang-format on
@@ -95,13 +99,17 @@ void registerSoundSourceComponent(sol::state &lua) {
     BIND(setMaxGain),
     BIND(setDirectional),
     BIND(setLooping),
+    BIND(setPriority),
 
     BIND(setVelocity),
 
     BIND(getClip),
     BIND(getSettings),
+    BIND(getPriority),
     BIND(getVelocity),
 
+    BIND(isReal),
+
     BIND(play),
     BIND(pause),
     BIND(stop),
@@ -168,12 +176,49 @@ void registerAudioWorld(sol::state &lua) {
 
     BIND(setSettings),
     BIND(getSettings),
+
+    BIND(setVoiceSettings),
+    BIND(getVoiceSettings),
+    BIND(getVoiceStats),
     
     BIND(getDevice),
 
     BIND_TOSTRING(AudioWorld)
   );
 #undef BIND
+
+#define BIND(Member) _BIND(AudioWorld::VoiceSettings, Member)
+  lua DEFINE_NESTED_USERTYPE(AudioWorld, VoiceSettings,
+    sol::call_constructor,
+    sol::factories(
+      [] { return AudioWorld::VoiceSettings{}; },
+      [](const sol::table &t) {
+        return AudioWorld::VoiceSettings{
+          CAPTURE_FIELD(maxNumVoices, 64u),
+          CAPTURE_FIELD(minAudibility, 0.001f),
+        };
+      }
+    ),
+
+    BIND(maxNumVoices),
+    BIND(minAudibility),
+
+    BIND_TOSTRING(AudioWorld::VoiceSettings)
+  );
+#undef BIND
+
+#define BIND(Member) _BIND(AudioWorld::VoiceStats, Member)
+  lua DEFINE_NESTED_USERTYPE(AudioWorld, VoiceStats,
+    sol::no_constructor,
+
+    BIND(numAudible),
+    BIND(numReal),
+    BIND(numVirtualized),
+    BIND(numRealized),
+
+    BIND_TOSTRING(AudioWorld::VoiceStats)
+  );
+#undef BIND
   // clang-format on
 
   registerResource(lua);
@@ -2,12 +2,20 @@
 
 #include "entt/entity/registry.hpp"
 #include "entt/entity/handle.hpp"
+#include "entt/entity/helper.hpp" // to_entity
 #include "entt/meta/factory.hpp"
 #include "sol/table.hpp"
+#include "sol/variadic_args.hpp"
 
 // register entt::handle user type in lua
 void registerEntityHandle(sol::state &);
 
+// Calls fn(entity, components...) for each entity that has all of the given
+// components, e.g.: each(Transform, RigidBody, function(e, xf, rb) end)
+// @param args Component types, the last one is the function.
+void eachEntity(entt::registry &, const sol::variadic_args &args,
+                sol::this_state);
+
 // Extends meta_type of a given component(s)
 // with functions to get/emplace from a script
 class LuaComponent {
@@ -21,10 +29,35 @@ public:
     Get = entt::hashed_string{"LuaComponent::_get"}.value(),
   };
 
+  // Typed functions (no meta lookup nor meta_any), used by the Entity
+  // bindings (see: getAccessors).
+  struct Accessors {
+    bool (*has)(entt::handle);
+    sol::reference (*get)(entt::handle, sol::this_state);
+    sol::reference (*emplace)(entt::handle, sol::table &, sol::this_state);
+    bool (*remove)(entt::handle);
+  };
+  // @return nullptr if the type has not been extended.
+  [[nodiscard]] static const Accessors *getAccessors(entt::id_type typeId);
+
   template <class T> static void extendMetaType() {
     entt::meta<T>()
       .template func<&LuaComponent::_emplace<T>>(Functions::Emplace)
       .template func<&LuaComponent::_get<T>>(Functions::Get);
+
+    _addAccessors(entt::type_hash<T>::value(),
+                  {
+                    .has = [](entt::handle h) { return h.all_of<T>(); },
+                    .get = [](entt::handle h,
+                              sol::this_state s) -> sol::reference {
+                      return _get<T>(h, s);
+                    },
+                    .emplace = [](entt::handle h, sol::table &instance,
+                                  sol::this_state s) -> sol::reference {
+                      return _emplace<T>(h, instance, s);
+                    },
+                    .remove = [](entt::handle h) { return h.remove<T>() > 0; },
+                  });
   }
   template <class T, class... Rest>
   static void extendMetaTypes(entt::type_list<T, Rest...>) {
@@ -39,7 +72,26 @@ public:
     extendMetaTypes(entt::type_list<Ts...>{});
   }
 
+  // A script modifies a component through the reference, unnoticed by the
+  // registry. A write binding (e.g. Transform::setPosition) calls this, so
+  // the owner entity gets patched (on_update), reads cost nothing.
+  // @param idx Stack index of the reference (from get/emplace).
+  template <class T> static void patch(lua_State *L, int idx, T &comp) {
+    lua_getiuservalue(L, idx, 1);
+    auto *r = static_cast<entt::registry *>(lua_touserdata(L, -1));
+    lua_pop(L, 1);
+    if (!r) return; // Not owned by an entity, e.g. Transform().
+
+    if (const auto e = entt::to_entity(*r, comp); e != entt::null) {
+      r->patch<T>(e);
+    }
+  }
+
 private:
+  static void _addAccessors(entt::id_type, const Accessors &);
+  // Keeps the registry in the user value of the reference (see: patch).
+  static sol::reference _setOwner(sol::reference, entt::registry &);
+
   template <class T>
   static auto _emplace(entt::handle h, sol::table &instance,
                        const sol::this_state s) {
@@ -54,11 +106,13 @@ private:
     h.remove<T>();
     auto &comp =
       h.emplace<T>(instance.is<T>() ? std::move(instance.as<T &&>()) : T{});
-
-    return sol::make_reference(s, std::ref(comp));
+    return _setOwner(sol::make_reference(s, std::ref(comp)), *h.registry());
   }
-  template <class T> static auto _get(entt::handle h, const sol::this_state s) {
+  template <class T>
+  static sol::reference _get(entt::handle h, const sol::this_state s) {
     auto *comp = h.try_get<T>();
-    return comp ? sol::make_reference(s, comp) : sol::lua_nil_t{};
+    if (!comp) return sol::lua_nil_t{};
+
+    return _setOwner(sol::make_reference(s, comp), *h.registry());
   }
 };
@@ -6,9 +6,24 @@
 #include "MetaComponent.hpp"
 #include "HierarchySystem.hpp"
 
+#include "entt/entity/runtime_view.hpp"
+
 #include <format>
+#include <unordered_map>
 #include <vector>
 
+namespace {
+
+using AccessorMap = std::unordered_map<entt::id_type, LuaComponent::Accessors>;
+
+// Filled once, at startup (see: LuaComponent::extendMetaType).
+[[nodiscard]] AccessorMap &getAccessorMap() {
+  static AccessorMap map;
+  return map;
+}
+
+} // namespace
+
 void registerEntityHandle(sol::state &lua) {
   // clang-format off
   lua.new_usertype<entt::handle>("Entity",
@@ -27,6 +42,10 @@ void registerEntityHandle(sol::state &lua) {
         const auto typeId = getTypeId(type);
         if (!typeId) return false;
 
+        if (const auto *accessors = LuaComponent::getAccessors(*typeId);
+            accessors) {
+          return accessors->has(self);
+        }
         const auto metaType = entt::resolve(*typeId);
         if (!metaType) return false; // Component not registered.
       
@@ -41,12 +60,8 @@ void registerEntityHandle(sol::state &lua) {
         const auto typeId = getTypeId(type);
         if (!typeId) return sol::lua_nil_t{};
 
-        const auto metaType = entt::resolve(*typeId);
-        if (!metaType) return sol::lua_nil_t{};
-
-        auto result =
-          invokeMetaFunc(metaType, LuaComponent::Functions::Get, self, s);
-        return result.cast<sol::reference>();
+        const auto *accessors = LuaComponent::getAccessors(*typeId);
+        return accessors ? accessors->get(self, s) : sol::lua_nil_t{};
       },
 
     "emplace",
@@ -57,12 +72,8 @@ void registerEntityHandle(sol::state &lua) {
         const auto typeId = getTypeId(comp);
         if (!typeId) return sol::lua_nil_t{};
 
-        const auto metaType = entt::resolve(*typeId);
-        if (!metaType) return sol::lua_nil_t{};
-      
-        auto result = invokeMetaFunc(metaType, LuaComponent::Functions::Emplace,
-                                     self, comp, s);
-        return result.cast<sol::reference>();
+        const auto *accessors = LuaComponent::getAccessors(*typeId);
+        return accessors ? accessors->emplace(self, comp, s) : sol::lua_nil_t{};
       },
     "remove",
       [](entt::handle self, const sol::object &type) {
@@ -71,7 +82,13 @@ void registerEntityHandle(sol::state &lua) {
         const auto typeId = getTypeId(type);
         if (!typeId) return false;
 
+        if (const auto *accessors = LuaComponent::getAccessors(*typeId);
+            accessors) {
+          return accessors->remove(self);
+        }
         const auto metaType = entt::resolve(*typeId);
+        if (!metaType) return false;
+
         auto result =
           invokeMetaFunc(metaType, MetaComponent::Functions::Remove, self);
         return result.cast<entt::handle::size_type>() > 0;
@@ -123,3 +140,69 @@ void registerEntityHandle(sol::state &lua) {
   );
   // clang-format on
 }
+
+void eachEntity(entt::registry &r, const sol::variadic_args &args,
+                const sol::this_state s) {
+  if (args.size() < 2) return;
+  const auto fn = args.get<sol::optional<sol::protected_function>>(
+    int32_t(args.size()) - 1);
+  if (!fn) return;
+
+  const auto numTypes = args.size() - 1;
+  std::vector<const LuaComponent::Accessors *> accessors;
+  accessors.reserve(numTypes);
+
+  entt::runtime_view view;
+  for (auto i = 0u; i < numTypes; ++i) {
+    const auto typeId = getTypeId(args.get<sol::object>(int32_t(i)));
+    if (!typeId) return;
+    const auto *storage = r.storage(*typeId);
+    if (!storage) return; // No entity has ever had such component.
+    const auto *a = LuaComponent::getAccessors(*typeId);
+    if (!a) return;
+
+    view.iterate(*storage);
+    accessors.push_back(a);
+  }
+
+  // The callback is allowed to modify the registry.
+  const std::vector<entt::entity> entities{view.begin(), view.end()};
+  std::vector<sol::reference> components(numTypes);
+  for (const auto e : entities) {
+    if (!view.contains(e)) continue;
+
+    const entt::handle h{r, e};
+    std::ranges::transform(accessors, components.begin(),
+                           [h, s](const auto *a) { return a->get(h, s); });
+    // Propagates the error to the caller (the script).
+    if (const auto result = (*fn)(h, sol::as_args(components));
+        !result.valid()) {
+      const sol::error e = result;
+      throw e;
+    }
+  }
+}
+
+//
+// LuaComponent class:
+//
+
+const LuaComponent::Accessors *
+LuaComponent::getAccessors(const entt::id_type typeId) {
+  const auto &map = getAccessorMap();
+  const auto it = map.find(typeId);
+  return it != map.cend() ? &it->second : nullptr;
+}
+void LuaComponent::_addAccessors(const entt::id_type typeId,
+                                 const Accessors &accessors) {
+  getAccessorMap().insert_or_assign(typeId, accessors);
+}
+sol::reference LuaComponent::_setOwner(sol::reference ref,
+                                       entt::registry &r) {
+  auto *L = ref.lua_state();
+  ref.push();
+  lua_pushlightuserdata(L, &r);
+  lua_setiuservalue(L, -2, 1);
+  lua_pop(L, 1);
+  return ref;
+}
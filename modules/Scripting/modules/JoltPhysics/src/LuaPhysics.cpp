@@ -10,6 +10,109 @@
 
 namespace {
 
+// An array of tables -> queries (the whole batch is converted at once).
+template <typename T, typename Fn>
+[[nodiscard]] std::vector<T> toQueries(const sol::table &in, Fn &&fn) {
+  std::vector<T> out;
+  out.reserve(in.size());
+  for (auto i = 1u; i <= in.size(); ++i) {
+    out.push_back(fn(in.get<sol::table>(i)));
+  }
+  return out;
+}
+
+[[nodiscard]] RayCastQuery toRayCastQuery(const sol::table &t) {
+  return RayCastQuery{
+    CAPTURE_FIELD_T(from, glm::vec3, 0.0f),
+    CAPTURE_FIELD_T(direction, glm::vec3, 0.0f),
+    CAPTURE_FIELD_T(layer, CollisionLayer, {}),
+  };
+}
+[[nodiscard]] ShapeCastQuery toShapeCastQuery(const sol::table &t) {
+  return ShapeCastQuery{
+    CAPTURE_FIELD_T(shape, QueryShape, QueryShape{}),
+    CAPTURE_FIELD_T(from, glm::vec3, 0.0f),
+    CAPTURE_FIELD_T(rotation, glm::quat, glm::quat(1.0f, 0.0f, 0.0f, 0.0f)),
+    CAPTURE_FIELD_T(direction, glm::vec3, 0.0f),
+    CAPTURE_FIELD_T(layer, CollisionLayer, {}),
+  };
+}
+[[nodiscard]] OverlapQuery toOverlapQuery(const sol::table &t) {
+  return OverlapQuery{
+    CAPTURE_FIELD_T(shape, QueryShape, QueryShape{}),
+    CAPTURE_FIELD_T(position, glm::vec3, 0.0f),
+    CAPTURE_FIELD_T(rotation, glm::quat, glm::quat(1.0f, 0.0f, 0.0f, 0.0f)),
+    CAPTURE_FIELD_T(layer, CollisionLayer, {}),
+  };
+}
+
+void registerBatchQueries(sol::state &lua) {
+  // clang-format off
+#define BIND(Member) _BIND(QueryShape, Member)
+  lua.DEFINE_USERTYPE(QueryShape,
+    sol::no_constructor,
+
+    BIND(type),
+    BIND(size),
+
+    BIND(sphere),
+    BIND(box),
+    BIND(capsule),
+
+    BIND_TOSTRING(QueryShape)
+  );
+#undef BIND
+
+#define MAKE_PAIR(Value) _MAKE_PAIR(QueryShape::Type, Value)
+  lua DEFINE_NESTED_ENUM(QueryShape, Type, {
+    MAKE_PAIR(Sphere),
+    MAKE_PAIR(Box),
+    MAKE_PAIR(Capsule),
+  });
+#undef MAKE_PAIR
+
+  // Indices are 1-based (as the arrays).
+#define BIND(Member) _BIND(CastResults, Member)
+  lua.DEFINE_USERTYPE(CastResults,
+    sol::no_constructor,
+
+    "NoHit", sol::var(CastResults::kNoHit),
+
+    BIND(entityIds),
+    BIND(fractions),
+    BIND(positions),
+    BIND(normals),
+
+    BIND(size),
+    "hasHit", [](const CastResults &self, std::size_t i) {
+      return i > 0 && i <= self.size() && self.hasHit(i - 1);
+    },
+
+    BIND_TOSTRING(CastResults)
+  );
+#undef BIND
+
+#define BIND(Member) _BIND(OverlapResults, Member)
+  lua.DEFINE_USERTYPE(OverlapResults,
+    sol::no_constructor,
+
+    BIND(maxHits),
+    BIND(numHits),
+
+    BIND(size),
+    "getEntities", [](const OverlapResults &self, std::size_t i) {
+      const auto entities = i > 0 && i <= self.size()
+        ? self.getEntities(i - 1) : std::span<const uint32_t>{};
+      return sol::as_table(
+        std::vector<uint32_t>{entities.begin(), entities.end()});
+    },
+
+    BIND_TOSTRING(OverlapResults)
+  );
+#undef BIND
+  // clang-format on
+}
+
 void registerPhysicsWorld(sol::state &lua) {
   // clang-format off
 #define BIND(Member) _BIND(RayCastBPResult, Member)
@@ -44,10 +147,41 @@ void registerPhysicsWorld(sol::state &lua) {
 
     BIND(setGravity),
     BIND(getGravity),
+
+    BIND(setCollisionGroups),
+    BIND(getCollisionGroups),
     
     BIND(castRayBP),
     BIND(castRayNP),
 
+    "castRays", [](const PhysicsWorld &self, const sol::table &queries) {
+      CastResults results;
+      self.castRays(toQueries<RayCastQuery>(queries, toRayCastQuery),
+                    results);
+      return results;
+    },
+    "castShapes", [](const PhysicsWorld &self, const sol::table &queries) {
+      CastResults results;
+      self.castShapes(toQueries<ShapeCastQuery>(queries, toShapeCastQuery),
+                      results);
+      return results;
+    },
+    "overlapShapes", sol::overload(
+      [](const PhysicsWorld &self, const sol::table &queries) {
+        OverlapResults results;
+        self.overlapShapes(toQueries<OverlapQuery>(queries, toOverlapQuery),
+                           results);
+        return results;
+      },
+      [](const PhysicsWorld &self, const sol::table &queries,
+         uint32_t maxHits) {
+        OverlapResults results{.maxHits = maxHits};
+        self.overlapShapes(toQueries<OverlapQuery>(queries, toOverlapQuery),
+                           results);
+        return results;
+      }
+    ),
+
     BIND_TOSTRING(PhysicsWorld)
   );
 #undef BIND
@@ -194,6 +328,26 @@ void registerCollisionLayer(sol::state &lua) {
         return std::format("CollisionLayer({})", self.group);
       }
   );
+#undef BIND
+
+#define BIND(Member) _BIND(CollisionGroups, Member)
+  lua.DEFINE_USERTYPE(CollisionGroups,
+    sol::call_constructor,
+    sol::constructors<CollisionGroups()>(),
+
+    "getName", [](const CollisionGroups &self, uint8_t group) {
+      return self.names.at(group);
+    },
+    "setName", [](CollisionGroups &self, uint8_t group, std::string name) {
+      self.names.at(group) = std::move(name);
+    },
+
+    BIND(set),
+    BIND(canCollide),
+
+    sol::meta_function::to_string,
+      [](const CollisionGroups &) { return "CollisionGroups"; }
+  );
   // clang-format on
 #undef BIND
 }
@@ -450,6 +604,7 @@ void registerCharacterVirtualComponent(sol::state &lua) {
 } // namespace
 
 void registerJoltPhysics(sol::state &lua) {
+  registerBatchQueries(lua);
   registerPhysicsWorld(lua);
 
   registerEvents(lua);
@@ -118,12 +118,29 @@ void registerPixelFormat(sol::state &lua) {
     MAKE_PAIR(ETC2_RGBA8_sRGB),
     MAKE_PAIR(ETC2_RGB8A1_sRGB),
 
+    MAKE_PAIR(BC1_RGB_UNorm),
+    MAKE_PAIR(BC1_RGB_sRGB),
+    MAKE_PAIR(BC1_RGBA_UNorm),
+    MAKE_PAIR(BC1_RGBA_sRGB),
+
     MAKE_PAIR(BC2_UNorm),
     MAKE_PAIR(BC2_sRGB),
 
     MAKE_PAIR(BC3_UNorm),
     MAKE_PAIR(BC3_sRGB),
 
+    MAKE_PAIR(BC4_UNorm),
+    MAKE_PAIR(BC4_SNorm),
+
+    MAKE_PAIR(BC5_UNorm),
+    MAKE_PAIR(BC5_SNorm),
+
+    MAKE_PAIR(BC6H_UFloat),
+    MAKE_PAIR(BC6H_SFloat),
+
+    MAKE_PAIR(BC7_UNorm),
+    MAKE_PAIR(BC7_sRGB),
+
     MAKE_PAIR(Depth16),
     MAKE_PAIR(Depth32F),
 
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "sol/state.hpp"
+#include <chrono>
+#include <deque>
+#include <expected>
+#include <variant>
+
+// Runs Lua functions as coroutines, spread across frames. A coroutine
+// suspends itself with:
+// - coroutine.yield()    -> resumed in the next frame
+// - wait(seconds)
+// - waitFrames(n)
+// - waitUntil(predicate) -> the predicate is checked once per frame
+// The update resumes the coroutines (round robin) until the budget is spent,
+// the next frame continues with the ones that were left out.
+class CoroutineScheduler {
+public:
+  using fsec = std::chrono::duration<float>;
+  using Duration = std::chrono::duration<float, std::milli>;
+
+  struct Settings {
+    // Time of the resumes per update, at least one coroutine is resumed.
+    Duration budget{1.0f};
+    // Max number of the finished threads kept for reuse.
+    uint32_t maxPoolSize{32};
+  };
+  explicit CoroutineScheduler(const Settings & = {});
+  CoroutineScheduler(const CoroutineScheduler &) = delete;
+  CoroutineScheduler(CoroutineScheduler &&) noexcept = default;
+  ~CoroutineScheduler() = default;
+
+  CoroutineScheduler &operator=(const CoroutineScheduler &) = delete;
+  CoroutineScheduler &operator=(CoroutineScheduler &&) noexcept = default;
+
+  using Id = uint32_t;
+
+  // Starts in the next update.
+  // @return An id of the coroutine (see: cancel).
+  Id spawn(lua_State *, const sol::function &, const sol::variadic_args &);
+  // @return false if the coroutine has already finished.
+  bool cancel(const Id);
+
+  // @param L The caller (a thread of the state that spawned the coroutines).
+  void update(lua_State *L, const fsec dt);
+
+  [[nodiscard]] std::size_t size() const;
+  [[nodiscard]] bool empty() const;
+  void clear();
+
+  void setSettings(const Settings &);
+  [[nodiscard]] const Settings &getSettings() const;
+
+  struct Stats {
+    uint32_t numResumed{0}; // In the last update.
+    uint32_t numPending{0}; // Left out (the budget was spent).
+    Duration time{0};       // Of the last update.
+    uint32_t numFinished{0};
+    uint32_t numFailed{0};
+    std::size_t poolSize{0};
+  };
+  [[nodiscard]] const Stats &getStats() const;
+
+private:
+  struct WaitSeconds {
+    fsec remaining;
+  };
+  struct WaitFrames {
+    uint32_t remaining;
+  };
+  struct WaitUntil {
+    sol::protected_function predicate;
+  };
+  using Wait = std::variant<std::monostate, WaitSeconds, WaitFrames, WaitUntil>;
+
+  struct Task {
+    Id id;
+    sol::thread thread;
+    int32_t numArgs; // Pushed onto the thread (the first resume).
+    bool started{false};
+    Wait wait;
+    uint64_t lastUpdate; // When the task was visited (or spawned).
+  };
+  [[nodiscard]] sol::thread _acquireThread(lua_State *);
+  void _releaseThread(sol::thread &&);
+
+  // @return true if the coroutine can be resumed (or an error of the
+  // waitUntil predicate).
+  [[nodiscard]] static std::expected<bool, std::string> _isReady(Task &);
+  // @return false if the coroutine has finished (or failed).
+  [[nodiscard]] bool _resume(lua_State *L, Task &);
+
+private:
+  Settings m_settings;
+  Id m_nextId{0};
+  uint64_t m_numUpdates{0};
+  std::deque<Task> m_tasks; // In order of the next resume.
+  // The task being resumed is not in the m_tasks.
+  std::optional<Id> m_running;
+  bool m_cancelRunning{false};
+  std::vector<sol::thread> m_pool;
+  Stats m_stats;
+};
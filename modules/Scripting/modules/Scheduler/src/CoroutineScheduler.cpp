@@ -0,0 +1,212 @@
+#include "CoroutineScheduler.hpp"
+#include "spdlog/spdlog.h"
+#include <algorithm> // max, count_if
+#include <cassert>
+#include <functional> // not_fn
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+} // namespace
+
+//
+// CoroutineScheduler class:
+//
+
+CoroutineScheduler::CoroutineScheduler(const Settings &settings)
+    : m_settings{settings} {}
+
+CoroutineScheduler::Id CoroutineScheduler::spawn(lua_State *L,
+                                                 const sol::function &fn,
+                                                 const sol::variadic_args &va) {
+  auto thread = _acquireThread(L);
+  auto *T = thread.thread_state();
+
+  fn.push(T);
+  const auto numArgs = int32_t(va.size());
+  for (auto i = 0; i < numArgs; ++i) {
+    lua_pushvalue(L, va.stack_index() + i);
+  }
+  lua_xmove(L, T, numArgs);
+
+  const auto id = m_nextId++;
+  m_tasks.push_back({
+    .id = id,
+    .thread = std::move(thread),
+    .numArgs = numArgs,
+    .lastUpdate = m_numUpdates,
+  });
+  return id;
+}
+bool CoroutineScheduler::cancel(const Id id) {
+  if (m_running == id) {
+    m_cancelRunning = true;
+    return true;
+  }
+  // A suspended thread can not be reused (not returned to the pool).
+  return std::erase_if(m_tasks, [id](const Task &t) { return t.id == id; });
+}
+
+void CoroutineScheduler::update(lua_State *L, const fsec dt) {
+  const auto start = Clock::now();
+  m_stats.numResumed = 0;
+  m_stats.numPending = 0;
+
+  for (auto &task : m_tasks) {
+    if (auto *w = std::get_if<WaitSeconds>(&task.wait); w) {
+      w->remaining -= dt;
+    } else if (auto *w = std::get_if<WaitFrames>(&task.wait); w) {
+      if (w->remaining > 0) --w->remaining;
+    }
+  }
+
+  // Each coroutine is visited once, the ones spawned in the meantime wait for
+  // the next update. The visited tasks go to the back, so the loop ends at the
+  // first one visited (a coroutine might cancel any of the others).
+  const auto updateId = ++m_numUpdates;
+  const auto visited = [updateId](const Task &t) {
+    return t.lastUpdate == updateId;
+  };
+  while (!m_tasks.empty() && !visited(m_tasks.front())) {
+    if (m_stats.numResumed > 0 && Clock::now() - start >= m_settings.budget) {
+      // The left out coroutines stay at the front (the next update).
+      m_stats.numPending =
+        uint32_t(std::ranges::count_if(m_tasks, std::not_fn(visited)));
+      break;
+    }
+    auto task = std::move(m_tasks.front());
+    m_tasks.pop_front();
+    task.lastUpdate = updateId;
+
+    const auto ready = _isReady(task);
+    if (!ready) {
+      SPDLOG_ERROR("waitUntil failed. {}", ready.error());
+      ++m_stats.numFailed;
+      continue;
+    }
+    if (!*ready) {
+      m_tasks.push_back(std::move(task));
+      continue;
+    }
+
+    m_running = task.id;
+    const auto alive = _resume(L, task);
+    m_running = std::nullopt;
+    ++m_stats.numResumed;
+
+    // Cleared even if the coroutine has finished (cancelled itself).
+    const auto cancelled = std::exchange(m_cancelRunning, false);
+    if (alive && !cancelled) {
+      m_tasks.push_back(std::move(task));
+    }
+  }
+  m_stats.time = Clock::now() - start;
+  m_stats.poolSize = m_pool.size();
+}
+
+std::size_t CoroutineScheduler::size() const { return m_tasks.size(); }
+bool CoroutineScheduler::empty() const { return m_tasks.empty(); }
+void CoroutineScheduler::clear() { m_tasks.clear(); }
+
+void CoroutineScheduler::setSettings(const Settings &settings) {
+  m_settings = settings;
+  if (m_pool.size() > m_settings.maxPoolSize) {
+    m_pool.resize(m_settings.maxPoolSize);
+  }
+}
+const CoroutineScheduler::Settings &CoroutineScheduler::getSettings() const {
+  return m_settings;
+}
+
+const CoroutineScheduler::Stats &CoroutineScheduler::getStats() const {
+  return m_stats;
+}
+
+//
+// (private):
+//
+
+sol::thread CoroutineScheduler::_acquireThread(lua_State *L) {
+  if (m_pool.empty()) return sol::thread::create(L);
+
+  auto thread = std::move(m_pool.back());
+  m_pool.pop_back();
+  return thread;
+}
+void CoroutineScheduler::_releaseThread(sol::thread &&thread) {
+  assert(lua_gettop(thread.thread_state()) == 0);
+  if (m_pool.size() < m_settings.maxPoolSize) {
+    m_pool.push_back(std::move(thread));
+  }
+}
+
+std::expected<bool, std::string> CoroutineScheduler::_isReady(Task &task) {
+  const auto ready = std::visit(
+    [](auto &w) -> std::expected<bool, std::string> {
+      using T = std::decay_t<decltype(w)>;
+
+      if constexpr (std::is_same_v<T, WaitSeconds>) {
+        return w.remaining.count() <= 0.0f;
+      } else if constexpr (std::is_same_v<T, WaitFrames>) {
+        return w.remaining == 0;
+      } else if constexpr (std::is_same_v<T, WaitUntil>) {
+        const auto result = w.predicate();
+        if (!result.valid()) {
+          const sol::error e = result;
+          return std::unexpected{e.what()};
+        }
+        return result.template get<bool>();
+      } else {
+        return true;
+      }
+    },
+    task.wait);
+  if (ready && *ready) task.wait = {};
+  return ready;
+}
+
+bool CoroutineScheduler::_resume(lua_State *L, Task &task) {
+  auto *T = task.thread.thread_state();
+  const auto numArgs = task.started ? 0 : task.numArgs;
+  task.started = true;
+
+  int32_t numResults{0};
+  switch (lua_resume(T, L, numArgs, &numResults)) {
+  case LUA_YIELD: {
+    // See: registerScheduler (the wait functions).
+    const auto first = lua_gettop(T) - numResults + 1;
+    const auto type = numResults > 0 && lua_type(T, first) == LUA_TSTRING
+                        ? std::string_view{lua_tostring(T, first)}
+                        : std::string_view{};
+    if (numResults >= 2) {
+      if (type == "wait") {
+        task.wait = WaitSeconds{fsec{float(lua_tonumber(T, first + 1))}};
+      } else if (type == "waitFrames") {
+        const auto n = lua_tointeger(T, first + 1);
+        task.wait = WaitFrames{uint32_t(std::max<lua_Integer>(n, 1))};
+      } else if (type == "waitUntil") {
+        // Called from the resumer (not from the suspended thread).
+        lua_pushvalue(T, first + 1);
+        lua_xmove(T, L, 1);
+        task.wait = WaitUntil{sol::protected_function{L, -1}};
+        lua_pop(L, 1);
+      }
+    }
+    lua_pop(T, numResults);
+    return true;
+  }
+  case LUA_OK:
+    lua_pop(T, numResults);
+    ++m_stats.numFinished;
+    _releaseThread(std::move(task.thread));
+    return false;
+
+  default: {
+    const auto *msg = lua_tostring(T, -1);
+    SPDLOG_ERROR("Coroutine failed. {}", msg ? msg : "(no message)");
+    ++m_stats.numFailed;
+    return false;
+  }
+  }
+}
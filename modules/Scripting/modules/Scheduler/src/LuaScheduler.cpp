@@ -2,6 +2,7 @@
 #include "sol/state.hpp"
 #include "sol/variadic_args.hpp"
 #include "entt/process/scheduler.hpp"
+#include "CoroutineScheduler.hpp"
 #include "Sol2HelperMacros.hpp"
 
 #include <chrono>
@@ -58,7 +59,92 @@ private:
   fsec m_time{0};
 };
 
+namespace {
+
+void registerCoroutineScheduler(sol::state &lua) {
+  // Yielded to the CoroutineScheduler (see: CoroutineScheduler::_resume).
+  lua.set_function("wait", sol::yielding([](const float seconds) {
+                     return std::make_tuple("wait", seconds);
+                   }));
+  lua.set_function("waitFrames", sol::yielding([](const int32_t n) {
+                     return std::make_tuple("waitFrames", n);
+                   }));
+  lua.set_function("waitUntil",
+                   sol::yielding([](const sol::function &predicate) {
+                     return std::make_tuple("waitUntil", predicate);
+                   }));
+
+  using Stats = CoroutineScheduler::Stats;
+
+#define BIND(Member) _BIND(CoroutineScheduler, Member)
+  // clang-format off
+  lua.DEFINE_USERTYPE(CoroutineScheduler,
+    sol::call_constructor,
+    sol::factories(
+      [] { return CoroutineScheduler{}; },
+      // @param budget In milliseconds.
+      [](const float budget) {
+        return CoroutineScheduler{{
+          .budget = CoroutineScheduler::Duration{budget},
+        }};
+      }),
+
+    "budget", sol::property(
+      [](const CoroutineScheduler &self) {
+        return self.getSettings().budget.count();
+      },
+      [](CoroutineScheduler &self, const float budget) {
+        auto settings = self.getSettings();
+        settings.budget = CoroutineScheduler::Duration{budget};
+        self.setSettings(settings);
+      }),
+
+    "spawn",
+      [](CoroutineScheduler &self, const sol::this_state s,
+         const sol::function &fn, const sol::variadic_args &va) {
+        return self.spawn(s, fn, va);
+      },
+    BIND(cancel),
+
+    "update",
+      [](CoroutineScheduler &self, const sol::this_state s, fsec dt) {
+        self.update(s, dt);
+      },
+
+    BIND(size),
+    BIND(empty),
+    BIND(clear),
+
+    BIND(getStats),
+
+    BIND_TOSTRING(CoroutineScheduler)
+  );
+#undef BIND
+
+#define BIND(Member) _BIND(Stats, Member)
+  lua DEFINE_NESTED_USERTYPE(CoroutineScheduler, Stats,
+    sol::no_constructor,
+
+    BIND(numResumed),
+    BIND(numPending),
+    "time", sol::readonly_property([](const Stats &self) {
+      return self.time.count();
+    }),
+    BIND(numFinished),
+    BIND(numFailed),
+    BIND(poolSize),
+
+    BIND_TOSTRING(CoroutineScheduler::Stats)
+  );
+  // clang-format on
+#undef BIND
+}
+
+} // namespace
+
 void registerScheduler(sol::state &lua) {
+  registerCoroutineScheduler(lua);
+
   using Scheduler = entt::basic_scheduler<fsec>;
 
 #define BIND(Member) _BIND(Scheduler, Member)
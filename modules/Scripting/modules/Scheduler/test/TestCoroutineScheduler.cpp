@@ -0,0 +1,245 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include "LuaScheduler.hpp"
+#include "CoroutineScheduler.hpp"
+
+#include <algorithm> // minmax_element
+
+namespace {
+
+[[nodiscard]] sol::state createState() {
+  sol::state lua;
+  lua.open_libraries(sol::lib::base, sol::lib::coroutine, sol::lib::os);
+  registerScheduler(lua);
+  return lua;
+}
+
+[[nodiscard]] const CoroutineScheduler::Stats &getStats(sol::state &lua) {
+  return lua["scheduler"].get<CoroutineScheduler &>().getStats();
+}
+
+// Each coroutine logs its name once per resume.
+constexpr auto kLoggingTasks = R"(
+log = {}
+for _, name in ipairs({ "a", "b", "c" }) do
+  scheduler:spawn(function(name)
+    while true do
+      log[#log + 1] = name
+      coroutine.yield()
+    end
+  end, name)
+end
+)";
+
+// ~1 ms per resume.
+constexpr auto kBusyTasks = R"(
+numResumes = {}
+for i = 1, 20 do
+  numResumes[i] = 0
+  scheduler:spawn(function(i)
+    while true do
+      local t = os.clock()
+      while os.clock() - t < 0.001 do end
+      numResumes[i] = numResumes[i] + 1
+      coroutine.yield()
+    end
+  end, i)
+end
+)";
+
+} // namespace
+
+TEST_CASE("Wait functions") {
+  auto lua = createState();
+  lua.script(R"(
+    log = {}
+    scheduler = CoroutineScheduler()
+    scheduler:spawn(function()
+      log[#log + 1] = "start"
+      waitFrames(2)
+      log[#log + 1] = "frames"
+      wait(0.5)
+      log[#log + 1] = "seconds"
+      waitUntil(function() return flag end)
+      log[#log + 1] = "until"
+    end)
+  )");
+  const auto update = [&lua] { lua.script("scheduler:update(0.25)"); };
+  const auto last = [&lua] {
+    const sol::table log = lua["log"];
+    return log.get<std::string>(log.size());
+  };
+
+  update();
+  REQUIRE(last() == "start");
+  update();
+  REQUIRE(last() == "start");
+  update();
+  REQUIRE(last() == "frames");
+
+  update();
+  REQUIRE(last() == "frames");
+  update();
+  REQUIRE(last() == "seconds");
+
+  update();
+  REQUIRE(last() == "seconds");
+  lua["flag"] = true;
+  update();
+  REQUIRE(last() == "until");
+
+  REQUIRE(lua["scheduler"].get<CoroutineScheduler &>().empty());
+  REQUIRE(getStats(lua).numFinished == 1);
+}
+
+TEST_CASE("Fair ordering") {
+  auto lua = createState();
+  // A coroutine per update.
+  lua.script("scheduler = CoroutineScheduler(0)");
+  lua.script(kLoggingTasks);
+
+  for (auto i = 0; i < 6; ++i) {
+    lua.script("scheduler:update(0.016)");
+    REQUIRE(getStats(lua).numResumed == 1);
+    REQUIRE(getStats(lua).numPending == 2);
+  }
+  const auto log = lua["log"].get<std::vector<std::string>>();
+  REQUIRE(log == std::vector<std::string>{"a", "b", "c", "a", "b", "c"});
+
+  SECTION("Cancel") {
+    lua.script("scheduler:cancel(1)"); // "b"
+    lua.script("log = {}");
+    for (auto i = 0; i < 4; ++i) {
+      lua.script("scheduler:update(0.016)");
+    }
+    const auto log = lua["log"].get<std::vector<std::string>>();
+    REQUIRE(log == std::vector<std::string>{"a", "c", "a", "c"});
+  }
+}
+
+TEST_CASE("Self cancel") {
+  auto lua = createState();
+  lua.script(R"(
+    numResumes = 0
+    scheduler = CoroutineScheduler()
+    local id
+    id = scheduler:spawn(function()
+      scheduler:cancel(id)
+      -- Returns (or fails) after the cancel.
+      if fail then error("Failure") end
+    end)
+    scheduler:spawn(function()
+      while true do
+        numResumes = numResumes + 1
+        coroutine.yield()
+      end
+    end)
+  )");
+  auto &scheduler = lua["scheduler"].get<CoroutineScheduler &>();
+
+  SECTION("Return") { lua["fail"] = false; }
+  SECTION("Failure") { lua["fail"] = true; }
+
+  for (auto i = 0; i < 3; ++i) {
+    lua.script("scheduler:update(0.016)");
+    // The other coroutine is not dropped.
+    REQUIRE(scheduler.size() == 1);
+  }
+  REQUIRE(lua["numResumes"].get<int32_t>() == 3);
+}
+
+TEST_CASE("Cancel another") {
+  auto lua = createState();
+  lua.script(R"(
+    log = {}
+    scheduler = CoroutineScheduler()
+    local ids = {}
+    for _, name in ipairs({ "a", "b", "c" }) do
+      ids[name] = scheduler:spawn(function(name)
+        while true do
+          log[#log + 1] = name
+          if name == "a" then scheduler:cancel(ids.c) end
+          coroutine.yield()
+        end
+      end, name)
+    end
+  )");
+
+  for (auto i = 0; i < 2; ++i) {
+    lua.script("scheduler:update(0.016)");
+    // "a" is not resumed again in place of the cancelled "c".
+    REQUIRE(getStats(lua).numResumed == 2);
+  }
+  const auto log = lua["log"].get<std::vector<std::string>>();
+  REQUIRE(log == std::vector<std::string>{"a", "b", "a", "b"});
+}
+
+TEST_CASE("Budget") {
+  auto lua = createState();
+  lua.script("scheduler = CoroutineScheduler(5)");
+  lua.script(kBusyTasks);
+
+  for (auto i = 0; i < 8; ++i) {
+    lua.script("scheduler:update(0.016)");
+    const auto &stats = getStats(lua);
+    // The budget is checked before each resume (at least 1 ms each).
+    REQUIRE(stats.numResumed >= 1);
+    REQUIRE(stats.numResumed <= 5);
+    REQUIRE(stats.numResumed + stats.numPending == 20);
+  }
+  // Round robin, no coroutine is resumed twice before the others.
+  const auto numResumes = lua["numResumes"].get<std::vector<int32_t>>();
+  const auto [min, max] = std::ranges::minmax_element(numResumes);
+  REQUIRE(*max - *min <= 1);
+}
+
+TEST_CASE("Thread pool") {
+  auto lua = createState();
+  lua.script(R"(
+    scheduler = CoroutineScheduler()
+    function spawnAll(n)
+      for i = 1, n do
+        scheduler:spawn(function() end)
+      end
+    end
+  )");
+  lua.script("spawnAll(10); scheduler:update(0.016)");
+  REQUIRE(getStats(lua).numFinished == 10);
+  REQUIRE(getStats(lua).poolSize == 10);
+
+  // The finished threads are reused.
+  lua.script("spawnAll(10); scheduler:update(0.016)");
+  REQUIRE(getStats(lua).poolSize == 10);
+
+  auto &scheduler = lua["scheduler"].get<CoroutineScheduler &>();
+  scheduler.setSettings({.maxPoolSize = 4});
+  lua.script("spawnAll(10); scheduler:update(0.016)");
+  REQUIRE(getStats(lua).poolSize == 4);
+
+  SECTION("Failure") {
+    lua.script(R"(
+      scheduler:spawn(function() error("Failure") end)
+      spawnAll(1)
+      scheduler:update(0.016)
+    )");
+    REQUIRE(getStats(lua).numFailed == 1);
+    REQUIRE(getStats(lua).numFinished == 31);
+    REQUIRE(scheduler.empty());
+  }
+}
+
+TEST_CASE("Coroutine scheduler benchmark", "[.benchmark]") {
+  auto lua = createState();
+  lua.script(R"(
+    scheduler = CoroutineScheduler(1000)
+    for i = 1, 1000 do
+      scheduler:spawn(function()
+        while true do coroutine.yield() end
+      end)
+    end
+  )");
+  BENCHMARK("1000 coroutines") { lua.script("scheduler:update(0.016)"); };
+}
+
+int main(int argc, char *argv[]) { return Catch::Session{}.run(argc, argv); }
@@ -2,10 +2,27 @@
 #include "sol/state.hpp"
 
 #include "Transform.hpp"
+#include "LuaEntity.hpp"
 #include "Sol2HelperMacros.hpp"
 
+namespace {
+
+// Marks the Transform of an entity as modified (see: LuaComponent::patch).
+// Returns self (the same reference), so a chained call patches it too.
+template <class... Args>
+[[nodiscard]] auto patching(Transform &(Transform::*f)(Args...)) {
+  return [f](sol::this_state s, Transform &self, Args... args) {
+    (self.*f)(args...);
+    LuaComponent::patch(s, 1, self);
+    return sol::stack_object{s, 1};
+  };
+}
+
+} // namespace
+
 void registerTransform(sol::state &lua) {
 #define BIND(Member) _BIND(Transform, Member)
+#define PATCHING(Member) #Member, patching(&Transform::Member)
   // clang-format off
   lua.DEFINE_USERTYPE(Transform,
     sol::call_constructor,
@@ -20,15 +37,15 @@ void registerTransform(sol::state &lua) {
     "Up", sol::readonly_property([]{ return Transform::kUp; }),
     "Forward", sol::readonly_property([]{ return Transform::kForward; }),
 
-    "load", [](Transform &self, const glm::mat4 &m) -> Transform & { 
-      return self.load(m);
-    },
-    BIND(loadIdentity),
+    "load", patching(
+      sol::resolve<Transform &(const glm::mat4 &)>(&Transform::load)
+    ),
+    PATCHING(loadIdentity),
 
-    BIND(setPosition),
-    BIND(setOrientation),
-    BIND(setEulerAngles),
-    BIND(setScale),
+    PATCHING(setPosition),
+    PATCHING(setOrientation),
+    PATCHING(setEulerAngles),
+    PATCHING(setScale),
 
     // ---
 
@@ -51,19 +68,21 @@ void registerTransform(sol::state &lua) {
     
     // ---
 
-    BIND(translate),
+    PATCHING(translate),
 
-    BIND(rotate),
-    BIND(pitch),
-    BIND(yaw),
-    BIND(roll),
+    PATCHING(rotate),
+    PATCHING(pitch),
+    PATCHING(yaw),
+    PATCHING(roll),
     
     "lookAt", sol::overload(
-      sol::resolve<Transform &(const glm::vec4 &)>(&Transform::lookAt),
-      sol::resolve<Transform &(const Transform &)>(&Transform::lookAt)
+      patching(
+        sol::resolve<Transform &(const glm::vec4 &)>(&Transform::lookAt)),
+      patching(
+        sol::resolve<Transform &(const Transform &)>(&Transform::lookAt))
     ),
 
-    BIND(scale),
+    PATCHING(scale),
     
     // ---
 
@@ -71,5 +90,6 @@ void registerTransform(sol::state &lua) {
     BIND_TOSTRING(Transform)
   );
   // clang-format on
+#undef PATCHING
 #undef BIND
 }
@@ -311,6 +311,8 @@ void registerRenderSettings(sol::state &lua) {
     MAKE_PAIR(FXAA),
     MAKE_PAIR(EyeAdaptation),
     MAKE_PAIR(CustomPostprocess),
+    MAKE_PAIR(MeshletCulling),
+    MAKE_PAIR(ComputeSkinning),
 
     MAKE_PAIR(Default),
 
@@ -0,0 +1,96 @@
+#include "GarbageCollector.hpp"
+#include <cassert>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+[[nodiscard]] std::size_t getHeapSize(lua_State *L) {
+  return std::size_t(lua_gc(L, LUA_GCCOUNT, 0)) * 1024 +
+         std::size_t(lua_gc(L, LUA_GCCOUNTB, 0));
+}
+
+} // namespace
+
+//
+// GarbageCollector class:
+//
+
+void GarbageCollector::setSettings(const Settings &settings) {
+  m_settings = settings;
+}
+const GarbageCollector::Settings &GarbageCollector::getSettings() const {
+  return m_settings;
+}
+
+void GarbageCollector::step(sol::state &lua) {
+  auto *L = lua.lua_state();
+  _applyMode(L);
+
+  const auto start = Clock::now();
+  m_stats.numSteps = 0;
+  if (m_settings.stepBudget > 0.0f) {
+    const std::chrono::duration<float, std::milli> budget{
+      m_settings.stepBudget};
+    const auto stepSize = int(m_settings.stepSize);
+    do {
+      ++m_stats.numSteps;
+      // 1 = the step has finished a cycle.
+      if (lua_gc(L, LUA_GCSTEP, stepSize) == 1) {
+        ++m_stats.numCycles;
+        break;
+      }
+    } while (m_settings.mode == Settings::Mode::Incremental &&
+             Clock::now() - start < budget);
+  }
+  m_stats.time = Clock::now() - start;
+  m_stats.heapSize = getHeapSize(L);
+}
+void GarbageCollector::collect(sol::state &lua) {
+  auto *L = lua.lua_state();
+  _applyMode(L);
+
+  const auto start = Clock::now();
+  lua_gc(L, LUA_GCCOLLECT, 0);
+  ++m_stats.numFullCollects;
+  m_stats.time = Clock::now() - start;
+  m_stats.heapSize = getHeapSize(L);
+}
+
+const GarbageCollector::Stats &GarbageCollector::getStats() const {
+  return m_stats;
+}
+
+//
+// (private):
+//
+
+void GarbageCollector::_applyMode(lua_State *L) const {
+  switch (m_settings.mode) {
+    using enum Settings::Mode;
+
+  case Incremental:
+    lua_gc(L, LUA_GCINC, 0, 0, 0); // 0 = keep the parameters.
+    break;
+  case Generational:
+    lua_gc(L, LUA_GCGEN, 0, 0);
+    break;
+  }
+}
+
+//
+// Helper:
+//
+
+const char *toString(const GarbageCollector::Settings::Mode mode) {
+  switch (mode) {
+    using enum GarbageCollector::Settings::Mode;
+
+  case Incremental:
+    return "Incremental";
+  case Generational:
+    return "Generational";
+  }
+  assert(false);
+  return "Undefined";
+}
@@ -0,0 +1,263 @@
+#include "LuaProfiler.hpp"
+#include "nlohmann/json.hpp"
+#include <algorithm> // find, sort
+#include <cassert>
+#include <format>
+
+#ifdef TRACY_ENABLE
+#  include "tracy/TracyC.h"
+#endif
+
+namespace {
+
+// The address is the key of the profiler in the registry (lightuserdata).
+constexpr char kRegistryKey{};
+
+[[nodiscard]] std::string_view toString(const char *str) {
+  return str ? str : "";
+}
+
+} // namespace
+
+//
+// LuaProfiler class:
+//
+
+LuaProfiler::LuaProfiler(sol::state &lua) : m_main{lua.lua_state()} {}
+LuaProfiler::~LuaProfiler() { stop(); }
+
+void LuaProfiler::start() {
+  if (m_running) return;
+
+  lua_pushlightuserdata(m_main, this);
+  lua_rawsetp(m_main, LUA_REGISTRYINDEX, &kRegistryKey);
+  lua_sethook(m_main, _hook, LUA_MASKCALL | LUA_MASKRET, 0);
+
+  m_startTime = Clock::now();
+  m_running = true;
+}
+void LuaProfiler::stop() {
+  if (!m_running) return;
+
+  // The coroutines remove their hooks (see: _hook).
+  lua_sethook(m_main, nullptr, 0, 0);
+  lua_pushnil(m_main);
+  lua_rawsetp(m_main, LUA_REGISTRYINDEX, &kRegistryKey);
+
+  // The calls in progress are accounted until now.
+  const auto now = Clock::now();
+  for (auto &[L, stack] : m_stacks) {
+    while (!stack.frames.empty()) {
+      _finish(stack, now, L == m_main);
+    }
+  }
+  m_stacks.clear();
+
+  m_duration += Clock::now() - m_startTime;
+  m_running = false;
+}
+bool LuaProfiler::isRunning() const { return m_running; }
+
+void LuaProfiler::reset() {
+  m_functions.clear();
+  m_duration = {};
+  m_startTime = Clock::now();
+}
+
+LuaProfiler::Report LuaProfiler::getReport() const {
+  Report report{.duration = m_duration};
+  if (m_running) report.duration += Clock::now() - m_startTime;
+
+  report.functions.reserve(m_functions.size());
+  for (const auto &[_, stats] : m_functions) {
+    report.functions.push_back(stats);
+
+    if (stats.line < 0) continue; // C functions are not part of a script.
+    auto it = std::ranges::find(report.scripts, stats.source,
+                                &ScriptStats::source);
+    if (it == report.scripts.end()) {
+      it = report.scripts.insert(it, ScriptStats{.source = stats.source});
+    }
+    it->numCalls += stats.numCalls;
+    it->selfTime += stats.selfTime;
+  }
+  std::ranges::sort(report.functions, std::greater{}, &FunctionStats::selfTime);
+  std::ranges::sort(report.scripts, std::greater{}, &ScriptStats::selfTime);
+  return report;
+}
+
+//
+// (private):
+//
+
+std::size_t LuaProfiler::FunctionKeyHash::operator()(
+  const FunctionKey &key) const noexcept {
+  return std::hash<const void *>{}(key.p) ^ (std::size_t(key.line) << 1);
+}
+
+void LuaProfiler::_hook(lua_State *L, lua_Debug *ar) {
+  lua_rawgetp(L, LUA_REGISTRYINDEX, &kRegistryKey);
+  auto *profiler = static_cast<LuaProfiler *>(lua_touserdata(L, -1));
+  lua_pop(L, 1);
+  if (!profiler) {
+    // A coroutine that inherited the hook (before stop).
+    lua_sethook(L, nullptr, 0, 0);
+    return;
+  }
+
+  switch (ar->event) {
+  case LUA_HOOKCALL:
+  case LUA_HOOKTAILCALL:
+    profiler->_onCall(L, ar, ar->event == LUA_HOOKTAILCALL);
+    break;
+  case LUA_HOOKRET:
+    profiler->_onReturn(L);
+    break;
+  }
+}
+
+LuaProfiler::FunctionKey LuaProfiler::_getFunction(lua_State *L,
+                                                   lua_Debug *ar) {
+  lua_getinfo(L, "Sf", ar);
+  FunctionKey key{ar->source, ar->linedefined};
+  if (ar->what == std::string_view{"C"}) {
+    key = {reinterpret_cast<const void *>(lua_tocfunction(L, -1)), -1};
+  }
+  lua_pop(L, 1);
+  return key;
+}
+int32_t LuaProfiler::_getDepth(lua_State *L) {
+  // Binary search of the last level (like luaL_traceback).
+  lua_Debug ar;
+  int32_t low{1};
+  int32_t high{1};
+  while (lua_getstack(L, high, &ar)) {
+    low = high;
+    high *= 2;
+  }
+  while (low < high) {
+    const auto mid = (low + high) / 2;
+    if (lua_getstack(L, mid, &ar)) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return high;
+}
+
+void LuaProfiler::_onCall(lua_State *L, lua_Debug *ar, const bool tail) {
+  const auto depth = _getDepth(L);
+  auto &stack = m_stacks[L];
+  // A tail call replaces the caller (at the same level), which is kept on
+  // the stack until the callee returns (see: _onReturn).
+  _unwind(stack, tail ? depth : depth - 1, L == m_main);
+
+  const auto function = _getFunction(L, ar);
+
+  auto &stats = m_functions[function];
+  if (stats.numCalls++ == 0) {
+    lua_getinfo(L, "n", ar);
+    stats.source = toString(ar->source);
+    stats.name = toString(ar->name);
+    stats.line = function.line;
+  }
+
+  Frame frame{.function = function, .depth = depth, .tail = tail};
+#ifdef TRACY_ENABLE
+  if (L == m_main) {
+    const auto name = stats.name.empty()
+                        ? std::format("{}:{}", stats.source, stats.line)
+                        : stats.name;
+    const auto zone = ___tracy_emit_zone_begin_alloc(
+      ___tracy_alloc_srcloc_name(
+        uint32_t(std::max(stats.line, 0)), stats.source.c_str(),
+        stats.source.size(), name.c_str(), name.size(), name.c_str(),
+        name.size()),
+      1);
+    frame.zoneId = zone.id;
+    frame.zoneActive = zone.active;
+  }
+#endif
+  // After the hook overhead.
+  frame.start = Clock::now();
+  stack.lastEvent = frame.start;
+  stack.frames.push_back(frame);
+}
+void LuaProfiler::_onReturn(lua_State *L) {
+  const auto now = Clock::now();
+
+  const auto depth = _getDepth(L);
+  auto &stack = m_stacks[L];
+  const auto mainThread = L == m_main;
+  _unwind(stack, depth, mainThread);
+
+  auto &frames = stack.frames;
+  // Otherwise called before the start.
+  if (!frames.empty() && frames.back().depth == depth) {
+    // A tail call replaced the caller, which returns too.
+    auto tail = false;
+    do {
+      tail = frames.back().tail;
+      _finish(stack, now, mainThread);
+    } while (tail && !frames.empty() && frames.back().depth == depth);
+  }
+  stack.lastEvent = now;
+}
+
+void LuaProfiler::_unwind(Stack &stack, const int32_t depth,
+                          const bool mainThread) {
+  while (!stack.frames.empty() && stack.frames.back().depth > depth) {
+    _finish(stack, stack.lastEvent, mainThread);
+  }
+}
+
+void LuaProfiler::_finish(Stack &stack, const Clock::time_point now,
+                          [[maybe_unused]] const bool mainThread) {
+  auto &frames = stack.frames;
+  assert(!frames.empty());
+  const auto frame = frames.back();
+  frames.pop_back();
+
+  const Duration total = now - frame.start;
+  auto &stats = m_functions[frame.function];
+  stats.totalTime += total;
+  stats.selfTime += total - frame.children;
+  if (!frames.empty()) frames.back().children += total;
+
+#ifdef TRACY_ENABLE
+  if (mainThread) {
+    ___tracy_emit_zone_end(TracyCZoneCtx{frame.zoneId, frame.zoneActive});
+  }
+#endif
+}
+
+//
+// Helper:
+//
+
+std::string toJSON(const LuaProfiler::Report &report) {
+  auto j = nlohmann::ordered_json{
+    {"duration", report.duration.count()},
+    {"scripts", nlohmann::ordered_json::array()},
+    {"functions", nlohmann::ordered_json::array()},
+  };
+  for (const auto &script : report.scripts) {
+    j["scripts"].push_back({
+      {"source", script.source},
+      {"numCalls", script.numCalls},
+      {"selfTime", script.selfTime.count()},
+    });
+  }
+  for (const auto &fn : report.functions) {
+    j["functions"].push_back({
+      {"source", fn.source},
+      {"name", fn.name},
+      {"line", fn.line},
+      {"numCalls", fn.numCalls},
+      {"totalTime", fn.totalTime.count()},
+      {"selfTime", fn.selfTime.count()},
+    });
+  }
+  return j.dump(2);
+}
@@ -1,7 +1,19 @@
 #include "ScriptContext.hpp"
 #include "os/FileSystem.hpp"
+#include <cassert>
 #include <format>
 
+namespace {
+
+[[nodiscard]] std::string getChunkName(const ScriptResource &resource) {
+  // '@' = a file (the error messages print the path).
+  return resource.isVirtual()
+           ? "=script"
+           : std::format("@{}", resource.getPath().generic_string());
+}
+
+} // namespace
+
 ScriptContext::ScriptContext(sol::state &s)
     : lua{std::addressof(s)}, defaultEnv{*lua, sol::create, lua->globals()} {
   const auto projectLocalPath = os::FileSystem::getRoot() / "";
@@ -10,3 +22,36 @@ ScriptContext::ScriptContext(sol::state &s)
     packagePath.set(std::format("{}{}?.lua;", packagePath.get<std::string>(),
                                 projectLocalPath.lexically_normal().string()));
 }
+
+std::expected<sol::table, std::string>
+ScriptContext::instantiate(const std::shared_ptr<ScriptResource> &resource) {
+  assert(resource);
+
+  auto it = chunks.find(resource.get());
+  if (it == chunks.cend() || it->second.resource.lock() != resource) {
+    std::erase_if(chunks,
+                  [](const auto &p) { return p.second.resource.expired(); });
+
+    auto loadResult = lua->load(resource->code, getChunkName(*resource));
+    if (!loadResult.valid()) {
+      const sol::error e = loadResult;
+      return std::unexpected{e.what()};
+    }
+    sol::protected_function function = loadResult;
+    sol::set_environment(defaultEnv, function);
+    it = chunks
+           .insert_or_assign(resource.get(),
+                             CompiledChunk{resource, std::move(function)})
+           .first;
+  }
+
+  auto result = it->second.function();
+  if (!result.valid()) {
+    const sol::error e = result;
+    return std::unexpected{e.what()};
+  }
+  if (result.get_type() != sol::type::table) {
+    return std::unexpected{"Expected table (ScriptNode)."};
+  }
+  return result.get<sol::table>();
+}
@@ -0,0 +1,195 @@
+#include "ScriptDispatcher.hpp"
+#include "entt/core/type_info.hpp"
+#include "spdlog/spdlog.h"
+#include <algorithm> // find, sort
+#include <cassert>
+#include <iterator> // distance
+
+namespace {
+
+// One C->Lua transition per list, pcall isolates the failing nodes.
+constexpr auto kDispatchCode = R"(
+local pcall, tostring = pcall, tostring
+
+return function(selves, functions, n, ...)
+  local failures
+  for i = 1, n do
+    local self = selves[i]
+    if self then
+      local ok, err = pcall(functions[i], self, ...)
+      if not ok then
+        failures = failures or {}
+        failures[i] = tostring(err)
+      end
+    end
+  end
+  return failures
+end
+)";
+
+template <std::size_t... Is>
+[[nodiscard]] constexpr auto makeInputTypeIds(std::index_sequence<Is...>) {
+  return std::array{
+    entt::type_hash<std::variant_alternative_t<Is, os::InputEvent>>::value()...,
+  };
+}
+constexpr auto kInputTypeIds = makeInputTypeIds(
+  std::make_index_sequence<ScriptDispatcher::kNumInputEvents>{});
+
+// @return A mask of the os::InputEvent alternatives (all by default).
+[[nodiscard]] auto getInputEvents(const sol::table &self) {
+  std::array<bool, ScriptDispatcher::kNumInputEvents> events{};
+  const auto types = self.get<sol::optional<sol::table>>("inputEvents");
+  if (!types) {
+    events.fill(true);
+    return events;
+  }
+  for (const auto &[_, type] : *types) {
+    if (type.get_type() != sol::type::table) continue;
+
+    const auto typeId =
+      type.as<sol::table>().get<sol::optional<sol::function>>("type_id");
+    if (!typeId) continue;
+
+    const auto it =
+      std::ranges::find(kInputTypeIds, (*typeId)().get<entt::id_type>());
+    if (it != kInputTypeIds.cend()) {
+      events[std::distance(kInputTypeIds.cbegin(), it)] = true;
+    }
+  }
+  return events;
+}
+
+} // namespace
+
+//
+// ScriptDispatcher class:
+//
+
+ScriptDispatcher::ScriptDispatcher(sol::state &lua) {
+  sol::protected_function chunk = lua.load(kDispatchCode, "=ScriptDispatcher");
+  m_dispatch = chunk().get<sol::protected_function>();
+  for (auto &list : m_lists) {
+    list.selves = lua.create_table();
+    list.functions = lua.create_table();
+  }
+}
+
+void ScriptDispatcher::add(const Id id, const sol::table &self) {
+  assert(m_current == nullptr);
+
+  const auto getHook = [&self](const char *name) {
+    return self.get<sol::optional<sol::function>>(name);
+  };
+  if (const auto fn = getHook("update"); fn) {
+    _add(m_lists[0], id, self, *fn);
+  }
+  if (const auto fn = getHook("physicsStep"); fn) {
+    _add(m_lists[1], id, self, *fn);
+  }
+  if (const auto fn = getHook("input"); fn) {
+    const auto events = getInputEvents(self);
+    for (auto i = 0u; i < kNumInputEvents; ++i) {
+      if (events[i]) _add(m_lists[kInputList + i], id, self, *fn);
+    }
+  }
+}
+void ScriptDispatcher::remove(const Id id) {
+  for (auto &list : m_lists) {
+    const auto it = list.positions.find(id);
+    if (it == list.positions.cend()) continue;
+
+    const auto position = it->second;
+    list.positions.erase(it);
+    if (&list == m_current) {
+      // The loop skips it, removed after the dispatch.
+      list.selves[position + 1] = false;
+      m_removed.push_back(position);
+    } else {
+      _remove(list, position);
+    }
+  }
+}
+
+ScriptDispatcher::Failures
+ScriptDispatcher::input(const os::InputEvent &evt) {
+  return _dispatch(m_lists[kInputList + evt.index()], evt);
+}
+ScriptDispatcher::Failures ScriptDispatcher::update(const float dt) {
+  return _dispatch(m_lists[0], dt);
+}
+ScriptDispatcher::Failures ScriptDispatcher::physicsStep(const float dt) {
+  return _dispatch(m_lists[1], dt);
+}
+
+ScriptDispatcher::Stats ScriptDispatcher::getStats() const {
+  Stats stats{
+    .numUpdate = uint32_t(m_lists[0].ids.size()),
+    .numPhysicsStep = uint32_t(m_lists[1].ids.size()),
+  };
+  for (auto i = 0u; i < kNumInputEvents; ++i) {
+    stats.numInput[i] = uint32_t(m_lists[kInputList + i].ids.size());
+  }
+  return stats;
+}
+
+//
+// (private):
+//
+
+void ScriptDispatcher::_add(List &list, const Id id, const sol::table &self,
+                            const sol::function &fn) {
+  if (list.positions.contains(id)) return;
+
+  list.positions[id] = list.ids.size();
+  list.ids.push_back(id);
+  const auto n = list.ids.size();
+  list.selves[n] = self;
+  list.functions[n] = fn;
+}
+void ScriptDispatcher::_remove(List &list, const std::size_t position) {
+  const auto last = list.ids.size() - 1;
+  if (position != last) {
+    const auto id = list.ids[last];
+    list.ids[position] = id;
+    list.positions[id] = position;
+    list.selves[position + 1] = list.selves.get<sol::object>(last + 1);
+    list.functions[position + 1] = list.functions.get<sol::object>(last + 1);
+  }
+  list.selves[last + 1] = sol::lua_nil;
+  list.functions[last + 1] = sol::lua_nil;
+  list.ids.pop_back();
+}
+
+template <typename... Args>
+ScriptDispatcher::Failures ScriptDispatcher::_dispatch(List &list,
+                                                       Args &&...args) {
+  if (list.ids.empty()) return {};
+
+  m_current = &list;
+  const auto result = m_dispatch(list.selves, list.functions, list.ids.size(),
+                                 std::forward<Args>(args)...);
+  m_current = nullptr;
+
+  Failures failures;
+  if (!result.valid()) {
+    const sol::error e = result;
+    SPDLOG_ERROR("Script dispatch failed. {}", e.what());
+  } else if (const auto t = result.get<sol::optional<sol::table>>(); t) {
+    for (const auto &[i, message] : *t) {
+      failures.push_back({
+        .id = list.ids[i.as<std::size_t>() - 1],
+        .message = message.as<std::string>(),
+      });
+    }
+  }
+
+  // The last positions first, the moved nodes are the remaining ones.
+  std::ranges::sort(m_removed, std::greater{});
+  for (const auto position : m_removed) {
+    _remove(list, position);
+  }
+  m_removed.clear();
+
+  return failures;
+}
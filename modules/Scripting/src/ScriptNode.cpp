@@ -25,6 +25,9 @@ ScriptNode::ScriptNode(sol::table &&t) : m_self{std::move(t)} {
 
 const sol::table &ScriptNode::self() const { return m_self; }
 
+ScriptNode::State ScriptNode::getState() const { return m_state; }
+void ScriptNode::invalidate() { m_state = State::Invalid; }
+
 void ScriptNode::init() {
   m_state = State::Ready;
   _call(m_hooks.init);
@@ -3,24 +3,61 @@
 #include "animation/SkeletonComponent.hpp"
 #include "animation/AnimationComponent.hpp"
 #include "animation/PlaybackController.hpp"
+#include "animation/AnimationLayers.hpp"
+#include "animation/AnimationLOD.hpp"
+#include "PerspectiveCamera.hpp"
 #include "DebugDraw.hpp"
 
 #include "SystemCommons.hpp"
 
+#include <string_view>
+
 /*
   Context variables:
-  - [none]
+  - [creates] AnimationLODSettings (serialized)
+  - [creates] AnimatedEntities (internal)
   Components:
   - SkeletonComponent
   - AnimationComponent
   - PlaybackController
+  - AnimationLayers (takes precedence over AnimationComponent)
   - gfx::MeshInstance
+  - [creates] AnimationPose (not serialized)
+  - [creates] AnimationLOD (not serialized)
+  Entities are updated in parallel (getSharedThreadPool).
 */
 class AnimationSystem {
 public:
   INTRODUCE_COMPONENTS(SkeletonComponent, AnimationComponent,
-                       PlaybackController)
+                       PlaybackController, AnimationLayers)
+
+  static void setup(entt::registry &);
 
-  static void update(entt::registry &, float dt);
+  // @param camera Used by the level of detail (AnimationLODSettings),
+  // nullptr = every entity is updated at full rate.
+  static void update(entt::registry &, float dt,
+                     const gfx::PerspectiveCamera *camera = nullptr);
   static void debugDraw(entt::registry &, DebugDraw &);
+
+  template <class Archive> static void save(Archive &archive) {
+    auto &[registry, _] = cereal::get_user_data<OutputContext>(archive);
+    archive(cereal::make_nvp(
+      kSettingsName, registry.ctx().template get<AnimationLODSettings>()));
+  }
+  template <class Archive> static void load(Archive &archive) {
+    auto &[registry, _] = cereal::get_user_data<InputContext>(archive);
+    // Scenes saved before the settings were introduced (the next node belongs
+    // to the components).
+    if constexpr (requires { archive.getNodeName(); }) {
+      const auto *name = archive.getNodeName();
+      if (name == nullptr || std::string_view{name} != kSettingsName) return;
+    }
+    archive(cereal::make_nvp(
+      kSettingsName, registry.ctx().template get<AnimationLODSettings>()));
+  }
+
+private:
+  static constexpr auto kSettingsName = "AnimationLODSettings";
 };
+
+[[nodiscard]] AnimationLODSettings &getAnimationLODSettings(entt::registry &);
@@ -1,33 +1,164 @@
 #include "AnimationSystem.hpp"
 #include "renderer/MeshInstance.hpp"
 
-#include "ozz/base/maths/soa_transform.h"
-#include "ozz/animation/runtime/sampling_job.h"
-#include "ozz/animation/runtime/local_to_model_job.h"
-
-#include "animation/Conversion.hpp"
+#include "animation/AnimationPose.hpp"
 #include "SkeletonDebugDraw.hpp"
+#include "ThreadPool.hpp"
+
+#include "glm/trigonometric.hpp" // radians
+#include "glm/geometric.hpp"     // distance
 
 #include "tracy/Tracy.hpp"
 
+#include <algorithm>  // nth_element, count_if
+#include <functional> // greater
+#include <cmath>      // tan
+#include <span>
+
 namespace {
 
-[[nodiscard]] auto
-buildSkin(std::span<const gfx::Joints::value_type> inverseBindPose,
-          ozz::span<const ozz::math::Float4x4> models) {
-  ZoneScopedN("BuildSkin");
-  gfx::Joints skin;
-  if (inverseBindPose.size() == models.size()) {
-    skin.reserve(inverseBindPose.size());
-    for (auto i = 0u; i < models.size(); ++i) {
-      skin.emplace_back(to_mat4(models[i]) * inverseBindPose[i]);
+// Entities to update (reused every frame).
+struct AnimatedEntities {
+  struct Entry {
+    entt::entity e;
+    float priority; // AnimationLOD::getPriority
+  };
+  std::vector<Entry> clips;   // AnimationComponent + PlaybackController.
+  std::vector<Entry> layered; // AnimationLayers.
+  std::vector<entt::entity> interpolated; // Skin only (see AnimationLOD).
+  std::vector<float> priorities;          // Scratch (maxUpdatesPerFrame).
+  uint64_t frame{0};
+};
+
+// Sampling + LocalToModel + skinning of a 60 joints skeleton: ~10-20us.
+constexpr auto kGrainSize = 8;
+constexpr auto kInterpolationGrainSize = 32;
+
+[[nodiscard]] bool isSkinned(const gfx::MeshInstance &meshInstance,
+                             const SkeletonComponent &skeleton) {
+  const auto *prototype = meshInstance.getPrototype().get();
+  return prototype && prototype->isSkeletal() && skeleton.resource;
+}
+
+struct Visibility {
+  float screenSize{1.0f};
+  bool visible{true};
+};
+// Uses the world AABB of the previous frame (set by the RenderSystem).
+[[nodiscard]] Visibility measure(const AABB &aabb,
+                                 const gfx::PerspectiveCamera &camera) {
+  if (isUninitialized(aabb)) return {};
+
+  const auto radius = aabb.getRadius();
+  const auto distance = glm::distance(aabb.getCenter(), camera.getPosition());
+  const auto halfHeight =
+    distance * std::tan(glm::radians(camera.getFov()) * 0.5f);
+  return {
+    .screenSize = distance > radius ? radius / halfHeight : 1.0f,
+    .visible = camera.getFrustum().testAABB(aabb),
+  };
+}
+
+// Postpones the least important updates (to the next frames).
+void applyBudget(entt::registry &r, AnimatedEntities &animated,
+                 uint32_t maxUpdates, bool interpolate) {
+  auto &[clips, layered, interpolated, priorities, _] = animated;
+  if (clips.size() + layered.size() <= maxUpdates) return;
+
+  priorities.clear();
+  for (const auto &entry : clips) priorities.push_back(entry.priority);
+  for (const auto &entry : layered) priorities.push_back(entry.priority);
+  const auto nth = priorities.begin() + (maxUpdates - 1);
+  std::nth_element(priorities.begin(), nth, priorities.end(),
+                   std::greater{});
+  const auto cut = *nth;
+  auto numTies =
+    maxUpdates - std::count_if(priorities.cbegin(), priorities.cend(),
+                               [cut](float p) { return p > cut; });
+
+  const auto postpone = [&](const AnimatedEntities::Entry &entry) {
+    if (entry.priority > cut) return false;
+    if (entry.priority == cut && numTies > 0) {
+      --numTies;
+      return false;
+    }
+    if (interpolate && r.get<AnimationLOD>(entry.e).canInterpolate()) {
+      interpolated.push_back(entry.e);
     }
+    return true;
+  };
+  std::erase_if(clips, postpone);
+  std::erase_if(layered, postpone);
+}
+
+[[nodiscard]] bool samplePose(const ozz::animation::Skeleton &skeleton,
+                              AnimationPose &pose,
+                              const AnimationComponent &animation,
+                              PlaybackController &controller, float dt) {
+  controller.update(*animation.resource, dt);
+  return pose.update(skeleton, *animation.resource, controller.getTimeRatio());
+}
+[[nodiscard]] bool samplePose(const ozz::animation::Skeleton &skeleton,
+                              AnimationPose &pose, AnimationLayers &layers,
+                              float dt) {
+  layers.update(dt);
+  return pose.update(skeleton, layers);
+}
+
+void updateSkin(gfx::MeshInstance &meshInstance, const AnimationPose &pose,
+                AnimationLOD &lod, bool interpolate) {
+  const auto models = pose.getModels();
+  const auto &inverseBindPose = meshInstance->getInverseBindPose();
+  if (inverseBindPose.size() != models.size()) {
+    meshInstance.setSkinMatrices({});
+    lod.clearSkin();
+    return;
+  }
+  if (interpolate && lod.getInterval() > 1) {
+    buildSkin(models, inverseBindPose, lod.pushSkin(models.size()));
+    lod.interpolate(meshInstance.prepareSkin(models.size()));
+  } else {
+    lod.clearSkin();
+    buildSkin(models, inverseBindPose, meshInstance.prepareSkin(models.size()));
   }
-  return skin;
 }
-[[nodiscard]] auto buildSkin(const gfx::Mesh &mesh,
-                             ozz::span<const ozz::math::Float4x4> models) {
-  return buildSkin(mesh.getInverseBindPose(), models);
+
+// Samples the animation(s) and skins each entity (in parallel).
+template <typename... Animation>
+void updatePoses(entt::registry &r,
+                 std::span<const AnimatedEntities::Entry> entries,
+                 bool interpolate) {
+  const auto view = r.view<gfx::MeshInstance, const SkeletonComponent,
+                           AnimationPose, AnimationLOD, Animation...>();
+  parallelFor(getSharedThreadPool(), entries.size(), kGrainSize,
+              [&view, entries, interpolate](std::size_t begin,
+                                            std::size_t end) {
+                ZoneScopedN("AnimationSystem::UpdateChunk");
+                for (auto i = begin; i < end; ++i) {
+                  const auto e = entries[i].e;
+                  auto [meshInstance, skeleton, pose, lod] =
+                    view.template get<gfx::MeshInstance,
+                                      const SkeletonComponent, AnimationPose,
+                                      AnimationLOD>(e);
+                  if (samplePose(*skeleton.resource, pose,
+                                 view.template get<Animation>(e)...,
+                                 lod.consumeDeltaTime())) {
+                    updateSkin(meshInstance, pose, lod, interpolate);
+                  }
+                }
+              });
+}
+void interpolateSkins(entt::registry &r,
+                      std::span<const entt::entity> entities) {
+  const auto view = r.view<gfx::MeshInstance, const AnimationLOD>();
+  parallelFor(getSharedThreadPool(), entities.size(), kInterpolationGrainSize,
+              [&view, entities](std::size_t begin, std::size_t end) {
+                ZoneScopedN("AnimationSystem::InterpolateChunk");
+                for (auto i = begin; i < end; ++i) {
+                  auto [meshInstance, lod] = view.get(entities[i]);
+                  lod.interpolate(meshInstance.prepareSkin(lod.getNumJoints()));
+                }
+              });
 }
 
 void drawSkeleton(DebugDraw &debugDraw,
@@ -47,63 +178,79 @@ void drawSkeleton(DebugDraw &debugDraw,
 
 } // namespace
 
-void AnimationSystem::update(entt::registry &r, float dt) {
+void AnimationSystem::setup(entt::registry &r) {
+  r.ctx().emplace<AnimationLODSettings>();
+}
+
+void AnimationSystem::update(entt::registry &r, float dt,
+                             const gfx::PerspectiveCamera *camera) {
   ZoneScopedN("AnimationSystem::Update");
-  for (auto [_, meshInstance, skeleton, animation, controller] :
-       r.view<gfx::MeshInstance, const SkeletonComponent,
-              const AnimationComponent, PlaybackController>()
-         .each()) {
-    const auto *prototype = meshInstance.getPrototype().get();
-    if (!prototype || !prototype->isSkeletal() || !skeleton.resource ||
-        !animation.resource) {
-      continue;
-    }
 
-    controller.update(*animation.resource, dt);
-
-    std::vector<ozz::math::SoaTransform> locals(
-      skeleton.resource->num_soa_joints());
-
-    ozz::animation::SamplingJob::Context context;
-    context.Resize(skeleton.resource->num_joints());
-    ozz::animation::SamplingJob samplingJob;
-    {
-      ZoneScopedN("SamplingJob");
-      samplingJob.animation = animation.resource.get();
-      samplingJob.context = &context;
-      samplingJob.ratio = controller.getTimeRatio();
-      samplingJob.output = ozz::make_span(locals);
-      if (!samplingJob.Run()) {
-        continue;
-      }
-    }
+  const auto &settings = getAnimationLODSettings(r);
+  auto &animated = r.ctx().emplace<AnimatedEntities>();
+  auto &[clips, layered, interpolated, _, frame] = animated;
+  clips.clear();
+  layered.clear();
+  interpolated.clear();
+  ++frame;
 
-    std::vector<ozz::math::Float4x4> models(skeleton.resource->num_joints());
-    ozz::animation::LocalToModelJob localToModelJob;
-    {
-      ZoneScopedN("LocalToModelJob");
-      localToModelJob.skeleton = skeleton.resource.get();
-      localToModelJob.input = ozz::make_span(locals);
-      localToModelJob.output = ozz::make_span(models);
-      if (!localToModelJob.Run()) {
-        continue;
-      }
-    }
+  // The components are created here (the parallel part can't modify the
+  // pools).
+  const auto schedule = [&](entt::entity e,
+                            const gfx::MeshInstance &meshInstance,
+                            std::vector<AnimatedEntities::Entry> &out) {
+    if (!r.all_of<AnimationPose>(e)) r.emplace<AnimationPose>(e);
+    auto &lod = r.get_or_emplace<AnimationLOD>(
+      e, uint32_t(entt::to_entity(e)));
 
-    meshInstance.setSkinMatrices(buildSkin(*prototype, localToModelJob.output));
+    const auto [screenSize, visible] =
+      camera ? measure(meshInstance.getAABB(), *camera) : Visibility{};
+    lod.advance(calcUpdateInterval(settings, screenSize, visible), dt);
+    if (lod.isDue(frame)) {
+      out.push_back({e, lod.getPriority(screenSize)});
+    } else if (settings.interpolate && lod.getInterval() > 0 &&
+               lod.canInterpolate()) {
+      interpolated.push_back(e);
+    }
+  };
+  for (auto [e, meshInstance, skeleton, animation] :
+       r.view<const gfx::MeshInstance, const SkeletonComponent,
+              const AnimationComponent, const PlaybackController>(
+          entt::exclude<AnimationLayers>)
+         .each()) {
+    if (isSkinned(meshInstance, skeleton) && animation.resource) {
+      schedule(e, meshInstance, clips);
+    }
+  }
+  for (auto [e, meshInstance, skeleton] :
+       r.view<const gfx::MeshInstance, const SkeletonComponent,
+              const AnimationLayers>()
+         .each()) {
+    if (isSkinned(meshInstance, skeleton)) schedule(e, meshInstance, layered);
   }
+  if (settings.enabled && settings.maxUpdatesPerFrame > 0) {
+    applyBudget(r, animated, settings.maxUpdatesPerFrame, settings.interpolate);
+  }
+  TracyPlot("AnimationSystem::Updates", int64_t(clips.size() + layered.size()));
+
+  updatePoses<const AnimationComponent, PlaybackController>(
+    r, clips, settings.interpolate);
+  updatePoses<AnimationLayers>(r, layered, settings.interpolate);
+  interpolateSkins(r, interpolated);
 }
 
 void AnimationSystem::debugDraw(entt::registry &r, DebugDraw &dd) {
   ZoneScopedN("AnimationSystem::DebugDraw");
-  for (auto [_, meshInstance, skeleton, animation] :
+  for (auto [_, meshInstance, skeleton] :
        r.view<const gfx::MeshInstance, const SkeletonComponent,
-              const AnimationComponent>()
+              const AnimationPose>()
          .each()) {
-    const auto *prototype = meshInstance.getPrototype().get();
-    if (prototype && prototype->isSkeletal() && skeleton.resource &&
-        animation.resource) {
+    if (isSkinned(meshInstance, skeleton)) {
       drawSkeleton(dd, *skeleton.resource, meshInstance);
     }
   }
 }
+
+AnimationLODSettings &getAnimationLODSettings(entt::registry &r) {
+  return r.ctx().get<AnimationLODSettings>();
+}
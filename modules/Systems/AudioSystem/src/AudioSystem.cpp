@@ -7,6 +7,10 @@ template <class T> void initComponent(entt::registry &r, entt::entity e) {
   const auto &world = r.ctx().get<AudioWorld>();
   world.init(r.try_get<Transform>(e), r.get<T>(e));
 }
+void releaseVoice(entt::registry &r, entt::entity e) {
+  const auto &world = r.ctx().get<AudioWorld>();
+  world.release(r.get<SoundSourceComponent>(e));
+}
 template <class T> void connectComponent(entt::registry &r) {
   r.on_construct<T>().template connect<&initComponent<T>>();
 }
@@ -22,11 +26,18 @@ void AudioSystem::setup(entt::registry &r, audio::Device &device) {
   r.ctx().emplace<MainListener>();
 
   connectComponent<SoundSourceComponent>(r);
+  r.on_destroy<SoundSourceComponent>().connect<&releaseVoice>();
   connectComponent<AudioPlayerComponent>(r);
 }
-void AudioSystem::update(entt::registry &r, [[maybe_unused]] float dt) {
+void AudioSystem::update(entt::registry &r, float dt) {
   ZoneScopedN("AudioSystem::Update");
   auto &world = r.ctx().get<AudioWorld>();
+  // Without an output device nothing else advances the sources (a headless
+  // run). A Loopback device is rendered by its owner.
+  if (auto &device = world.getDevice();
+      device.getBackend() == audio::Device::Backend::Null) {
+    device.render(fsec{dt});
+  }
 
   if (const auto [e] = getMainListener(r); e != entt::null) {
     auto *xf = r.try_get<const Transform>(e);
@@ -37,8 +48,9 @@ void AudioSystem::update(entt::registry &r, [[maybe_unused]] float dt) {
   }
 
   for (auto [e, c] : r.view<SoundSourceComponent>().each()) {
-    if (auto *xf = r.try_get<const Transform>(e)) world.update(*xf, c);
+    world.update(r.try_get<const Transform>(e), c, fsec{dt});
   }
+  world.updateVoices();
   for (auto [e, c] : r.view<AudioPlayerComponent>().each()) {
     world.update(r.try_get<const Transform>(e), c);
   }
@@ -8,7 +8,7 @@
   Context variables:
   - (none)
   Components:
-  - [setup callbacks] Transform
+  - [setup callbacks] Transform (a patch is propagated to the children)
   - [setup callbacks] ParentComponent
   - [setup callbacks] ChildrenComponent
 */
@@ -32,6 +32,16 @@ void setParentTransform(entt::registry &r, entt::entity e) {
 void detachTransform(entt::registry &r, entt::entity e) {
   if (auto *xf = r.try_get<Transform>(e); xf) xf->setParent(nullptr);
 }
+// The world transform of the children follows (e.g. their physics bodies).
+void patchChildrenTransform(entt::registry &r, entt::entity e) {
+  if (auto *c = r.try_get<const ChildrenComponent>(e); c)
+    for (auto child : c->children)
+      if (r.all_of<Transform>(child)) r.patch<Transform>(child);
+}
+// A patch notifies the other systems (the world transform has changed).
+void patchTransform(entt::registry &r, entt::entity e) {
+  if (r.all_of<Transform>(e)) r.patch<Transform>(e);
+}
 void detachChildrenTransform(entt::registry &r, entt::entity e) {
   if (auto *c = r.try_get<const ChildrenComponent>(e); c)
     for (auto child : c->children)
@@ -52,6 +62,7 @@ void HierarchySystem::setup(entt::registry &r) {
 
   r.on_construct<Transform>().connect<&setParentTransform>();
   r.on_update<Transform>().connect<&setParentTransform>();
+  r.on_update<Transform>().connect<&patchChildrenTransform>();
   r.on_destroy<Transform>().connect<&detachChildrenTransform>();
 }
 void HierarchySystem::attachTo(entt::registry &r, entt::entity child,
@@ -69,6 +80,7 @@ void HierarchySystem::attachTo(entt::registry &r, entt::entity child,
                entt::to_integral(designatedParent));
 
   setParentTransform(r, child);
+  patchTransform(r, child);
 }
 void HierarchySystem::detach(entt::registry &r, entt::entity e) {
   if (auto *pc = r.try_get<ParentComponent>(e); pc) {
@@ -87,6 +99,7 @@ void HierarchySystem::detach(entt::registry &r, entt::entity e) {
   }
 
   detachTransform(r, e);
+  patchTransform(r, e);
 }
 
 std::optional<entt::handle> getParent(entt::handle h) {
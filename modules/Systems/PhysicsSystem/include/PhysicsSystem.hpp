@@ -8,8 +8,10 @@
 /*
   Context variables:
   - [creates] PhysicsWorld
+  - [creates] DirtyBodies (internal)
   Components:
-  - Transform
+  - Transform (a patched/replaced Transform is pushed to Jolt before the next
+    step, see: markDirty)
   - [setup callbacks] ColliderComponent
   - [setup callbacks] RigidBody
   - [setup callbacks] Character
@@ -22,12 +24,25 @@ struct PhysicsSystem {
   static void setup(entt::registry &);
 
   // Simulate and update global Transform (Jolt -> Transform).
+  // Only the bodies that moved (see PhysicsWorld::getMovedBodies) are synced,
+  // static and sleeping bodies are skipped.
   static void simulate(entt::registry &, float timeStep);
   static void debugDraw(entt::registry &, DebugDraw &);
 
-  // Update position and rotation of a body (Transform -> Jolt).
+  // Deferred updateTransform, the body is updated before the next step.
+  // Connected to on_update<Transform>, so a patch (e.g. by the Lua Transform
+  // setters or the HierarchySystem) is enough.
+  static void markDirty(entt::registry &, entt::entity);
+  // Update position and rotation of a body (Transform -> Jolt), immediately.
   static void updateTransform(entt::registry &, entt::entity);
 
+  // In-memory snapshot of the simulation (including the CharacterVirtual
+  // components), e.g. to rewind a play-test without reloading the scene.
+  [[nodiscard]] static PhysicsState saveState(entt::registry &);
+  // Into the same registry, with the same physics entities.
+  // The Transforms are synced from the restored state.
+  static bool restoreState(entt::registry &, const PhysicsState &);
+
   template <class Archive> static void save(Archive &archive) {
     auto &[registry, _] = cereal::get_user_data<OutputContext>(archive);
     archive(registry.ctx().template get<PhysicsWorld>());
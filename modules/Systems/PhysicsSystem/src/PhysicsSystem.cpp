@@ -2,8 +2,17 @@
 #include "physics/Conversion.hpp"
 #include "tracy/Tracy.hpp"
 
+#include "Jolt/Physics/Body/BodyLock.h"
+
+#include <algorithm> // sort, unique
+
 namespace {
 
+// Entities with a modified Transform (to push to Jolt before the next step).
+struct DirtyBodies {
+  std::vector<entt::entity> entities;
+};
+
 // Engine -> Jolt
 void setTransform(JPH::BodyInterface &bodyInterface, const JPH::BodyID bodyId,
                   const Transform &xf) {
@@ -112,9 +121,96 @@ void connectCharacterVirtualComponent(entt::registry &r) {
   r.on_construct<CharacterVirtual>().connect<&initCharacterVirtual>();
 }
 
+//
+// Transform:
+//
+
+void connectTransformComponent(entt::registry &r) {
+  r.on_update<Transform>().connect<&PhysicsSystem::markDirty>();
+}
+
+// Engine -> Jolt (unless the body is already there, e.g. a Transform that a
+// script has only read).
+void pushTransform(JPH::BodyInterface &bodyInterface, const JPH::BodyID bodyId,
+                   const Transform &xf) {
+  const auto position = to_Jolt(xf.getPosition());
+  const auto rotation = to_Jolt(xf.getOrientation());
+  if (bodyInterface.GetPosition(bodyId).IsClose(position) &&
+      bodyInterface.GetRotation(bodyId).IsClose(rotation)) {
+    return;
+  }
+  bodyInterface.SetPositionAndRotation(bodyId, position, rotation,
+                                       JPH::EActivation::DontActivate);
+}
+
+// Engine -> Jolt (only the modified transforms).
+void pushDirtyTransforms(entt::registry &r, PhysicsWorld &world,
+                         float timeStep) {
+  auto &[entities] = r.ctx().get<DirtyBodies>();
+  if (entities.empty()) return;
+
+  ZoneScopedN("PushDirtyTransforms");
+  std::ranges::sort(entities);
+  entities.erase(std::ranges::unique(entities).begin(), entities.end());
+
+  auto &bodyInterface = world.getBodyInterfaceNoLock();
+  const auto transforms = r.view<const Transform>();
+  for (const auto e : entities) {
+    if (!transforms.contains(e)) continue;
+
+    const auto &xf = transforms.get<const Transform>(e);
+    if (const auto *rb = r.try_get<const RigidBody>(e); rb && *rb) {
+      if (rb->getSettings().motionType == MotionType::Kinematic &&
+          timeStep > 0.0f) {
+        // The velocity is derived from the displacement (so the kinematic
+        // body pushes the dynamic ones).
+        bodyInterface.MoveKinematic(rb->getBodyId(),
+                                    to_Jolt(xf.getPosition()),
+                                    to_Jolt(xf.getOrientation()), timeStep);
+      } else {
+        pushTransform(bodyInterface, rb->getBodyId(), xf);
+      }
+    }
+    if (const auto *c = r.try_get<const Character>(e); c && *c) {
+      pushTransform(bodyInterface, c->getBodyId(), xf);
+    }
+  }
+  entities.clear();
+}
+// Jolt -> Engine (only the bodies that moved in the last step).
+void pullMovedBodies(entt::registry &r, const PhysicsWorld &world) {
+  ZoneScopedN("PullMovedBodies");
+  const auto &lockInterface = world.getBodyLockInterfaceNoLock();
+  const auto view = r.view<Transform, const RigidBody>();
+  for (const auto bodyId : world.getMovedBodies()) {
+    const JPH::BodyLockRead lock{lockInterface, bodyId};
+    if (!lock.Succeeded()) continue;
+
+    const auto &body = lock.GetBody();
+    // The user data of a body is the entity (see: initRigidBody).
+    const auto e = entt::entity{static_cast<uint32_t>(body.GetUserData())};
+    if (!view.contains(e)) continue; // A Character.
+
+    auto [xf, rb] = view.get(e);
+    if (rb.getBodyId() == bodyId) setTransform(body.GetWorldTransform(), xf);
+  }
+}
+
+// The order of a view is stable as long as the storage isn't modified.
+[[nodiscard]] auto getCharacters(entt::registry &r) {
+  const auto view = r.view<const CharacterVirtual>();
+  std::vector<const CharacterVirtual *> characters;
+  characters.reserve(view.size());
+  for (const auto [_, c] : view.each()) {
+    characters.push_back(&c);
+  }
+  return characters;
+}
+
 } // namespace
 
 void PhysicsSystem::setup(entt::registry &r) {
+  r.ctx().emplace<DirtyBodies>();
   auto &world = r.ctx().emplace<PhysicsWorld>();
   world.on<ContactAddedEvent>([&r](const ContactAddedEvent &e, auto &) {
 #define FORWARD_EVT(T, first, second)                                          \
@@ -155,20 +251,18 @@ void PhysicsSystem::setup(entt::registry &r) {
   connectRigidBodyComponent(r);
   connectCharacterComponent(r);
   connectCharacterVirtualComponent(r);
+  connectTransformComponent(r);
 }
 
 void PhysicsSystem::simulate(entt::registry &r, float timeStep) {
   ZoneScopedN("PhysicsSystem::Simulate");
 
   auto &world = getPhysicsWorld(r);
+  pushDirtyTransforms(r, world, timeStep);
   world.simulate(timeStep);
+  pullMovedBodies(r, world);
 
   const auto transforms = r.view<Transform>();
-
-  const auto &bodyInterface = world.getBodyInterface();
-  for (auto [_, xf, rb] : (transforms | r.view<const RigidBody>()).each()) {
-    if (rb) setTransform(bodyInterface.GetWorldTransform(rb.getBodyId()), xf);
-  }
   for (auto [_, xf, c] : (transforms | r.view<const Character>()).each()) {
     constexpr auto kCollisionTolerance = 0.05f;
     world.update(c, &xf, kCollisionTolerance);
@@ -182,6 +276,11 @@ void PhysicsSystem::debugDraw(entt::registry &r, DebugDraw &dd) {
   getPhysicsWorld(r).debugDraw(dd);
 }
 
+void PhysicsSystem::markDirty(entt::registry &r, entt::entity e) {
+  if (r.any_of<RigidBody, Character>(e)) {
+    r.ctx().get<DirtyBodies>().entities.push_back(e);
+  }
+}
 void PhysicsSystem::updateTransform(entt::registry &r, entt::entity e) {
   if (const auto *xf = r.try_get<const Transform>(e); xf) {
     auto &bodyInterface = getPhysicsWorld(r).getBodyInterface();
@@ -194,6 +293,32 @@ void PhysicsSystem::updateTransform(entt::registry &r, entt::entity e) {
   }
 }
 
+PhysicsState PhysicsSystem::saveState(entt::registry &r) {
+  return getPhysicsWorld(r).saveState(getCharacters(r));
+}
+bool PhysicsSystem::restoreState(entt::registry &r,
+                                 const PhysicsState &state) {
+  ZoneScopedN("PhysicsSystem::RestoreState");
+
+  auto &world = getPhysicsWorld(r);
+  if (!world.restoreState(state, getCharacters(r))) return false;
+
+  // The restored state overrides the pending (Transform -> Jolt) changes.
+  r.ctx().get<DirtyBodies>().entities.clear();
+  pullMovedBodies(r, world);
+
+  const auto transforms = r.view<Transform>();
+  for (auto [_, xf, c] : (transforms | r.view<const Character>()).each()) {
+    constexpr auto kCollisionTolerance = 0.05f;
+    world.update(c, &xf, kCollisionTolerance);
+  }
+  for (auto [_, xf, c] :
+       (transforms | r.view<const CharacterVirtual>()).each()) {
+    xf.setPosition(c.getPosition()).setOrientation(c.getRotation());
+  }
+  return true;
+}
+
 //
 // Helper:
 //
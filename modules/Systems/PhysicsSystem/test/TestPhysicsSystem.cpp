@@ -0,0 +1,188 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include "PhysicsSystem.hpp"
+#include "HierarchySystem.hpp"
+#include "physics/JoltPhysics.hpp"
+
+#include "LuaEntity.hpp"
+#include "LuaMath.hpp"
+#include "LuaTransform.hpp"
+#include "sol/state.hpp"
+
+#include "Jolt/Physics/Collision/Shape/BoxShape.h"
+
+#include <algorithm> // count
+
+namespace {
+
+[[nodiscard]] auto makeBox(float halfExtent) {
+  return std::make_shared<ColliderResource>(
+    new JPH::BoxShape{JPH::Vec3::sReplicate(halfExtent)}, "box");
+}
+
+entt::entity spawn(entt::registry &r,
+                   const std::shared_ptr<ColliderResource> &collider,
+                   const glm::vec3 &position, MotionType motionType) {
+  const auto e = r.create();
+  r.emplace<Transform>(e, position);
+  r.emplace<ColliderComponent>(e, collider);
+  r.emplace<RigidBody>(e, RigidBody::Settings{.motionType = motionType});
+  return e;
+}
+
+[[nodiscard]] bool contains(std::span<const JPH::BodyID> bodies,
+                            JPH::BodyID bodyId) {
+  return std::ranges::count(bodies, bodyId) > 0;
+}
+
+constexpr auto kTimeStep = 1.0f / 60.0f;
+
+} // namespace
+
+TEST_CASE("Moved bodies") {
+  entt::registry r;
+  PhysicsSystem::setup(r);
+
+  const auto box = makeBox(0.5f);
+  const auto ground = spawn(r, box, glm::vec3{0.0f}, MotionType::Static);
+  const auto falling =
+    spawn(r, box, glm::vec3{0.0f, 10.0f, 0.0f}, MotionType::Dynamic);
+
+  PhysicsSystem::simulate(r, kTimeStep);
+
+  const auto movedBodies = getPhysicsWorld(r).getMovedBodies();
+  REQUIRE(contains(movedBodies, r.get<RigidBody>(falling).getBodyId()));
+  REQUIRE_FALSE(contains(movedBodies, r.get<RigidBody>(ground).getBodyId()));
+
+  REQUIRE(r.get<Transform>(falling).getPosition().y < 10.0f);
+  REQUIRE(r.get<Transform>(ground).getPosition() == glm::vec3{0.0f});
+
+  SECTION("Sleeping bodies are synced once") {
+    for (auto i = 0; i < 600; ++i) {
+      PhysicsSystem::simulate(r, kTimeStep);
+    }
+    const auto &rb = r.get<RigidBody>(falling);
+    REQUIRE(getPhysicsWorld(r).getMovedBodies().empty());
+    // Resting on the ground.
+    REQUIRE(r.get<Transform>(falling).getPosition().y ==
+            Approx{rb.getPosition().y});
+    REQUIRE(rb.getPosition().y == Approx{1.0f}.margin(0.05f));
+  }
+}
+
+TEST_CASE("Dirty transforms") {
+  entt::registry r;
+  PhysicsSystem::setup(r);
+
+  const auto box = makeBox(0.5f);
+  const auto kinematic = spawn(r, box, glm::vec3{0.0f}, MotionType::Kinematic);
+  const auto other = spawn(r, box, glm::vec3{5.0f}, MotionType::Static);
+
+  // Not patched: Jolt keeps the previous position.
+  r.get<Transform>(other).setPosition(glm::vec3{-5.0f});
+  r.patch<Transform>(kinematic, [](Transform &xf) {
+    xf.setPosition(glm::vec3{1.0f, 0.0f, 0.0f});
+  });
+  PhysicsSystem::simulate(r, kTimeStep);
+
+  REQUIRE(r.get<RigidBody>(kinematic).getPosition().x == Approx{1.0f});
+  REQUIRE(r.get<RigidBody>(other).getPosition() == glm::vec3{5.0f});
+}
+
+TEST_CASE("Transform modified by a script") {
+  entt::registry r;
+  PhysicsSystem::setup(r);
+  HierarchySystem::setup(r);
+
+  const auto box = makeBox(0.5f);
+  const auto kinematic = spawn(r, box, glm::vec3{0.0f}, MotionType::Kinematic);
+
+  sol::state lua;
+  lua.open_libraries(sol::lib::base);
+  registerMath(lua);
+  registerTransform(lua);
+  registerEntityHandle(lua);
+
+  // Through the reference, as in a ScriptNode.
+  lua["entity"] = entt::handle{r, kinematic};
+  lua.script(R"(
+    local xf = entity:get(Transform)
+    xf:setPosition(math.vec3(1, 0, 0))
+  )");
+  PhysicsSystem::simulate(r, kTimeStep);
+
+  const auto &rb = r.get<RigidBody>(kinematic);
+  REQUIRE(rb.getPosition().x == Approx{1.0f});
+
+  SECTION("Read only") {
+    // Not patched, a read must not mark the body dirty.
+    r.get<Transform>(kinematic).setPosition(glm::vec3{-5.0f});
+    lua["each"] = [&r](const sol::variadic_args &args,
+                       const sol::this_state s) { eachEntity(r, args, s); };
+    lua.script(R"(
+      local xf = entity:get(Transform)
+      local _ = xf:getPosition()
+      each(Transform, function(e, xf) local _ = xf:getScale() end)
+    )");
+    PhysicsSystem::simulate(r, kTimeStep);
+
+    REQUIRE(rb.getPosition().x == Approx{1.0f});
+  }
+  SECTION("Chained calls") {
+    lua.script(R"(
+      entity:get(Transform):setPosition(math.vec3(0)):translate(math.vec3(2))
+    )");
+    PhysicsSystem::simulate(r, kTimeStep);
+
+    REQUIRE(rb.getPosition().x == Approx{2.0f});
+    REQUIRE(rb.getPosition().y == Approx{2.0f});
+  }
+  SECTION("Moved parent") {
+    const auto parent = r.create();
+    r.emplace<Transform>(parent);
+    HierarchySystem::attachTo(r, kinematic, parent);
+
+    lua["parent"] = entt::handle{r, parent};
+    lua.script("parent:get(Transform):translate(math.vec3(0, 2, 0))");
+    PhysicsSystem::simulate(r, kTimeStep);
+
+    REQUIRE(rb.getPosition().x == Approx{1.0f});
+    REQUIRE(rb.getPosition().y == Approx{2.0f});
+  }
+}
+
+TEST_CASE("Static scene benchmark", "[.benchmark]") {
+  constexpr auto kNumStatic = 50'000;
+  constexpr auto kNumDynamic = 100;
+
+  entt::registry r;
+  PhysicsSystem::setup(r);
+
+  const auto box = makeBox(0.5f);
+  // A 224 x 224 grid, with a gap between the boxes.
+  constexpr auto kGridSize = 224;
+  for (auto i = 0; i < kNumStatic; ++i) {
+    const glm::vec3 position{
+      2.0f * float(i % kGridSize),
+      0.0f,
+      2.0f * float(i / kGridSize),
+    };
+    spawn(r, box, position, MotionType::Static);
+  }
+  for (auto i = 0; i < kNumDynamic; ++i) {
+    spawn(r, box, glm::vec3{2.0f * float(i), 5.0f, 1.0f},
+          MotionType::Dynamic);
+  }
+  getPhysicsWorld(r).optimizeBroadPhase();
+
+  BENCHMARK("Simulate") { PhysicsSystem::simulate(r, kTimeStep); };
+}
+
+int main(int argc, char *argv[]) {
+  LuaComponent::extendMetaType<Transform>();
+  JoltPhysics::setup();
+  const auto result = Catch::Session{}.run(argc, argv);
+  JoltPhysics::cleanup();
+  return result;
+}
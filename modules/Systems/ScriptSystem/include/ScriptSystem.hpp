@@ -1,6 +1,8 @@
 #pragma once
 
 #include "ScriptContext.hpp"
+#include "GarbageCollector.hpp"
+#include "ScriptDispatcher.hpp"
 #include "ScriptComponent.hpp"
 
 #include "SystemCommons.hpp"
@@ -8,6 +10,8 @@
 /*
   Context variables:
   - [creates] ScriptContext (state, environment)
+  - [creates] GarbageCollector
+  - [creates] ScriptDispatcher
   Components:
   - [setup callbacks] ScriptComponent
 */
@@ -20,9 +24,19 @@ struct ScriptSystem {
   static void onUpdate(entt::registry &, float dt);
   static void onPhysicsStep(entt::registry &, float dt);
 
+  // A full collection (e.g. after a scene transition), onUpdate only steps
+  // the collector (see: GarbageCollector::Settings).
+  static void collectGarbage(entt::registry &);
+
 private:
+  // Invalidates the failed nodes (see: ScriptDispatcher).
+  static void _handleFailures(entt::registry &,
+                              const ScriptDispatcher::Failures &);
+
   static void _initScriptComponent(entt::registry &, entt::entity);
   static void _cleanupScriptComponent(entt::registry &, entt::entity);
 };
 
 [[nodiscard]] ScriptContext &getScriptContext(entt::registry &);
+[[nodiscard]] GarbageCollector &getGarbageCollector(entt::registry &);
+[[nodiscard]] ScriptDispatcher &getScriptDispatcher(entt::registry &);
@@ -2,62 +2,106 @@
 #include "tracy/Tracy.hpp"
 #include "spdlog/spdlog.h"
 
+namespace {
+
+void plot([[maybe_unused]] const GarbageCollector::Stats &stats) {
+  TracyPlot("Lua::HeapSize", int64_t(stats.heapSize));
+  TracyPlot("Lua::GCTime", stats.time.count());
+}
+
+} // namespace
+
 void ScriptSystem::setup(entt::registry &r, sol::state &lua) {
   r.ctx().emplace<ScriptContext>(lua);
+  r.ctx().emplace<GarbageCollector>();
+  r.ctx().emplace<ScriptDispatcher>(lua);
   r.on_construct<ScriptComponent>().connect<&_initScriptComponent>();
   r.on_destroy<ScriptComponent>().connect<&_cleanupScriptComponent>();
 }
 
 void ScriptSystem::onInput(entt::registry &r, const os::InputEvent &evt) {
   ZoneScopedN("ScriptSystem::OnInput");
-  for (auto [_, c] : r.view<ScriptComponent>().each()) {
-    c.m_scriptNode.input(evt);
-  }
+  _handleFailures(r, getScriptDispatcher(r).input(evt));
 }
 void ScriptSystem::onUpdate(entt::registry &r, float dt) {
   ZoneScopedN("ScriptSystem::Update");
-  for (auto [_, c] : r.view<ScriptComponent>().each()) {
-    c.m_scriptNode.update(dt);
+  auto &dispatcher = getScriptDispatcher(r);
+  {
+    ZoneScopedN("ScriptSystem::InitScripts");
+    const auto getNode = [&r](const entt::entity e) -> ScriptNode * {
+      auto *c = r.valid(e) ? r.try_get<ScriptComponent>(e) : nullptr;
+      return c ? &c->m_scriptNode : nullptr;
+    };
+    // The nodes spawned by init are initialized in the next frame.
+    for (const auto id : std::exchange(dispatcher.pending, {})) {
+      const auto e = entt::entity{id};
+      if (auto *node = getNode(e);
+          node && node->getState() == ScriptNode::State::Uninitialized) {
+        node->init();
+      }
+      // init could emplace components (the storage might be reallocated).
+      if (auto *node = getNode(e);
+          node && node->getState() == ScriptNode::State::Ready) {
+        dispatcher.add(id, node->self());
+      }
+    }
   }
+  _handleFailures(r, dispatcher.update(dt));
   {
-    ZoneScopedN("Lua::CollectGarbage");
-    getScriptContext(r).lua->collect_garbage();
+    ZoneScopedN("Lua::StepGarbageCollector");
+    auto &gc = getGarbageCollector(r);
+    gc.step(*getScriptContext(r).lua);
+    plot(gc.getStats());
   }
 }
 void ScriptSystem::onPhysicsStep(entt::registry &r, float dt) {
   ZoneScopedN("ScriptSystem::OnPhysicsStep");
-  for (auto [_, c] : r.view<ScriptComponent>().each()) {
-    c.m_scriptNode.physicsStep(dt);
-  }
+  _handleFailures(r, getScriptDispatcher(r).physicsStep(dt));
+}
+
+void ScriptSystem::collectGarbage(entt::registry &r) {
+  ZoneScopedN("Lua::CollectGarbage");
+  auto &gc = getGarbageCollector(r);
+  gc.collect(*getScriptContext(r).lua);
+  plot(gc.getStats());
 }
 
 //
 // (private):
 //
 
+void ScriptSystem::_handleFailures(entt::registry &r,
+                                   const ScriptDispatcher::Failures &failures) {
+  auto &dispatcher = getScriptDispatcher(r);
+  for (const auto &[id, message] : failures) {
+    SPDLOG_ERROR("{}", message);
+    dispatcher.remove(id);
+    if (const auto e = entt::entity{id}; r.valid(e)) {
+      if (auto *c = r.try_get<ScriptComponent>(e); c) {
+        c->m_scriptNode.invalidate();
+      }
+    }
+  }
+}
+
 void ScriptSystem::_initScriptComponent(entt::registry &r, entt::entity e) {
   auto &c = r.get<ScriptComponent>(e);
   if (!c.m_resource) return;
 
-  const auto &[lua, defaultEnv] = getScriptContext(r);
-  auto result = lua->script(c.m_resource->code, defaultEnv);
-  if (!result.valid()) {
-    SPDLOG_ERROR("Invalid lua script.");
+  ZoneScopedN("ScriptSystem::InitScriptComponent");
+  auto self = getScriptContext(r).instantiate(c.m_resource);
+  if (!self) {
+    SPDLOG_ERROR("Invalid lua script. {}", self.error());
     c.m_resource = {};
     return;
   }
-  if (result.get_type() != sol::type::table) {
-    SPDLOG_ERROR("Invalid lua script, expected table (ScriptNode).");
-    c.m_resource = {};
-    return;
-  }
-
-  auto self = result.get<sol::table>();
-  self["entity"] = entt::handle{r, e};
-  c.m_scriptNode = ScriptNode{std::move(self)};
+  (*self)["entity"] = entt::handle{r, e};
+  c.m_scriptNode = ScriptNode{std::move(*self)};
+  getScriptDispatcher(r).pending.push_back(entt::to_integral(e));
 }
 void ScriptSystem::_cleanupScriptComponent(entt::registry &r, entt::entity e) {
   auto &c = r.get<ScriptComponent>(e);
+  getScriptDispatcher(r).remove(entt::to_integral(e));
   c.m_scriptNode.destroy();
 }
 
@@ -68,3 +112,9 @@ void ScriptSystem::_cleanupScriptComponent(entt::registry &r, entt::entity e) {
 ScriptContext &getScriptContext(entt::registry &r) {
   return r.ctx().get<ScriptContext>();
 }
+GarbageCollector &getGarbageCollector(entt::registry &r) {
+  return r.ctx().get<GarbageCollector>();
+}
+ScriptDispatcher &getScriptDispatcher(entt::registry &r) {
+  return r.ctx().get<ScriptDispatcher>();
+}
@@ -0,0 +1,480 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include "ScriptSystem.hpp"
+#include "LuaProfiler.hpp"
+#include "LuaEntity.hpp"
+#include "MetaComponent.hpp"
+#include "MetaHelper.hpp"
+#include "Sol2HelperMacros.hpp"
+
+#include <algorithm> // all_of, find_if
+#include <fstream>
+#include <thread> // this_thread::sleep_for
+
+namespace {
+
+// Each instance has its own table (hits), the shared counter is a global of
+// the default environment.
+constexpr auto kScript = R"(
+local node = { hits = 0 }
+
+function node:update(dt)
+  self.hits = self.hits + 1
+  numUpdates = (numUpdates or 0) + self.hits
+end
+
+return node
+)";
+// Short-lived tables and strings (garbage) every frame.
+constexpr auto kAllocatingScript = R"(
+local node = {}
+
+function node:update(dt)
+  for i = 1, 1000 do
+    local t = { i, tostring(i) }
+  end
+end
+
+return node
+)";
+
+// No hooks, skipped by the dispatcher.
+constexpr auto kEmptyScript = "return {}";
+constexpr auto kFailingScript = R"(
+local node = {}
+
+function node:update(dt)
+  error("Failure")
+end
+
+return node
+)";
+constexpr auto kSelfDestroyingScript = R"(
+local node = {}
+
+function node:update(dt)
+  self.entity:destroy()
+end
+
+return node
+)";
+constexpr auto kKeyboardScript = R"(
+local node = { inputEvents = { KeyboardEvent } }
+
+function node:input(evt)
+  numInputs = (numInputs or 0) + 1
+end
+
+return node
+)";
+
+constexpr auto kTimeStep = 1.0f / 60.0f;
+
+struct Health {
+  float value{100.0f};
+};
+
+void registerHealth(sol::state &lua) {
+  // clang-format off
+  lua.DEFINE_USERTYPE(Health,
+    sol::call_constructor,
+    sol::constructors<Health()>(),
+
+    _BIND(Health, value),
+
+    BIND_TYPEID(Health)
+  );
+  // clang-format on
+}
+
+[[nodiscard]] sol::state createState() {
+  sol::state lua;
+  lua.open_libraries(sol::lib::base, sol::lib::package);
+  return lua;
+}
+
+void spawn(entt::registry &r, const std::shared_ptr<ScriptResource> &script,
+           const int32_t count) {
+  for (auto i = 0; i < count; ++i) {
+    r.emplace<ScriptComponent>(r.create(), script);
+  }
+}
+
+} // namespace
+
+TEST_CASE("Script instances") {
+  auto lua = createState();
+  entt::registry r;
+  ScriptSystem::setup(r, lua);
+
+  const auto script = std::make_shared<ScriptResource>(kScript, "");
+  spawn(r, script, 100);
+
+  auto &ctx = getScriptContext(r);
+  // Compiled once.
+  REQUIRE(ctx.chunks.size() == 1);
+
+  ScriptSystem::onUpdate(r, kTimeStep);
+  // Otherwise: 1 + 2 + ... + 100.
+  REQUIRE(ctx.defaultEnv["numUpdates"].get<int32_t>() == 100);
+
+  SECTION("Invalid script") {
+    const auto e = r.create();
+    r.emplace<ScriptComponent>(
+      e, std::make_shared<ScriptResource>("return 42", ""));
+    REQUIRE_FALSE(r.get<ScriptComponent>(e).getResource());
+  }
+  SECTION("Another resource") {
+    const auto other = std::make_shared<ScriptResource>(kScript, "");
+    spawn(r, other, 1);
+    REQUIRE(ctx.chunks.size() == 2);
+  }
+}
+
+TEST_CASE("Script dispatch") {
+  auto lua = createState();
+  registerEntityHandle(lua);
+  entt::registry r;
+  ScriptSystem::setup(r, lua);
+
+  const auto script = std::make_shared<ScriptResource>(kScript, "");
+  spawn(r, script, 10);
+
+  auto &dispatcher = getScriptDispatcher(r);
+  auto &env = getScriptContext(r).defaultEnv;
+
+  SECTION("Hooks") {
+    spawn(r, std::make_shared<ScriptResource>(kEmptyScript, ""), 10);
+    ScriptSystem::onUpdate(r, kTimeStep);
+
+    const auto stats = dispatcher.getStats();
+    REQUIRE(stats.numUpdate == 10);
+    REQUIRE(stats.numPhysicsStep == 0);
+    REQUIRE(std::ranges::all_of(stats.numInput, [](auto n) { return n == 0; }));
+  }
+  SECTION("Failure") {
+    spawn(r, std::make_shared<ScriptResource>(kFailingScript, ""), 1);
+    ScriptSystem::onUpdate(r, kTimeStep);
+    ScriptSystem::onUpdate(r, kTimeStep);
+    // The failing node is removed, the others are still updated.
+    REQUIRE(dispatcher.getStats().numUpdate == 10);
+    REQUIRE(env["numUpdates"].get<int32_t>() == 10 + 20);
+  }
+  SECTION("Removal during the dispatch") {
+    spawn(r, std::make_shared<ScriptResource>(kSelfDestroyingScript, ""), 10);
+    ScriptSystem::onUpdate(r, kTimeStep);
+    REQUIRE(r.view<ScriptComponent>().size() == 10);
+    REQUIRE(dispatcher.getStats().numUpdate == 10);
+
+    ScriptSystem::onUpdate(r, kTimeStep);
+    REQUIRE(env["numUpdates"].get<int32_t>() == 10 + 20);
+  }
+  SECTION("Input events") {
+    env["KeyboardEvent"] = lua.create_table_with(
+      "type_id", &entt::type_hash<os::KeyboardEvent>::value);
+    spawn(r, std::make_shared<ScriptResource>(kKeyboardScript, ""), 1);
+    ScriptSystem::onUpdate(r, kTimeStep);
+
+    const auto kKeyboard = os::InputEvent{os::KeyboardEvent{}}.index();
+    const auto stats = dispatcher.getStats();
+    for (auto i = 0u; i < stats.numInput.size(); ++i) {
+      REQUIRE(stats.numInput[i] == (i == kKeyboard ? 1 : 0));
+    }
+    ScriptSystem::onInput(r, os::MouseMoveEvent{});
+    ScriptSystem::onInput(r, os::KeyboardEvent{});
+    REQUIRE(env["numInputs"].get<int32_t>() == 1);
+  }
+}
+
+TEST_CASE("Lua profiler") {
+  auto lua = createState();
+  entt::registry r;
+  ScriptSystem::setup(r, lua);
+  spawn(r, std::make_shared<ScriptResource>(kScript, ""), 10);
+
+  LuaProfiler profiler{lua};
+  profiler.start();
+  REQUIRE(lua_gethook(lua.lua_state()) != nullptr);
+  for (auto i = 0; i < 3; ++i) {
+    ScriptSystem::onUpdate(r, kTimeStep);
+  }
+  profiler.stop();
+  // No overhead when disabled.
+  REQUIRE(lua_gethook(lua.lua_state()) == nullptr);
+
+  const auto report = profiler.getReport();
+  REQUIRE(report.duration.count() > 0);
+
+  // ScriptNode:update (a virtual resource = "=script").
+  const auto update = std::ranges::find_if(report.functions, [](auto &fn) {
+    return fn.source == "=script" && fn.line == 4;
+  });
+  REQUIRE(update != report.functions.cend());
+  REQUIRE(update->numCalls == 30);
+  REQUIRE(update->selfTime <= update->totalTime);
+
+  const auto script = std::ranges::find_if(
+    report.scripts, [](auto &s) { return s.source == "=script"; });
+  REQUIRE(script != report.scripts.cend());
+  REQUIRE(script->numCalls >= update->numCalls);
+
+  REQUIRE(toJSON(report).find("\"=script\"") != std::string::npos);
+
+  SECTION("Reset") {
+    profiler.reset();
+    REQUIRE(profiler.getReport().functions.empty());
+  }
+}
+
+TEST_CASE("Lua profiler, error caught by the host") {
+  using namespace std::chrono_literals;
+  constexpr auto kPause = 50ms;
+
+  auto lua = createState();
+  entt::registry r;
+  ScriptSystem::setup(r, lua);
+  spawn(r, std::make_shared<ScriptResource>(kFailingScript, ""), 1);
+  spawn(r, std::make_shared<ScriptResource>(kScript, ""), 10);
+
+  LuaProfiler profiler{lua};
+  profiler.start();
+  // The failing node:update is unwound by the error (caught by the
+  // sol::protected_function, there is no return event).
+  ScriptSystem::onUpdate(r, kTimeStep);
+  std::this_thread::sleep_for(kPause);
+  ScriptSystem::onUpdate(r, kTimeStep);
+  profiler.stop();
+
+  const auto report = profiler.getReport();
+
+  const auto error = std::ranges::find_if(
+    report.functions, [](auto &fn) { return fn.name == "error"; });
+  REQUIRE(error != report.functions.cend());
+  REQUIRE(error->numCalls == 1);
+
+  // node:update of both scripts, the unwound frames end with the error
+  // (not with the next call).
+  auto numCalls = 0u;
+  for (const auto &fn : report.functions) {
+    if (fn.source != "=script") continue;
+    REQUIRE(fn.totalTime < kPause);
+    numCalls += fn.numCalls;
+  }
+  REQUIRE(numCalls == 1 + 20);
+}
+
+TEST_CASE("Garbage collector") {
+  using enum GarbageCollector::Settings::Mode;
+
+  auto lua = createState();
+  entt::registry r;
+  ScriptSystem::setup(r, lua);
+  spawn(r, std::make_shared<ScriptResource>(kAllocatingScript, ""), 10);
+
+  auto &gc = getGarbageCollector(r);
+  const auto &stats = gc.getStats();
+
+  SECTION("Incremental") {
+    gc.setSettings({.mode = Incremental, .stepBudget = 1.0f});
+    for (auto i = 0; i < 60; ++i) {
+      ScriptSystem::onUpdate(r, kTimeStep);
+    }
+    REQUIRE(stats.numSteps > 0);
+    REQUIRE(stats.numCycles > 0);
+    REQUIRE(stats.heapSize < (16u << 20));
+  }
+  SECTION("Generational") {
+    gc.setSettings({.mode = Generational});
+    for (auto i = 0; i < 60; ++i) {
+      ScriptSystem::onUpdate(r, kTimeStep);
+    }
+    REQUIRE(stats.numSteps == 1);
+    REQUIRE(stats.heapSize < (16u << 20));
+  }
+  SECTION("Full collection on demand") {
+    ScriptSystem::onUpdate(r, kTimeStep);
+    const auto heapSize = stats.heapSize;
+    r.clear();
+    ScriptSystem::collectGarbage(r);
+    REQUIRE(stats.numFullCollects == 1);
+    REQUIRE(stats.heapSize <= heapSize);
+  }
+}
+
+TEST_CASE("Component accessors") {
+  auto lua = createState();
+  registerEntityHandle(lua);
+  registerHealth(lua);
+
+  entt::registry r;
+  lua["each"] = [&r](const sol::variadic_args &args, const sol::this_state s) {
+    eachEntity(r, args, s);
+  };
+  const entt::handle h{r, r.create()};
+  lua["e"] = h;
+
+  REQUIRE(LuaComponent::getAccessors(entt::type_hash<Health>::value()));
+
+  lua.script("e:emplace(Health()).value = 5");
+  REQUIRE(h.get<Health>().value == 5.0f);
+  REQUIRE(lua.script("return e:has(Health)").get<bool>());
+
+  SECTION("Reference") {
+    lua.script("e:get(Health).value = 10");
+    REQUIRE(h.get<Health>().value == 10.0f);
+  }
+  SECTION("Remove") {
+    REQUIRE(lua.script("return e:remove(Health)").get<bool>());
+    REQUIRE_FALSE(h.all_of<Health>());
+    REQUIRE(lua.script("return e:get(Health)").get_type() == sol::type::nil);
+  }
+  SECTION("Each") {
+    r.emplace<Health>(r.create(), 1.0f);
+    r.emplace<ScriptComponent>(r.create()); // Filtered out.
+    const auto sum = lua.script(R"(
+      local sum = 0
+      each(Health, function(e, health) sum = sum + health.value end)
+      return sum
+    )");
+    REQUIRE(sum.get<float>() == 6.0f);
+  }
+}
+
+TEST_CASE("Component accessors benchmark", "[.benchmark]") {
+  auto lua = createState();
+  registerEntityHandle(lua);
+  registerHealth(lua);
+
+  entt::registry r;
+  const entt::handle h{r, r.create()};
+  h.emplace<Health>();
+  lua["e"] = h;
+
+  const sol::this_state s{lua.lua_state()};
+  BENCHMARK("meta: get") {
+    const auto metaType = entt::resolve(entt::type_hash<Health>::value());
+    return invokeMetaFunc(metaType, LuaComponent::Functions::Get, h, s)
+      .cast<sol::reference>();
+  };
+  BENCHMARK("Accessors: get") {
+    const auto *accessors =
+      LuaComponent::getAccessors(entt::type_hash<Health>::value());
+    return accessors->get(h, s);
+  };
+  BENCHMARK("Lua: 1000 x Entity:get") {
+    return lua.script("for i = 1, 1000 do local h = e:get(Health) end");
+  };
+  for (auto i = 0; i < 999; ++i) {
+    r.emplace<Health>(r.create());
+  }
+  lua["each"] = [&r](const sol::variadic_args &args, const sol::this_state s) {
+    eachEntity(r, args, s);
+  };
+  BENCHMARK("Lua: each over 1000 entities") {
+    return lua.script("each(Health, function(e, h) h.value = 1 end)");
+  };
+}
+
+TEST_CASE("Scripts benchmark", "[.benchmark]") {
+  auto lua = createState();
+  entt::registry r;
+  ScriptSystem::setup(r, lua);
+  const auto script = std::make_shared<ScriptResource>(kScript, "");
+
+  BENCHMARK("Spawn 1000 scripted entities") {
+    r.clear();
+    spawn(r, script, 1000);
+  };
+  // The cost of the compilation per instance (before the chunk cache).
+  BENCHMARK("Compile and run 1000 scripts") {
+    for (auto i = 0; i < 1000; ++i) {
+      std::ignore = lua.safe_script(kScript, getScriptContext(r).defaultEnv);
+    }
+  };
+}
+
+TEST_CASE("Script dispatch benchmark", "[.benchmark]") {
+  constexpr auto kNumEntities = 10'000;
+
+  auto lua = createState();
+  entt::registry r;
+  ScriptSystem::setup(r, lua);
+  const auto script = std::make_shared<ScriptResource>(kScript, "");
+  spawn(r, script, kNumEntities);
+  ScriptSystem::onUpdate(r, kTimeStep); // init.
+
+  BENCHMARK("10k scripts, batched") {
+    ScriptSystem::onUpdate(r, kTimeStep);
+  };
+
+  // A protected_function call per node (the previous dispatch).
+  std::vector<ScriptNode> nodes;
+  nodes.reserve(kNumEntities);
+  for (auto i = 0; i < kNumEntities; ++i) {
+    nodes.emplace_back(*getScriptContext(r).instantiate(script)).init();
+  }
+  BENCHMARK("10k scripts, per node") {
+    for (auto &node : nodes) {
+      node.update(kTimeStep);
+    }
+  };
+
+  r.clear();
+  spawn(r, std::make_shared<ScriptResource>(kEmptyScript, ""), kNumEntities);
+  ScriptSystem::onUpdate(r, kTimeStep);
+  BENCHMARK("10k scripts without hooks") {
+    ScriptSystem::onUpdate(r, kTimeStep);
+  };
+}
+
+TEST_CASE("Lua profiler benchmark", "[.benchmark]") {
+  auto lua = createState();
+  entt::registry r;
+  ScriptSystem::setup(r, lua);
+  spawn(r, std::make_shared<ScriptResource>(kScript, ""), 1000);
+  ScriptSystem::onUpdate(r, kTimeStep);
+
+  LuaProfiler profiler{lua};
+  BENCHMARK("1000 scripts, profiler disabled") {
+    ScriptSystem::onUpdate(r, kTimeStep);
+  };
+  profiler.start();
+  BENCHMARK("1000 scripts, profiler enabled") {
+    ScriptSystem::onUpdate(r, kTimeStep);
+  };
+  profiler.stop();
+
+  // Headless report (e.g. for a comparison between the runs).
+  std::ofstream{"ScriptSystemProfile.json"} << toJSON(profiler.getReport());
+}
+
+TEST_CASE("Garbage collector benchmark", "[.benchmark]") {
+  using enum GarbageCollector::Settings::Mode;
+
+  auto lua = createState();
+  entt::registry r;
+  ScriptSystem::setup(r, lua);
+  spawn(r, std::make_shared<ScriptResource>(kAllocatingScript, ""), 100);
+
+  auto &gc = getGarbageCollector(r);
+  BENCHMARK("Incremental (1 ms budget)") {
+    gc.setSettings({.mode = Incremental, .stepBudget = 1.0f});
+    ScriptSystem::onUpdate(r, kTimeStep);
+  };
+  BENCHMARK("Generational") {
+    gc.setSettings({.mode = Generational});
+    ScriptSystem::onUpdate(r, kTimeStep);
+  };
+  // A full collection every frame (the previous behavior).
+  BENCHMARK("Full collection") {
+    ScriptSystem::onUpdate(r, kTimeStep);
+    ScriptSystem::collectGarbage(r);
+  };
+}
+
+int main(int argc, char *argv[]) {
+  MetaComponent::registerMetaComponent<Health>();
+  LuaComponent::extendMetaType<Health>();
+  return Catch::Session{}.run(argc, argv);
+}
@@ -7,6 +7,7 @@
 #include "renderer/WorldRenderer.hpp"
 #include "audio/Device.hpp"
 #include "sol/state.hpp"
+#include "LuaProfiler.hpp"
 
 class App final : public ImGuiApp {
 public:
@@ -40,6 +41,7 @@ private:
   std::unique_ptr<audio::Device> m_audioDevice;
 
   sol::state m_luaState;
+  std::unique_ptr<LuaProfiler> m_luaProfiler;
 
   enum class DockSpaceSection {
     Left,
@@ -2,4 +2,4 @@
 
 #include "AudioClipManager.hpp"
 
-void show(const char *name, bool *open, AudioClipCache &);
+void show(const char *name, bool *open, AudioClipManager &);
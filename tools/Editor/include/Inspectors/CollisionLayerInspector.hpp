@@ -3,3 +3,4 @@
 #include "physics/CollisionLayer.hpp"
 
 bool inspect(CollisionLayer &);
+bool inspect(CollisionGroups &);
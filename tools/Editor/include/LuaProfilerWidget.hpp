@@ -0,0 +1,5 @@
+#pragma once
+
+#include "LuaProfiler.hpp"
+
+void showLuaProfilerWindow(const char *name, bool *open, LuaProfiler &);
@@ -128,6 +128,7 @@ private:
   void _onInspect(entt::handle, SkeletonComponent &) const;
   void _onInspect(entt::handle, AnimationComponent &) const;
   void _onInspect(entt::handle, PlaybackController &) const;
+  void _onInspect(entt::handle, AnimationLayers &) const;
 
   void _onInspect(entt::handle, CameraComponent &) const;
   void _onInspect(entt::handle, gfx::Light &) const;
@@ -157,6 +158,7 @@ private:
 
   bool m_passthroughInput{false};
   std::optional<Scene> m_playTest;
+  std::optional<PhysicsState> m_physicsSnapshot; // Of the m_playTest.
 
   RenderTargetPreview m_renderTargetPreview;
 
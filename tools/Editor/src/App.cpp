@@ -22,6 +22,7 @@
 
 #include "ImGuiModal.hpp"
 #include "GPUWidget.hpp"
+#include "LuaProfilerWidget.hpp"
 #include "WorldRendererWidget.hpp"
 #include "ProjectSettingsWidget.hpp"
 #include "imgui_internal.h" // DockBuilder
@@ -56,7 +57,7 @@ struct GUI {
   sol::state lua;
 
   using enum sol::lib;
-  lua.open_libraries(base, package, string, os, math, table);
+  lua.open_libraries(base, package, coroutine, string, os, math, table);
   tracy::LuaRegister(lua);
   registerModules(lua);
 
@@ -102,10 +103,13 @@ App::App(std::span<char *> args)
   Services::init(rd, *m_audioDevice);
   m_cubemapConverter = std::make_unique<gfx::CubemapConverter>(rd);
   m_renderer = std::make_unique<gfx::WorldRenderer>(*m_cubemapConverter);
+  m_renderer->setTextureStreamer(
+    &Services::Resources::Textures::value().getStreamer());
 
   m_luaState = createLuaState();
   m_luaState["GameWindow"] = std::ref(getWindow());
   m_luaState["InputSystem"] = std::ref(getInputSystem());
+  m_luaProfiler = std::make_unique<LuaProfiler>(m_luaState);
 
   _setupWidgets();
 
@@ -200,6 +204,11 @@ void App::_setupWidgets() {
     [this](const char *name, bool *open) {
       showWorldRendererWindow(name, open, *m_renderer);
     });
+  m_widgets.add<SimpleWidgetWindow>(
+    "Lua Profiler", {.name = ICON_FA_GAUGE " Lua Profiler", .open = false},
+    [this](const char *name, bool *open) {
+      showLuaProfilerWindow(name, open, *m_luaProfiler);
+    });
   m_widgets.add<ShapeCreatorWidget>("Shape Creator",
                                     {.name = "Shape Creator", .open = false});
 
@@ -508,6 +517,9 @@ void App::_onPreRender() {
 }
 void App::_onRender(rhi::CommandBuffer &cb, rhi::RenderTargetView rtv,
                     fsec dt) {
+  // Once per frame, before the widgets (scene viewports, material preview)
+  // draw and request texture mips (see: WorldRenderer::setTextureStreamer).
+  Services::Resources::Textures::value().getStreamer().update();
   INVOKE(m_widgets, onRender, cb, dt.count())
   drawGui(cb, rtv);
 }
@@ -1,6 +1,7 @@
 #include "AudioClipCache.hpp"
 #include "ImGuiDragAndDrop.hpp"
 #include "CacheInspector.hpp"
+#include "StringUtility.hpp" // formatBytes
 
 namespace {
 
@@ -42,18 +43,86 @@ void print(const audio::ClipInfo &info) {
   ImGui::BulletText("duration: %.2f sec", info.duration().count());
 }
 
+[[nodiscard]] const char *toString(const AudioClipResource::Residency v) {
+  switch (v) {
+    using enum AudioClipResource::Residency;
+
+  case Loading:
+    return "Loading";
+  case Decoded:
+    return "Decoded";
+  case Streamed:
+    return "Streamed";
+  case Compressed:
+    return "Compressed";
+  case Failed:
+    return "Failed";
+  }
+  assert(false);
+  return "Undefined";
+}
+
+void print(const AudioClipResource &r) {
+  print(r.getInfo());
+  ImGui::Separator();
+  ImGui::BulletText("Residency: %s", toString(r.getResidency()));
+  ImGui::BulletText("Memory: %s", formatBytes(r.getMemoryUsage()).c_str());
+}
+
+void showPolicyMenu(AudioClipManager &manager) {
+  auto policy = manager.getPolicy();
+  auto dirty = ImGui::MenuItem("Async", nullptr, &policy.async);
+  dirty |= ImGui::MenuItem("Keep compressed", nullptr, &policy.keepCompressed);
+  auto maxDecodedSize = uint32_t(policy.maxDecodedSize >> 10);
+  ImGui::SetNextItemWidth(100.0f);
+  if (ImGui::InputScalar("Max decoded (KiB)", ImGuiDataType_U32,
+                         &maxDecodedSize)) {
+    policy.maxDecodedSize = std::size_t(maxDecodedSize) << 10;
+    dirty = true;
+  }
+  auto budget = uint32_t(policy.memoryBudget >> 20);
+  ImGui::SetNextItemWidth(100.0f);
+  if (ImGui::InputScalar("Budget (MiB)", ImGuiDataType_U32, &budget)) {
+    policy.memoryBudget = std::size_t(budget) << 20;
+    dirty = true;
+  }
+  if (dirty) manager.setPolicy(policy);
+  if (ImGui::MenuItem("Trim")) manager.trim();
+
+  ImGui::Separator();
+
+  const auto stats = manager.getStats();
+  ImGui::BulletText("Clips: %u (loading: %u, streamed: %u)", stats.numClips,
+                    stats.numLoading, stats.numStreamed);
+  ImGui::BulletText("Memory: %s / %s", formatBytes(stats.memoryUsage).c_str(),
+                    formatBytes(policy.memoryBudget).c_str());
+  ImGui::BulletText("Evictions: %u", stats.numEvictions);
+}
+
 } // namespace
 
-void show(const char *name, bool *open, AudioClipCache &cache) {
+void show(const char *name, bool *open, AudioClipManager &cache) {
   if (ImGui::Begin(name, open, ImGuiWindowFlags_MenuBar)) {
-    defaultMenuBar(cache);
+    if (ImGui::BeginMenuBar()) {
+      if (ImGui::BeginMenu("Menu")) {
+        if (ImGui::MenuItem(ICON_FA_ERASER " Clear")) {
+          cache.clear();
+        }
+        ImGui::EndMenu();
+      }
+      if (ImGui::BeginMenu("Policy")) {
+        showPolicyMenu(cache);
+        ImGui::EndMenu();
+      }
+      ImGui::EndMenuBar();
+    }
     view(
       cache,
       [](auto id) {
         onDragSource(kImGuiPayloadTypeAudioClip, id,
                      [] { ImGui::Text("AudioClip inside ..."); });
       },
-      [](const auto &r) { print(r.getInfo()); }, std::nullopt);
+      [](const AudioClipResource &r) { print(r); }, std::nullopt);
   }
   ImGui::End();
 }
@@ -1,6 +1,7 @@
 #include "GPUWidget.hpp"
 #include "imgui.h"
 #include "IconsFontAwesome6.h"
+#include "StringUtility.hpp" // formatBytes
 #include <fstream>
 
 void showGPUWindow(const char *name, bool *open, const rhi::RenderDevice &rd) {
@@ -11,6 +12,10 @@ void showGPUWindow(const char *name, bool *open, const rhi::RenderDevice &rd) {
     ImGui::Text("DeviceID: %u", deviceId);
     ImGui::Text("DeviceName: %s", deviceName.data());
 
+    const auto [usage, budget] = rd.getMemoryBudget();
+    ImGui::Text("VRAM: %s / %s", formatBytes(usage).c_str(),
+                formatBytes(budget).c_str());
+
     ImGui::Spacing();
     ImGui::Separator();
     ImGui::Spacing();
@@ -1,6 +1,7 @@
 #include "Inspectors/CollisionLayerInspector.hpp"
 #include "ImGuiPopups.hpp"
 #include "imgui_internal.h" // {Push/Pop}ItemFlag
+#include "imgui_stdlib.h"   // InputText
 #include <bitset>
 #include <format>
 
@@ -58,3 +59,48 @@ bool inspect(CollisionLayer &layer) {
 
   return dirty;
 }
+
+bool inspect(CollisionGroups &groups) {
+  constexpr auto kNumGroups = CollisionGroups::kNumGroups;
+
+  auto dirty = false;
+  for (auto i = 0; i < kNumGroups; ++i) {
+    ImGui::PushID(i);
+    dirty |= ImGui::InputTextWithHint(std::format("Group {}", i).c_str(),
+                                      "Name", &groups.names[i]);
+    ImGui::PopID();
+  }
+
+  ImGui::Spacing();
+
+  // Lower triangle of the (symmetric) matrix.
+  constexpr auto kTableFlags =
+    ImGuiTableFlags_BordersInner | ImGuiTableFlags_SizingFixedFit;
+  if (ImGui::BeginTable(IM_UNIQUE_ID, kNumGroups + 1, kTableFlags)) {
+    ImGui::TableSetupColumn("");
+    for (auto j = 0; j < kNumGroups; ++j) {
+      ImGui::TableSetupColumn(std::format("{}", j).c_str());
+    }
+    ImGui::TableHeadersRow();
+
+    for (auto i = 0; i < kNumGroups; ++i) {
+      ImGui::TableNextRow();
+      ImGui::TableSetColumnIndex(0);
+      const auto &name = groups.names[i];
+      ImGui::TextUnformatted(name.empty() ? std::format("{}", i).c_str()
+                                          : name.c_str());
+      for (auto j = 0; j <= i; ++j) {
+        ImGui::TableSetColumnIndex(j + 1);
+        ImGui::PushID(i * kNumGroups + j);
+        if (auto collide = groups.canCollide(i, j);
+            ImGui::Checkbox("##collide", &collide)) {
+          groups.set(i, j, collide);
+          dirty = true;
+        }
+        ImGui::PopID();
+      }
+    }
+    ImGui::EndTable();
+  }
+  return dirty;
+}
@@ -0,0 +1,112 @@
+#include "LuaProfilerWidget.hpp"
+#include "IconsFontAwesome6.h"
+#include "imgui.h"
+#include <fstream>
+
+namespace {
+
+constexpr auto kMaxNumFunctions = 50;
+
+constexpr auto kTableFlags =
+  ImGuiTableFlags_BordersV | ImGuiTableFlags_BordersOuterH |
+  ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit |
+  ImGuiTableFlags_ScrollY;
+
+// Without the '@' (a file) or '=' prefix.
+[[nodiscard]] const char *getSourceName(const std::string &source) {
+  return source.empty() ? "" : source.c_str() + 1;
+}
+
+void showScripts(const LuaProfiler::Report &report) {
+  if (ImGui::BeginTable(IM_UNIQUE_ID, 4, kTableFlags, {0, 150})) {
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Script");
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableSetupColumn("Self [ms]");
+    ImGui::TableSetupColumn("%");
+    ImGui::TableHeadersRow();
+
+    for (const auto &[source, numCalls, selfTime] : report.scripts) {
+      ImGui::TableNextRow();
+      ImGui::TableSetColumnIndex(0);
+      ImGui::TextUnformatted(getSourceName(source));
+      ImGui::TableSetColumnIndex(1);
+      ImGui::Text("%u", numCalls);
+      ImGui::TableSetColumnIndex(2);
+      ImGui::Text("%.3f", selfTime.count());
+      ImGui::TableSetColumnIndex(3);
+      ImGui::Text("%.1f", report.duration.count() > 0
+                            ? 100.0 * selfTime / report.duration
+                            : 0.0);
+    }
+    ImGui::EndTable();
+  }
+}
+void showFunctions(const LuaProfiler::Report &report) {
+  if (ImGui::BeginTable(IM_UNIQUE_ID, 5, kTableFlags)) {
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Function");
+    ImGui::TableSetupColumn("Source");
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableSetupColumn("Self [ms]");
+    ImGui::TableSetupColumn("Total [ms]");
+    ImGui::TableHeadersRow();
+
+    auto count = 0;
+    for (const auto &fn : report.functions) {
+      if (count++ == kMaxNumFunctions) break;
+
+      ImGui::TableNextRow();
+      ImGui::TableSetColumnIndex(0);
+      ImGui::TextUnformatted(fn.name.empty() ? "?" : fn.name.c_str());
+      ImGui::TableSetColumnIndex(1);
+      if (fn.line < 0) {
+        ImGui::TextUnformatted("[C]");
+      } else {
+        ImGui::Text("%s:%d", getSourceName(fn.source), fn.line);
+      }
+      ImGui::TableSetColumnIndex(2);
+      ImGui::Text("%u", fn.numCalls);
+      ImGui::TableSetColumnIndex(3);
+      ImGui::Text("%.3f", fn.selfTime.count());
+      ImGui::TableSetColumnIndex(4);
+      ImGui::Text("%.3f", fn.totalTime.count());
+    }
+    ImGui::EndTable();
+  }
+}
+
+} // namespace
+
+void showLuaProfilerWindow(const char *name, bool *open,
+                           LuaProfiler &profiler) {
+  ZoneScopedN("LuaProfilerWindow");
+  if (ImGui::Begin(name, open)) {
+    if (profiler.isRunning()) {
+      if (ImGui::Button(ICON_FA_STOP " Stop")) profiler.stop();
+    } else {
+      if (ImGui::Button(ICON_FA_PLAY " Start")) profiler.start();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button(ICON_FA_ERASER " Reset")) profiler.reset();
+
+    const auto report = profiler.getReport();
+    ImGui::SameLine();
+    if (ImGui::Button(ICON_FA_FILE_EXPORT " Export")) {
+      if (auto f = std::ofstream{"LuaProfile.json"}; f.is_open()) {
+        f << toJSON(report);
+      }
+    }
+    ImGui::SameLine();
+    ImGui::Text("Duration: %.3f s", report.duration.count() / 1000.0);
+
+    ImGui::Spacing();
+    ImGui::SeparatorText("Scripts");
+    showScripts(report);
+
+    ImGui::Spacing();
+    ImGui::SeparatorText("Functions");
+    showFunctions(report);
+  }
+  ImGui::End();
+}
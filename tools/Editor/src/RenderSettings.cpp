@@ -42,6 +42,8 @@ void inspect(gfx::RenderFeatures &features) {
     FEATURE_CHECKBOX(FXAA);
     FEATURE_CHECKBOX(EyeAdaptation);
     FEATURE_CHECKBOX(CustomPostprocess);
+    FEATURE_CHECKBOX(MeshletCulling);
+    FEATURE_CHECKBOX(ComputeSkinning);
     ImGui::PopItemFlag();
 
     ImGui::EndCombo();
@@ -0,0 +1,80 @@
+#include "SceneEditor/SceneEditor.hpp"
+#include "Services.hpp"
+#include "Inspectors/ResourceInspector.hpp"
+#include "IconsFontAwesome6.h"
+#include "ImGuiPopups.hpp"
+#include "ImGuiDragAndDrop.hpp"
+#include "ImGuiHelper.hpp"
+
+#include <optional>
+
+namespace {
+
+constexpr auto kCrossFadeDuration = 0.25f;
+
+} // namespace
+
+void SceneEditor::_onInspect(entt::handle h,
+                             AnimationLayers &animationLayers) const {
+  std::optional<std::size_t> toRemove;
+
+  for (auto i = 0u; i < animationLayers.size(); ++i) {
+    auto &layer = animationLayers.getLayer(i);
+    const auto resource = std::dynamic_pointer_cast<Resource>(layer.animation);
+
+    ImGui::PushID(int(i));
+    const auto treeOpened =
+      ImGui::TreeNode(&layer, ICON_FA_PERSON_WALKING " [%u] %s", i,
+                      resource ? toString(*resource).c_str() : "(none)");
+
+    if (ImGui::BeginDragDropTarget()) {
+      if (auto incomingResource = extractResourceFromPayload(
+            kImGuiPayloadTypeAnimation,
+            Services::Resources::Animations::value());
+          incomingResource) {
+        if (auto r = incomingResource->handle(); layer.animation != r) {
+          layer.animation = std::move(r);
+        }
+      }
+      ImGui::EndDragDropTarget();
+    }
+    attachPopup(IM_UNIQUE_ID, ImGuiMouseButton_Right,
+                [&animationLayers, &toRemove, i] {
+                  if (ImGui::MenuItem(ICON_FA_SHUFFLE " Cross-fade")) {
+                    animationLayers.crossFade(i, kCrossFadeDuration);
+                  }
+                  if (ImGui::MenuItem(ICON_FA_TRASH " Remove")) toRemove = i;
+                });
+
+    if (treeOpened) {
+      ImGui::ComboEx("Mode", layer.mode,
+                     "Override\0"
+                     "Additive\0"
+                     "\0");
+      if (auto f = layer.weight; ImGui::SliderFloat("Weight", &f, 0.0f, 1.0f)) {
+        animationLayers.fadeTo(i, f, 0.0f);
+      }
+      if (layer.mask.empty()) {
+        ImGui::TextUnformatted("Mask: (none)");
+      } else {
+        ImGui::Text("Mask: %zu joints", layer.mask.size());
+        ImGui::SameLine();
+        if (ImGui::SmallButton(ICON_FA_ERASER)) layer.mask.clear();
+      }
+      _onInspect(h, layer.controller);
+      ImGui::TreePop();
+    }
+    ImGui::PopID();
+  }
+  if (toRemove) animationLayers.removeLayer(*toRemove);
+
+  if (ImGui::Button(ICON_FA_PLUS " Add layer")) {
+    animationLayers.addLayer(nullptr);
+  }
+  ImGui::SameLine();
+  ImGui::SetNextItemWidth(100);
+  if (auto f = animationLayers.getThreshold();
+      ImGui::SliderFloat("Threshold", &f, 0.0f, 1.0f)) {
+    animationLayers.setThreshold(f);
+  }
+}
@@ -8,6 +8,13 @@
 #include "ImGuiPopups.hpp"
 #include "ImGuiDragAndDrop.hpp"
 
+namespace {
+
+constexpr uint8_t kMinPriority{0};
+constexpr uint8_t kMaxPriority{255};
+
+} // namespace
+
 void SceneEditor::_onInspect(entt::handle, SoundSourceComponent &c) const {
   const auto resource = c.getClip();
   print(resource.get());
@@ -33,4 +40,11 @@ void SceneEditor::_onInspect(entt::handle, SoundSourceComponent &c) const {
   ImGui::Spacing();
 
   inspect(c);
+
+  if (auto v = c.getPriority();
+      ImGui::SliderScalar("priority", ImGuiDataType_U8, &v, &kMinPriority,
+                          &kMaxPriority)) {
+    c.setPriority(v);
+  }
+  ImGui::Text("Voice: %s", c.isReal() ? "real" : "virtual");
 }
@@ -5,16 +5,19 @@
 #include "Inspectors/CameraInspector.hpp"
 #include "Inspectors/SkyLightInspector.hpp"
 #include "Inspectors/PostProcessEffectInspector.hpp"
+#include "Inspectors/CollisionLayerInspector.hpp"
 
 #include "ImGuiTitleBarMacro.hpp"
 #include "ImGuiModal.hpp"
 #include "ImGuiDragAndDrop.hpp"
+#include "ImGuiHelper.hpp" // ComboEx
 #include "imgui_internal.h" // DockBuilder, MenuItemEx
 
 #include "FileDialog.hpp"
 #include "TexturePreview.hpp"
 
 #include "RenderSettings.hpp"
+#include "StringUtility.hpp" // formatBytes
 
 #include "RmlUi/Core.h"
 
@@ -138,6 +141,26 @@ void inspect(PhysicsWorld &physicsWorld) {
     physicsWorld.setGravity(v);
   }
 
+  ImGui::Spacing();
+  ImGui::SeparatorText("Simulation");
+
+  auto stepSettings = physicsWorld.getStepSettings();
+  constexpr auto kMinSteps = 1u;
+  constexpr auto kMaxSteps = 8u;
+  dirty = ImGui::SliderScalar("Collision steps", ImGuiDataType_U32,
+                              &stepSettings.collisionSteps, &kMinSteps,
+                              &kMaxSteps);
+  dirty |= ImGui::DragFloat("Max step size", &stepSettings.maxStepSize,
+                            0.001f, 0.0f, 0.1f, "%.4f s");
+  if (dirty) physicsWorld.setStepSettings(stepSettings);
+
+  ImGui::Spacing();
+  ImGui::SeparatorText("Collision groups");
+
+  if (auto groups = physicsWorld.getCollisionGroups(); inspect(groups)) {
+    physicsWorld.setCollisionGroups(groups);
+  }
+
   ImGui::Spacing();
   ImGui::SeparatorText("Stats");
 
@@ -164,6 +187,11 @@ void inspect(PhysicsWorld &physicsWorld) {
 
     ImGui::EndTable();
   }
+
+  const auto [capacity, highWaterMark, numOverflows] =
+    physicsWorld.getTempAllocatorStats();
+  ImGui::Text("Temp allocator: %u / %u KB (peak), %u overflow(s)",
+              highWaterMark / 1024, capacity / 1024, numOverflows);
 }
 
 [[nodiscard]] bool inspect(const char *label,
@@ -202,6 +230,65 @@ void inspect(AudioWorld &world) {
   }
 
   if (dirty) world.setSettings(settings);
+
+  ImGui::Spacing();
+  ImGui::SeparatorText("Voices");
+
+  auto voiceSettings = world.getVoiceSettings();
+  constexpr auto kMinVoices = 1u;
+  constexpr auto kMaxVoices = 255u;
+  dirty = ImGui::SliderScalar("maxNumVoices", ImGuiDataType_U32,
+                              &voiceSettings.maxNumVoices, &kMinVoices,
+                              &kMaxVoices);
+  dirty |= ImGui::DragFloat("minAudibility", &voiceSettings.minAudibility,
+                            0.0001f, 0.0f, 1.0f, "%.4f",
+                            ImGuiSliderFlags_AlwaysClamp);
+  if (dirty) world.setVoiceSettings(voiceSettings);
+
+  const auto [numAudible, numReal, numVirtualized, numRealized] =
+    world.getVoiceStats();
+  ImGui::Text("Real: %u / %u audible (+%u, -%u)", numReal, numAudible,
+              numRealized, numVirtualized);
+}
+
+void inspect(GarbageCollector &gc, entt::registry &r) {
+  auto settings = gc.getSettings();
+  auto dirty = ImGui::ComboEx("mode", settings.mode,
+                              "Incremental\0"
+                              "Generational\0"
+                              "\0");
+  dirty |= ImGui::SliderFloat("stepBudget (ms)", &settings.stepBudget, 0.0f,
+                              4.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
+  dirty |= ImGui::InputScalar("stepSize (KB)", ImGuiDataType_U32,
+                              &settings.stepSize);
+  if (dirty) gc.setSettings(settings);
+
+  if (ImGui::Button("Collect")) ScriptSystem::collectGarbage(r);
+
+  const auto &stats = gc.getStats();
+  ImGui::Text("Heap: %s", formatBytes(stats.heapSize).c_str());
+  ImGui::Text("Time: %.3f ms (steps: %u)", stats.time.count(),
+              stats.numSteps);
+  ImGui::Text("Cycles: %u, full: %u", stats.numCycles,
+              stats.numFullCollects);
+}
+
+void inspect(AnimationLODSettings &settings) {
+  ImGui::Checkbox("enabled", &settings.enabled);
+  ImGui::BeginDisabled(!settings.enabled);
+  ImGui::SliderFloat("fullRateScreenSize", &settings.fullRateScreenSize,
+                     0.01f, 1.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
+  constexpr auto kZero = 0u;
+  constexpr auto kOne = 1u;
+  constexpr auto kMaxInterval = 60u;
+  ImGui::SliderScalar("maxInterval", ImGuiDataType_U32, &settings.maxInterval,
+                      &kOne, &kMaxInterval);
+  ImGui::SliderScalar("offscreenInterval", ImGuiDataType_U32,
+                      &settings.offscreenInterval, &kZero, &kMaxInterval);
+  ImGui::Checkbox("interpolate", &settings.interpolate);
+  ImGui::InputScalar("maxUpdatesPerFrame", ImGuiDataType_U32,
+                     &settings.maxUpdatesPerFrame);
+  ImGui::EndDisabled();
 }
 
 void inspect(SceneEditor::Viewport &viewport, gfx::WorldRenderer &renderer) {
@@ -344,6 +431,9 @@ void showComponentsMenuItems(entt::handle h) {
     if (ImGui::MenuItemEx("Controller", ICON_FA_CLAPPERBOARD)) {
       h.emplace_or_replace<PlaybackController>();
     }
+    if (ImGui::MenuItemEx("Layers", ICON_FA_LAYER_GROUP)) {
+      h.emplace_or_replace<AnimationLayers>();
+    }
 
     ImGui::EndMenu();
   }
@@ -613,7 +703,8 @@ void SceneEditor::onUpdate(float dt) {
   m_dispatcher.update();
   if (m_playTest) {
     auto &r = m_playTest->getRegistry();
-    AnimationSystem::update(r, dt);
+    const auto *mainCamera = getMainCameraComponent(r);
+    AnimationSystem::update(r, dt, mainCamera ? &mainCamera->camera : nullptr);
     AudioSystem::update(r, dt);
     ScriptSystem::onUpdate(r, dt);
     UISystem::update(r);
@@ -772,12 +863,28 @@ void SceneEditor::_menuBar() {
     if (ImGui::MenuItem(ICON_FA_PLAY " Play", nullptr, nullptr,
                         hasScene && !m_playTest)) {
       m_playTest.emplace(activeEntry->scene);
+      // Restart = rewind the physics (without copying the scene again).
+      m_physicsSnapshot = PhysicsSystem::saveState(m_playTest->getRegistry());
     }
     if (ImGui::MenuItem(ICON_FA_STOP " Stop", nullptr, nullptr,
                         m_playTest.has_value())) {
       m_playTest = std::nullopt;
+      m_physicsSnapshot = std::nullopt;
       m_passthroughInput = false;
     }
+    if (ImGui::BeginMenu(ICON_FA_CAMERA " Snapshot", m_playTest.has_value())) {
+      auto &r = m_playTest->getRegistry();
+      if (ImGui::MenuItem("Save physics state")) {
+        m_physicsSnapshot = PhysicsSystem::saveState(r);
+      }
+      if (ImGui::MenuItem(ICON_FA_CLOCK_ROTATE_LEFT " Restore physics state",
+                          nullptr, nullptr, m_physicsSnapshot.has_value()) &&
+          !PhysicsSystem::restoreState(r, *m_physicsSnapshot)) {
+        SPDLOG_WARN("The physics snapshot doesn't match the scene.");
+        m_physicsSnapshot = std::nullopt;
+      }
+      ImGui::EndMenu();
+    }
 
     ImGui::EndMenuBar();
   }
@@ -864,6 +971,12 @@ void SceneEditor::_showConfigWidget(Entry &e) {
     if (ImGui::CollapsingHeader("Audio")) {
       ImGui::Frame([&r] { inspect(getAudioWorld(r)); });
     }
+    if (ImGui::CollapsingHeader("Animation LOD")) {
+      ImGui::Frame([&r] { inspect(getAnimationLODSettings(r)); });
+    }
+    if (ImGui::CollapsingHeader("Garbage collector")) {
+      ImGui::Frame([&r] { inspect(getGarbageCollector(r), r); });
+    }
     if (ImGui::CollapsingHeader("Bounds")) {
       ImGui::Frame([&r] { inspect(r.ctx().get<AABB>()); });
     }
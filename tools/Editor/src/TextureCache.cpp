@@ -4,10 +4,12 @@
 #include "ImGuiDragAndDrop.hpp"
 #include "ImGuiModal.hpp"
 #include "ImGuiPopups.hpp"
+#include "StringUtility.hpp" // formatBytes
 
 namespace {
 
-void print(const rhi::Texture &texture) {
+void print(const rhi::Texture &texture,
+           std::optional<gfx::TextureStreamer::Residency> residency) {
   assert(texture);
 
   ImGui::BulletText("Type: %s", toString(texture.getType()));
@@ -17,9 +19,40 @@ void print(const rhi::Texture &texture) {
                     texture.getDepth());
   ImGui::BulletText("Mip levels: %u", texture.getNumMipLevels());
   ImGui::BulletText("Layers: %u", texture.getNumLayers());
+  if (residency) {
+    ImGui::BulletText("Streamed: mip %u (desired: %u) of %u",
+                      residency->firstLevel, residency->desiredLevel,
+                      residency->numLevels);
+  }
+}
+
+void showStreamingMenu(gfx::TextureStreamer &streamer) {
+  auto settings = streamer.getSettings();
+  auto dirty = ImGui::MenuItem("Enabled", nullptr, &settings.enabled);
+  auto budget = uint32_t(settings.budget >> 20);
+  ImGui::SetNextItemWidth(100.0f);
+  if (ImGui::InputScalar("Budget (MiB)", ImGuiDataType_U32, &budget)) {
+    settings.budget = uint64_t(budget) << 20;
+    dirty = true;
+  }
+  ImGui::SetNextItemWidth(100.0f);
+  dirty |= ImGui::SliderFloat("Mip bias", &settings.mipBias, -2.0f, 2.0f);
+  if (dirty) streamer.setSettings(settings);
+
+  ImGui::Separator();
+
+  const auto &stats = streamer.getStats();
+  ImGui::BulletText("Textures: %u (pending: %u)", stats.numTextures,
+                    stats.numPending);
+  ImGui::BulletText("Resident: %s / %s",
+                    formatBytes(stats.residentBytes).c_str(),
+                    formatBytes(stats.fullBytes).c_str());
+  ImGui::BulletText("Budget: %s", formatBytes(stats.budget).c_str());
+  ImGui::BulletText("Evictions: %u", stats.numEvictions);
+  ImGui::BulletText("Over budget: %u", stats.numOverBudget);
 }
 
-void view(gfx::TextureCache &cache, float windowWidth, float thumbnailSize) {
+void view(gfx::TextureManager &cache, float windowWidth, float thumbnailSize) {
   if (cache.empty()) {
     ImGui::Text("(empty)");
     return;
@@ -44,7 +77,8 @@ void view(gfx::TextureCache &cache, float windowWidth, float thumbnailSize) {
       ImGui::PrintPath(path);
 
       ImGui::Separator();
-      print(*resource);
+      print(*resource,
+            cache.getStreamer().getResidency(resource.handle().get()));
 
       ImGui::EndTooltip();
     }
@@ -96,6 +130,10 @@ void show(const char *name, bool *open, gfx::TextureManager &cache) {
         }
         ImGui::EndMenu();
       }
+      if (ImGui::BeginMenu("Streaming")) {
+        showStreamingMenu(cache.getStreamer());
+        ImGui::EndMenu();
+      }
       ImGui::EndMenuBar();
     }
 
@@ -2,6 +2,11 @@
 
 #include "assimp/scene.h"
 #include "assimp/Exporter.hpp"
+#include <filesystem>
+
+// Export properties (besides the flags):
+// - "threadPool" (callback): returns a ThreadPool *, used for LOD generation.
+// - "perSourceOutputDir" (bool): see OutputLayout (Batch.hpp).
 
 void supernovaMeshExportFunction(const char *filePath, Assimp::IOSystem *,
                                  const aiScene *,
@@ -0,0 +1,220 @@
+#include "Batch.hpp"
+
+#include <fstream>
+#include <algorithm> // sort, equal
+#include <format>
+
+namespace {
+
+constexpr auto kOutputDirName = "out";
+constexpr auto kSourceHashFileName = "source.hash";
+
+[[nodiscard]] std::string trim(std::string_view str) {
+  constexpr auto kWhitespace = " \t\r\n";
+  const auto first = str.find_first_not_of(kWhitespace);
+  if (first == std::string_view::npos) return {};
+  const auto last = str.find_last_not_of(kWhitespace);
+  return std::string{str.substr(first, last - first + 1)};
+}
+
+[[nodiscard]] bool isSupported(const std::filesystem::path &p,
+                               const Assimp::Importer &importer) {
+  return std::filesystem::is_regular_file(p) &&
+         importer.IsExtensionSupported(p.extension().string());
+}
+
+[[nodiscard]] std::expected<std::vector<std::filesystem::path>, std::string>
+readManifest(const std::filesystem::path &p, const Assimp::Importer &importer) {
+  std::ifstream f{p};
+  if (!f.is_open()) {
+    return std::unexpected{std::format("Could not open: '{}'", p.string())};
+  }
+  const auto dir = p.parent_path();
+  std::vector<std::filesystem::path> out;
+  for (std::string line; std::getline(f, line);) {
+    line = trim(line);
+    if (line.empty() || line.starts_with('#')) continue;
+
+    auto source = (dir / line).lexically_normal();
+    if (!isSupported(source, importer)) {
+      return std::unexpected{
+        std::format("Unsupported or missing file: '{}'", source.string())};
+    }
+    out.emplace_back(std::move(source));
+  }
+  return out;
+}
+[[nodiscard]] std::vector<std::filesystem::path>
+scanDirectory(const std::filesystem::path &dir,
+              const Assimp::Importer &importer) {
+  std::vector<std::filesystem::path> out;
+  for (auto it = std::filesystem::recursive_directory_iterator{dir};
+       it != std::filesystem::recursive_directory_iterator{}; ++it) {
+    if (it->is_directory() && it->path().filename() == kOutputDirName) {
+      it.disable_recursion_pending();
+    } else if (isSupported(it->path(), importer)) {
+      out.emplace_back(it->path().lexically_normal());
+    }
+  }
+  return out;
+}
+
+// FNV-1a (64 bit), stable across runs and platforms (unlike std::hash).
+class Hasher {
+public:
+  void update(std::string_view data) {
+    for (const auto c : data) {
+      m_value ^= uint8_t(c);
+      m_value *= 0x100000001b3ull;
+    }
+  }
+  [[nodiscard]] bool updateFile(const std::filesystem::path &p) {
+    std::ifstream f{p, std::ios::binary};
+    if (!f.is_open()) return false;
+
+    std::vector<char> chunk(64 << 10);
+    while (f.read(chunk.data(), chunk.size()) || f.gcount() > 0) {
+      update({chunk.data(), std::size_t(f.gcount())});
+    }
+    return true;
+  }
+
+  [[nodiscard]] uint64_t getValue() const { return m_value; }
+
+private:
+  uint64_t m_value{0xcbf29ce484222325ull};
+};
+
+[[nodiscard]] std::optional<uint64_t>
+calcSourceHash(std::string_view settings,
+               std::span<const std::filesystem::path> sources) {
+  Hasher hasher;
+  hasher.update(settings);
+  for (const auto &p : sources) {
+    hasher.update(p.generic_string());
+    if (!hasher.updateFile(p)) return std::nullopt;
+  }
+  return hasher.getValue();
+}
+
+[[nodiscard]] std::vector<std::filesystem::path>
+listFiles(const std::filesystem::path &dir) {
+  std::vector<std::filesystem::path> out;
+  for (const auto &entry : std::filesystem::recursive_directory_iterator{dir}) {
+    if (entry.is_regular_file()) {
+      out.emplace_back(entry.path().lexically_relative(dir));
+    }
+  }
+  std::ranges::sort(out);
+  return out;
+}
+[[nodiscard]] bool compareFiles(const std::filesystem::path &a,
+                                const std::filesystem::path &b) {
+  if (std::filesystem::file_size(a) != std::filesystem::file_size(b)) {
+    return false;
+  }
+  std::ifstream fa{a, std::ios::binary};
+  std::ifstream fb{b, std::ios::binary};
+  return std::equal(std::istreambuf_iterator<char>{fa},
+                    std::istreambuf_iterator<char>{},
+                    std::istreambuf_iterator<char>{fb});
+}
+
+} // namespace
+
+std::filesystem::path getOutputDir(const std::filesystem::path &source,
+                                   const OutputLayout layout) {
+  auto dir = source.parent_path() / kOutputDirName;
+  if (layout == OutputLayout::PerSource) dir /= source.stem();
+  return dir;
+}
+
+std::expected<std::vector<std::filesystem::path>, std::string>
+collectInputs(const std::filesystem::path &p,
+              const Assimp::Importer &importer) {
+  std::vector<std::filesystem::path> out;
+  if (std::filesystem::is_directory(p)) {
+    out = scanDirectory(p, importer);
+  } else if (p.extension() == ".txt") {
+    auto manifest = readManifest(p, importer);
+    if (!manifest) return std::unexpected{std::move(manifest.error())};
+    out = std::move(*manifest);
+  } else {
+    out.emplace_back(p);
+  }
+  std::ranges::sort(out);
+  const auto [first, last] = std::ranges::unique(out);
+  out.erase(first, last);
+  return out;
+}
+
+//
+// RecordingIOSystem class:
+//
+
+Assimp::IOStream *RecordingIOSystem::Open(const char *file,
+                                          const char *mode) {
+  auto *stream = DefaultIOSystem::Open(file, mode);
+  if (stream) {
+    std::scoped_lock lock{m_mutex};
+    const std::filesystem::path p{file};
+    m_openedFiles.emplace(std::filesystem::absolute(p).lexically_normal());
+  }
+  return stream;
+}
+std::vector<std::filesystem::path> RecordingIOSystem::getOpenedFiles() const {
+  std::scoped_lock lock{m_mutex};
+  return std::vector(m_openedFiles.cbegin(), m_openedFiles.cend());
+}
+
+//
+// Source hash:
+//
+
+bool isUpToDate(const std::filesystem::path &outputDir,
+                std::string_view settings) {
+  // 1st line: hash, then the source files (one per line).
+  std::ifstream f{outputDir / kSourceHashFileName};
+  if (!f.is_open()) return false;
+
+  std::string line;
+  if (!std::getline(f, line)) return false;
+  const auto expected = line;
+
+  std::vector<std::filesystem::path> sources;
+  while (std::getline(f, line)) {
+    if (!line.empty()) sources.emplace_back(line);
+  }
+  if (sources.empty()) return false;
+
+  const auto hash = calcSourceHash(settings, sources);
+  return hash && std::format("{:016x}", *hash) == expected;
+}
+void writeSourceHash(const std::filesystem::path &outputDir,
+                     std::string_view settings,
+                     std::span<const std::filesystem::path> sources) {
+  const auto hash = calcSourceHash(settings, sources);
+  if (!hash) return;
+
+  if (std::ofstream f{outputDir / kSourceHashFileName}; f.is_open()) {
+    f << std::format("{:016x}", *hash) << '\n';
+    for (const auto &p : sources) {
+      f << p.generic_string() << '\n';
+    }
+  }
+}
+
+std::optional<std::filesystem::path>
+compareDirectories(const std::filesystem::path &a,
+                   const std::filesystem::path &b) {
+  const auto filesA = listFiles(a);
+  const auto filesB = listFiles(b);
+  if (const auto [itA, itB] = std::ranges::mismatch(filesA, filesB);
+      itA != filesA.cend() || itB != filesB.cend()) {
+    return itA != filesA.cend() ? *itA : *itB;
+  }
+  for (const auto &p : filesA) {
+    if (!compareFiles(a / p, b / p)) return p;
+  }
+  return std::nullopt;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "assimp/DefaultIOSystem.h"
+#include "assimp/Importer.hpp"
+
+#include <filesystem>
+#include <expected>
+#include <optional>
+#include <mutex>
+#include <set>
+#include <span>
+
+enum class OutputLayout {
+  Shared,    // <dir>/out (a single source file).
+  PerSource, // <dir>/out/<stem> (a directory or a manifest).
+};
+// @return The directory with all files generated from the given source.
+[[nodiscard]] std::filesystem::path
+getOutputDir(const std::filesystem::path &source, const OutputLayout);
+
+// @param p A source file, a directory (recursive, skips output directories)
+// or a manifest (.txt, one path per line, relative to the manifest).
+// @return Sorted list of (supported by the importer) source files.
+[[nodiscard]] std::expected<std::vector<std::filesystem::path>, std::string>
+collectInputs(const std::filesystem::path &p, const Assimp::Importer &);
+
+// Records every file opened by the importer (e.g. .gltf + .bin, .obj + .mtl).
+class RecordingIOSystem final : public Assimp::DefaultIOSystem {
+public:
+  Assimp::IOStream *Open(const char *file, const char *mode) override;
+
+  [[nodiscard]] std::vector<std::filesystem::path> getOpenedFiles() const;
+
+private:
+  mutable std::mutex m_mutex;
+  std::set<std::filesystem::path> m_openedFiles;
+};
+
+// Content hash of the source files (and the settings), stored next to the
+// converted files.
+
+// @return true if none of the sources (nor the settings) has changed since
+// the last conversion.
+[[nodiscard]] bool isUpToDate(const std::filesystem::path &outputDir,
+                              std::string_view settings);
+void writeSourceHash(const std::filesystem::path &outputDir,
+                     std::string_view settings,
+                     std::span<const std::filesystem::path> sources);
+
+// @return The first (relative) path that differs, std::nullopt if both
+// directories have byte-identical content.
+[[nodiscard]] std::optional<std::filesystem::path>
+compareDirectories(const std::filesystem::path &a,
+                   const std::filesystem::path &b);
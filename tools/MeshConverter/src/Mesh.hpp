@@ -2,6 +2,7 @@
 
 #include "VertexBuffer.hpp"
 #include "SubMesh.hpp"
+#include "Meshlets.hpp"
 #include "aiStringHash.hpp"
 
 using aiInverseBindPoseMap =
@@ -22,14 +23,19 @@ struct Mesh {
   ByteBuffer::value_type *vertexAt(const SubMesh &, std::size_t offset = 0);
 
   VertexBuffer vertices;
+  // Quantized positions are relative to these bounds.
+  std::optional<AABB> positionBounds;
 
   uint32_t indexStride{0};
   IndicesList indices;
 
+  std::vector<Meshlet> meshlets;
+
   // In bytes
   struct BufferOffsets {
     std::size_t vertices{0};
     std::size_t indices{0};
+    std::size_t meshlets{0};
     std::size_t inverseBindPose{0};
   };
   BufferOffsets byteOffsets;
@@ -8,8 +8,10 @@
 #include "ozz/animation/runtime/skeleton_utils.h"
 
 #include "MaterialConverter.hpp"
+#include "VertexQuantization.hpp"
+#include "ThreadPool.hpp"
 
-#include "meshoptimizer.h"      // meshopt_simplify
+#include "meshoptimizer.h" // meshopt_simplify, meshopt_generateVertexRemap
 #include "glm/gtc/type_ptr.hpp" // value_ptr
 
 #include "math/json.hpp"
@@ -18,6 +20,7 @@
 
 #include <fstream> // ofstream
 #include <numeric> // accumulate
+#include <ranges>  // zip
 
 // https://github.com/assimp/assimp/blob/master/code/AssetLib/Obj/ObjExporter.cpp
 
@@ -65,6 +68,20 @@ void copy(const IndicesList &src, const offline::SubMesh::LOD &lod,
   std::copy(begin, end, std::back_inserter(dst));
 }
 
+// Without a pool: serial, in the calling thread.
+void forEach(ThreadPool *pool, std::size_t count, const auto &fn) {
+  if (!pool) {
+    for (auto i = 0u; i < count; ++i)
+      fn(i);
+    return;
+  }
+  ThreadPool::TaskGroup group;
+  for (auto i = 0u; i < count; ++i) {
+    pool->run(group, [&fn, i] { fn(i); });
+  }
+  pool->wait(group);
+}
+
 [[nodiscard]] auto toByteBuffer(const auto &src, std::size_t stride) {
   ByteBuffer out(stride * src.size());
   auto data = out.data();
@@ -106,6 +123,12 @@ void to_json(nlohmann::ordered_json &j, const SubMesh &in) {
     {"LOD", in.LODs},
     {"aabb", in.aabb},
   };
+  if (in.numMeshlets > 0) {
+    j["meshlets"] = {
+      {"offset", in.meshletOffset},
+      {"count", in.numMeshlets},
+    };
+  }
   if (in.material) {
     j.push_back({
       "material",
@@ -137,6 +160,16 @@ void to_json(nlohmann::ordered_json &j, const Mesh &in) {
       },
     },
   };
+  if (in.positionBounds) {
+    j["vertices"]["positionBounds"] = *in.positionBounds;
+  }
+  if (!in.meshlets.empty()) {
+    j["meshlets"] = {
+      {"byteOffset", in.byteOffsets.meshlets},
+      {"count", in.meshlets.size()},
+      {"stride", sizeof(offline::Meshlet)},
+    };
+  }
   if (!in.inverseBindPoseMap.empty()) {
     j["inverseBindPose"] = {
       {"byteOffset", in.byteOffsets.inverseBindPose},
@@ -151,7 +184,8 @@ void to_json(nlohmann::ordered_json &j, const Mesh &in) {
 // MeshExporter:
 //
 
-MeshExporter::MeshExporter(Flags flags) : m_flags{flags} {}
+MeshExporter::MeshExporter(Flags flags, ThreadPool *threadPool)
+    : m_flags{flags}, m_threadPool{threadPool} {}
 
 MeshExporter &MeshExporter::load(const aiScene *scene) {
   assert(scene);
@@ -173,7 +207,7 @@ MeshExporter &MeshExporter::load(const aiScene *scene) {
 }
 MeshExporter &MeshExporter::save(const std::filesystem::path &p) {
   const auto dir = p.parent_path();
-  std::filesystem::create_directory(dir);
+  std::filesystem::create_directories(dir); // out/<stem> in batch mode.
 
   _writeDataBuffer(dir);
   if (!bool(m_flags & Flags::IgnoreMaterials)) {
@@ -215,6 +249,7 @@ void MeshExporter::_processMeshes(std::span<aiMesh *> meshes,
     const auto &subMesh = _processMesh(*mesh, materials);
     expand(m_mesh.aabb, subMesh.aabb);
   }
+  if (bool(m_flags & Flags::GenerateLODs)) _generateLODs(3);
   if (m_runtimeSkeleton) {
     for (const auto *name : m_runtimeSkeleton->joint_names()) {
       m_mesh.inverseBindPoseMap.try_emplace(aiString{name});
@@ -226,6 +261,11 @@ void MeshExporter::_processMeshes(std::span<aiMesh *> meshes,
     // (For safety) LOD generation likely increased the number of indices.
     m_mesh.updateIndexStride();
   }
+  if (!m_mesh.meshlets.empty()) {
+    LOG_EX(info, "Meshlets: {}", m_mesh.meshlets.size());
+  }
+  // After LOD generation (meshopt_simplify requires float positions).
+  if (bool(m_flags & Flags::QuantizeVertices)) _quantizeVertices();
   _buildBufferOffsets();
 }
 void MeshExporter::_findVertexFormat(std::span<aiMesh *> meshes) {
@@ -278,6 +318,9 @@ MeshExporter::_processMesh(const aiMesh &mesh,
   }
   _fillVertexBuffer(mesh, subMesh);
   _fillIndexBuffer(mesh, subMesh);
+  _joinIdenticalVertices(subMesh);
+  // Reorders the LOD0 (simplification doesn't care about the order).
+  if (bool(m_flags & Flags::GenerateMeshlets)) _generateMeshlets(subMesh);
   return subMesh;
 }
 void MeshExporter::_buildBufferOffsets() {
@@ -291,9 +334,13 @@ void MeshExporter::_buildBufferOffsets() {
 
   const auto vertexBufferByteSize = m_mesh.vertices.buffer.size();
   const auto indexBufferByteSize = m_mesh.indexStride * numIndices;
+  const auto meshletsByteSize =
+    sizeof(offline::Meshlet) * m_mesh.meshlets.size();
   m_mesh.byteOffsets = {
     .indices = vertexBufferByteSize,
-    .inverseBindPose = vertexBufferByteSize + indexBufferByteSize,
+    .meshlets = vertexBufferByteSize + indexBufferByteSize,
+    .inverseBindPose =
+      vertexBufferByteSize + indexBufferByteSize + meshletsByteSize,
   };
 }
 
@@ -388,11 +435,65 @@ void MeshExporter::_fillIndexBuffer(const aiMesh &mesh,
     std::ranges::copy(MAKE_SPAN(face, Indices),
                       std::back_inserter(m_mesh.indices));
   }
-  if (bool(m_flags & Flags::GenerateLODs)) _generateLODs(subMesh, 3);
+}
+void MeshExporter::_joinIdenticalVertices(offline::SubMesh &subMesh) {
+  // Replaces aiProcess_JoinIdenticalVertices (hashes whole vertices, after
+  // the joints and weights are assigned).
+  assert(&subMesh == &m_mesh.subMeshes.back());
+  const auto &baseLevel = subMesh.LODs.front();
+  auto *indices = m_mesh.indices.data() + baseLevel.indexOffset;
+  auto *vertices = m_mesh.vertexAt(subMesh);
+  const auto stride = m_mesh.vertices.getStride();
+
+  std::vector<uint32_t> remap(subMesh.numVertices);
+  const auto numVertices = meshopt_generateVertexRemap(
+    remap.data(), indices, baseLevel.numIndices, vertices, subMesh.numVertices,
+    stride);
+  if (numVertices == subMesh.numVertices) return;
+
+  meshopt_remapIndexBuffer(indices, indices, baseLevel.numIndices,
+                           remap.data());
+  meshopt_remapVertexBuffer(vertices, vertices, subMesh.numVertices, stride,
+                            remap.data());
+  subMesh.numVertices = numVertices;
+  m_mesh.vertices.buffer.resize((subMesh.vertexOffset + numVertices) * stride);
 }
 
-void MeshExporter::_generateLODs(offline::SubMesh &subMesh,
-                                 std::size_t numLevels) {
+void MeshExporter::_generateLODs(std::size_t numLevels) {
+  std::vector<std::vector<IndicesList>> LODs(m_mesh.subMeshes.size());
+  forEach(m_threadPool, LODs.size(), [this, &LODs, numLevels](std::size_t i) {
+    LODs[i] = _simplify(m_mesh.subMeshes[i], numLevels);
+  });
+
+  // Rebuilds the index buffer in the submesh order (LODs right after the base
+  // level), so the output doesn't depend on the thread count.
+  auto numIndices = m_mesh.indices.size();
+  for (const auto &levels : LODs) {
+    for (const auto &level : levels)
+      numIndices += level.size();
+  }
+  IndicesList indices;
+  indices.reserve(numIndices);
+  for (auto [subMesh, levels] : std::views::zip(m_mesh.subMeshes, LODs)) {
+    auto &baseLevel = subMesh.LODs.front();
+    const auto indexOffset = indices.size();
+    copy(m_mesh.indices, baseLevel, indices);
+
+    const auto shift = uint32_t(indexOffset - baseLevel.indexOffset);
+    for (auto &meshlet : std::span{m_mesh.meshlets}.subspan(
+           subMesh.meshletOffset, subMesh.numMeshlets)) {
+      meshlet.indexOffset += shift;
+    }
+    baseLevel.indexOffset = indexOffset;
+    for (const auto &level : levels) {
+      subMesh.addLOD(indices, level);
+    }
+  }
+  m_mesh.indices = std::move(indices);
+}
+std::vector<IndicesList>
+MeshExporter::_simplify(const offline::SubMesh &subMesh,
+                        std::size_t numLevels) {
   const auto &baseLevel = subMesh.LODs.front();
 
   // https://github.com/zeux/meshoptimizer/blob/577c585eeb477e18902bd7f3d66bf33d89216cef/demo/main.cpp#L536
@@ -400,6 +501,8 @@ void MeshExporter::_generateLODs(offline::SubMesh &subMesh,
   std::vector<IndicesList> LODs(numLevels);
   copy(m_mesh.indices, baseLevel, LODs[0]);
 
+  std::vector<IndicesList> out; // Without the base level.
+
   const auto vertexStride = m_mesh.vertices.info.getStride();
   const auto *firstVertex = std::bit_cast<float *>(m_mesh.vertexAt(subMesh));
 
@@ -416,13 +519,33 @@ void MeshExporter::_generateLODs(offline::SubMesh &subMesh,
 
     currentLevel.resize(src.size());
     currentLevel.resize(meshopt_simplify(
-      &currentLevel[0], &src[0], src.size(), firstVertex, subMesh.numVertices,
-      vertexStride, targetIndexCount, kTargetError));
+      currentLevel.data(), src.data(), src.size(), firstVertex,
+      subMesh.numVertices, vertexStride, targetIndexCount, kTargetError));
 
-    if (currentLevel.size() != src.size()) {
-      subMesh.addLOD(m_mesh.indices, currentLevel);
-    }
+    if (currentLevel.size() != src.size()) out.push_back(currentLevel);
   }
+  return out;
+}
+
+void MeshExporter::_generateMeshlets(offline::SubMesh &subMesh) {
+  const auto &baseLevel = subMesh.LODs.front();
+  auto meshlets = offline::buildMeshlets(
+    std::span{m_mesh.indices}.subspan(baseLevel.indexOffset,
+                                      baseLevel.numIndices),
+    baseLevel.indexOffset, std::bit_cast<float *>(m_mesh.vertexAt(subMesh)),
+    subMesh.numVertices, m_mesh.vertices.getStride());
+
+  subMesh.meshletOffset = m_mesh.meshlets.size();
+  subMesh.numMeshlets = meshlets.size();
+  std::ranges::copy(meshlets, std::back_inserter(m_mesh.meshlets));
+}
+
+void MeshExporter::_quantizeVertices() {
+  const auto srcStride = m_mesh.vertices.getStride();
+  m_mesh.positionBounds = m_mesh.aabb;
+  m_mesh.vertices = quantize(m_mesh.vertices, *m_mesh.positionBounds);
+  LOG_EX(info, "Vertex stride: {} -> {} bytes", srcStride,
+         m_mesh.vertices.getStride());
 }
 
 bool MeshExporter::_writeDataBuffer(const std::filesystem::path &dir) const {
@@ -437,6 +560,7 @@ bool MeshExporter::_writeDataBuffer(const std::filesystem::path &dir) const {
 
   write(m_mesh.vertices.buffer);
   write(toByteBuffer(m_mesh.indices, m_mesh.indexStride));
+  write(m_mesh.meshlets);
   if (m_runtimeSkeleton) {
     write(makeInverseBindPose(*m_runtimeSkeleton, m_mesh.inverseBindPoseMap));
   }
@@ -3,14 +3,20 @@
 #include "Mesh.hpp"
 #include "AnimationConverter.hpp"
 
+class ThreadPool;
+
 class MeshExporter {
 public:
   enum class Flags {
     None = 0,
     IgnoreMaterials = 1 << 0,
     GenerateLODs = 1 << 1,
+    QuantizeVertices = 1 << 2,
+    GenerateMeshlets = 1 << 3,
   };
-  explicit MeshExporter(Flags);
+  // @param threadPool Optional, LOD generation runs in parallel (the output is
+  // the same as without it).
+  explicit MeshExporter(Flags, ThreadPool *threadPool = nullptr);
   MeshExporter(const MeshExporter &) = delete;
   MeshExporter &operator=(const MeshExporter &) = delete;
 
@@ -27,13 +33,19 @@ private:
 
   void _fillVertexBuffer(const aiMesh &, offline::SubMesh &);
   void _fillIndexBuffer(const aiMesh &, offline::SubMesh &);
-  void _generateLODs(offline::SubMesh &, std::size_t numLevels);
+  void _joinIdenticalVertices(offline::SubMesh &);
+  void _generateLODs(std::size_t numLevels);
+  [[nodiscard]] std::vector<IndicesList>
+  _simplify(const offline::SubMesh &, std::size_t numLevels);
+  void _generateMeshlets(offline::SubMesh &);
+  void _quantizeVertices();
 
   bool _writeDataBuffer(const std::filesystem::path &dir) const;
   bool _exportMeshMeta(const std::filesystem::path &p) const;
 
 private:
   Flags m_flags{Flags::None};
+  ThreadPool *m_threadPool{nullptr};
 
   struct Transforms {
     Transforms() = default;
@@ -0,0 +1,68 @@
+#include "Meshlets.hpp"
+
+#include "meshoptimizer.h"      // meshopt_buildMeshlets
+#include "glm/gtc/type_ptr.hpp" // make_vec3
+
+#include <algorithm> // copy
+#include <cassert>
+
+namespace offline {
+
+namespace {
+
+// https://github.com/zeux/meshoptimizer#clusterization
+constexpr auto kMaxVertices = 64u;
+constexpr auto kMaxTriangles = 124u;
+// Trades the spatial locality for tighter normal cones.
+constexpr auto kConeWeight = 0.25f;
+
+} // namespace
+
+std::vector<Meshlet> buildMeshlets(std::span<uint32_t> indices,
+                                   std::size_t indexOffset,
+                                   const float *positions,
+                                   std::size_t numVertices,
+                                   std::size_t vertexStride) {
+  assert(indices.size() % 3 == 0);
+
+  const auto maxMeshlets =
+    meshopt_buildMeshletsBound(indices.size(), kMaxVertices, kMaxTriangles);
+  std::vector<meshopt_Meshlet> meshlets(maxMeshlets);
+  std::vector<uint32_t> meshletVertices(maxMeshlets * kMaxVertices);
+  std::vector<uint8_t> meshletTriangles(maxMeshlets * kMaxTriangles * 3);
+
+  meshlets.resize(meshopt_buildMeshlets(
+    meshlets.data(), meshletVertices.data(), meshletTriangles.data(),
+    indices.data(), indices.size(), positions, numVertices, vertexStride,
+    kMaxVertices, kMaxTriangles, kConeWeight));
+
+  std::vector<Meshlet> out;
+  out.reserve(meshlets.size());
+  std::vector<uint32_t> reordered;
+  reordered.reserve(indices.size());
+
+  for (const auto &meshlet : meshlets) {
+    const auto *vertices = &meshletVertices[meshlet.vertex_offset];
+    const auto *triangles = &meshletTriangles[meshlet.triangle_offset];
+    const auto bounds = meshopt_computeMeshletBounds(
+      vertices, triangles, meshlet.triangle_count, positions, numVertices,
+      vertexStride);
+
+    out.push_back({
+      .center = glm::make_vec3(bounds.center),
+      .radius = bounds.radius,
+      .coneAxis = glm::make_vec3(bounds.cone_axis),
+      .coneCutoff = bounds.cone_cutoff,
+      .indexOffset = uint32_t(indexOffset + reordered.size()),
+      .numTriangles = meshlet.triangle_count,
+    });
+    for (auto i = 0u; i < meshlet.triangle_count * 3; ++i) {
+      reordered.push_back(vertices[triangles[i]]);
+    }
+  }
+  assert(reordered.size() == indices.size());
+  std::ranges::copy(reordered, indices.begin());
+  return out;
+}
+
+} // namespace offline
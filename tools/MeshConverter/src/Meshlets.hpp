@@ -0,0 +1,30 @@
+#pragma once
+
+#include "glm/ext/vector_float3.hpp"
+#include <span>
+#include <vector>
+
+namespace offline {
+
+// Matches gfx::Meshlet (WorldRenderer/include/renderer/Meshlet.hpp).
+struct alignas(16) Meshlet {
+  glm::vec3 center; // Bounding sphere.
+  float radius;
+  glm::vec3 coneAxis; // Normal cone.
+  float coneCutoff;
+  uint32_t indexOffset; // In the mesh index buffer.
+  uint32_t numTriangles;
+};
+static_assert(sizeof(Meshlet) == 48);
+
+// Splits a triangle list into clusters and reorders the indices, so each
+// meshlet covers a contiguous range.
+// @param indices Relative to the first vertex.
+// @param indexOffset Of the first index (in the mesh index buffer).
+// @param positions Float3 (the first attribute of a vertex).
+[[nodiscard]] std::vector<Meshlet>
+buildMeshlets(std::span<uint32_t> indices, std::size_t indexOffset,
+              const float *positions, std::size_t numVertices,
+              std::size_t vertexStride);
+
+} // namespace offline
@@ -22,6 +22,10 @@ struct SubMesh {
   std::vector<LOD> LODs;
   AABB aabb;
 
+  // Clusters of the LOD0 (see Mesh::meshlets).
+  std::size_t meshletOffset{0};
+  std::size_t numMeshlets{0};
+
   std::optional<offline::Material> material;
 };
 
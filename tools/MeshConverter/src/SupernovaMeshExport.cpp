@@ -1,5 +1,6 @@
 #include "SupernovaMeshExport.hpp"
 #include "MeshExporter.hpp"
+#include "Batch.hpp"
 #include "assimp/Exceptional.h"
 
 void supernovaMeshExportFunction(const char *filePath, Assimp::IOSystem *,
@@ -9,12 +10,17 @@ void supernovaMeshExportFunction(const char *filePath, Assimp::IOSystem *,
   if (!p.has_filename()) {
     throw DeadlyExportError{"Invalid path."};
   }
-  const auto outputDir = p.parent_path() / "out";
+  const auto layout =
+    properties && properties->GetPropertyBool("perSourceOutputDir")
+      ? OutputLayout::PerSource
+      : OutputLayout::Shared;
+  const auto outputDir = getOutputDir(p, layout);
   std::filesystem::remove_all(outputDir);
   const auto outputMeta = (outputDir / p.stem()).replace_extension("mesh");
 
   using enum MeshExporter::Flags;
   auto flags = None;
+  ThreadPool *threadPool{nullptr};
   if (properties) {
     if (properties->GetPropertyBool("ignoreMaterials")) {
       flags |= IgnoreMaterials;
@@ -22,6 +28,16 @@ void supernovaMeshExportFunction(const char *filePath, Assimp::IOSystem *,
     if (properties->GetPropertyBool("generateLODs")) {
       flags |= GenerateLODs;
     }
+    if (properties->GetPropertyBool("quantizeVertices")) {
+      flags |= QuantizeVertices;
+    }
+    if (properties->GetPropertyBool("generateMeshlets")) {
+      flags |= GenerateMeshlets;
+    }
+    if (const auto callback = properties->GetPropertyCallback("threadPool");
+        callback) {
+      threadPool = static_cast<ThreadPool *>(callback(nullptr));
+    }
   }
-  MeshExporter{flags}.load(scene).save(outputMeta);
+  MeshExporter{flags, threadPool}.load(scene).save(outputMeta);
 }
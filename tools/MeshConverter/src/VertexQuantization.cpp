@@ -0,0 +1,176 @@
+#include "VertexQuantization.hpp"
+
+#include "meshoptimizer.h" // meshopt_quantize*
+#include "glm/common.hpp"   // abs, max
+#include "glm/geometric.hpp" // normalize
+
+#include <algorithm> // max_element
+#include <array>
+#include <cstring> // memcpy
+#include <cassert>
+
+namespace {
+
+using Type = rhi::VertexAttribute::Type;
+
+template <typename T> [[nodiscard]] T read(const uint8_t *data) {
+  T v;
+  std::memcpy(&v, data, sizeof(T));
+  return v;
+}
+template <typename T, std::size_t N>
+void write(uint8_t *data, const std::array<T, N> &v) {
+  std::memcpy(data, v.data(), sizeof(T) * N);
+}
+
+[[nodiscard]] int32_t findMaxJoint(const VertexBuffer &vertices) {
+  const auto &attributes = vertices.info.getAttributes();
+  const auto it = attributes.find(gfx::AttributeLocation::Joints);
+  if (it == attributes.cend()) return 0;
+
+  const auto *data = vertices.buffer.data() + it->second.offset;
+  const auto stride = vertices.getStride();
+  int32_t maxJoint{0};
+  for (auto i = 0u; i < vertices.getNumVertices(); ++i) {
+    const auto joints = read<std::array<int32_t, 4>>(data + i * stride);
+    maxJoint = std::max(maxJoint, *std::ranges::max_element(joints));
+  }
+  return maxJoint;
+}
+
+[[nodiscard]] Type getQuantizedType(gfx::AttributeLocation location, Type type,
+                                    int32_t maxJoint) {
+  switch (location) {
+    using enum gfx::AttributeLocation;
+
+  case Position:
+    return type == Type::Float3 ? Type::UShort4_Norm : type;
+  case Normal:
+  case Tangent:
+  case Bitangent:
+    return type == Type::Float3 ? Type::Short2_Norm : type;
+  case TexCoord_0:
+  case TexCoord_1:
+    return type == Type::Float2 ? Type::Half2 : type;
+  case Color_0:
+  case Weights:
+    return type == Type::Float4 ? Type::UByte4_Norm : type;
+  case Joints:
+    return type == Type::Int4 && maxJoint <= UINT8_MAX ? Type::UByte4 : type;
+  }
+  return type;
+}
+
+// Rounding errors go to the largest weight, so the weights of a normalized
+// vertex still sum to 1 (255).
+[[nodiscard]] std::array<uint8_t, 4> quantizeWeights(const glm::vec4 &v) {
+  std::array<int32_t, 4> q;
+  for (auto i = 0; i < 4; ++i)
+    q[i] = meshopt_quantizeUnorm(v[i], 8);
+
+  const auto target = meshopt_quantizeUnorm(v.x + v.y + v.z + v.w, 8);
+  *std::ranges::max_element(q) += target - (q[0] + q[1] + q[2] + q[3]);
+  return {uint8_t(q[0]), uint8_t(q[1]), uint8_t(q[2]), uint8_t(q[3])};
+}
+
+void encode(gfx::AttributeLocation location, const uint8_t *in, Type srcType,
+            uint8_t *out, Type dstType, const AABB &bounds) {
+  switch (dstType) {
+  case Type::UShort4_Norm: {
+    const auto extent = glm::max(bounds.max - bounds.min,
+                                 glm::vec3{std::numeric_limits<float>::min()});
+    const auto v = (read<glm::vec3>(in) - bounds.min) / extent;
+    write(out, std::array{
+                 uint16_t(meshopt_quantizeUnorm(v.x, 16)),
+                 uint16_t(meshopt_quantizeUnorm(v.y, 16)),
+                 uint16_t(meshopt_quantizeUnorm(v.z, 16)),
+                 uint16_t{0},
+               });
+  } break;
+  case Type::Short2_Norm: {
+    const auto v = encodeOctahedral(read<glm::vec3>(in));
+    write(out, std::array{
+                 int16_t(meshopt_quantizeSnorm(v.x, 16)),
+                 int16_t(meshopt_quantizeSnorm(v.y, 16)),
+               });
+  } break;
+  case Type::Half2: {
+    const auto v = read<glm::vec2>(in);
+    write(out, std::array{
+                 meshopt_quantizeHalf(v.x),
+                 meshopt_quantizeHalf(v.y),
+               });
+  } break;
+  case Type::UByte4_Norm: {
+    const auto v = read<glm::vec4>(in);
+    if (location == gfx::AttributeLocation::Weights) {
+      write(out, quantizeWeights(v));
+    } else {
+      write(out, std::array{
+                   uint8_t(meshopt_quantizeUnorm(v.r, 8)),
+                   uint8_t(meshopt_quantizeUnorm(v.g, 8)),
+                   uint8_t(meshopt_quantizeUnorm(v.b, 8)),
+                   uint8_t(meshopt_quantizeUnorm(v.a, 8)),
+                 });
+    }
+  } break;
+  case Type::UByte4: {
+    // Unused slots (-1) have a zero weight.
+    const auto v = glm::max(read<glm::ivec4>(in), glm::ivec4{0});
+    write(out, std::array{uint8_t(v.x), uint8_t(v.y), uint8_t(v.z),
+                          uint8_t(v.w)});
+  } break;
+
+  default:
+    assert(srcType == dstType);
+    std::memcpy(out, in, rhi::getSize(srcType));
+    break;
+  }
+}
+
+} // namespace
+
+glm::vec2 encodeOctahedral(const glm::vec3 &n) {
+  const auto sum = glm::abs(n.x) + glm::abs(n.y) + glm::abs(n.z);
+  if (sum == 0.0f) return glm::vec2{0.0f};
+
+  auto v = glm::vec2{n} / sum;
+  if (n.z < 0.0f) {
+    v = (1.0f - glm::abs(glm::vec2{v.y, v.x})) *
+        glm::vec2{v.x >= 0.0f ? 1.0f : -1.0f, v.y >= 0.0f ? 1.0f : -1.0f};
+  }
+  return v;
+}
+glm::vec3 decodeOctahedral(const glm::vec2 &e) {
+  glm::vec3 v{e, 1.0f - glm::abs(e.x) - glm::abs(e.y)};
+  const auto t = glm::max(-v.z, 0.0f);
+  v.x += v.x >= 0.0f ? -t : t;
+  v.y += v.y >= 0.0f ? -t : t;
+  return glm::normalize(v);
+}
+
+VertexBuffer quantize(const VertexBuffer &src, const AABB &positionBounds) {
+  const auto maxJoint = findMaxJoint(src);
+
+  VertexInfo::Builder builder;
+  for (const auto &[location, attribute] : src.info.getAttributes()) {
+    builder.add(location, getQuantizedType(location, attribute.type, maxJoint));
+  }
+
+  const auto numVertices = src.getNumVertices();
+  VertexBuffer dst{.info = builder.build()};
+  dst.reserve(numVertices);
+  std::ignore = dst.insert(numVertices);
+
+  const auto &dstAttributes = dst.info.getAttributes();
+  for (auto i = 0u; i < numVertices; ++i) {
+    const auto *in = src.buffer.data() + i * src.getStride();
+    auto *out = dst.at(i);
+    for (const auto &[location, attribute] : src.info.getAttributes()) {
+      const auto &dstAttribute = dstAttributes.at(location);
+      encode(location, in + attribute.offset, attribute.type,
+             out + dstAttribute.offset, dstAttribute.type, positionBounds);
+    }
+  }
+  return dst;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "VertexBuffer.hpp"
+#include "math/AABB.hpp"
+#include "glm/ext/vector_float2.hpp"
+
+// https://knarkowicz.wordpress.com/2014/04/16/octahedron-normal-vector-encoding/
+// Matches _decodeOctahedral (WorldRenderer/shaders/VertexAttributes.glsl).
+
+[[nodiscard]] glm::vec2 encodeOctahedral(const glm::vec3 &);
+[[nodiscard]] glm::vec3 decodeOctahedral(const glm::vec2 &);
+
+// @param src Vertices with the default (32 bit) attribute types.
+// @param positionBounds Encloses all positions.
+// @return Vertices with:
+// - Position: UShort4_Norm (within positionBounds).
+// - Normal, Tangent, Bitangent: Short2_Norm (octahedral).
+// - TexCoord_0, TexCoord_1: Half2.
+// - Color_0, Weights: UByte4_Norm.
+// - Joints: UByte4 (unless there is more than 256 joints).
+[[nodiscard]] VertexBuffer quantize(const VertexBuffer &src,
+                                    const AABB &positionBounds);
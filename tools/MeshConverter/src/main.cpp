@@ -7,10 +7,15 @@
 #include "PrintSceneStats.hpp"
 #include "ExtraAnimations.hpp"
 #include "SupernovaMeshExport.hpp"
+#include "ThreadPool.hpp"
+#include "Batch.hpp"
 
 #include "spdlog/spdlog.h"
 
 #include <expected>
+#include <format>
+#include <map>
+#include <thread> // hardware_concurrency
 
 namespace {
 
@@ -46,11 +51,15 @@ private:
   clock::time_point m_start;
 };
 
+// Bump when the output changes, to invalidate the source hashes.
+constexpr auto kConverterVersion = 1;
+
 class App {
 public:
   App() {
     m_program.add_argument("input")
-      .help("Input resource file")
+      .help("Input resource file, a directory (converts all supported files) "
+            "or a manifest (.txt, one path per line)")
       .metavar("RESOURCE_PATH")
       .required();
 
@@ -103,11 +112,38 @@ public:
     m_program.add_argument("--generate-lods")
       .default_value(false)
       .implicit_value(true);
+    m_program.add_argument("--quantize")
+      .help("Compact vertex attributes (16 bit positions, octahedral normals, "
+            "half float texture coordinates, 8 bit joints and weights)")
+      .default_value(false)
+      .implicit_value(true);
+    m_program.add_argument("--generate-meshlets")
+      .help("Split meshes into clusters for GPU culling")
+      .default_value(false)
+      .implicit_value(true);
+
+    // ---
+
+    // Batch mode:
+
+    m_program.add_argument("-j", "--jobs")
+      .help("Number of worker threads (0 = the main thread only)")
+      .default_value(std::thread::hardware_concurrency())
+      .scan<'u', uint32_t>();
+    m_program.add_argument("--incremental")
+      .help("Skips files that haven't changed since the last conversion")
+      .default_value(false)
+      .implicit_value(true);
+    m_program.add_argument("--check-determinism")
+      .help("Converts each file again (serially) and compares the output")
+      .default_value(false)
+      .implicit_value(true);
 
     // ---
 
     m_program.add_argument("--extra-animations")
-      .help("Load extra animations separated into multiple files")
+      .help("Load extra animations separated into multiple files (a single "
+            "input file only)")
       .metavar("RELATIVE_PATH")
       .remaining();
 
@@ -132,41 +168,174 @@ public:
       Assimp::DefaultLogger::set(m_logger.get());
     }
 
-    if (const auto time = _load(resourcePath); time) {
-      m_logger->info("Import time: ", *time);
-    } else {
-      std::cerr << "Importer error: " << time.error() << std::endl;
+    const auto inputs = collectInputs(resourcePath, Assimp::Importer{});
+    if (!inputs) {
+      std::cerr << inputs.error() << std::endl;
+      return -1;
+    }
+    if (inputs->empty()) {
+      std::cerr << "Nothing to convert." << std::endl;
+      return -1;
+    }
+    if (inputs->size() > 1 && m_program.present("--extra-animations")) {
+      std::cerr << "--extra-animations requires a single input file."
+                << std::endl;
+      return -1;
+    }
+
+    m_settings = _makeSettingsKey();
+    // The layout doesn't depend on the number of files found (a directory
+    // with a single source is still converted to out/<stem>).
+    m_outputLayout = std::filesystem::is_directory(resourcePath) ||
+                         resourcePath.extension() == ".txt"
+                       ? OutputLayout::PerSource
+                       : OutputLayout::Shared;
+
+    Stopwatch stopwatch;
+    std::vector<Status> results(inputs->size(), Status::OutputConflict);
+    {
+      ThreadPool threadPool{m_program.get<uint32_t>("--jobs")};
+      ThreadPool::TaskGroup group;
+      // Sources that differ only in the extension (e.g. model.fbx and
+      // model.gltf) would be exported to the same directory.
+      std::map<std::filesystem::path, std::filesystem::path> outputDirs;
+      for (auto i = 0u; i < inputs->size(); ++i) {
+        const auto &p = (*inputs)[i];
+        const auto [it, inserted] =
+          outputDirs.emplace(getOutputDir(p, m_outputLayout), p);
+        if (!inserted) {
+          spdlog::error("'{}' has the same output directory as '{}'.",
+                        p.string(), it->second.string());
+          continue;
+        }
+        threadPool.run(group, [this, &threadPool, &p, &result = results[i]] {
+          result = _convert(p, threadPool);
+        });
+      }
+      threadPool.wait(group);
+    }
+
+    if (inputs->size() > 1) {
+      const auto count = [&results](Status status) {
+        return std::size_t(std::ranges::count(results, status));
+      };
+      const auto numConverted = count(Status::Converted);
+      const auto numUpToDate = count(Status::UpToDate);
+      spdlog::info("Converted: {}, up to date: {}, failed: {} ({})",
+                   numConverted, numUpToDate,
+                   results.size() - numConverted - numUpToDate,
+                   stopwatch.count());
+    }
+    for (const auto status : results) {
+      if (const auto code = toExitCode(status); code != 0) return code;
+    }
+    return 0;
+  }
+
+private:
+  enum class Status {
+    Converted,
+    UpToDate,
+    ImportError,
+    ExportError,
+    NotDeterministic,
+    OutputConflict,
+  };
+  [[nodiscard]] static int32_t toExitCode(Status status) {
+    switch (status) {
+      using enum Status;
+    case Converted:
+    case UpToDate:
+      return 0;
+    case ImportError:
       return -2;
+    case ExportError:
+      return -3;
+    case NotDeterministic:
+      return -4;
+    case OutputConflict:
+      return -5;
+    }
+    return -1;
+  }
+
+  // Everything (besides the sources) that affects the output.
+  [[nodiscard]] std::string _makeSettingsKey() const {
+    auto key = std::format("v{};pp={}", kConverterVersion,
+                           _getPostProcessingFlags(m_program));
+    if (const auto transform = getTransform(m_program); transform) {
+      for (auto c = 0; c < 4; ++c)
+        for (auto r = 0; r < 4; ++r)
+          key += std::format(";{}", (*transform)[c][r]);
+    }
+    for (const auto *name : {"--ignore-materials", "--generate-lods",
+                             "--quantize", "--generate-meshlets"}) {
+      key += std::format(";{}={}", name, m_program.get<bool>(name));
+    }
+    if (m_program.present("--extra-animations")) {
+      for (const auto &name :
+           m_program.get<std::vector<std::string>>("--extra-animations")) {
+        key += std::format(";{}", name);
+      }
+    }
+    return key;
+  }
+
+  // Thread-safe (a local importer, m_program and m_settings are read-only).
+  [[nodiscard]] Status _convert(const std::filesystem::path &p,
+                                ThreadPool &threadPool) const {
+    const auto incremental = m_program.get<bool>("--incremental");
+    const auto outputDir = getOutputDir(p, m_outputLayout);
+    if (incremental && isUpToDate(outputDir, m_settings)) {
+      spdlog::info("'{}' is up to date.", p.string());
+      return Status::UpToDate;
     }
 
-    auto masterScene = std::unique_ptr<aiScene>(m_importer.GetOrphanedScene());
+    Assimp::Importer importer;
+    auto *ioSystem = new RecordingIOSystem;
+    importer.SetIOHandler(ioSystem); // Takes ownership.
+
+    if (const auto time = _load(importer, p); time) {
+      m_logger->info("Import time (", p.filename().string(), "): ", *time);
+    } else {
+      spdlog::error("'{}' importer error: {}", p.string(), time.error());
+      return Status::ImportError;
+    }
+
+    auto masterScene = std::unique_ptr<aiScene>(importer.GetOrphanedScene());
 
     if (m_program.present("--extra-animations")) {
       auto animations = loadExtraAnimations(
-        m_importer, resourcePath.parent_path(),
+        importer, p.parent_path(),
         m_program.get<std::vector<std::string>>("--extra-animations"));
       copyAnimations(masterScene.get(), animations);
     }
     if (m_program["--stats"] == true) std::cout << *masterScene;
 
-    if (const auto time = _export(resourcePath, *masterScene); time) {
-      m_logger->info("Export time: ", *time);
+    if (const auto time = _export(p, *masterScene, &threadPool); time) {
+      m_logger->info("Export time (", p.filename().string(), "): ", *time);
     } else {
-      std::cerr << "Exporter error: " << time.error() << std::endl;
-      return -3;
+      spdlog::error("'{}' exporter error: {}", p.string(), time.error());
+      return Status::ExportError;
     }
 
-    return 0;
+    if (m_program["--check-determinism"] == true &&
+        !_checkDeterminism(p, *masterScene)) {
+      return Status::NotDeterministic;
+    }
+    if (incremental) {
+      writeSourceHash(outputDir, m_settings, ioSystem->getOpenedFiles());
+    }
+    return Status::Converted;
   }
 
-private:
   std::expected<std::chrono::milliseconds, std::string>
-  _load(const std::filesystem::path &p) {
+  _load(Assimp::Importer &importer, const std::filesystem::path &p) const {
     Stopwatch stopwatch;
 
-    const auto scene = m_importer.ReadFile(p.string(), 0);
+    const auto scene = importer.ReadFile(p.string(), 0);
     if (!scene) {
-      return std::unexpected{m_importer.GetErrorString()};
+      return std::unexpected{importer.GetErrorString()};
     }
     if (const auto transform = getTransform(m_program); transform) {
       m_logger->info("Applying transform");
@@ -177,11 +346,12 @@ private:
     // - Right-handed coordinate space.
     // - Face winding order is counter clockwise (CCW).
 
+    // Identical vertices are joined by the exporter (meshoptimizer, hash based
+    // instead of the slow aiProcess_JoinIdenticalVertices).
     auto flags = _getPostProcessingFlags(m_program);
     flags |= aiProcess_Triangulate;
-    flags |= aiProcess_JoinIdenticalVertices; // Slow
     flags |= aiProcess_FlipUVs;
-    m_importer.ApplyPostProcessing(flags);
+    importer.ApplyPostProcessing(flags);
 
     return stopwatch.count();
   }
@@ -200,8 +370,10 @@ private:
     return flags;
   }
 
+  // @param threadPool nullptr = serial.
   std::expected<std::chrono::milliseconds, std::string>
-  _export(const std::filesystem::path &p, const aiScene &scene) {
+  _export(const std::filesystem::path &p, const aiScene &scene,
+          ThreadPool *threadPool) const {
     Stopwatch stopwatch;
 
     Assimp::Exporter exporter;
@@ -213,6 +385,16 @@ private:
                                m_program.get<bool>("--ignore-materials"));
     properties.SetPropertyBool("generateLODs",
                                m_program.get<bool>("--generate-lods"));
+    properties.SetPropertyBool("quantizeVertices",
+                               m_program.get<bool>("--quantize"));
+    properties.SetPropertyBool("generateMeshlets",
+                               m_program.get<bool>("--generate-meshlets"));
+    properties.SetPropertyBool("perSourceOutputDir",
+                               m_outputLayout == OutputLayout::PerSource);
+    if (threadPool) {
+      properties.SetPropertyCallback(
+        "threadPool", [threadPool](void *) -> void * { return threadPool; });
+    }
 
     if (exporter.Export(&scene, "sne", p.string(), 0, &properties) !=
         AI_SUCCESS) {
@@ -220,10 +402,38 @@ private:
     }
     return stopwatch.count();
   }
+  // Exports the scene again (serially, to a temporary directory) and compares
+  // the output with the (parallel) one.
+  [[nodiscard]] bool _checkDeterminism(const std::filesystem::path &p,
+                                       const aiScene &scene) const {
+    const auto scratchDir =
+      std::filesystem::temp_directory_path() / "MeshConverter" /
+      std::format("{:x}", std::hash<std::string>{}(p.string()));
+    std::filesystem::remove_all(scratchDir);
+    std::filesystem::create_directories(scratchDir);
+
+    const auto scratchFile = scratchDir / p.filename();
+    auto passed = false;
+    if (const auto time = _export(scratchFile, scene, nullptr); !time) {
+      spdlog::error("'{}' exporter error (serial): {}", p.string(),
+                    time.error());
+    } else if (const auto diff = compareDirectories(
+                 getOutputDir(p, m_outputLayout),
+                 getOutputDir(scratchFile, m_outputLayout));
+               diff) {
+      spdlog::error("'{}' the parallel and serial outputs differ: '{}'",
+                    p.string(), diff->generic_string());
+    } else {
+      passed = true;
+    }
+    std::filesystem::remove_all(scratchDir);
+    return passed;
+  }
 
 private:
   argparse::ArgumentParser m_program;
-  Assimp::Importer m_importer;
+  std::string m_settings;
+  OutputLayout m_outputLayout{OutputLayout::Shared};
   std::unique_ptr<CustomLogger> m_logger;
 };
 
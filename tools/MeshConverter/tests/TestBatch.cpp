@@ -0,0 +1,57 @@
+#include "catch.hpp"
+
+#include "Batch.hpp"
+#include <fstream>
+
+namespace {
+
+void writeFile(const std::filesystem::path &p, std::string_view content) {
+  std::filesystem::create_directories(p.parent_path());
+  std::ofstream{p, std::ios::binary} << content;
+}
+
+// A single triangle.
+constexpr auto kObj = "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+
+} // namespace
+
+TEST_CASE("Folder with many sources") {
+  const auto dir =
+    std::filesystem::temp_directory_path() / "MeshConverterTestBatch";
+  std::filesystem::remove_all(dir);
+  writeFile(dir / "a.obj", kObj);
+  writeFile(dir / "b.obj", kObj);
+  writeFile(dir / "props/c.obj", kObj);
+  // Converted by a previous run (skipped).
+  writeFile(dir / "out/a/a.obj", kObj);
+
+  const auto inputs = collectInputs(dir, Assimp::Importer{});
+  REQUIRE(inputs);
+  REQUIRE(inputs->size() == 3);
+
+  SECTION("Output directories") {
+    using enum OutputLayout;
+    const auto &a = (*inputs)[0];
+    const auto &b = (*inputs)[1];
+    REQUIRE(getOutputDir(a, Shared) == getOutputDir(b, Shared));
+    REQUIRE(getOutputDir(a, PerSource) == dir / "out" / "a");
+    REQUIRE(getOutputDir(b, PerSource) == dir / "out" / "b");
+  }
+  SECTION("Determinism check") {
+    // Parallel (in place) and serial (scratch) outputs of the same source.
+    for (const auto *name : {"a", "b"}) {
+      writeFile(dir / "out" / name / "data.bin", name);
+      writeFile(dir / "scratch/out" / name / "data.bin", name);
+    }
+    REQUIRE_FALSE(compareDirectories(dir / "out/a", dir / "scratch/out/a"));
+    REQUIRE_FALSE(compareDirectories(dir / "out/b", dir / "scratch/out/b"));
+    // Only the output of a given source is compared.
+    writeFile(dir / "out/b/extra.bin", "b");
+    REQUIRE_FALSE(compareDirectories(dir / "out/a", dir / "scratch/out/a"));
+    REQUIRE(compareDirectories(dir / "out/b", dir / "scratch/out/b") ==
+            std::filesystem::path{"extra.bin"});
+  }
+  std::filesystem::remove_all(dir);
+}
+
+int main(int argc, char *argv[]) { return Catch::Session{}.run(argc, argv); }
@@ -0,0 +1,216 @@
+#include "catch.hpp"
+
+#include "VertexQuantization.hpp"
+#include "glm/common.hpp"       // max
+#include "glm/geometric.hpp"    // dot, normalize
+#include "glm/gtc/packing.hpp"  // unpackHalf1x16
+#include "glm/gtc/type_ptr.hpp" // value_ptr
+
+#include <cstring>
+#include <random>
+
+namespace {
+
+using enum gfx::AttributeLocation;
+
+constexpr auto kNumVertices = 1000u;
+constexpr auto kNumJoints = 60;
+
+const AABB kBounds{
+  .min = glm::vec3{-2.5f, 0.0f, -1.0f},
+  .max = glm::vec3{3.0f, 7.5f, 1.0f},
+};
+
+struct Vertex {
+  glm::vec3 position;
+  glm::vec4 color;
+  glm::vec3 normal;
+  glm::vec2 texCoord0;
+  glm::vec3 tangent;
+  glm::vec3 bitangent;
+  glm::vec2 texCoord1;
+  glm::ivec4 joints;
+  glm::vec4 weights;
+};
+
+[[nodiscard]] std::vector<Vertex> makeVertices() {
+  std::mt19937 rng{1337};
+  std::uniform_real_distribution<float> unit{0.0f, 1.0f};
+  std::uniform_real_distribution<float> snorm{-1.0f, 1.0f};
+  std::uniform_real_distribution<float> uv{-4.0f, 4.0f};
+  std::uniform_int_distribution<int32_t> joint{0, kNumJoints - 1};
+
+  const auto randomDirection = [&] {
+    glm::vec3 v;
+    do {
+      v = {snorm(rng), snorm(rng), snorm(rng)};
+    } while (glm::dot(v, v) < 1e-4f);
+    return glm::normalize(v);
+  };
+
+  std::vector<Vertex> vertices(kNumVertices);
+  for (auto &v : vertices) {
+    v.position = kBounds.min + glm::vec3{unit(rng), unit(rng), unit(rng)} *
+                                 (kBounds.max - kBounds.min);
+    v.color = {unit(rng), unit(rng), unit(rng), unit(rng)};
+    v.normal = randomDirection();
+    v.texCoord0 = {uv(rng), uv(rng)};
+    v.tangent = randomDirection();
+    v.bitangent = randomDirection();
+    v.texCoord1 = {unit(rng), unit(rng)};
+    v.joints = {joint(rng), joint(rng), joint(rng), -1};
+    v.weights = {unit(rng), unit(rng), unit(rng), 0.0f};
+    v.weights /= v.weights.x + v.weights.y + v.weights.z;
+  }
+  return vertices;
+}
+
+// The same layout as MeshExporter::_findVertexFormat.
+[[nodiscard]] VertexBuffer makeVertexBuffer(std::span<const Vertex> in) {
+  using enum rhi::VertexAttribute::Type;
+
+  VertexInfo::Builder builder;
+  builder.add(Position, Float3)
+    .add(Color_0, Float4)
+    .add(Normal, Float3)
+    .add(TexCoord_0, Float2)
+    .add(Tangent, Float3)
+    .add(Bitangent, Float3)
+    .add(TexCoord_1, Float2)
+    .add(Joints, Int4)
+    .add(Weights, Float4);
+
+  VertexBuffer out{.info = builder.build()};
+  std::ignore = out.insert(in.size());
+  for (auto i = 0u; i < in.size(); ++i) {
+    const auto copy = [&](gfx::AttributeLocation location, const auto &value) {
+      std::memcpy(out.at(i) + out.info.getAttribute(location).offset,
+                  glm::value_ptr(value), sizeof(value));
+    };
+    const auto &v = in[i];
+    copy(Position, v.position);
+    copy(Color_0, v.color);
+    copy(Normal, v.normal);
+    copy(TexCoord_0, v.texCoord0);
+    copy(Tangent, v.tangent);
+    copy(Bitangent, v.bitangent);
+    copy(TexCoord_1, v.texCoord1);
+    copy(Joints, v.joints);
+    copy(Weights, v.weights);
+  }
+  return out;
+}
+
+template <typename T, std::size_t N>
+[[nodiscard]] auto read(VertexBuffer &vertices, std::size_t index,
+                        gfx::AttributeLocation location) {
+  std::array<T, N> v;
+  std::memcpy(v.data(),
+              vertices.at(index) + vertices.info.getAttribute(location).offset,
+              sizeof(v));
+  return v;
+}
+
+[[nodiscard]] glm::vec3 decodeNormal(const std::array<int16_t, 2> &q) {
+  const auto snorm = [](int16_t v) { return glm::max(v / 32767.0f, -1.0f); };
+  return decodeOctahedral({snorm(q[0]), snorm(q[1])});
+}
+
+} // namespace
+
+TEST_CASE("Octahedral round trip") {
+  const glm::vec3 kDirections[]{
+    {1.0f, 0.0f, 0.0f},  {-1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f},
+    {0.0f, -1.0f, 0.0f}, {0.0f, 0.0f, 1.0f},  {0.0f, 0.0f, -1.0f},
+  };
+  for (const auto &n : kDirections) {
+    REQUIRE(glm::dot(decodeOctahedral(encodeOctahedral(n)), n) >= 0.99999f);
+  }
+}
+
+TEST_CASE("Quantized attributes") {
+  const auto vertices = makeVertices();
+  const auto src = makeVertexBuffer(vertices);
+  auto dst = quantize(src, kBounds);
+
+  REQUIRE(dst.getNumVertices() == src.getNumVertices());
+
+  SECTION("Types") {
+    using enum rhi::VertexAttribute::Type;
+    const auto typeOf = [&dst](gfx::AttributeLocation location) {
+      return dst.info.getAttribute(location).type;
+    };
+    CHECK(typeOf(Position) == UShort4_Norm);
+    CHECK(typeOf(Color_0) == UByte4_Norm);
+    CHECK(typeOf(Normal) == Short2_Norm);
+    CHECK(typeOf(TexCoord_0) == Half2);
+    CHECK(typeOf(Tangent) == Short2_Norm);
+    CHECK(typeOf(Bitangent) == Short2_Norm);
+    CHECK(typeOf(TexCoord_1) == Half2);
+    CHECK(typeOf(Joints) == UByte4);
+    CHECK(typeOf(Weights) == UByte4_Norm);
+  }
+  SECTION("Size") {
+    INFO("Vertex stride: " << src.getStride() << " -> " << dst.getStride());
+    CHECK(src.getStride() == 112);
+    CHECK(dst.getStride() == 40);
+    CHECK(dst.buffer.size() * 2 < src.buffer.size());
+  }
+  SECTION("Error bounds") {
+    const auto extent = kBounds.max - kBounds.min;
+    // Half of the quantization step (+ float rounding).
+    const auto maxPositionError = extent / 65535.0f * 0.5f + 1e-5f;
+    // < 0.3 degree.
+    constexpr auto kMinNormalDot = 0.99999f;
+
+    for (auto i = 0u; i < kNumVertices; ++i) {
+      const auto &v = vertices[i];
+
+      const auto p = read<uint16_t, 4>(dst, i, Position);
+      const auto position =
+        kBounds.min + glm::vec3{p[0], p[1], p[2]} / 65535.0f * extent;
+      for (auto c = 0; c < 3; ++c)
+        REQUIRE(std::abs(position[c] - v.position[c]) <= maxPositionError[c]);
+
+      REQUIRE(glm::dot(decodeNormal(read<int16_t, 2>(dst, i, Normal)),
+                       v.normal) >= kMinNormalDot);
+      REQUIRE(glm::dot(decodeNormal(read<int16_t, 2>(dst, i, Tangent)),
+                       v.tangent) >= kMinNormalDot);
+      REQUIRE(glm::dot(decodeNormal(read<int16_t, 2>(dst, i, Bitangent)),
+                       v.bitangent) >= kMinNormalDot);
+
+      // 11 bits of precision (+ denormals).
+      const auto uv = read<uint16_t, 2>(dst, i, TexCoord_0);
+      for (auto c = 0; c < 2; ++c) {
+        REQUIRE(std::abs(glm::unpackHalf1x16(uv[c]) - v.texCoord0[c]) <=
+                std::abs(v.texCoord0[c]) / 2048.0f + 1e-7f);
+      }
+
+      const auto color = read<uint8_t, 4>(dst, i, Color_0);
+      for (auto c = 0; c < 4; ++c)
+        REQUIRE(std::abs(color[c] / 255.0f - v.color[c]) <= 0.5f / 255.0f);
+
+      const auto joints = read<uint8_t, 4>(dst, i, Joints);
+      for (auto c = 0; c < 3; ++c)
+        REQUIRE(joints[c] == v.joints[c]);
+
+      const auto weights = read<uint8_t, 4>(dst, i, Weights);
+      REQUIRE(weights[0] + weights[1] + weights[2] + weights[3] == 255);
+      // The largest weight absorbs rounding errors of the others.
+      for (auto c = 0; c < 4; ++c) {
+        REQUIRE(std::abs(weights[c] / 255.0f - v.weights[c]) <=
+                2.0f / 255.0f);
+      }
+    }
+  }
+}
+
+TEST_CASE("Joints that don't fit in a byte") {
+  auto vertices = makeVertices();
+  vertices.front().joints.x = 300;
+  const auto dst = quantize(makeVertexBuffer(vertices), kBounds);
+  REQUIRE(dst.info.getAttribute(Joints).type ==
+          rhi::VertexAttribute::Type::Int4);
+}
+
+int main(int argc, char *argv[]) { return Catch::Session{}.run(argc, argv); }
@@ -0,0 +1,219 @@
+#include "Cooker.hpp"
+#include "MipChain.hpp"
+#include "bc/BlockCompression.hpp"
+#include "bc/ImageQuality.hpp"
+#include "rhi/PixelFormat.hpp"
+
+#include "ktx.h"
+
+#include <algorithm> // max_element
+#include <thread>    // hardware_concurrency
+#include <cassert>
+
+namespace {
+
+[[nodiscard]] bool isBasisUniversal(TargetFormat format) {
+  return format == TargetFormat::UASTC || format == TargetFormat::ETC1S;
+}
+
+[[nodiscard]] bc::Format toBlockFormat(TargetFormat format) {
+  switch (format) {
+  case TargetFormat::BC1:
+    return bc::Format::BC1;
+  case TargetFormat::BC3:
+    return bc::Format::BC3;
+  case TargetFormat::BC4:
+    return bc::Format::BC4;
+  case TargetFormat::BC5:
+    return bc::Format::BC5;
+  case TargetFormat::BC6H:
+    return bc::Format::BC6H;
+  case TargetFormat::BC7:
+    return bc::Format::BC7;
+
+  default:
+    assert(false);
+    return bc::Format::BC7;
+  }
+}
+
+[[nodiscard]] rhi::PixelFormat getPixelFormat(TargetFormat format, bool sRGB) {
+  switch (format) {
+    using enum rhi::PixelFormat;
+
+  case TargetFormat::BC1:
+    return sRGB ? BC1_RGBA_sRGB : BC1_RGBA_UNorm;
+  case TargetFormat::BC3:
+    return sRGB ? BC3_sRGB : BC3_UNorm;
+  case TargetFormat::BC4:
+    return BC4_UNorm;
+  case TargetFormat::BC5:
+    return BC5_UNorm;
+  case TargetFormat::BC6H:
+    return BC6H_UFloat;
+  case TargetFormat::BC7:
+    return sRGB ? BC7_sRGB : BC7_UNorm;
+
+  // Basis Universal encoder input:
+  case TargetFormat::UASTC:
+  case TargetFormat::ETC1S:
+    return sRGB ? RGBA8_sRGB : RGBA8_UNorm;
+  }
+
+  assert(false);
+  return Undefined;
+}
+
+[[nodiscard]] uint32_t getNumChannels(bc::Format format) {
+  switch (format) {
+  case bc::Format::BC4:
+    return 1;
+  case bc::Format::BC5:
+    return 2;
+  case bc::Format::BC1:
+  case bc::Format::BC6H:
+    return 3;
+
+  default:
+    return 4;
+  }
+}
+
+[[nodiscard]] double calcPSNR(const Image &image, bc::Format format,
+                              std::span<const std::byte> blocks) {
+  std::vector<std::byte> decoded(image.pixels.size());
+  if (!bc::decode(format, blocks, image.width, image.height, decoded.data())) {
+    return 0.0;
+  }
+  const auto numChannels = getNumChannels(format);
+  if (image.hdr) {
+    const auto source = std::span{
+      reinterpret_cast<const float *>(image.pixels.data()),
+      image.pixels.size() / sizeof(float),
+    };
+    const auto peak = std::max(1.0f, *std::ranges::max_element(source));
+    return bc::calcPSNR(
+      source,
+      {reinterpret_cast<const float *>(decoded.data()), source.size()}, peak,
+      numChannels);
+  }
+  return bc::calcPSNR(
+    {reinterpret_cast<const uint8_t *>(image.pixels.data()),
+     image.pixels.size()},
+    {reinterpret_cast<const uint8_t *>(decoded.data()), decoded.size()},
+    numChannels);
+}
+
+struct Deleter {
+  void operator()(ktxTexture2 *texture) const {
+    ktxTexture_Destroy(ktxTexture(texture));
+  }
+};
+
+} // namespace
+
+std::optional<TargetFormat> parseTargetFormat(std::string_view str) {
+  constexpr std::pair<std::string_view, TargetFormat> kFormats[]{
+    {"bc1", TargetFormat::BC1},     {"bc3", TargetFormat::BC3},
+    {"bc4", TargetFormat::BC4},     {"bc5", TargetFormat::BC5},
+    {"bc6h", TargetFormat::BC6H},   {"bc7", TargetFormat::BC7},
+    {"uastc", TargetFormat::UASTC}, {"etc1s", TargetFormat::ETC1S},
+  };
+  for (const auto &[name, format] : kFormats) {
+    if (name == str) return format;
+  }
+  return std::nullopt;
+}
+
+std::expected<CookStats, std::string> cook(Image &&image,
+                                           const CookSettings &settings,
+                                           const std::filesystem::path &output) {
+  if (image.hdr != (settings.format == TargetFormat::BC6H)) {
+    return std::unexpected{image.hdr ? "HDR images require the bc6h format."
+                                     : "bc6h requires an HDR image."};
+  }
+  if (image.hdr && settings.sRGB) {
+    return std::unexpected{"HDR images can't be sRGB."};
+  }
+
+  auto levels = settings.generateMipmaps
+                  ? buildMipChain(std::move(image), settings.sRGB)
+                  : std::vector<Image>{};
+  if (levels.empty()) levels.emplace_back(std::move(image));
+
+  ktxTextureCreateInfo createInfo{};
+  createInfo.vkFormat =
+    ktx_uint32_t(getPixelFormat(settings.format, settings.sRGB));
+  createInfo.baseWidth = levels.front().width;
+  createInfo.baseHeight = levels.front().height;
+  createInfo.baseDepth = 1;
+  createInfo.numDimensions = 2;
+  createInfo.numLevels = uint32_t(levels.size());
+  createInfo.numLayers = 1;
+  createInfo.numFaces = 1;
+  createInfo.isArray = KTX_FALSE;
+  createInfo.generateMipmaps = KTX_FALSE;
+
+  std::unique_ptr<ktxTexture2, Deleter> texture;
+  {
+    ktxTexture2 *temp{nullptr};
+    if (const auto result = ktxTexture2_Create(
+          &createInfo, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &temp);
+        result != KTX_SUCCESS) {
+      return std::unexpected{ktxErrorString(result)};
+    }
+    texture.reset(temp);
+  }
+
+  CookStats stats;
+  stats.numLevels = createInfo.numLevels;
+  for (auto level = 0u; level < levels.size(); ++level) {
+    const auto &mip = levels[level];
+    stats.sourceSize += mip.pixels.size();
+
+    auto data = std::span{mip.pixels};
+    std::vector<std::byte> blocks;
+    if (!isBasisUniversal(settings.format)) {
+      const auto blockFormat = toBlockFormat(settings.format);
+      blocks =
+        bc::encode(blockFormat, mip.pixels.data(), mip.width, mip.height);
+      if (level == 0) stats.psnr = calcPSNR(mip, blockFormat, blocks);
+      data = blocks;
+    }
+    if (const auto result = ktxTexture_SetImageFromMemory(
+          ktxTexture(texture.get()), level, 0, 0,
+          std::bit_cast<const ktx_uint8_t *>(data.data()), data.size());
+        result != KTX_SUCCESS) {
+      return std::unexpected{ktxErrorString(result)};
+    }
+  }
+
+  if (isBasisUniversal(settings.format)) {
+    ktxBasisParams params{};
+    params.structSize = sizeof(ktxBasisParams);
+    params.uastc = settings.format == TargetFormat::UASTC;
+    params.threadCount = std::max(1u, std::thread::hardware_concurrency());
+    params.qualityLevel = 128; // ETC1S
+    params.uastcFlags = KTX_PACK_UASTC_LEVEL_DEFAULT;
+    if (const auto result = ktxTexture2_CompressBasisEx(texture.get(), &params);
+        result != KTX_SUCCESS) {
+      return std::unexpected{ktxErrorString(result)};
+    }
+  }
+  // ETC1S is already supercompressed (BasisLZ).
+  if (settings.zstdLevel > 0 && settings.format != TargetFormat::ETC1S) {
+    if (const auto result =
+          ktxTexture2_DeflateZstd(texture.get(), settings.zstdLevel);
+        result != KTX_SUCCESS) {
+      return std::unexpected{ktxErrorString(result)};
+    }
+  }
+
+  if (const auto result = ktxTexture_WriteToNamedFile(
+        ktxTexture(texture.get()), output.string().c_str());
+      result != KTX_SUCCESS) {
+    return std::unexpected{ktxErrorString(result)};
+  }
+  stats.outputSize = std::filesystem::file_size(output);
+  return stats;
+}
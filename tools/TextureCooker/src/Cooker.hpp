@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Image.hpp"
+#include <optional>
+
+enum class TargetFormat {
+  BC1,
+  BC3,
+  BC4,
+  BC5,
+  BC6H,
+  BC7,
+  // Basis Universal (transcoded by KTXLoader on load):
+  UASTC,
+  ETC1S,
+};
+
+struct CookSettings {
+  TargetFormat format{TargetFormat::BC7};
+  bool sRGB{false};
+  bool generateMipmaps{true};
+  // Zstandard supercompression level (0 = disabled). Ignored by ETC1S.
+  uint32_t zstdLevel{0};
+};
+
+struct CookStats {
+  std::size_t sourceSize{0}; // Uncompressed (RGBA8/RGBA32F), with mips.
+  std::size_t outputSize{0}; // .ktx2 file.
+  uint32_t numLevels{0};
+  // Of the base level, not available for Basis Universal.
+  std::optional<double> psnr;
+};
+
+[[nodiscard]] std::optional<TargetFormat> parseTargetFormat(std::string_view);
+
+[[nodiscard]] std::expected<CookStats, std::string>
+cook(Image &&, const CookSettings &, const std::filesystem::path &output);
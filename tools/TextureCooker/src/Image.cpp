@@ -0,0 +1,44 @@
+#include "Image.hpp"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include <memory>
+#include <cstdio>  // fopen, fclose
+#include <cstring> // memcpy
+
+std::expected<Image, std::string> loadImage(const std::filesystem::path &p) {
+  auto *file = std::fopen(p.string().c_str(), "rb");
+  if (!file) {
+    return std::unexpected{"Could not open the file."};
+  }
+
+  Image image;
+  image.hdr = stbi_is_hdr_from_file(file) != 0;
+
+  struct Deleter {
+    void operator()(void *pixels) const { stbi_image_free(pixels); }
+  };
+  std::unique_ptr<void, Deleter> pixels;
+  {
+    int32_t width;
+    int32_t height;
+    auto ptr = image.hdr ? static_cast<void *>(stbi_loadf_from_file(
+                             file, &width, &height, nullptr, STBI_rgb_alpha))
+                         : static_cast<void *>(stbi_load_from_file(
+                             file, &width, &height, nullptr, STBI_rgb_alpha));
+    pixels.reset(ptr);
+    image.width = uint32_t(width);
+    image.height = uint32_t(height);
+  }
+  std::fclose(file);
+
+  if (!pixels) {
+    return std::unexpected{stbi_failure_reason()};
+  }
+
+  image.pixels.resize(std::size_t{image.width} * image.height *
+                      image.getPixelSize());
+  std::memcpy(image.pixels.data(), pixels.get(), image.pixels.size());
+  return image;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <filesystem>
+#include <expected>
+#include <vector>
+
+// Tightly packed RGBA8 (LDR) or RGBA32F (HDR) pixels.
+struct Image {
+  uint32_t width{0};
+  uint32_t height{0};
+  bool hdr{false};
+  std::vector<std::byte> pixels;
+
+  [[nodiscard]] uint32_t getPixelSize() const {
+    return hdr ? sizeof(float) * 4 : sizeof(uint8_t) * 4;
+  }
+};
+
+[[nodiscard]] std::expected<Image, std::string>
+loadImage(const std::filesystem::path &);
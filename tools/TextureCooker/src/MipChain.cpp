@@ -0,0 +1,102 @@
+#include "MipChain.hpp"
+
+#include <algorithm> // clamp
+#include <array>
+#include <cmath> // pow, round
+
+namespace {
+
+[[nodiscard]] float toLinear(float c) {
+  return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+[[nodiscard]] float toSRGB(float c) {
+  return c <= 0.0031308f ? c * 12.92f
+                         : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+}
+
+class Sampler {
+public:
+  Sampler(const Image &image, bool sRGB) : m_image{image}, m_sRGB{sRGB} {
+    if (m_sRGB) {
+      for (auto i = 0u; i < m_toLinear.size(); ++i)
+        m_toLinear[i] = toLinear(float(i) / 255.0f);
+    }
+  }
+
+  // @return RGBA in linear space.
+  [[nodiscard]] std::array<float, 4> fetch(uint32_t x, uint32_t y) const {
+    x = std::min(x, m_image.width - 1);
+    y = std::min(y, m_image.height - 1);
+    const auto offset = (std::size_t{y} * m_image.width + x) * 4;
+
+    std::array<float, 4> color;
+    if (m_image.hdr) {
+      const auto *src =
+        reinterpret_cast<const float *>(m_image.pixels.data()) + offset;
+      std::copy_n(src, 4, color.begin());
+    } else {
+      const auto *src =
+        reinterpret_cast<const uint8_t *>(m_image.pixels.data()) + offset;
+      for (auto c = 0; c < 3; ++c)
+        color[c] = m_sRGB ? m_toLinear[src[c]] : float(src[c]) / 255.0f;
+      color[3] = float(src[3]) / 255.0f;
+    }
+    return color;
+  }
+
+private:
+  const Image &m_image;
+  const bool m_sRGB;
+  std::array<float, 256> m_toLinear{};
+};
+
+// 2x2 box filter.
+[[nodiscard]] Image downsample(const Image &src, bool sRGB) {
+  Image dst{
+    .width = std::max(1u, src.width / 2),
+    .height = std::max(1u, src.height / 2),
+    .hdr = src.hdr,
+    .pixels = {},
+  };
+  dst.pixels.resize(std::size_t{dst.width} * dst.height * dst.getPixelSize());
+
+  constexpr std::pair<uint32_t, uint32_t> kOffsets[]{
+    {0, 0}, {1, 0}, {0, 1}, {1, 1},
+  };
+
+  const Sampler sampler{src, sRGB};
+  for (auto y = 0u; y < dst.height; ++y) {
+    for (auto x = 0u; x < dst.width; ++x) {
+      std::array<float, 4> sum{};
+      for (const auto &[dx, dy] : kOffsets) {
+        const auto color = sampler.fetch(x * 2 + dx, y * 2 + dy);
+        for (auto c = 0; c < 4; ++c)
+          sum[c] += color[c] * 0.25f;
+      }
+
+      const auto offset = (std::size_t{y} * dst.width + x) * 4;
+      if (dst.hdr) {
+        auto *out = reinterpret_cast<float *>(dst.pixels.data()) + offset;
+        std::copy_n(sum.cbegin(), 4, out);
+      } else {
+        auto *out = reinterpret_cast<uint8_t *>(dst.pixels.data()) + offset;
+        for (auto c = 0; c < 4; ++c) {
+          const auto v = c < 3 && sRGB ? toSRGB(sum[c]) : sum[c];
+          out[c] = uint8_t(std::clamp(std::round(v * 255.0f), 0.0f, 255.0f));
+        }
+      }
+    }
+  }
+  return dst;
+}
+
+} // namespace
+
+std::vector<Image> buildMipChain(Image &&image, bool sRGB) {
+  std::vector<Image> levels;
+  levels.emplace_back(std::move(image));
+  while (levels.back().width > 1 || levels.back().height > 1) {
+    levels.emplace_back(downsample(levels.back(), sRGB));
+  }
+  return levels;
+}
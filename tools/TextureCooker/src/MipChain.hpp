@@ -0,0 +1,7 @@
+#pragma once
+
+#include "Image.hpp"
+
+// @param sRGB Filter in linear space (LDR only).
+// @return Base level (source image) followed by all mip levels, down to 1x1.
+[[nodiscard]] std::vector<Image> buildMipChain(Image &&, bool sRGB);
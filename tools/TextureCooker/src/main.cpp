@@ -0,0 +1,111 @@
+#include "Cooker.hpp"
+
+#include "argparse/argparse.hpp"
+#include "spdlog/spdlog.h"
+
+namespace {
+
+class Stopwatch {
+  using clock = std::chrono::high_resolution_clock;
+
+public:
+  Stopwatch() { start(); }
+
+  void start() { m_start = clock::now(); }
+  template <typename T = std::chrono::milliseconds> auto count() {
+    return std::chrono::duration_cast<T>(clock::now() - m_start);
+  }
+
+private:
+  clock::time_point m_start;
+};
+
+class App {
+public:
+  App() {
+    m_program.add_argument("input")
+      .help("Source image (.png, .jpg, .tga, .hdr, ...)")
+      .metavar("IMAGE_PATH")
+      .required();
+    m_program.add_argument("-o", "--output")
+      .help("Output .ktx2 file (defaults to the input path)")
+      .metavar("KTX2_PATH");
+
+    m_program.add_argument("--format")
+      .help("bc1|bc3|bc4|bc5|bc6h|bc7|uastc|etc1s")
+      .default_value(std::string{"bc7"});
+    m_program.add_argument("--srgb")
+      .help("Color data (albedo, emissive)")
+      .default_value(false)
+      .implicit_value(true);
+    m_program.add_argument("--no-mips")
+      .help("Skips generation of the mip chain")
+      .default_value(false)
+      .implicit_value(true);
+    m_program.add_argument("--zstd")
+      .help("Zstandard supercompression level (1-22)")
+      .default_value(0u)
+      .scan<'u', uint32_t>();
+
+    auto &logger = *spdlog::default_logger();
+    logger.set_pattern("[%^%l%$] %v");
+  }
+
+  int32_t execute(int argc, char *argv[]) {
+    try {
+      m_program.parse_args(argc, argv);
+    } catch (const std::runtime_error &err) {
+      std::cerr << err.what() << std::endl << m_program;
+      return -1;
+    }
+
+    const auto format =
+      parseTargetFormat(m_program.get<std::string>("--format"));
+    if (!format) {
+      std::cerr << "Unknown format." << std::endl << m_program;
+      return -1;
+    }
+    const std::filesystem::path inputPath = m_program.get<std::string>("input");
+    const auto outputPath =
+      m_program.present("--output")
+        ? std::filesystem::path{m_program.get<std::string>("--output")}
+        : std::filesystem::path{inputPath}.replace_extension(".ktx2");
+
+    Stopwatch stopwatch;
+    auto image = loadImage(inputPath);
+    if (!image) {
+      std::cerr << "Loader error: " << image.error() << std::endl;
+      return -2;
+    }
+    spdlog::info("Load time: {}", stopwatch.count());
+
+    stopwatch.start();
+    const auto stats = cook(std::move(*image),
+                            {
+                              .format = *format,
+                              .sRGB = m_program.get<bool>("--srgb"),
+                              .generateMipmaps = !m_program.get<bool>("--no-mips"),
+                              .zstdLevel = m_program.get<uint32_t>("--zstd"),
+                            },
+                            outputPath);
+    if (!stats) {
+      std::cerr << "Cooker error: " << stats.error() << std::endl;
+      return -3;
+    }
+    spdlog::info("Cook time: {}", stopwatch.count());
+    spdlog::info("Mip levels: {}", stats->numLevels);
+    spdlog::info("Size: {} -> {} bytes ({:.2f}x)", stats->sourceSize,
+                 stats->outputSize,
+                 double(stats->sourceSize) / double(stats->outputSize));
+    if (stats->psnr) spdlog::info("PSNR: {:.2f} dB", *stats->psnr);
+
+    return 0;
+  }
+
+private:
+  argparse::ArgumentParser m_program{"TextureCooker"};
+};
+
+} // namespace
+
+int main(int argc, char *argv[]) { return App{}.execute(argc, argv); }
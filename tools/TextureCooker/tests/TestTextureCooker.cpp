@@ -0,0 +1,157 @@
+#include "catch.hpp"
+
+#include "Cooker.hpp"
+#include "MipChain.hpp"
+#include "rhi/PixelFormat.hpp"
+
+#include "ktx.h"
+
+#include <algorithm> // max
+#include <memory>
+#include <cstring> // memcpy
+
+namespace {
+
+constexpr auto kWidth = 70u;
+constexpr auto kHeight = 45u; // Not a multiple of the block size.
+
+[[nodiscard]] Image makeImage(uint32_t width, uint32_t height, bool hdr) {
+  Image image{.width = width, .height = height, .hdr = hdr, .pixels = {}};
+  image.pixels.resize(std::size_t{width} * height * image.getPixelSize());
+  return image;
+}
+[[nodiscard]] Image makeLDRImage(uint32_t width, uint32_t height) {
+  auto image = makeImage(width, height, false);
+  auto *dst = reinterpret_cast<uint8_t *>(image.pixels.data());
+  for (auto y = 0u; y < height; ++y) {
+    for (auto x = 0u; x < width; ++x, dst += 4) {
+      dst[0] = uint8_t(255 * x / width);
+      dst[1] = uint8_t(255 * y / height);
+      dst[2] = uint8_t(255 * (x + y) / (width + height));
+      dst[3] = 255;
+    }
+  }
+  return image;
+}
+[[nodiscard]] Image makeHDRImage(uint32_t width, uint32_t height) {
+  auto image = makeImage(width, height, true);
+  auto *dst = reinterpret_cast<float *>(image.pixels.data());
+  for (auto y = 0u; y < height; ++y) {
+    for (auto x = 0u; x < width; ++x, dst += 4) {
+      dst[0] = 16.0f * float(x) / float(width);
+      dst[1] = 4.0f * float(y) / float(height);
+      dst[2] = 0.5f;
+      dst[3] = 1.0f;
+    }
+  }
+  return image;
+}
+
+struct Deleter {
+  void operator()(ktxTexture2 *texture) const {
+    ktxTexture_Destroy(ktxTexture(texture));
+  }
+};
+[[nodiscard]] std::unique_ptr<ktxTexture2, Deleter>
+loadTexture(const std::filesystem::path &p) {
+  ktxTexture2 *texture{nullptr};
+  REQUIRE(ktxTexture2_CreateFromNamedFile(p.string().c_str(),
+                                          KTX_TEXTURE_CREATE_NO_FLAGS,
+                                          &texture) == KTX_SUCCESS);
+  return std::unique_ptr<ktxTexture2, Deleter>{texture};
+}
+
+} // namespace
+
+TEST_CASE("Target format") {
+  REQUIRE(parseTargetFormat("bc6h") == TargetFormat::BC6H);
+  REQUIRE(parseTargetFormat("etc1s") == TargetFormat::ETC1S);
+  REQUIRE_FALSE(parseTargetFormat("BC7"));
+  REQUIRE_FALSE(parseTargetFormat("astc"));
+}
+
+TEST_CASE("Mip chain") {
+  const auto levels = buildMipChain(makeLDRImage(kWidth, kHeight), false);
+  REQUIRE(levels.size() == 7);
+  REQUIRE(levels.front().width == kWidth);
+  REQUIRE(levels.front().height == kHeight);
+  for (auto i = 1u; i < levels.size(); ++i) {
+    const auto &level = levels[i];
+    REQUIRE(level.width == std::max(1u, levels[i - 1].width / 2));
+    REQUIRE(level.height == std::max(1u, levels[i - 1].height / 2));
+    REQUIRE(level.pixels.size() ==
+            std::size_t{level.width} * level.height * level.getPixelSize());
+  }
+  REQUIRE(levels.back().width == 1);
+  REQUIRE(levels.back().height == 1);
+
+  SECTION("sRGB") {
+    // Black and white checkerboard.
+    auto image = makeImage(2, 2, false);
+    constexpr uint8_t kPixels[]{
+      0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 255,
+    };
+    std::memcpy(image.pixels.data(), kPixels, sizeof(kPixels));
+
+    const auto linear = buildMipChain(Image{image}, false);
+    const auto sRGB = buildMipChain(std::move(image), true);
+    REQUIRE(linear.size() == 2);
+    REQUIRE(sRGB.size() == 2);
+    // Averaged in linear space: 0.5 -> 188 (instead of 128).
+    REQUIRE(uint8_t(linear.back().pixels[0]) == 128);
+    REQUIRE(uint8_t(sRGB.back().pixels[0]) == 188);
+    REQUIRE(uint8_t(sRGB.back().pixels[3]) == 255);
+  }
+}
+
+TEST_CASE("Cook") {
+  const auto output =
+    std::filesystem::temp_directory_path() / "TestTextureCooker.ktx2";
+
+  SECTION("BC7") {
+    CookSettings settings;
+    settings.sRGB = true;
+    const auto stats = cook(makeLDRImage(kWidth, kHeight), settings, output);
+    REQUIRE(stats);
+    REQUIRE(stats->numLevels == 7);
+    REQUIRE(stats->outputSize == std::filesystem::file_size(output));
+    REQUIRE(stats->psnr);
+    REQUIRE(*stats->psnr >= 30.0);
+
+    const auto texture = loadTexture(output);
+    REQUIRE(texture->vkFormat == ktx_uint32_t(rhi::PixelFormat::BC7_sRGB));
+    REQUIRE(texture->baseWidth == kWidth);
+    REQUIRE(texture->baseHeight == kHeight);
+    REQUIRE(texture->numLevels == 7);
+  }
+  SECTION("BC6H") {
+    const auto stats = cook(makeHDRImage(kWidth, kHeight),
+                            {
+                              .format = TargetFormat::BC6H,
+                              .sRGB = false,
+                              .generateMipmaps = false,
+                              .zstdLevel = 3,
+                            },
+                            output);
+    REQUIRE(stats);
+    REQUIRE(stats->numLevels == 1);
+    REQUIRE(stats->psnr);
+    REQUIRE(*stats->psnr >= 30.0);
+
+    const auto texture = loadTexture(output);
+    REQUIRE(texture->vkFormat == ktx_uint32_t(rhi::PixelFormat::BC6H_UFloat));
+    REQUIRE(texture->supercompressionScheme == KTX_SS_ZSTD);
+  }
+  SECTION("Invalid settings") {
+    CookSettings settings;
+    REQUIRE_FALSE(cook(makeHDRImage(4, 4), settings, output));
+    settings.format = TargetFormat::BC6H;
+    REQUIRE_FALSE(cook(makeLDRImage(4, 4), settings, output));
+    settings.sRGB = true;
+    REQUIRE_FALSE(cook(makeHDRImage(4, 4), settings, output));
+  }
+
+  std::filesystem::remove(output);
+}
+
+int main(int argc, char *argv[]) { return Catch::Session{}.run(argc, argv); }